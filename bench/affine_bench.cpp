@@ -0,0 +1,91 @@
+#include<vector>
+
+#include "substd/affine.hpp"
+#include "bench.hpp"
+
+constexpr size_t count = 1 << 16;
+constexpr size_t iterations = 50;
+
+template<typename T>
+void Run(const char* type){
+    std::vector<ss::mat<T,4>> ma(count), mb(count), mout(count);
+    std::vector<ss::affine<T,3>> aa(count), ab(count), aout(count);
+    for(size_t i = 0; i < count; i++){
+        ss::mat<T,3> r = ss::CreateRotationMatrix<T,3>(ss::vec<T,3>{(T)(i % 7) * (T)0.1, (T)0.2, (T)(i % 3) * (T)0.3});
+        aa[i] = ss::affine<T,3>(r, ss::vec<T,3>{(T)i, (T)1, (T)-2});
+        ab[i] = ss::affine<T,3>(r.Transpose(), ss::vec<T,3>{(T)0.5, (T)(i % 5), (T)3});
+        ma[i] = aa[i].ToMatrix();
+        mb[i] = ab[i].ToMatrix();
+    }
+    std::vector<ss::vec<T,3>> points(count), out(count);
+    for(size_t i = 0; i < count; i++){points[i] = ss::vec<T,3>{(T)i, (T)(i % 11), (T)-1};}
+
+    std::printf("%s: %zu transforms, %zu bytes as mat<%s,4>, %zu as affine<%s,3>\n", type, count, sizeof(ss::mat<T,4>) * count, type, sizeof(ss::affine<T,3>) * count, type);
+    bench::Header("mat4", "affine");
+    bench::Report("compose pairs", bench::Measure(iterations, [&]{
+        for(size_t i = 0; i < count; i++){mout[i] = ma[i] * mb[i];}
+        bench::Keep(mout);
+    }), bench::Measure(iterations, [&]{
+        for(size_t i = 0; i < count; i++){aout[i] = aa[i] * ab[i];}
+        bench::Keep(aout);
+    }));
+    //Each product feeds the next, as walking down a hierarchy does
+    bench::Report("compose chain", bench::Measure(iterations, [&]{
+        ss::mat<T,4> acc(1);
+        for(size_t i = 0; i < count; i++){acc = acc * ma[i];}
+        bench::Keep(acc);
+    }), bench::Measure(iterations, [&]{
+        ss::affine<T,3> acc((T)1);
+        for(size_t i = 0; i < count; i++){acc = acc * aa[i];}
+        bench::Keep(acc);
+    }));
+    //What Orientation used to do, a plug matrix times a rotation matrix, against building it directly
+    std::vector<ss::vec<T,3>> angles(count);
+    for(size_t i = 0; i < count; i++){angles[i] = ss::vec<T,3>{(T)(i % 7) * (T)0.1, (T)0.2, (T)(i % 3) * (T)0.3};}
+    bench::Report("build TRS", bench::Measure(iterations, [&]{
+        for(size_t i = 0; i < count; i++){
+            ss::mat<T,4> plug(1), rot(1);
+            const ss::mat<T,3> r = ss::CreateRotationMatrix<T,3>(angles[i]);
+            for(size_t col = 0; col < 3; col++){
+                plug[col][col] = points[i][col];
+                plug[3][col] = points[i][col];
+                for(size_t row = 0; row < 3; row++){rot[col][row] = r[col][row];}
+            }
+            mout[i] = plug * rot;
+        }
+        bench::Keep(mout);
+    }), bench::Measure(iterations, [&]{
+        for(size_t i = 0; i < count; i++){aout[i] = ss::CreateTRS<T,3>(points[i], points[i], angles[i]);}
+        bench::Keep(aout);
+    }));
+    bench::Report("transform points", bench::Measure(iterations, [&]{
+        for(size_t i = 0; i < count; i++){
+            const ss::vec<T,4> p = ma[i] * points[i].Homogenized();
+            out[i] = ss::vec<T,3>{p[0], p[1], p[2]};
+        }
+        bench::Keep(out);
+    }), bench::Measure(iterations, [&]{
+        for(size_t i = 0; i < count; i++){out[i] = aa[i] * points[i];}
+        bench::Keep(out);
+    }));
+    bench::Report("inverse, orthogonal rows", bench::Measure(iterations, [&]{
+        for(size_t i = 0; i < count; i++){mout[i] = ma[i].AffineInverse();}
+        bench::Keep(mout);
+    }), bench::Measure(iterations, [&]{
+        for(size_t i = 0; i < count; i++){aout[i] = aa[i].OrthogonalInverse();}
+        bench::Keep(aout);
+    }));
+    bench::Report("inverse, general", bench::Measure(iterations, [&]{
+        for(size_t i = 0; i < count; i++){mout[i] = ma[i].Inverse();}
+        bench::Keep(mout);
+    }), bench::Measure(iterations, [&]{
+        for(size_t i = 0; i < count; i++){aout[i] = aa[i].Inverse();}
+        bench::Keep(aout);
+    }));
+}
+
+int main(int argc, const char** argv){
+    Run<float>("float");
+    Run<double>("double");
+    return 0;
+}
@@ -0,0 +1,45 @@
+#ifndef SUBSTD_BENCH_HPP
+#define SUBSTD_BENCH_HPP
+
+#include<chrono>
+#include<cstdio>
+#include<cstddef>
+
+namespace bench {
+
+///@fn Keep Forces the compiler to materialize t, so the work producing it cannot be optimized away.
+template<typename T>
+inline void Keep(const T& t){
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r"(&t) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &t;
+#endif
+}
+
+///@fn Measure Runs f() iterations times and returns the average nanoseconds per call.
+template<typename F>
+double Measure(const size_t& iterations, F f){
+    f();
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < iterations; i++){
+        f();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (double)iterations;
+}
+
+///@fn Report Prints a row of the form "name  baseline ns  candidate ns  speedup"
+inline void Report(const char* name, const double& baseline, const double& candidate){
+    std::printf("%-40s %12.3f ns %12.3f ns %8.2fx\n", name, baseline, candidate, baseline / candidate);
+}
+
+///@fn Header
+inline void Header(const char* baseline, const char* candidate){
+    std::printf("%-40s %15s %15s %9s\n", "benchmark", baseline, candidate, "speedup");
+}
+
+}
+
+#endif//SUBSTD_BENCH_HPP
@@ -0,0 +1,143 @@
+#include<cstdio>
+#include<fstream>
+#include<sstream>
+#include<string>
+#include<vector>
+
+#include "substd/codec.hpp"
+#include "substd/io.hpp"
+#include "bench.hpp"
+
+constexpr size_t count = 1 << 22;
+
+//Mostly single byte values, some two byte and a few wide ones, like the deltas and ids we store
+std::vector<uint32_t> TypicalValues(){
+    std::vector<uint32_t> values(count);
+    uint32_t state = 12345;
+    for(size_t i = 0; i < count; i++){
+        state = (state * 1103515245u) + 12345u;
+        const uint32_t r = state >> 8;
+        const uint32_t bucket = r % 32;
+        values[i] = (bucket == 0) ? r : ((bucket < 5) ? (r & 0x3FFF) : (r & 0x7F));
+    }
+    return values;
+}
+
+int main(int argc, const char** argv){
+    const std::vector<uint32_t> values = TypicalValues();
+    std::vector<uint32_t> out(count);
+
+    std::vector<uint8_t> fixed;
+    {
+        ss::ByteWriter w(fixed);
+        w.WriteLEU32Array(values.data(), count);
+    }
+    std::vector<uint8_t> varint;
+    {
+        ss::ByteWriter w(varint);
+        w.WriteVarU32Array(values.data(), count);
+    }
+
+    std::printf("%zu uint32s, %zu bytes fixed width, %zu bytes as varints (%.2f bytes each)\n",
+        count, fixed.size(), varint.size(), (double)varint.size() / (double)count);
+    bench::Header("fixed width", "varint");
+
+    const double fixed_read = bench::Measure(10, [&]{
+        ss::ByteReader r(fixed.data(), fixed.size());
+        for(size_t i = 0; i < count; i++){out[i] = r.ReadLEU32();}
+        bench::Keep(out);
+    });
+    bench::Report("ByteReader::ReadVarU32", fixed_read, bench::Measure(10, [&]{
+        ss::ByteReader r(varint.data(), varint.size());
+        for(size_t i = 0; i < count; i++){out[i] = r.ReadVarU32();}
+        bench::Keep(out);
+    }));
+
+    const double fixed_array = bench::Measure(10, [&]{
+        ss::ByteReader r(fixed.data(), fixed.size());
+        r.ReadLEU32Array(out.data(), count);
+        bench::Keep(out);
+    });
+    bench::Report("DecodeVarint loop", fixed_array, bench::Measure(10, [&]{
+        const uint8_t* in = varint.data();
+        const uint8_t* end = in + varint.size();
+        for(size_t i = 0; i < count; i++){in += ss::DecodeVarint<uint32_t>(in, end, out[i]);}
+        bench::Keep(out);
+    }));
+    bench::Report("DecodeVarintArray", fixed_array, bench::Measure(10, [&]{
+        size_t consumed;
+        ss::DecodeVarintArray(varint.data(), varint.size(), out.data(), count, consumed);
+        bench::Keep(out);
+    }));
+    bench::Report("ByteReader::ReadVarU32Array", fixed_array, bench::Measure(10, [&]{
+        ss::ByteReader r(varint.data(), varint.size());
+        r.ReadVarU32Array(out.data(), count);
+        bench::Keep(out);
+    }));
+
+    const double fixed_write = bench::Measure(10, [&]{
+        std::vector<uint8_t> bytes;
+        ss::ByteWriter w(bytes);
+        w.WriteLEU32Array(values.data(), count);
+        bench::Keep(bytes);
+    });
+    bench::Report("ByteWriter::WriteVarU32Array", fixed_write, bench::Measure(10, [&]{
+        std::vector<uint8_t> bytes;
+        ss::ByteWriter w(bytes);
+        w.WriteVarU32Array(values.data(), count);
+        bench::Keep(bytes);
+    }));
+
+    //Through a stream and a file, where the varints' smaller size counts
+    const std::string fixed_string(fixed.begin(), fixed.end());
+    const std::string varint_string(varint.begin(), varint.end());
+    std::printf("\nthe same values through a stream and a file\n");
+    bench::Header("fixed width", "varint");
+    bench::Report("ByteReader::ReadVarU32Array (istream)", bench::Measure(10, [&]{
+        std::istringstream istr(fixed_string);
+        ss::ByteReader r(istr);
+        r.ReadLEU32Array(out.data(), count);
+        bench::Keep(out);
+    }), bench::Measure(10, [&]{
+        std::istringstream istr(varint_string);
+        ss::ByteReader r(istr);
+        r.ReadVarU32Array(out.data(), count);
+        bench::Keep(out);
+    }));
+    const char* fixed_path = "codec_bench_fixed.bin";
+    const char* varint_path = "codec_bench_varint.bin";
+    {
+        std::ofstream f(fixed_path, std::ios::binary);
+        f.write(fixed_string.data(), (std::streamsize)fixed_string.size());
+        std::ofstream v(varint_path, std::ios::binary);
+        v.write(varint_string.data(), (std::streamsize)varint_string.size());
+    }
+    bench::Report("ByteReader::ReadVarU32Array (ifstream)", bench::Measure(10, [&]{
+        std::ifstream file(fixed_path, std::ios::binary);
+        ss::ByteReader r(file);
+        r.ReadLEU32Array(out.data(), count);
+        bench::Keep(out);
+    }), bench::Measure(10, [&]{
+        std::ifstream file(varint_path, std::ios::binary);
+        ss::ByteReader r(file);
+        r.ReadVarU32Array(out.data(), count);
+        bench::Keep(out);
+    }));
+    std::remove(fixed_path);
+    std::remove(varint_path);
+
+    //Fixed 14 bit fields (wide values truncated), against the whole words they replace
+    std::vector<uint8_t> packed;
+    {
+        ss::BitWriter w(packed);
+        for(size_t i = 0; i < count; i++){w.Write(values[i], 14);}
+    }
+    std::printf("\n%zu 14 bit fields, %zu bytes packed\n", count, packed.size());
+    bench::Header("fixed width", "bits");
+    bench::Report("BitReader::Read(14)", fixed_read, bench::Measure(10, [&]{
+        ss::BitReader r(packed.data(), packed.size());
+        for(size_t i = 0; i < count; i++){out[i] = (uint32_t)r.Read(14);}
+        bench::Keep(out);
+    }));
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include<cstdio>
+#include<sstream>
+#include<string>
+#include<vector>
+
+#include "substd/mat.hpp"
+#include "bench.hpp"
+
+// The operator<< vec and mat had before format.hpp, each component through ostream formatting
+// and a GetRow copy per mat row, kept here as the baseline the current implementation is measured against.
+namespace legacy {
+
+template<typename T, size_t dim>
+void Print(std::ostream& o, const ss::vec<T, dim>& v){
+    o<<"("<<v.front();
+    for(auto iter = v.begin()+1; iter!=v.end(); iter++){
+        o<<", "<<(*iter);
+    }
+    o<<")";
+}
+
+template<typename T, size_t r, size_t c>
+void Print(std::ostream& o, const ss::mat<T, r, c>& m){
+    for(size_t row = 0; row < m.NumberOfRows(); row++){
+        ss::vec<T, c> curr = m.GetRow(row);
+        o<<"["<<curr[0];
+        for(size_t i = 1; i < curr.Dimension(); i++){
+            o<<", "<<curr[i];
+        }
+        o<<"]"<<"\n";
+    }
+}
+
+// Reading the components back with istream extraction
+template<typename T, size_t dim>
+void Scan(std::istream& i, ss::vec<T, dim>& v){
+    char c;
+    i>>c;
+    for(size_t k = 0; k < dim; k++){i>>v[k]>>c;}
+}
+
+}
+
+constexpr size_t count = 1 << 18;
+
+int main(int argc, const char** argv){
+    std::vector<ss::vec3f> points(count), parsed(count);
+    std::vector<ss::mat<float, 4>> transforms(count / 16, ss::mat<float, 4>(1));
+    for(size_t i = 0; i < count; i++){
+        const float f = (float)i;
+        points[i] = ss::vec3f{f * 0.37f, -f / 7.0f, f * 1.0e-3f};
+        transforms[i % transforms.size()][3][i % 3] = f * 0.1f;
+    }
+
+    std::printf("%zu vec3fs, %zu mat4fs\n", count, transforms.size());
+    bench::Header("legacy", "substd");
+    const double legacy_vec = bench::Measure(3, [&]{
+        std::ostringstream o;
+        for(const ss::vec3f& p : points){legacy::Print(o, p); o<<'\n';}
+        bench::Keep(o);
+    });
+    bench::Report("vec operator<<", legacy_vec, bench::Measure(3, [&]{
+        std::ostringstream o;
+        for(const ss::vec3f& p : points){o<<p<<'\n';}
+        bench::Keep(o);
+    }));
+    bench::Report("vec AppendTo (reused string)", legacy_vec, bench::Measure(3, [&]{
+        std::string s;
+        for(const ss::vec3f& p : points){ss::AppendTo(s, p); s.push_back('\n');}
+        bench::Keep(s);
+    }));
+    const double legacy_mat = bench::Measure(3, [&]{
+        std::ostringstream o;
+        for(const ss::mat<float, 4>& m : transforms){legacy::Print(o, m);}
+        bench::Keep(o);
+    });
+    bench::Report("mat operator<<", legacy_mat, bench::Measure(3, [&]{
+        std::ostringstream o;
+        for(const ss::mat<float, 4>& m : transforms){o<<m;}
+        bench::Keep(o);
+    }));
+    bench::Report("mat AppendTo CSV (reused string)", legacy_mat, bench::Measure(3, [&]{
+        std::string s;
+        for(const ss::mat<float, 4>& m : transforms){ss::AppendTo(s, m, ss::Format::CSV());}
+        bench::Keep(s);
+    }));
+
+    std::string text;
+    for(const ss::vec3f& p : points){ss::AppendTo(text, p); text.push_back('\n');}
+    bench::Report("vec Parse", bench::Measure(3, [&]{
+        std::istringstream i(text);
+        for(ss::vec3f& p : parsed){legacy::Scan(i, p);}
+        bench::Keep(parsed);
+    }), bench::Measure(3, [&]{
+        const char* at = text.data();
+        const char* end = text.data() + text.size();
+        for(ss::vec3f& p : parsed){at = ss::Parse(at, end, p);}
+        bench::Keep(parsed);
+    }));
+    return 0;
+}
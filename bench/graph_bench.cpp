@@ -0,0 +1,153 @@
+#include<chrono>
+#include<cstdio>
+#include<queue>
+#include<vector>
+
+#include "substd/graph.hpp"
+#include "bench.hpp"
+
+struct Node : public ss::Tree<Node> {
+    float value;
+    Node(Node* parent, const float& value) : ss::Tree<Node>(parent), value(value) {}
+};
+
+float SumPreOrder(const ss::Tree<Node>* node){
+    float sum = static_cast<const Node*>(node)->value;
+    for(const ss::Tree<Node>* child : *node){sum += SumPreOrder(child);}
+    return sum;
+}
+
+float SumPostOrder(ss::Tree<Node>* node){
+    float sum = 0;
+    for(ss::Tree<Node>* child : *node){sum += SumPostOrder(child);}
+    Node* self = static_cast<Node*>(node);
+    self->value = sum * 0.5f + 1.0f;
+    return self->value;
+}
+
+float SumValuesPostOrder(const ss::Tree<Node>* node){
+    float sum = 0;
+    for(const ss::Tree<Node>* child : *node){sum += SumValuesPostOrder(child);}
+    return sum + static_cast<const Node*>(node)->value;
+}
+
+constexpr size_t count = 200000;
+
+int main(int argc, const char** argv){
+    //A scene like shape built depth first, each node a child of somewhere along the current path, which is
+    //kept to around 16 deep
+    uint32_t state = 3;
+    auto random = [&](const uint32_t& n){
+        state = (state * 1103515245u) + 12345u;
+        return (state >> 8) % n;
+    };
+    std::vector<size_t> parent_of(count, count);
+    {
+        std::vector<size_t> path{0};
+        for(size_t i = 1; i < count; i++){
+            const size_t pop = (path.size() > 16) ? 1 + random(3) : random(3);
+            for(size_t k = 0; k < pop && path.size() > 1; k++){path.pop_back();}
+            parent_of[i] = path.back();
+            path.push_back(i);
+        }
+    }
+
+    std::vector<Node*> nodes(count);
+    ss::FlatTree<float> flat;
+    std::printf("%zu nodes\n", count);
+    bench::Header("Tree", "FlatTree");
+    bench::Report("build depth first", bench::Measure(1, [&]{
+        for(size_t i = 0; i < count; i++){nodes[i] = new Node((i == 0) ? nullptr : nodes[parent_of[i]], (float)(i % 7));}
+        bench::Keep(nodes);
+        if(nodes[0] != nullptr){delete nodes[0];}
+        for(size_t i = 0; i < count; i++){nodes[i] = new Node((i == 0) ? nullptr : nodes[parent_of[i]], (float)(i % 7));}
+    }), bench::Measure(1, [&]{
+        flat.Clear();
+        for(size_t i = 0; i < count; i++){
+            if(i == 0){flat.AddRoot((float)(i % 7));}
+            else{flat.AddChild((ss::FlatTree<float>::index_type)parent_of[i], (float)(i % 7));}
+        }
+        bench::Keep(flat);
+    }));
+    //Measure runs each once more before timing, leaving one tree of each to use below
+    delete nodes[0];
+    for(size_t i = 0; i < count; i++){nodes[i] = new Node((i == 0) ? nullptr : nodes[parent_of[i]], (float)(i % 7));}
+
+    //Scatter the heap tree the way edits over time do, moving subtrees about. Moves are checked in sequence
+    //against the parents so far, so none makes a cycle.
+    std::vector<size_t> parents = parent_of;
+    std::vector<std::pair<size_t, size_t>> moves;
+    while(moves.size() < 2000){
+        const size_t node = 1 + random(count - 1);
+        const size_t target = random(count);
+        bool inside = false;
+        for(size_t a = target; a != count && !inside; a = parents[a]){inside = (a == node);}
+        if(!inside){
+            moves.emplace_back(node, target);
+            parents[node] = target;
+        }
+    }
+    std::vector<uint32_t> handles(count);
+    for(ss::FlatTree<float>::index_type k = 0; k < count; k++){handles[k] = flat.HandleOf(k);}
+    //Each move is made once, so these are timed directly rather than with Measure
+    auto once = [](auto f){
+        auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    };
+    bench::Report("reparent 2000 subtrees", once([&]{
+        for(auto& m : moves){nodes[m.first]->GetParent()->GiveChild(nodes[m.second], nodes[m.first]);}
+    }), once([&]{
+        for(auto& m : moves){flat.Reparent(flat.IndexOf(handles[m.first]), flat.IndexOf(handles[m.second]));}
+    }));
+
+    float tree_sum = 0, flat_sum = 0;
+    bench::Report("sum values pre-order", bench::Measure(20, [&]{
+        tree_sum = SumPreOrder(nodes[0]);
+        bench::Keep(tree_sum);
+    }), bench::Measure(20, [&]{
+        flat_sum = 0;
+        for(const float& v : flat){flat_sum += v;}
+        bench::Keep(flat_sum);
+    }));
+    std::vector<float> subtree(count);
+    bench::Report("subtree sums post-order", bench::Measure(20, [&]{
+        tree_sum = SumPostOrder(nodes[0]);
+        bench::Keep(tree_sum);
+    }), bench::Measure(20, [&]{
+        //Children are after their parent, so a reverse scan sees every child first
+        std::fill(subtree.begin(), subtree.end(), 0.0f);
+        for(ss::FlatTree<float>::index_type k = (ss::FlatTree<float>::index_type)count; k-- > 0;){
+            flat[k] = subtree[k] * 0.5f + 1.0f;
+            const ss::FlatTree<float>::index_type p = flat.Parent(k);
+            if(p != ss::FlatTree<float>::NONE){subtree[p] += flat[k];}
+        }
+        bench::Keep(subtree);
+    }));
+    bench::Report("PostOrder iteration", bench::Measure(20, [&]{
+        tree_sum = SumValuesPostOrder(nodes[0]);
+        bench::Keep(tree_sum);
+    }), bench::Measure(20, [&]{
+        flat_sum = 0;
+        for(ss::FlatTree<float>::index_type k : flat.PostOrder()){flat_sum += flat[k];}
+        bench::Keep(flat_sum);
+    }));
+    bench::Report("breadth first", bench::Measure(20, [&]{
+        std::queue<const ss::Tree<Node>*> queue;
+        queue.push(nodes[0]);
+        tree_sum = 0;
+        while(!queue.empty()){
+            const ss::Tree<Node>* n = queue.front();
+            queue.pop();
+            tree_sum += static_cast<const Node*>(n)->value;
+            for(const ss::Tree<Node>* child : *n){queue.push(child);}
+        }
+        bench::Keep(tree_sum);
+    }), bench::Measure(20, [&]{
+        flat_sum = 0;
+        for(ss::FlatTree<float>::index_type k : flat.BreadthFirst()){flat_sum += flat[k];}
+        bench::Keep(flat_sum);
+    }));
+    delete nodes[0];
+    return 0;
+}
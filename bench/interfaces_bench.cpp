@@ -0,0 +1,105 @@
+#include<vector>
+
+#include "substd/interfaces.hpp"
+#include "bench.hpp"
+
+// ss::ITransformable before version numbers: every change walked the whole subtree below it setting a flag.
+namespace legacy {
+
+template<typename T, size_t dim>
+class ITransformable : public ss::Tree<ITransformable<T,dim>> {
+protected:
+    mutable bool parentHasChanged;
+    mutable ss::mat<T,dim+1> globalMatrix;
+
+    void NotifyChildren() {
+        for(auto iter = this->begin(); iter != this->end(); iter++){
+            ITransformable<T,dim>* child = static_cast<ITransformable<T,dim>*>(*iter);
+            child->parentHasChanged = true;
+            child->NotifyChildren();
+        }
+    }
+
+public:
+    ITransformable(ITransformable<T,dim>* parent) : ss::Tree<ITransformable<T,dim>>(parent), parentHasChanged(true), globalMatrix(1) {}
+    virtual ss::mat<T,dim+1> GetLocalMatrix() const = 0;
+
+    void FlagLocalChange() {
+        parentHasChanged = true;
+        NotifyChildren();
+    }
+
+    ss::mat<T,dim+1> GetGlobalMatrix() const {
+        if(parentHasChanged){
+            const ITransformable<T,dim>* parent = static_cast<const ITransformable<T,dim>*>(this->GetParent());
+            globalMatrix = (parent != nullptr) ? (parent->GetGlobalMatrix() * GetLocalMatrix()) : GetLocalMatrix();
+            parentHasChanged = false;
+        }
+        return globalMatrix;
+    }
+};
+
+}
+
+template<class Base>
+class Node : public Base {
+public:
+    ss::mat<float,4> local;
+    Node(Node* parent, const float& x) : Base(parent), local(1) {local[3] = ss::vec4f{x, 0.5f, -x, 1.0f};}
+    ss::mat<float,4> GetLocalMatrix() const override {return local;}
+    void Move(const float& x){
+        local[3][0] = x;
+        this->FlagLocalChange();
+    }
+};
+using LegacyNode = Node<legacy::ITransformable<float,3>>;
+using VersionedNode = Node<ss::ITransformable<float,3>>;
+
+constexpr size_t count = 1 << 17;
+
+int main(int argc, const char** argv){
+    //The same shape twice, each node under a uniformly random earlier one
+    std::vector<LegacyNode*> legacy_nodes{new LegacyNode(nullptr, 0.0f)};
+    std::vector<VersionedNode*> nodes{new VersionedNode(nullptr, 0.0f)};
+    std::vector<size_t> has_child(count, 0);
+    uint32_t state = 5;
+    auto random = [&](const size_t& n){
+        state = (state * 1103515245u) + 12345u;
+        return (size_t)(state >> 8) % n;
+    };
+    for(size_t i = 1; i < count; i++){
+        const size_t parent = random(i);
+        has_child[parent] = 1;
+        legacy_nodes.push_back(new LegacyNode(legacy_nodes[parent], (float)(i % 9)));
+        nodes.push_back(new VersionedNode(nodes[parent], (float)(i % 9)));
+    }
+    std::vector<size_t> leaves;
+    for(size_t i = 0; i < count; i++){if(!has_child[i]){leaves.push_back(i);}}
+    std::vector<size_t> order(leaves.size());
+    for(size_t i = 0; i < order.size(); i++){order[i] = leaves[random(leaves.size())];}
+
+    std::printf("%zu nodes under the root, %zu leaves, reading K random leaves after each move\n", count - 1, leaves.size());
+    bench::Header("NotifyChildren", "versions");
+    float x = 0.0f;
+    for(size_t k = 1; k <= order.size(); k *= 8){
+        char name[64];
+        std::snprintf(name, sizeof(name), "move root, read %zu leaves", k);
+        bench::Report(name, bench::Measure(20, [&]{
+            legacy_nodes[0]->Move(x += 1.0f);
+            for(size_t i = 0; i < k; i++){bench::Keep(legacy_nodes[order[i]]->GetGlobalMatrix());}
+        }), bench::Measure(20, [&]{
+            nodes[0]->Move(x += 1.0f);
+            for(size_t i = 0; i < k; i++){bench::Keep(nodes[order[i]]->GetGlobalMatrix());}
+        }));
+    }
+    bench::Report("move root, read every node", bench::Measure(20, [&]{
+        legacy_nodes[0]->Move(x += 1.0f);
+        for(LegacyNode* n : legacy_nodes){bench::Keep(n->GetGlobalMatrix());}
+    }), bench::Measure(20, [&]{
+        nodes[0]->Move(x += 1.0f);
+        for(VersionedNode* n : nodes){bench::Keep(n->GetGlobalMatrix());}
+    }));
+    delete legacy_nodes[0];
+    delete nodes[0];
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include<cstdio>
+#include<fstream>
+#include<sstream>
+#include<string>
+#include<vector>
+
+#include "substd/io.hpp"
+#include "substd/mapped_file.hpp"
+#include "bench.hpp"
+
+// The byte at a time stream functions io.hpp had before ByteReader/ByteWriter,
+// kept here as the baseline the current implementation is measured against.
+namespace legacy {
+
+uint8_t GetNextU8(std::istream& istr, std::ostream& err = std::cerr) {
+    if(istr.eof()){err<<"substd IO Error: Expected Atleast One More Byte But EOF Reached."<<std::endl; return 0;}
+    else{
+        return istr.get();
+    }
+}
+uint16_t GetNextBEU16(std::istream& istr, std::ostream& err = std::cerr){
+    uint16_t u = ((uint16_t)GetNextU8(istr, err)) << 8;
+    u |= (uint16_t)GetNextU8(istr, err);
+    return u;
+}
+uint32_t GetNextBEU32(std::istream& istr, std::ostream& err = std::cerr){
+    uint32_t u = ((uint32_t)GetNextBEU16(istr, err)) << 16;
+    u |= (uint32_t)GetNextBEU16(istr, err);
+    return u;
+}
+
+void PutU8(std::ostream& ostr, const uint8_t& i) {
+    ostr.write((char*)(&i), 1);
+}
+void PutBEU16(std::ostream& ostr, const uint16_t& i) {
+    PutU8(ostr, ((i&0xFF00)>>8));
+    PutU8(ostr, (i&0x00FF));
+}
+void PutBEU32(std::ostream& ostr, const uint32_t& i) {
+    PutBEU16(ostr, ((i&0xFFFF0000)>>16));
+    PutBEU16(ostr, (i&0x0000FFFF));
+}
+
+}
+
+constexpr size_t count = 1 << 22;
+
+int main(int argc, const char** argv){
+    std::vector<uint32_t> words(count), out(count);
+    for(size_t i = 0; i < count; i++){words[i] = (uint32_t)(i * 2654435761u);}
+    std::string encoded;
+    {
+        std::ostringstream ostr;
+        ss::ByteWriter w(ostr);
+        w.WriteBEU32Array(words.data(), count);
+        w.Flush();
+        encoded = ostr.str();
+    }
+
+    std::printf("%zu big endian uint32s (%zu MiB) per call\n", count, (count * 4) >> 20);
+    bench::Header("legacy", "substd");
+
+    const double legacy_read = bench::Measure(5, [&]{
+        std::istringstream istr(encoded);
+        for(size_t i = 0; i < count; i++){out[i] = legacy::GetNextBEU32(istr);}
+        bench::Keep(out);
+    });
+    bench::Report("GetNextBEU32 (istream)", legacy_read, bench::Measure(5, [&]{
+        std::istringstream istr(encoded);
+        for(size_t i = 0; i < count; i++){out[i] = ss::GetNextBEU32(istr);}
+        bench::Keep(out);
+    }));
+    bench::Report("TryGetNextBEU32 (istream)", legacy_read, bench::Measure(5, [&]{
+        std::istringstream istr(encoded);
+        for(size_t i = 0; i < count; i++){out[i] = ss::TryGetNextBEU32(istr).value_or(0);}
+        bench::Keep(out);
+    }));
+    bench::Report("ByteReader::ReadBEU32 (streambuf)", legacy_read, bench::Measure(5, [&]{
+        std::istringstream istr(encoded);
+        ss::ByteReader r(istr);
+        for(size_t i = 0; i < count; i++){out[i] = r.ReadBEU32();}
+        bench::Keep(out);
+    }));
+    bench::Report("ByteReader::ReadBEU32 (buffer)", legacy_read, bench::Measure(5, [&]{
+        ss::ByteReader r(encoded.data(), encoded.size());
+        for(size_t i = 0; i < count; i++){out[i] = r.ReadBEU32();}
+        bench::Keep(out);
+    }));
+    bench::Report("ByteReader::ReadBEU32Array (buffer)", legacy_read, bench::Measure(5, [&]{
+        ss::ByteReader r(encoded.data(), encoded.size());
+        r.ReadBEU32Array(out.data(), count);
+        bench::Keep(out);
+    }));
+
+    const double legacy_write = bench::Measure(5, [&]{
+        std::ostringstream ostr;
+        for(size_t i = 0; i < count; i++){legacy::PutBEU32(ostr, words[i]);}
+        bench::Keep(ostr);
+    });
+    bench::Report("PutBEU32 (ostream)", legacy_write, bench::Measure(5, [&]{
+        std::ostringstream ostr;
+        for(size_t i = 0; i < count; i++){ss::PutBEU32(ostr, words[i]);}
+        bench::Keep(ostr);
+    }));
+    bench::Report("ByteWriter::WriteBEU32 (streambuf)", legacy_write, bench::Measure(5, [&]{
+        std::ostringstream ostr;
+        ss::ByteWriter w(ostr);
+        for(size_t i = 0; i < count; i++){w.WriteBEU32(words[i]);}
+        w.Flush();
+        bench::Keep(ostr);
+    }));
+    bench::Report("ByteWriter::WriteBEU32Array (vector)", legacy_write, bench::Measure(5, [&]{
+        std::vector<uint8_t> bytes;
+        ss::ByteWriter w(bytes);
+        w.WriteBEU32Array(words.data(), count);
+        w.Flush();
+        bench::Keep(bytes);
+    }));
+
+    const char* path = "io_bench.bin";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(encoded.data(), (std::streamsize)encoded.size());
+    }
+    std::printf("\nthe same %zu MiB from a file\n", (count * 4) >> 20);
+    bench::Header("legacy", "substd");
+    const double legacy_file = bench::Measure(5, [&]{
+        std::ifstream file(path, std::ios::binary);
+        for(size_t i = 0; i < count; i++){out[i] = legacy::GetNextBEU32(file);}
+        bench::Keep(out);
+    });
+    bench::Report("ByteReader::ReadBEU32 (ifstream)", legacy_file, bench::Measure(5, [&]{
+        std::ifstream file(path, std::ios::binary);
+        ss::ByteReader r(file);
+        for(size_t i = 0; i < count; i++){out[i] = r.ReadBEU32();}
+        bench::Keep(out);
+    }));
+    bench::Report("MappedFile::GetNextBEU32", legacy_file, bench::Measure(5, [&]{
+        ss::MappedFile file(path, ss::MappedFile::Access::Sequential);
+        for(size_t i = 0; i < count; i++){out[i] = file.GetNextBEU32();}
+        bench::Keep(out);
+    }));
+    bench::Report("MappedFile BEArrayView::CopyTo", legacy_file, bench::Measure(5, [&]{
+        ss::MappedFile file(path, ss::MappedFile::Access::Sequential);
+        file.GetNextBEArray<uint32_t>(count).CopyTo(out.data());
+        bench::Keep(out);
+    }));
+    std::remove(path);
+    return 0;
+}
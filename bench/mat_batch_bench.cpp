@@ -0,0 +1,59 @@
+#include<vector>
+
+#include "substd/mat_batch.hpp"
+#include "bench.hpp"
+
+// ss::mat::VecProd before it read the columns in place: the whole matrix was copied
+// into a vec of columns for every vector, kept here as the baseline.
+namespace legacy {
+
+template<typename T, size_t n>
+ss::vec<T,n> VecProd(const ss::mat<T,n>& m, const ss::vec<T,n>& v){
+    ss::vec<ss::vec<T,n>,n> columns(((std::array<ss::vec<T,n>,n>)m));
+    ss::vec<T,n> sum(0);
+    for(size_t i = 0; i < n; i++){
+        sum += columns.at(i) * v.at(i);
+    }
+    return sum;
+}
+
+}
+
+constexpr size_t count = 1 << 20;
+constexpr size_t iterations = 10;
+
+int main(int argc, const char** argv){
+    ss::mat<float,4> m(1);
+    m[0][0] = 0.8f; m[1][0] = -0.6f; m[0][1] = 0.6f; m[1][1] = 0.8f;
+    m[3] = ss::vec4f{1.0f, 2.0f, 3.0f, 1.0f};
+
+    std::vector<ss::vec3f> points(count), out(count);
+    for(size_t i = 0; i < count; i++){
+        points[i] = ss::vec3f{(float)i, (float)(i % 17), (float)(i % 5)};
+    }
+    ss::vec3f_soa soa(points), soa_out(count);
+
+    std::printf("%zu vec3f points transformed by one mat<float,4> per call\n", count);
+    bench::Header("baseline", "candidate");
+    const double legacy = bench::Measure(iterations, [&]{
+        for(size_t i = 0; i < count; i++){out[i] = legacy::VecProd(m, points[i].Homogenized());}
+        bench::Keep(out);
+    });
+    bench::Report("legacy VecProd vs VecProd", legacy, bench::Measure(iterations, [&]{
+        for(size_t i = 0; i < count; i++){out[i] = m * points[i].Homogenized();}
+        bench::Keep(out);
+    }));
+    bench::Report("legacy VecProd vs TransformPoints", legacy, bench::Measure(iterations, [&]{
+        ss::TransformPoints(m, points.data(), out.data(), count);
+        bench::Keep(out);
+    }));
+    bench::Report("legacy VecProd vs TransformPoints (MT)", legacy, bench::Measure(iterations, [&]{
+        ss::TransformPoints(m, points.data(), out.data(), count, 0);
+        bench::Keep(out);
+    }));
+    bench::Report("legacy VecProd vs TransformPoints (SoA)", legacy, bench::Measure(iterations, [&]{
+        ss::TransformPoints(m, soa, soa_out);
+        bench::Keep(soa_out);
+    }));
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include<vector>
+
+#include "substd/mat.hpp"
+#include "substd/quat.hpp"
+#include "bench.hpp"
+
+// The row copy + Dot product ss::mat::MatProd used before the dedicated product engine,
+// kept here as the baseline the current implementation is measured against.
+namespace legacy {
+
+template<typename T, size_t n>
+ss::mat<T,n> MatProd(const ss::mat<T,n>& a, const ss::mat<T,n>& b){
+    ss::mat<T,n> ret;
+    for(size_t col = 0; col < n; col++){
+        for(size_t row = 0; row < n; row++){
+            ret[col][row] = a.GetRow(row).Dot(b[col]);
+        }
+    }
+    return ret;
+}
+
+// The three full 3x3 products CreateRotationMatrix<T,3> used before the Givens builder.
+template<typename T>
+ss::mat<T,3> CreateRotationMatrix(const ss::vec<T,3>& rot){
+    ss::mat<T,3> ret(1);
+    T cos, sin;
+    cos = std::cos(rot[2]); sin = std::sin(rot[2]);
+    ret[0][0] = cos; ret[0][1] = sin; ret[1][0] = -sin; ret[1][1] = cos;
+    cos = std::cos(rot[1]); sin = std::sin(rot[1]);
+    ss::mat<T,3> yrot(1);
+    yrot[0][0] = cos; yrot[0][2] = -sin; yrot[2][0] = sin; yrot[2][2] = cos;
+    ret = yrot*ret;
+    cos = std::cos(rot[0]); sin = std::sin(rot[0]);
+    ss::mat<T,3> xrot(1);
+    xrot[1][1] = cos; xrot[1][2] = sin; xrot[2][1] = -sin; xrot[2][2] = cos;
+    ret = xrot*ret;
+    return ret;
+}
+
+}
+
+constexpr size_t count = 1024;
+
+template<typename T, size_t n>
+void RunProduct(const char* name, const size_t& iterations){
+    std::vector<ss::mat<T,n>> a(count), b(count), out(count);
+    for(size_t i = 0; i < count; i++){
+        for(size_t col = 0; col < n; col++){
+            for(size_t row = 0; row < n; row++){
+                a[i][col][row] = (T)(i + row) * (T)0.01;
+                b[i][col][row] = (T)(col + 1) * (T)0.5;
+            }
+        }
+    }
+    bench::Report(name,
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){out[i] = legacy::MatProd(a[i], b[i]);} bench::Keep(out);}),
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){out[i] = a[i] * b[i];} bench::Keep(out);})
+    );
+}
+
+template<typename T>
+void RunInverse(const char* name, const size_t& iterations){
+    std::vector<ss::mat<T,4>> m(count), out(count);
+    for(size_t i = 0; i < count; i++){
+        m[i] = ss::mat<T,4>(1);
+        m[i][0][0] = (T)0.8; m[i][1][0] = (T)-0.6;
+        m[i][0][1] = (T)0.6; m[i][1][1] = (T)0.8;
+        m[i][3] = ss::vec<T,4>{(T)i, (T)2, (T)3, (T)1};
+    }
+    bench::Report(name,
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){out[i] = m[i].Inverse();} bench::Keep(out);}),
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){out[i] = m[i].AffineInverse();} bench::Keep(out);})
+    );
+}
+
+template<typename T>
+void RunRotation(const size_t& iterations){
+    std::vector<ss::vec<T,3>> rot(count);
+    std::vector<ss::vec<T,3>> sin(count), cos(count);
+    std::vector<ss::quat<T>> q(count);
+    std::vector<ss::mat<T,3>> out(count);
+    for(size_t i = 0; i < count; i++){
+        rot[i] = ss::vec<T,3>{(T)i * (T)0.001, (T)0.5, (T)-0.25};
+        for(size_t k = 0; k < 3; k++){ss::SinCos<T>(rot[i][k], sin[i][k], cos[i][k]);}
+        q[i] = ss::quat<T>::FromRotation(rot[i]);
+    }
+    const double legacy_ns = bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){out[i] = legacy::CreateRotationMatrix(rot[i]);} bench::Keep(out);});
+    bench::Report("angles", legacy_ns,
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){out[i] = ss::CreateRotationMatrix<T,3>(rot[i]);} bench::Keep(out);})
+    );
+    bench::Report("cached sin/cos", legacy_ns,
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){out[i] = ss::CreateRotationMatrix<T,3>(sin[i], cos[i]);} bench::Keep(out);})
+    );
+    bench::Report("quat ToMatrix", legacy_ns,
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){out[i] = q[i].ToMatrix();} bench::Keep(out);})
+    );
+}
+
+int main(int argc, const char** argv){
+    std::printf("%zu matrix products per call\n", count);
+    bench::Header("GetRow/Dot", "MatProd");
+    RunProduct<float,3>("mat3f * mat3f", 1000);
+    RunProduct<float,4>("mat4f * mat4f", 1000);
+    RunProduct<double,4>("mat4d * mat4d", 1000);
+    RunProduct<double,16>("mat16d * mat16d", 20);
+
+    std::printf("\n%zu inverses per call\n", count);
+    bench::Header("Inverse", "AffineInverse");
+    RunInverse<float>("mat4f inverse", 1000);
+    RunInverse<double>("mat4d inverse", 1000);
+
+    std::printf("\n%zu 3D rotation matrices per call\n", count);
+    bench::Header("3 products", "Givens/quat");
+    RunRotation<float>(1000);
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include<cmath>
+#include<vector>
+
+#include "substd/math.hpp"
+#include "bench.hpp"
+
+constexpr size_t count = 1 << 16;
+
+const char* TierName(const ss::Accuracy& a){
+    switch(a){
+        case ss::Accuracy::Low: return "Low";
+        case ss::Accuracy::Medium: return "Medium";
+        default: return "Full";
+    }
+}
+
+void Row(const char* function, const char* type, const ss::Accuracy& a, const double& error, const double& libm_ns, const double& ns){
+    std::printf("%-8s %-7s %-7s %12.3e %12.3f %12.3f %8.2fx\n", function, type, TierName(a), error,
+        libm_ns / (double)count, ns / (double)count, libm_ns / ns);
+}
+
+template<typename T, ss::Accuracy a>
+void RunTrig(const char* type, const size_t& iterations){
+    std::vector<T> theta(count), sin(count), cos(count);
+    for(size_t i = 0; i < count; i++){
+        theta[i] = (T)(-10.0 + 20.0 * (double)i / (double)count);
+    }
+    const double libm_sin = bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){sin[i] = std::sin(theta[i]);} bench::Keep(sin);});
+    const double libm_sincos = bench::Measure(iterations, [&]{
+        for(size_t i = 0; i < count; i++){sin[i] = std::sin(theta[i]); cos[i] = std::cos(theta[i]);}
+        bench::Keep(sin); bench::Keep(cos);
+    });
+
+    const double sin_ns = bench::Measure(iterations, [&]{ss::Sin<T, a>(theta.data(), sin.data(), count); bench::Keep(sin);});
+    const double sincos_ns = bench::Measure(iterations, [&]{ss::SinCos<T, a>(theta.data(), sin.data(), cos.data(), count); bench::Keep(sin); bench::Keep(cos);});
+    double error = 0;
+    for(size_t i = 0; i < count; i++){
+        error = std::max(error, std::abs((double)sin[i] - std::sin((double)theta[i])));
+        error = std::max(error, std::abs((double)cos[i] - std::cos((double)theta[i])));
+    }
+    Row("Sin", type, a, error, libm_sin, sin_ns);
+    Row("SinCos", type, a, error, libm_sincos, sincos_ns);
+}
+
+template<typename T, ss::Accuracy a>
+void RunSqrt(const char* type, const size_t& iterations){
+    std::vector<T> x(count), out(count);
+    for(size_t i = 0; i < count; i++){
+        x[i] = (T)std::pow(10.0, -10.0 + 20.0 * (double)i / (double)count);
+    }
+    const double libm_sqrt = bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){out[i] = std::sqrt(x[i]);} bench::Keep(out);});
+    const double libm_rsqrt = bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){out[i] = (T)1 / std::sqrt(x[i]);} bench::Keep(out);});
+
+    const double sqrt_ns = bench::Measure(iterations, [&]{ss::Sqrt<T, a>(x.data(), out.data(), count); bench::Keep(out);});
+    double sqrt_error = 0;
+    for(size_t i = 0; i < count; i++){sqrt_error = std::max(sqrt_error, std::abs((double)out[i] / std::sqrt((double)x[i]) - 1.0));}
+    const double rsqrt_ns = bench::Measure(iterations, [&]{ss::RSqrt<T, a>(x.data(), out.data(), count); bench::Keep(out);});
+    double rsqrt_error = 0;
+    for(size_t i = 0; i < count; i++){rsqrt_error = std::max(rsqrt_error, std::abs((double)out[i] * std::sqrt((double)x[i]) - 1.0));}
+    Row("Sqrt", type, a, sqrt_error, libm_sqrt, sqrt_ns);
+    Row("RSqrt", type, a, rsqrt_error, libm_rsqrt, rsqrt_ns);
+}
+
+template<typename T>
+void Run(const char* type, const size_t& iterations){
+    RunTrig<T, ss::Accuracy::Low>(type, iterations);
+    RunTrig<T, ss::Accuracy::Medium>(type, iterations);
+    RunTrig<T, ss::Accuracy::Full>(type, iterations);
+    RunSqrt<T, ss::Accuracy::Low>(type, iterations);
+    RunSqrt<T, ss::Accuracy::Medium>(type, iterations);
+    RunSqrt<T, ss::Accuracy::Full>(type, iterations);
+}
+
+int main(int argc, const char** argv){
+    std::printf("%zu elements per call, error is absolute for Sin/Cos and relative for Sqrt/RSqrt\n", count);
+    std::printf("%-8s %-7s %-7s %12s %12s %12s %9s\n", "function", "type", "tier", "max error", "libm ns/el", "ss ns/el", "speedup");
+    Run<float>("float", 200);
+    Run<double>("double", 200);
+    return 0;
+}
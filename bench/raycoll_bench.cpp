@@ -0,0 +1,128 @@
+#include<random>
+#include<vector>
+
+#include "substd/raycoll.hpp"
+#include "substd/broadphase.hpp"
+#include "bench.hpp"
+
+class Mover : public ss::AABBRayMoveChecker<float>, public ss::Orientation<float, float, 2> {
+public:
+    Mover(const int& res = 3) : ss::AABBRayMoveChecker<float>(res, res) {}
+
+    //How AllowedMove worked before check points were batched, each one transformed and trimmed on its own
+    float LegacyAllowedMove(const size_t& dir, const float& move, const ss::IRayCollidable<float, 2>& collidable, const ss::vec2f& offset) const {
+        if(move == 0){return move;}
+        const ss::mat<float, 3> global = this->GetGlobalMatrix();
+        float curr_move = move;
+        for(size_t k = 0; k < checkPoints[dir].size(); k++){
+            const ss::vec<float, 3> point = global * checkPoints[dir].Get(k).Homogenized();
+            curr_move = collidable.TrimMove(ss::vec2f{point[0] + offset[0], point[1] + offset[1]}, dir, curr_move);
+            if(curr_move == 0){return curr_move;}
+        }
+        return curr_move;
+    }
+    ss::vec2f LegacyAllowedMove(const ss::vec2f& move, const ss::IRayCollidable<float, 2>& collidable) const {
+        ss::vec2f curr_move{0.0f, 0.0f};
+        for(size_t dir = 0; dir < 2; dir++){curr_move[dir] = LegacyAllowedMove(dir, move[dir], collidable, curr_move);}
+        return curr_move;
+    }
+};
+
+class SweptMover : public ss::SweptAABBMoveChecker<float, 2>, public ss::Orientation<float, float, 2> {};
+
+//Every mover asks how far it may move this frame, without moving, so each run asks the same questions
+template<typename M, typename G>
+double CheckMoves(const std::vector<M>& movers, const std::vector<ss::vec2f>& moves, const G& group, const size_t& iterations){
+    return bench::Measure(iterations, [&]{
+        ss::vec2f sum{0.0f, 0.0f};
+        for(size_t i = 0; i < movers.size(); i++){sum += movers[i].AllowedMove(moves[i], group);}
+        bench::Keep(sum);
+    });
+}
+
+int main(int argc, const char** argv){
+    //10k colliders scattered over a 1000x1000 world, 1k movers each moving up to 10 along both axes
+    constexpr size_t colliders = 10000;
+    constexpr size_t mover_count = 1000;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> place(0.0f, 1000.0f), size(1.0f, 10.0f), step(-10.0f, 10.0f);
+    std::vector<ss::AABBRayCollidable<float>> boxes;
+    boxes.reserve(colliders);
+    for(size_t i = 0; i < colliders; i++){boxes.emplace_back(ss::vec2f{place(rng), place(rng)}, ss::vec2f{size(rng), size(rng)});}
+    std::vector<Mover> movers(mover_count);
+    std::vector<ss::vec2f> moves(mover_count);
+    for(size_t i = 0; i < mover_count; i++){
+        movers[i].SetPosition(ss::vec2f{place(rng), place(rng)});
+        moves[i] = ss::vec2f{step(rng), step(rng)};
+    }
+
+    ss::RayCollisionGroup<float, 2> linear;
+    ss::BVHCollisionGroup<float, 2> bvh, mixed;
+    ss::GridCollisionGroup<float, 2> grid;
+    ss::SpatialHashCollisionGroup<float, 2> spatial(10.0f);
+    for(size_t i = 0; i < colliders; i++){
+        linear.AddCollidable(&boxes[i]);
+        bvh.AddCollidable(&boxes[i]);
+        mixed.AddCollidable(&boxes[i], i % 10 == 0);
+        grid.AddCollidable(&boxes[i]);
+        spatial.AddCollidable(&boxes[i]);
+    }
+    bvh.Update();
+    mixed.Update();
+    grid.Update();
+
+    std::printf("%zu colliders, %zu movers\n", colliders, mover_count);
+    bench::Header("linear", "broad phase");
+    const double baseline = CheckMoves(movers, moves, linear, 3);
+    bench::Report("check moves, BVH", baseline, CheckMoves(movers, moves, bvh, 50));
+    bench::Report("check moves, BVH 10% dynamic", baseline, CheckMoves(movers, moves, mixed, 50));
+    bench::Report("check moves, grid", baseline, CheckMoves(movers, moves, grid, 50));
+    bench::Report("check moves, spatial hash", baseline, CheckMoves(movers, moves, spatial, 50));
+
+    //What keeping up with moving colliders costs each frame
+    bench::Header("BVH rebuild", "BVH refit");
+    bench::Report("update 10% dynamic", bench::Measure(50, [&]{mixed.Rebuild();}), bench::Measure(50, [&]{mixed.Update();}));
+    bench::Header("BVH rebuild", "grid rebuild");
+    bench::Report("build 10k", bench::Measure(20, [&]{bvh.Rebuild();}), bench::Measure(20, [&]{grid.Update();}));
+    bench::Header("BVH rebuild", "spatial hash update");
+    bench::Report("update 10k", bench::Measure(20, [&]{bvh.Rebuild();}), bench::Measure(20, [&]{spatial.Update();}));
+
+    //Every actor resolving its move each tick, check points one at a time or as packets
+    constexpr size_t actors = 5000;
+    std::vector<Mover> crowd, dense_crowd;
+    std::vector<ss::vec2f> crowd_moves(actors);
+    for(size_t i = 0; i < actors; i++){
+        crowd.emplace_back(3);
+        dense_crowd.emplace_back(16);
+        const ss::vec2f at{place(rng), place(rng)};
+        crowd.back().SetPosition(at);
+        dense_crowd.back().SetPosition(at);
+        crowd_moves[i] = ss::vec2f{step(rng), step(rng)};
+    }
+    auto per_point = [&](const std::vector<Mover>& movers, const ss::IRayCollidable<float, 2>& group, const size_t& iterations){
+        return bench::Measure(iterations, [&]{
+            ss::vec2f sum{0.0f, 0.0f};
+            for(size_t i = 0; i < movers.size(); i++){sum += movers[i].LegacyAllowedMove(crowd_moves[i], group);}
+            bench::Keep(sum);
+        });
+    };
+    std::printf("%zu actors\n", actors);
+    bench::Header("per point", "packet");
+    bench::Report("3 points a side, BVH", per_point(crowd, bvh, 20), CheckMoves(crowd, crowd_moves, bvh, 20));
+    bench::Report("3 points a side, grid", per_point(crowd, grid, 20), CheckMoves(crowd, crowd_moves, grid, 20));
+    bench::Report("16 points a side, BVH", per_point(dense_crowd, bvh, 20), CheckMoves(dense_crowd, crowd_moves, bvh, 20));
+    bench::Report("16 points a side, grid", per_point(dense_crowd, grid, 20), CheckMoves(dense_crowd, crowd_moves, grid, 20));
+    ss::RayCollisionGroup<float, 2> few;
+    for(size_t i = 0; i < 16; i++){few.AddCollidable(&boxes[i]);}
+    bench::Report("16 points a side, 16 colliders", per_point(dense_crowd, few, 20), CheckMoves(dense_crowd, crowd_moves, few, 20));
+
+    //The same actors as swept boxes, exact whatever the sampling resolution was
+    std::vector<SweptMover> swept_crowd(actors);
+    for(size_t i = 0; i < actors; i++){swept_crowd[i].SetPosition(crowd[i].GetPosition());}
+    bench::Header("sampled packet", "swept box");
+    bench::Report("3 points a side, BVH", CheckMoves(crowd, crowd_moves, bvh, 20), CheckMoves(swept_crowd, crowd_moves, bvh, 20));
+    bench::Report("16 points a side, BVH", CheckMoves(dense_crowd, crowd_moves, bvh, 20), CheckMoves(swept_crowd, crowd_moves, bvh, 20));
+    bench::Report("16 points a side, grid", CheckMoves(dense_crowd, crowd_moves, grid, 20), CheckMoves(swept_crowd, crowd_moves, grid, 20));
+    bench::Report("16 points a side, 16 colliders", CheckMoves(dense_crowd, crowd_moves, few, 20), CheckMoves(swept_crowd, crowd_moves, few, 20));
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include<algorithm>
+#include<list>
+#include<mutex>
+#include<random>
+#include<thread>
+#include<vector>
+
+#include "substd/interfaces.hpp"
+#include "bench.hpp"
+
+//The registry storage IRegistered defaulted to before DenseRegistry, std::list::remove scanning on every destruction
+class Listed : public ss::IRegistered<Listed, std::list<Listed*>> {public: float value = 1.0f;};
+class Dense : public ss::IRegistered<Dense> {public: float value = 1.0f;};
+class Sharded : public ss::IRegistered<Sharded, ss::ShardedRegistry<Sharded>> {public: float value = 1.0f;};
+
+//Serializing every construction behind one mutex, what concurrent construction took before ConcurrentRegistry
+template<typename T>
+class LockedRegistry {
+protected:
+    std::mutex mutex;
+    ss::DenseRegistry<T> registry;
+public:
+    using handle_type = ss::RegistryHandle;
+    handle_type Insert(T* t){
+        std::lock_guard<std::mutex> lock(mutex);
+        return registry.Insert(t);
+    }
+    bool Erase(const handle_type& h){
+        std::lock_guard<std::mutex> lock(mutex);
+        return registry.Erase(h);
+    }
+};
+class Locked : public ss::IRegistered<Locked, LockedRegistry<Locked>> {public: float value = 1.0f;};
+class Concurrent : public ss::IRegistered<Concurrent, ss::ConcurrentRegistry<Concurrent>> {public: float value = 1.0f;};
+
+//Creates count objects then destroys them in a random order, as tearing down a level does
+template<typename O>
+double CreateDestroy(const size_t& count, const size_t& iterations){
+    std::vector<size_t> order(count);
+    for(size_t i = 0; i < count; i++){order[i] = i;}
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+    std::vector<O*> objects(count);
+    return bench::Measure(iterations, [&]{
+        for(size_t i = 0; i < count; i++){objects[i] = new O();}
+        for(size_t i = 0; i < count; i++){delete objects[order[i]];}
+        bench::Keep(objects);
+    });
+}
+
+//As CreateDestroy, split across threads threads each creating and destroying its share
+template<typename O>
+double CreateDestroyThreaded(const size_t& count, const size_t& threads, const size_t& iterations){
+    return bench::Measure(iterations, [&]{
+        std::vector<std::thread> workers;
+        for(size_t t = 0; t < threads; t++){
+            workers.emplace_back([&, t]{
+                const size_t share = count / threads;
+                std::vector<size_t> order(share);
+                for(size_t i = 0; i < share; i++){order[i] = i;}
+                std::shuffle(order.begin(), order.end(), std::mt19937(42 + t));
+                std::vector<O*> objects(share);
+                for(size_t i = 0; i < share; i++){objects[i] = new O();}
+                for(size_t i = 0; i < share; i++){delete objects[order[i]];}
+            });
+        }
+        for(auto& worker : workers){worker.join();}
+    });
+}
+
+int main(int argc, const char** argv){
+    bench::Header("std::list", "DenseRegistry");
+    for(size_t count : {1024, 4096, 16384}){
+        char name[64];
+        std::snprintf(name, sizeof(name), "create, destroy %zu", count);
+        bench::Report(name, CreateDestroy<Listed>(count, 3), CreateDestroy<Dense>(count, 3));
+    }
+
+    constexpr size_t million = 1 << 20;
+    std::vector<Listed*> listed(million);
+    std::vector<Dense*> dense(million);
+    for(size_t i = 0; i < million; i++){
+        listed[i] = new Listed();
+        dense[i] = new Dense();
+    }
+    bench::Report("iterate 1M", bench::Measure(20, [&]{
+        float sum = 0.0f;
+        for(Listed* l : Listed::registry){sum += l->value;}
+        bench::Keep(sum);
+    }), bench::Measure(20, [&]{
+        float sum = 0.0f;
+        Dense::registry.ForEach([&](Dense* d){sum += d->value;});
+        bench::Keep(sum);
+    }));
+    //Emptied first, so the list is not searched a million times on the way out
+    Listed::registry.clear();
+    for(size_t i = 0; i < million; i++){
+        delete listed[i];
+        delete dense[i];
+    }
+
+    std::printf("1M objects, %zu hardware threads\n", ss::HardwareThreads());
+    bench::Header("DenseRegistry", "ShardedRegistry");
+    bench::Report("create, destroy 1M", CreateDestroy<Dense>(million, 5), CreateDestroy<Sharded>(million, 5));
+
+    bench::Header("global mutex", "ConcurrentRegistry");
+    for(size_t threads : {1, 4, 16}){
+        char name[64];
+        std::snprintf(name, sizeof(name), "create, destroy 1M on %zu threads", threads);
+        bench::Report(name, CreateDestroyThreaded<Locked>(million, threads, 5), CreateDestroyThreaded<Concurrent>(million, threads, 5));
+    }
+
+    for(size_t i = 0; i < million; i++){dense[i] = new Dense();}
+    ss::ThreadPool pool;
+    bench::Header("ForEach", "ForEachParallel");
+    bench::Report("scale 1M values", bench::Measure(20, [&]{
+        Dense::registry.ForEach([](Dense* d){d->value *= 1.0001f;});
+    }), bench::Measure(20, [&]{
+        Dense::registry.ForEachParallel(pool, [](Dense* d){d->value *= 1.0001f;});
+    }));
+    for(size_t i = 0; i < million; i++){delete dense[i];}
+    return 0;
+}
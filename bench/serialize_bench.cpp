@@ -0,0 +1,100 @@
+#include<cstdio>
+#include<sstream>
+#include<string>
+#include<vector>
+
+#include "substd/serialize.hpp"
+#include "bench.hpp"
+
+// Saving through operator<< and loading by parsing that text back, the only way to persist a vec before serialize.hpp,
+// kept here as the baseline the binary formats are measured against.
+namespace legacy {
+
+void Save(std::ostream& o, const std::vector<ss::vec3f>& points){
+    for(const ss::vec3f& p : points){o<<p<<"\n";}
+}
+
+void Load(std::istream& i, std::vector<ss::vec3f>& points){
+    char c;
+    for(ss::vec3f& p : points){i>>c>>p[0]>>c>>p[1]>>c>>p[2]>>c;}
+}
+
+}
+
+constexpr size_t count = 1 << 20;
+
+int main(int argc, const char** argv){
+    std::vector<ss::vec3f> points(count), loaded(count);
+    for(size_t i = 0; i < count; i++){
+        const float f = (float)i;
+        points[i] = ss::vec3f{f * 0.37f, -f / 7.0f, f * 1.0e-3f};
+    }
+
+    std::string text;
+    {
+        std::ostringstream o;
+        legacy::Save(o, points);
+        text = o.str();
+    }
+    std::vector<uint8_t> binary;
+    {
+        ss::ByteWriter w(binary);
+        ss::WriteArray(w, points);
+    }
+    std::printf("%zu vec3fs, %zu bytes as text, %zu bytes as binary\n", count, text.size(), binary.size());
+    bench::Header("text", "binary");
+
+    const double text_save = bench::Measure(3, [&]{
+        std::ostringstream o;
+        legacy::Save(o, points);
+        bench::Keep(o);
+    });
+    bench::Report("Write per vec (ostream)", text_save, bench::Measure(3, [&]{
+        std::ostringstream o;
+        ss::ByteWriter w(o);
+        for(const ss::vec3f& p : points){ss::Write(w, p);}
+        w.Flush();
+        bench::Keep(o);
+    }));
+    bench::Report("WriteArray (ostream)", text_save, bench::Measure(3, [&]{
+        std::ostringstream o;
+        ss::ByteWriter w(o);
+        ss::WriteArray(w, points);
+        w.Flush();
+        bench::Keep(o);
+    }));
+    bench::Report("WriteArray (vector)", text_save, bench::Measure(3, [&]{
+        std::vector<uint8_t> bytes;
+        ss::ByteWriter w(bytes);
+        ss::WriteArray(w, points);
+        w.Flush();
+        bench::Keep(bytes);
+    }));
+
+    const double text_load = bench::Measure(3, [&]{
+        std::istringstream i(text);
+        legacy::Load(i, loaded);
+        bench::Keep(loaded);
+    });
+    const std::string binary_string(binary.begin(), binary.end());
+    bench::Report("Read per vec (istream)", text_load, bench::Measure(3, [&]{
+        std::istringstream i(binary_string);
+        ss::ByteReader r(i);
+        ss::ArrayHeader h;
+        ss::Read(r, h);
+        for(ss::vec3f& p : loaded){ss::Read(r, p);}
+        bench::Keep(loaded);
+    }));
+    bench::Report("ReadArray (istream)", text_load, bench::Measure(3, [&]{
+        std::istringstream i(binary_string);
+        ss::ByteReader r(i);
+        ss::ReadArray(r, loaded);
+        bench::Keep(loaded);
+    }));
+    bench::Report("ReadArray (buffer)", text_load, bench::Measure(3, [&]{
+        ss::ByteReader r(binary.data(), binary.size());
+        ss::ReadArray(r, loaded);
+        bench::Keep(loaded);
+    }));
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include<random>
+#include<vector>
+
+#include "substd/spatial_hash.hpp"
+#include "bench.hpp"
+
+//One tick of count entities wandering a 1000x1000 world, each then looking for neighbours within radius
+int main(int argc, const char** argv){
+    constexpr size_t count = 5000;
+    constexpr float radius = 10.0f;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> place(0.0f, 1000.0f), step(-1.0f, 1.0f);
+    std::vector<ss::vec2f> positions(count), velocities(count);
+    for(size_t i = 0; i < count; i++){
+        positions[i] = ss::vec2f{place(rng), place(rng)};
+        velocities[i] = ss::vec2f{step(rng), step(rng)};
+    }
+
+    ss::SpatialHash<float, 2, uint32_t> hash(radius);
+    std::vector<ss::RegistryHandle> handles(count);
+    for(size_t i = 0; i < count; i++){handles[i] = hash.Insert(positions[i], (uint32_t)i);}
+
+    std::printf("%zu entities, radius %g\n", count, radius);
+    bench::Header("brute force", "SpatialHash");
+    bench::Report("move, query neighbours", bench::Measure(5, [&]{
+        size_t neighbours = 0;
+        for(size_t i = 0; i < count; i++){positions[i] += velocities[i];}
+        for(size_t i = 0; i < count; i++){
+            for(size_t j = 0; j < count; j++){
+                const float dx = positions[j][0] - positions[i][0], dy = positions[j][1] - positions[i][1];
+                neighbours += ((dx * dx) + (dy * dy) <= radius * radius);
+            }
+        }
+        bench::Keep(neighbours);
+    }), bench::Measure(100, [&]{
+        size_t neighbours = 0;
+        for(size_t i = 0; i < count; i++){
+            positions[i] += velocities[i];
+            hash.Move(handles[i], positions[i]);
+        }
+        for(size_t i = 0; i < count; i++){
+            hash.QueryRadius(positions[i], radius, [&](const uint32_t&, const ss::vec2f&){neighbours++;});
+        }
+        bench::Keep(neighbours);
+    }));
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include<random>
+#include<vector>
+
+#include "substd/static_collision.hpp"
+#include "bench.hpp"
+
+class Mover : public ss::AABBRayMoveChecker<float>, public ss::Orientation<float, float, 2> {
+public:
+    Mover() : ss::AABBRayMoveChecker<float>(3, 3) {}
+};
+class SweptMover : public ss::SweptAABBMoveChecker<float, 2>, public ss::Orientation<float, float, 2> {};
+
+//Every mover asks how far it may move this frame, without moving, so each run asks the same questions
+template<typename M>
+double CheckMoves(const std::vector<M>& movers, const std::vector<ss::vec2f>& moves, const ss::IRayCollidable<float, 2>& group, const size_t& iterations){
+    return bench::Measure(iterations, [&]{
+        ss::vec2f sum{0.0f, 0.0f};
+        for(size_t i = 0; i < movers.size(); i++){sum += movers[i].AllowedMove(moves[i], group);}
+        bench::Keep(sum);
+    });
+}
+
+int main(int argc, const char** argv){
+    //A level of homogeneous box walls over a 1000x1000 world, with no broad phase either way
+    constexpr size_t walls = 2000;
+    constexpr size_t actors = 1000;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> place(0.0f, 1000.0f), size(1.0f, 10.0f), step(-10.0f, 10.0f);
+    std::vector<ss::AABBRayCollidable<float>> boxes;
+    boxes.reserve(walls);
+    ss::RayCollisionGroup<float, 2> virtual_group;
+    ss::StaticCollisionGroup<ss::BoxShape<float, 2>> static_group;
+    for(size_t i = 0; i < walls; i++){
+        boxes.emplace_back(ss::vec2f{place(rng), place(rng)}, ss::vec2f{size(rng), size(rng)});
+        virtual_group.AddCollidable(&boxes.back());
+        static_group.Add(ss::BoxShape<float, 2>(boxes.back().GetBounds()));
+    }
+    std::vector<Mover> movers(actors);
+    std::vector<SweptMover> swept_movers(actors);
+    std::vector<ss::vec2f> moves(actors), origins(actors);
+    for(size_t i = 0; i < actors; i++){
+        origins[i] = ss::vec2f{place(rng), place(rng)};
+        movers[i].SetPosition(origins[i]);
+        swept_movers[i].SetPosition(origins[i]);
+        moves[i] = ss::vec2f{step(rng), step(rng)};
+    }
+
+    std::printf("%zu walls, %zu actors\n", walls, actors);
+    bench::Header("RayCollisionGroup", "StaticCollisionGroup");
+    auto rays = [&](const ss::IRayCollidable<float, 2>& group){
+        return bench::Measure(10, [&]{
+            float sum = 0.0f;
+            for(size_t i = 0; i < actors; i++){sum += group.TrimMove(origins[i], i % 2, moves[i][i % 2]);}
+            bench::Keep(sum);
+        });
+    };
+    bench::Report("single rays", rays(virtual_group), rays(static_group));
+    bench::Report("check points as packets", CheckMoves(movers, moves, virtual_group, 5), CheckMoves(movers, moves, static_group, 5));
+    bench::Report("swept boxes", CheckMoves(swept_movers, moves, virtual_group, 5), CheckMoves(swept_movers, moves, static_group, 5));
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include<vector>
+
+#include "substd/transform_batch.hpp"
+#include "bench.hpp"
+
+class Node : public ss::ITransformable<float,3> {
+public:
+    ss::mat<float,4> local;
+    Node(Node* parent, const float& x) : ss::ITransformable<float,3>(parent), local(1) {
+        local[3] = ss::vec4f{x, 0.5f, -x, 1.0f};
+    }
+    ss::mat<float,4> GetLocalMatrix() const override {return local;}
+};
+
+constexpr size_t count = 1 << 20;
+constexpr size_t iterations = 5;
+
+int main(int argc, const char** argv){
+    //Each node under a uniformly random earlier one, around 14 levels deep
+    std::vector<Node*> nodes;
+    nodes.reserve(count);
+    nodes.push_back(new Node(nullptr, 0.0f));
+    uint32_t state = 11;
+    auto random = [&](const size_t& n){
+        state = (state * 1103515245u) + 12345u;
+        return (size_t)(state >> 8) % n;
+    };
+    for(size_t i = 1; i < count; i++){nodes.push_back(new Node(nodes[random(i)], (float)(i % 9)));}
+    ss::TransformLevels<float,3> levels(nodes[0]);
+    levels.Update();
+    std::vector<ss::mat<float,4>> globals(count);
+
+    std::vector<Node*> changed;
+    for(size_t i = 0; i < count / 100; i++){changed.push_back(nodes[random(count)]);}
+
+    std::printf("%zu nodes in %zu levels, %zu hardware threads\n", count, levels.Levels(), ss::HardwareThreads());
+    //Flagging only bumps a version, all of the time below is spent bringing matrices up to date
+    std::printf("FlagLocalChange on the root: %.3f ns\n", bench::Measure(iterations, [&]{nodes[0]->FlagLocalChange();}));
+    levels.Update();
+    bench::Header("lazy reads", "levels");
+    //The baseline reads every node's global into an array, the lazy recalculation recursing up to the first fresh ancestor
+    auto read_all = [&]{
+        for(size_t i = 0; i < count; i++){globals[i] = nodes[i]->GetGlobalMatrix();}
+        bench::Keep(globals);
+    };
+    bench::Report("root moved, all recalculated", bench::Measure(iterations, [&]{
+        nodes[0]->FlagLocalChange();
+        read_all();
+    }), bench::Measure(iterations, [&]{
+        nodes[0]->FlagLocalChange();
+        bench::Keep(levels.Update());
+    }));
+    bench::Report("1% of nodes moved", bench::Measure(iterations, [&]{
+        for(Node* n : changed){n->FlagLocalChange();}
+        read_all();
+    }), bench::Measure(iterations, [&]{
+        for(Node* n : changed){n->FlagLocalChange();}
+        bench::Keep(levels.Update());
+    }));
+    ss::ThreadPool pool;
+    bench::Report("root moved, ThreadPool", bench::Measure(iterations, [&]{
+        nodes[0]->FlagLocalChange();
+        read_all();
+    }), bench::Measure(iterations, [&]{
+        nodes[0]->FlagLocalChange();
+        bench::Keep(levels.Update(pool));
+    }));
+    delete nodes[0];
+    return 0;
+}
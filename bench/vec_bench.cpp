@@ -0,0 +1,98 @@
+#include<functional>
+#include<vector>
+
+#include "substd/vec.hpp"
+#include "bench.hpp"
+
+// The std::function based element-wise kernels ss::vec used before they were made inlinable,
+// kept here as the baseline the current implementation is measured against.
+namespace legacy {
+
+template<typename T, size_t dim>
+ss::vec<T,dim> GenerateBinary(const ss::vec<T,dim>& a, const ss::vec<T,dim>& b, const std::function<T(const T&, const T&)>& f){
+    ss::vec<T,dim> ret;
+    std::transform(a.begin(), a.end(), b.begin(), ret.begin(), f);
+    return ret;
+}
+template<typename T, size_t dim>
+ss::vec<T,dim> GenerateUnary(const ss::vec<T,dim>& a, const std::function<T(const T&)>& f){
+    ss::vec<T,dim> ret;
+    std::transform(a.begin(), a.end(), ret.begin(), f);
+    return ret;
+}
+template<typename T, size_t dim>
+void ReflexiveBinary(ss::vec<T,dim>& a, const ss::vec<T,dim>& b, const std::function<void(T&, const T&)>& f){
+    for(size_t i = 0; i < dim; i++){
+        f(a.at(i), b.at(i));
+    }
+}
+template<typename T, size_t dim>
+ss::vec<T,dim> Sum(const ss::vec<T,dim>& a, const ss::vec<T,dim>& b){
+    return GenerateBinary<T,dim>(a, b, [](const T& x, const T& y)->T{return x+y;});
+}
+template<typename T, size_t dim>
+ss::vec<T,dim> Prod(const ss::vec<T,dim>& a, const T& s){
+    return GenerateUnary<T,dim>(a, [s](const T& x)->T{return x*s;});
+}
+template<typename T, size_t dim>
+void Add(ss::vec<T,dim>& a, const ss::vec<T,dim>& b){
+    ReflexiveBinary<T,dim>(a, b, [](T& x, const T& y)->void{x += y;});
+}
+template<typename T, size_t dim>
+T Dot(const ss::vec<T,dim>& a, const ss::vec<T,dim>& b){
+    T sum = 0;
+    for(size_t i = 0; i < dim; i++){
+        sum += a.at(i) * b.at(i);
+    }
+    return sum;
+}
+
+}
+
+constexpr size_t count = 4096;
+constexpr size_t iterations = 2000;
+
+template<typename T, size_t dim>
+void Run(const char* name){
+    std::vector<ss::vec<T,dim>> a(count), b(count), out(count);
+    for(size_t i = 0; i < count; i++){
+        for(size_t j = 0; j < dim; j++){
+            a[i][j] = (T)(i + j);
+            b[i][j] = (T)(j + 1);
+        }
+    }
+    char label[64];
+
+    std::snprintf(label, sizeof(label), "%s Sum", name);
+    bench::Report(label,
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){out[i] = legacy::Sum(a[i], b[i]);} bench::Keep(out);}),
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){out[i] = a[i] + b[i];} bench::Keep(out);})
+    );
+    std::snprintf(label, sizeof(label), "%s Prod", name);
+    bench::Report(label,
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){out[i] = legacy::Prod(a[i], (T)3);} bench::Keep(out);}),
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){out[i] = a[i] * (T)3;} bench::Keep(out);})
+    );
+    std::snprintf(label, sizeof(label), "%s Add", name);
+    bench::Report(label,
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){legacy::Add(out[i], b[i]);} bench::Keep(out);}),
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){out[i] += b[i];} bench::Keep(out);})
+    );
+    std::snprintf(label, sizeof(label), "%s Dot", name);
+    T sink = 0;
+    bench::Report(label,
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){sink += legacy::Dot(a[i], b[i]);} bench::Keep(sink);}),
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){sink += a[i].Dot(b[i]);} bench::Keep(sink);})
+    );
+}
+
+int main(int argc, const char** argv){
+    std::printf("%zu element-wise operations per call\n", count);
+    bench::Header("std::function", "ss::vec");
+    Run<float,3>("vec3f");
+    Run<float,4>("vec4f");
+    Run<double,2>("vec2d");
+    Run<double,4>("vec4d");
+    Run<int,4>("vec4i");
+    return 0;
+}
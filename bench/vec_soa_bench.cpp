@@ -0,0 +1,41 @@
+#include<vector>
+
+#include "substd/vec_soa.hpp"
+#include "bench.hpp"
+
+constexpr size_t count = 1 << 18;
+constexpr size_t iterations = 50;
+
+int main(int argc, const char** argv){
+    std::vector<ss::vec3f> aos(count), aos_other(count), aos_out(count);
+    for(size_t i = 0; i < count; i++){
+        aos[i] = ss::vec3f{(float)i, (float)(i % 7) + 1.0f, 0.5f};
+        aos_other[i] = ss::vec3f{1.0f, 2.0f, (float)(i % 3)};
+    }
+    ss::vec3f_soa soa(aos), soa_other(aos_other), soa_out(count);
+    std::vector<float> scalars(count);
+
+    std::printf("%zu vec3f per call\n", count);
+    bench::Header("AoS", "SoA");
+    bench::Report("Add",
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){aos_out[i] += aos_other[i];} bench::Keep(aos_out);}),
+        bench::Measure(iterations, [&]{soa_out += soa_other; bench::Keep(soa_out);})
+    );
+    bench::Report("Scale",
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){aos_out[i] *= 1.0001f;} bench::Keep(aos_out);}),
+        bench::Measure(iterations, [&]{soa_out *= 1.0001f; bench::Keep(soa_out);})
+    );
+    bench::Report("Dot",
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){scalars[i] = aos[i].Dot(aos_other[i]);} bench::Keep(scalars);}),
+        bench::Measure(iterations, [&]{soa.Dot(soa_other, scalars.data()); bench::Keep(scalars);})
+    );
+    bench::Report("Magnitude",
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){scalars[i] = aos[i].Magnitude<float>();} bench::Keep(scalars);}),
+        bench::Measure(iterations, [&]{soa.Magnitude(scalars.data()); bench::Keep(scalars);})
+    );
+    bench::Report("Normalized",
+        bench::Measure(iterations, [&]{for(size_t i = 0; i < count; i++){aos_out[i] = aos[i].Normalized<float>();} bench::Keep(aos_out);}),
+        bench::Measure(iterations, [&]{soa_out = soa; soa_out.Normalize(); bench::Keep(soa_out);})
+    );
+    return 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Axis aligned bounding boxes in any number of dimensions.
+ * @include limits vec math
+*/
+
+#ifndef SUBSTD_AABB_HPP
+#define SUBSTD_AABB_HPP
+
+#include<limits>
+
+#include<substd/vec.hpp>
+#include<substd/math.hpp>
+
+namespace ss
+{
+
+/**
+ * @class aabb
+ * @brief The closed box [min, max] on every axis.
+ *
+ * @tparam T type of the coordinates
+ * @tparam dim number of dimensions
+ */
+template<typename T, size_t dim>
+struct aabb {
+    vec<T,dim> min;
+    vec<T,dim> max;
+
+    /**
+     * @brief Default Constructor, leaves the corners uninitialized
+    */
+    aabb(){}
+    aabb(const vec<T,dim>& min, const vec<T,dim>& max) : min(min), max(max) {}
+
+    ///@fn Empty @return aabb A box containing nothing, which Expand() grows into the first thing added
+    static aabb Empty(){
+        return aabb(vec<T,dim>(std::numeric_limits<T>::max()), vec<T,dim>(std::numeric_limits<T>::lowest()));
+    }
+    ///@fn FromCenter @return aabb The box of size size centred on center
+    static aabb FromCenter(const vec<T,dim>& center, const vec<T,dim>& size){
+        aabb ret;
+        for(size_t i = 0; i < dim; i++){
+            const T half = size[i] / (T)2;
+            ret.min[i] = center[i] - half;
+            ret.max[i] = center[i] + half;
+        }
+        return ret;
+    }
+    ///@fn Segment @return aabb The bounds of the segment from origin moving move along axis dir
+    static aabb Segment(const vec<T,dim>& origin, const size_t& dir, const T& move){
+        return aabb(origin, origin).Swept(dir, move);
+    }
+    ///@fn Swept @return aabb The bounds of everything the box passes through moving move along axis dir
+    aabb Swept(const size_t& dir, const T& move) const {
+        aabb ret = *this;
+        if(move < 0){ret.min[dir] += move;}
+        else {ret.max[dir] += move;}
+        return ret;
+    }
+
+    ///@fn Overlaps @return bool Whether the two closed boxes share any point, touching faces included
+    bool Overlaps(const aabb& other) const {
+        for(size_t i = 0; i < dim; i++){
+            if(other.max[i] < min[i] || max[i] < other.min[i]){return false;}
+        }
+        return true;
+    }
+    ///@fn Contains @return bool Whether p is inside or on the box
+    bool Contains(const vec<T,dim>& p) const {
+        for(size_t i = 0; i < dim; i++){
+            if(p[i] < min[i] || max[i] < p[i]){return false;}
+        }
+        return true;
+    }
+
+    ///@fn Expand Grows the box to contain p
+    void Expand(const vec<T,dim>& p){
+        for(size_t i = 0; i < dim; i++){
+            min[i] = Min(min[i], p[i]);
+            max[i] = Max(max[i], p[i]);
+        }
+    }
+    ///@fn Expand Grows the box to contain other
+    void Expand(const aabb& other){
+        for(size_t i = 0; i < dim; i++){
+            min[i] = Min(min[i], other.min[i]);
+            max[i] = Max(max[i], other.max[i]);
+        }
+    }
+    ///@fn Union @return aabb The smallest box containing both
+    aabb Union(const aabb& other) const {
+        aabb ret = *this;
+        ret.Expand(other);
+        return ret;
+    }
+
+    ///@fn Center
+    vec<T,dim> Center() const {
+        vec<T,dim> ret;
+        for(size_t i = 0; i < dim; i++){ret[i] = (min[i] + max[i]) / (T)2;}
+        return ret;
+    }
+    ///@fn Size
+    vec<T,dim> Size() const {
+        vec<T,dim> ret;
+        for(size_t i = 0; i < dim; i++){ret[i] = max[i] - min[i];}
+        return ret;
+    }
+    ///@fn LongestAxis @return size_t The axis the box is widest along
+    size_t LongestAxis() const {
+        size_t ret = 0;
+        for(size_t i = 1; i < dim; i++){
+            if(max[i] - min[i] > max[ret] - min[ret]){ret = i;}
+        }
+        return ret;
+    }
+
+    bool operator==(const aabb& other) const {return min == other.min && max == other.max;}
+    bool operator!=(const aabb& other) const {return !(*this == other);}
+};
+
+using aabb2f = aabb<float, 2>;
+using aabb3f = aabb<float, 3>;
+using aabb2d = aabb<double, 2>;
+using aabb3d = aabb<double, 3>;
+
+}
+
+#endif // SUBSTD_AABB_HPP
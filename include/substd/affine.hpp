@@ -0,0 +1,246 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Affine transforms stored without the constant bottom row of their homogeneous matrices
+ * @include vec mat simd
+*/
+
+#ifndef SUBSTD_AFFINE_HPP
+#define SUBSTD_AFFINE_HPP
+
+#include<substd/vec.hpp>
+#include<substd/mat.hpp>
+#include<substd/simd.hpp>
+
+namespace ss
+{
+
+/**
+ * @class affine
+ * @brief A dim x (dim+1) column major matrix: the linear part in the first dim columns and the translation in the last.
+ *
+ * Stands for the homogeneous mat<T,dim+1> with (0, ..., 0, 1) as its bottom row, which is never stored or
+ * multiplied. For affine<float,3> that is 12 floats instead of 16, and composing two is 36 multiply-adds
+ * instead of 64.
+ *
+ * @tparam T type of the matrix scalar
+ * @tparam dim number of dimensions transformed
+ */
+template<typename T, size_t dim>
+class affine : public mat<T, dim, dim+1> {
+protected:
+    using A = affine<T, dim>;
+    using base = mat<T, dim, dim+1>;
+
+public:
+    /**
+     * @brief Default Constructor
+    */
+    affine(){}
+    /**
+     * @brief Identity Constructor
+     *
+     * @param t Value to set the diagonal of the linear part to, the translation is zero
+    */
+    affine(const T& t){
+        for(size_t col = 0; col < dim; col++){(*this)[col] = vec<T,dim>::Unit(col, t);}
+        (*this)[dim] = vec<T,dim>(0);
+    }
+    /**
+     * @brief Linear part and translation Constructor
+    */
+    affine(const mat<T,dim>& linear, const vec<T,dim>& translation){
+        for(size_t col = 0; col < dim; col++){(*this)[col] = linear[col];}
+        (*this)[dim] = translation;
+    }
+    /**
+     * @brief Homogeneous matrix Constructor, m's bottom row is assumed to be (0, ..., 0, 1) and dropped
+    */
+    explicit affine(const mat<T,dim+1>& m){
+        for(size_t col = 0; col <= dim; col++){
+            for(size_t row = 0; row < dim; row++){(*this)[col][row] = m[col][row];}
+        }
+    }
+    affine(const base& m) : base(m) {}
+
+    ///@fn Linear @return mat<T,dim> A copy of the linear part
+    mat<T,dim> Linear() const {
+        mat<T,dim> ret;
+        for(size_t col = 0; col < dim; col++){ret[col] = (*this)[col];}
+        return ret;
+    }
+    ///@fn SetLinear
+    void SetLinear(const mat<T,dim>& linear){
+        for(size_t col = 0; col < dim; col++){(*this)[col] = linear[col];}
+    }
+    ///@fn Translation
+    vec<T,dim>& Translation() {return (*this)[dim];}
+    const vec<T,dim>& Translation() const {return (*this)[dim];}
+
+    ///@fn ToMatrix @return mat<T,dim+1> The homogeneous matrix this stands for
+    mat<T,dim+1> ToMatrix() const {
+        mat<T,dim+1> ret;
+        for(size_t col = 0; col <= dim; col++){
+            for(size_t row = 0; row < dim; row++){ret[col][row] = (*this)[col][row];}
+            ret[col][dim] = (col == dim) ? (T)1 : (T)0;
+        }
+        return ret;
+    }
+
+    /**
+     * @fn Compose
+     * @return affine The transform applying other first and then this, (this * other) as homogeneous matrices.
+     * @remark The linear part of this times all of other as one dim x dim x (dim+1) product, then this translation added.
+     */
+    A Compose(const A& other) const {
+        A ret;
+        if constexpr(simd::affine_kernel<T, dim>::enabled) {
+            simd::affine_kernel<T, dim>::Compose(this->front().data(), other.front().data(), ret.front().data());
+        }
+        else {
+            MatrixProduct<T, T, dim, dim, dim+1>(this->front().data(), other.front().data(), ret.front().data());
+            for(size_t row = 0; row < dim; row++){ret[dim][row] += (*this)[dim][row];}
+        }
+        return ret;
+    }
+
+    ///@fn TransformPoint @return vec<T,dim> The point p transformed, translation included
+    vec<T,dim> TransformPoint(const vec<T,dim>& p) const {
+        vec<T,dim> ret;
+        if constexpr(simd::affine_kernel<T, dim>::enabled) {
+            simd::affine_kernel<T, dim>::TransformPoint(this->front().data(), p.data(), ret.data());
+            return ret;
+        }
+        ret = (*this)[dim];
+        for(size_t col = 0; col < dim; col++){
+            const T scale = p[col];
+            for(size_t row = 0; row < dim; row++){ret[row] += (*this)[col][row] * scale;}
+        }
+        return ret;
+    }
+    ///@fn TransformDirection @return vec<T,dim> The direction d transformed by the linear part only
+    vec<T,dim> TransformDirection(const vec<T,dim>& d) const {
+        vec<T,dim> ret(0);
+        for(size_t col = 0; col < dim; col++){
+            const T scale = d[col];
+            for(size_t row = 0; row < dim; row++){ret[row] += (*this)[col][row] * scale;}
+        }
+        return ret;
+    }
+
+    /**
+     * @fn Inverse
+     * @brief The inverse of any invertible affine transform, the linear part inverted with mat<T,dim>::Inverse().
+     * @remark A singular linear part produces non-finite elements.
+     */
+    A Inverse() const {
+        if constexpr(simd::affine_kernel<T, dim>::enabled) {
+            A ret;
+            simd::affine_kernel<T, dim>::Inverse(this->front().data(), ret.front().data());
+            return ret;
+        }
+        const mat<T,dim> linear = Linear().Inverse();
+        vec<T,dim> translation(0);
+        for(size_t col = 0; col < dim; col++){
+            const T t = (*this)[dim][col];
+            for(size_t row = 0; row < dim; row++){translation[row] -= linear[col][row] * t;}
+        }
+        return A(linear, translation);
+    }
+    /**
+     * @fn OrthogonalInverse
+     * @brief The inverse when the linear part has mutually orthogonal rows, a rotation optionally followed by a
+     * per-axis scale, as mat::AffineInverse() requires; the linear part is inverted by transposing it.
+     */
+    A OrthogonalInverse() const {
+        A ret;
+        if constexpr(simd::affine_kernel<T, dim>::enabled) {
+            simd::affine_kernel<T, dim>::OrthogonalInverse(this->front().data(), ret.front().data());
+            return ret;
+        }
+        T inv_sqr[dim] = {};
+        for(size_t col = 0; col < dim; col++){
+            for(size_t row = 0; row < dim; row++){inv_sqr[row] += (*this)[col][row] * (*this)[col][row];}
+        }
+        for(size_t row = 0; row < dim; row++){inv_sqr[row] = (T)1 / inv_sqr[row];}
+        for(size_t col = 0; col < dim; col++){
+            for(size_t row = 0; row < dim; row++){ret[col][row] = (*this)[row][col] * inv_sqr[col];}
+        }
+        ret[dim] = vec<T,dim>(0);
+        for(size_t col = 0; col < dim; col++){
+            const T t = (*this)[dim][col];
+            for(size_t row = 0; row < dim; row++){ret[dim][row] -= ret[col][row] * t;}
+        }
+        return ret;
+    }
+
+    //Operators, hiding mat's, which would treat this as a plain dim x (dim+1) matrix
+
+    ///@brief Composition, see Compose
+    A operator*(const A& other) const {return Compose(other);}
+    void operator*=(const A& other) {*this = Compose(other);}
+    ///@brief Transforms p as a point, see TransformPoint
+    vec<T,dim> operator*(const vec<T,dim>& p) const {return TransformPoint(p);}
+
+    bool operator==(const A& other) const {return static_cast<const base&>(*this) == static_cast<const base&>(other);}
+    bool operator!=(const A& other) const {return !(*this == other);}
+};
+
+/**
+ * @fn CreateTRS
+ * @brief Builds translation * scale * rotation from precomputed sines and cosines of every plane angle (see RotationPlane).
+ *
+ * The linear part starts as the scale rather than the identity, and each plane rotation is applied to the two
+ * columns it mixes as in CreateRotationMatrix, so the scale lands on the rows of the rotation without a product;
+ * position is written straight into the translation column. No intermediate matrix is built.
+ */
+template<typename T, size_t dim>
+affine<T,dim> CreateTRS(const vec<T,dim>& position, const vec<T,dim>& scale, const vec<T,(dim*(dim-1))/2>& sin, const vec<T,(dim*(dim-1))/2>& cos){
+    affine<T,dim> ret;
+    for(size_t col = 0; col < dim; col++){ret[col] = vec<T,dim>::Unit(col, scale[col]);}
+    for(size_t k = 0; k < (dim*(dim-1))/2; k++){
+        if(sin[k] == (T)0 && cos[k] == (T)1){continue;}
+        const std::pair<size_t, size_t> plane = RotationPlane<dim>(k);
+        const T s = ((plane.first + plane.second) % 2 == 1) ? sin[k] : -sin[k];
+        const T c = cos[k];
+        vec<T, dim>& col_i = ret[plane.first];
+        vec<T, dim>& col_j = ret[plane.second];
+        for(size_t row = 0; row < dim; row++){
+            const T a = col_i[row];
+            const T b = col_j[row];
+            col_i[row] = (c * a) + (s * b);
+            col_j[row] = (c * b) - (s * a);
+        }
+    }
+    ret[dim] = position;
+    return ret;
+}
+
+/**
+ * @fn CreateTRS
+ * @brief Builds translation * scale * rotation from one angle (in radians) per rotational plane, as Orientation does.
+ */
+template<typename T, size_t dim>
+affine<T,dim> CreateTRS(const vec<T,dim>& position, const vec<T,dim>& scale, const vec<T,(dim*(dim-1))/2>& rot){
+    constexpr size_t NRP = (dim*(dim-1))/2;
+    vec<T, NRP> sin, cos;
+    for(size_t k = 0; k < NRP; k++){
+        if(rot[k] == (T)0){
+            sin[k] = 0;
+            cos[k] = 1;
+        }
+        else{
+            SinCos<T>(rot[k], sin[k], cos[k]);
+        }
+    }
+    return CreateTRS<T, dim>(position, scale, sin, cos);
+}
+
+using affine2f = affine<float, 2>;
+using affine3f = affine<float, 3>;
+using affine2d = affine<double, 2>;
+using affine3d = affine<double, 3>;
+
+}
+
+#endif // SUBSTD_AFFINE_HPP
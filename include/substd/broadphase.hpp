@@ -0,0 +1,577 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Collision groups that only ask the collidables near a ray to trim it: a bounding volume hierarchy, a uniform
+ * grid and a spatial hash.
+ * @include algorithm cstdint vector aabb raycoll spatial_hash
+*/
+
+#ifndef SUBSTD_BROADPHASE_HPP
+#define SUBSTD_BROADPHASE_HPP
+
+#include<algorithm>
+#include<cstdint>
+#include<vector>
+
+#include<substd/aabb.hpp>
+#include<substd/raycoll.hpp>
+#include<substd/spatial_hash.hpp>
+
+namespace ss
+{
+
+#ifndef SS_BVH_LEAF_SIZE
+///@brief The most collidables a BVHCollisionGroup leaf holds.
+#define SS_BVH_LEAF_SIZE 4
+#endif
+
+#ifndef SS_GRID_MAX_CELLS_PER_COLLIDABLE
+///@brief GridCollisionGroup grows its automatic cell size until it has no more cells than this per collidable.
+#define SS_GRID_MAX_CELLS_PER_COLLIDABLE 4
+#endif
+
+/**
+ * @class BVHCollisionGroup
+ * @brief A RayCollisionGroup of IBoundedRayCollidables kept in bounding volume hierarchies, so a ray only visits
+ * the collidables whose bounds it touches.
+ *
+ * Static and dynamic collidables are kept in separate trees. Both are rebuilt on the next query after
+ * collidables are added or removed. Dynamic collidables may move, but only after Update() refits the bounds
+ * of their tree is it safe to query again; static ones must not move at all. Queries are safe from many
+ * threads at once as long as nothing is added, removed or updated meanwhile and Update() ran since the last change.
+ */
+template<typename T, size_t dim>
+class BVHCollisionGroup : public IRayCollidable<T,dim> {
+public:
+    using collidable_type = IBoundedRayCollidable<T,dim>;
+
+protected:
+    struct Node {
+        aabb<T,dim> bounds;
+        ///@brief A leaf's first collidable, or an inner node's right child (its left child directly follows it)
+        uint32_t first;
+        ///@brief A leaf's collidable count, 0 for an inner node
+        uint32_t count;
+    };
+
+    //Nodes in pre-order, so each subtree is contiguous and every child comes after its parent
+    struct Tree {
+        std::vector<collidable_type*> collidables;
+        std::vector<aabb<T,dim>> bounds;
+        std::vector<Node> nodes;
+        bool dirty = false;
+
+        uint32_t Build(const uint32_t& begin, const uint32_t& end, std::vector<vec<T,dim>>& centers){
+            const uint32_t index = (uint32_t)nodes.size();
+            nodes.emplace_back();
+            aabb<T,dim> node_bounds = aabb<T,dim>::Empty();
+            aabb<T,dim> center_bounds = aabb<T,dim>::Empty();
+            for(uint32_t i = begin; i < end; i++){
+                node_bounds.Expand(bounds[i]);
+                center_bounds.Expand(centers[i]);
+            }
+            nodes[index].bounds = node_bounds;
+            if(end - begin <= SS_BVH_LEAF_SIZE){
+                nodes[index].first = begin;
+                nodes[index].count = end - begin;
+                return index;
+            }
+            //Split at the median centre along the axis the centres spread furthest along
+            const size_t axis = center_bounds.LongestAxis();
+            const uint32_t middle = begin + ((end - begin) / 2);
+            std::vector<uint32_t> order(end - begin);
+            for(uint32_t i = 0; i < order.size(); i++){order[i] = begin + i;}
+            std::nth_element(order.begin(), order.begin() + (middle - begin), order.end(), [&](const uint32_t& a, const uint32_t& b){
+                return centers[a][axis] < centers[b][axis];
+            });
+            Permute(order, begin, centers);
+            Build(begin, middle, centers);
+            nodes[index].first = Build(middle, end, centers);
+            nodes[index].count = 0;
+            return index;
+        }
+        //Puts entry order[i] at begin + i, for each of the parallel arrays
+        void Permute(const std::vector<uint32_t>& order, const uint32_t& begin, std::vector<vec<T,dim>>& centers){
+            std::vector<collidable_type*> c(order.size());
+            std::vector<aabb<T,dim>> b(order.size());
+            std::vector<vec<T,dim>> p(order.size());
+            for(size_t i = 0; i < order.size(); i++){
+                c[i] = collidables[order[i]];
+                b[i] = bounds[order[i]];
+                p[i] = centers[order[i]];
+            }
+            std::copy(c.begin(), c.end(), collidables.begin() + begin);
+            std::copy(b.begin(), b.end(), bounds.begin() + begin);
+            std::copy(p.begin(), p.end(), centers.begin() + begin);
+        }
+
+        void Rebuild(){
+            nodes.clear();
+            bounds.resize(collidables.size());
+            std::vector<vec<T,dim>> centers(collidables.size());
+            for(size_t i = 0; i < collidables.size(); i++){
+                bounds[i] = collidables[i]->GetBounds();
+                centers[i] = bounds[i].Center();
+            }
+            if(!collidables.empty()){Build(0, (uint32_t)collidables.size(), centers);}
+            dirty = false;
+        }
+        //Recalculates every bound keeping the tree's shape, children first since they follow their parents
+        void Refit(){
+            for(size_t i = 0; i < collidables.size(); i++){bounds[i] = collidables[i]->GetBounds();}
+            for(size_t n = nodes.size(); n-- > 0;){
+                Node& node = nodes[n];
+                if(node.count > 0){
+                    node.bounds = bounds[node.first];
+                    for(uint32_t i = 1; i < node.count; i++){node.bounds.Expand(bounds[node.first + i]);}
+                }
+                else {
+                    node.bounds = nodes[n + 1].bounds.Union(nodes[node.first].bounds);
+                }
+            }
+        }
+
+        /**
+         * Visits the collidables whose bounds touch start swept by the move so far, asking trim(collidable, move)
+         * for the move each allows
+         */
+        template<typename F>
+        T Trim(const aabb<T,dim>& start, const size_t& dir, T move, F trim) const {
+            if(nodes.empty()){return move;}
+            aabb<T,dim> ray = start.Swept(dir, move);
+            //Deep enough for any tree of 2^64 nodes, as every split is at the median
+            uint32_t stack[64];
+            size_t top = 0;
+            stack[top++] = 0;
+            while(top > 0){
+                const Node& node = nodes[stack[--top]];
+                if(!node.bounds.Overlaps(ray)){continue;}
+                if(node.count > 0){
+                    for(uint32_t i = node.first; i < node.first + node.count; i++){
+                        if(!bounds[i].Overlaps(ray)){continue;}
+                        const T trimmed = trim(collidables[i], move);
+                        if(trimmed != move){
+                            move = trimmed;
+                            if(move == 0){return move;}
+                            ray = start.Swept(dir, move);
+                        }
+                    }
+                    continue;
+                }
+                //The child nearer the origin along the move goes on top, so it trims the ray before the other is tested
+                const uint32_t left = (uint32_t)(&node - nodes.data()) + 1;
+                const uint32_t right = node.first;
+                const bool left_first = (move > 0) ? (nodes[left].bounds.min[dir] <= nodes[right].bounds.min[dir])
+                                                   : (nodes[left].bounds.max[dir] >= nodes[right].bounds.max[dir]);
+                stack[top++] = left_first ? right : left;
+                stack[top++] = left_first ? left : right;
+            }
+            return move;
+        }
+
+        bool Remove(collidable_type* coll){
+            auto iter = std::find(collidables.begin(), collidables.end(), coll);
+            if(iter == collidables.end()){return false;}
+            collidables.erase(iter);
+            dirty = true;
+            return true;
+        }
+    };
+
+    mutable Tree static_tree;
+    mutable Tree dynamic_tree;
+
+    void RebuildDirty() const {
+        if(static_tree.dirty){static_tree.Rebuild();}
+        if(dynamic_tree.dirty){dynamic_tree.Rebuild();}
+    }
+
+public:
+    /**
+     * @fn AddCollidable
+     * @param dynamic Whether coll will move, in which case call Update() after it does
+     */
+    void AddCollidable(collidable_type* coll, const bool& dynamic = false){
+        Tree& tree = dynamic ? dynamic_tree : static_tree;
+        tree.collidables.push_back(coll);
+        tree.dirty = true;
+    }
+    ///@fn RemoveCollidable
+    void RemoveCollidable(collidable_type* coll){
+        if(!static_tree.Remove(coll)){dynamic_tree.Remove(coll);}
+    }
+    ///@fn Size @return size_t The number of collidables, static and dynamic
+    size_t Size() const {return static_tree.collidables.size() + dynamic_tree.collidables.size();}
+
+    /**
+     * @fn Update
+     * @brief Rebuilds the trees if collidables were added or removed, and refits the dynamic tree to where its collidables are now.
+     */
+    void Update(){
+        const bool refit = !dynamic_tree.dirty;
+        RebuildDirty();
+        if(refit){dynamic_tree.Refit();}
+    }
+    ///@fn Rebuild Rebuilds both trees, for when dynamic collidables have moved far enough for a refit tree to fit them loosely
+    void Rebuild(){
+        static_tree.Rebuild();
+        dynamic_tree.Rebuild();
+    }
+
+    T TrimMove(const vec<T,dim>& origin, const size_t& dir, const T& move) const override {
+        RebuildDirty();
+        const aabb<T,dim> start(origin, origin);
+        auto trim = [&](const collidable_type* coll, const T& m){return coll->TrimMove(origin, dir, m);};
+        const T curr_move = static_tree.Trim(start, dir, move, trim);
+        if(curr_move == 0){return curr_move;}
+        return dynamic_tree.Trim(start, dir, curr_move, trim);
+    }
+    ///@fn TrimMoves Walks each tree once for the whole packet, by the bounds of every ray in it
+    T TrimMoves(const std::array<const T*,dim>& origins, const size_t& count, const size_t& dir, const T& move) const override {
+        RebuildDirty();
+        if(count == 0){return move;}
+        const aabb<T,dim> start = detail::LaneBounds<T,dim>(origins, count);
+        auto trim = [&](const collidable_type* coll, const T& m){return coll->TrimMoves(origins, count, dir, m);};
+        const T curr_move = static_tree.Trim(start, dir, move, trim);
+        if(curr_move == 0){return curr_move;}
+        return dynamic_tree.Trim(start, dir, curr_move, trim);
+    }
+    T TrimBoxMove(const aabb<T,dim>& box, const size_t& dir, const T& move) const override {
+        RebuildDirty();
+        auto trim = [&](const collidable_type* coll, const T& m){return coll->TrimBoxMove(box, dir, m);};
+        const T curr_move = static_tree.Trim(box, dir, move, trim);
+        if(curr_move == 0){return curr_move;}
+        return dynamic_tree.Trim(box, dir, curr_move, trim);
+    }
+};
+
+/**
+ * @class GridCollisionGroup
+ * @brief A RayCollisionGroup of IBoundedRayCollidables sorted into a uniform grid over their combined bounds,
+ * a ray visiting only the cells along it.
+ *
+ * Cheaper to build than BVHCollisionGroup and best when the collidables are of similar size. Each is listed
+ * in every cell its bounds touch, so a ray crossing several of those cells may ask it more than once; that
+ * gives the same answer. Rays outside the grid are clamped to the cells on its border.
+ *
+ * The grid is rebuilt on the next query after collidables are added or removed, or by Update() after they move.
+ */
+template<typename T, size_t dim>
+class GridCollisionGroup : public IRayCollidable<T,dim> {
+public:
+    using collidable_type = IBoundedRayCollidable<T,dim>;
+
+protected:
+    std::vector<collidable_type*> collidables;
+    T requested_cell_size;
+
+    mutable bool dirty = false;
+    mutable T cell_size = 1;
+    mutable aabb<T,dim> grid_bounds;
+    mutable vec<size_t,dim> cells;
+    mutable std::vector<aabb<T,dim>> bounds;
+    ///@brief Where each cell's collidables start in cell_items, with one more entry for the end of the last
+    mutable std::vector<uint32_t> cell_starts;
+    mutable std::vector<uint32_t> cell_items;
+
+    //Clamped to the grid in T before the cast, which also sends NaN to the first cell
+    size_t CellOf(const T& coordinate, const size_t& axis) const {
+        const T cell = Floor<T>((coordinate - grid_bounds.min[axis]) / cell_size);
+        if(!(cell > 0)){return 0;}
+        if(!(cell < (T)(cells[axis] - 1))){return cells[axis] - 1;}
+        return (size_t)cell;
+    }
+    size_t CellCount() const {
+        size_t count = 1;
+        for(size_t i = 0; i < dim; i++){count *= cells[i];}
+        return count;
+    }
+    //Sets cells for the current cell_size, false if there would be more than limit of them
+    bool FitCells(const size_t& limit) const {
+        size_t count = 1;
+        for(size_t i = 0; i < dim; i++){
+            const T span = Floor<T>((grid_bounds.max[i] - grid_bounds.min[i]) / cell_size);
+            if(!(span < (T)limit)){return false;}
+            cells[i] = (size_t)span + 1;
+            if(cells[i] > limit / count){return false;}
+            count *= cells[i];
+        }
+        return true;
+    }
+
+    //Calls f(cell index) for every cell box overlaps
+    template<typename F>
+    void ForCells(const aabb<T,dim>& box, F f) const {
+        vec<size_t,dim> low, high, at;
+        for(size_t i = 0; i < dim; i++){
+            low[i] = CellOf(box.min[i], i);
+            high[i] = CellOf(box.max[i], i);
+        }
+        at = low;
+        while(true){
+            size_t index = 0;
+            for(size_t i = dim; i-- > 0;){index = (index * cells[i]) + at[i];}
+            f(index);
+            size_t i = 0;
+            for(; i < dim; i++){
+                if(at[i] < high[i]){
+                    at[i]++;
+                    break;
+                }
+                at[i] = low[i];
+            }
+            if(i == dim){return;}
+        }
+    }
+
+    void Rebuild() const {
+        bounds.resize(collidables.size());
+        grid_bounds = aabb<T,dim>::Empty();
+        T mean_size = 0;
+        for(size_t i = 0; i < collidables.size(); i++){
+            bounds[i] = collidables[i]->GetBounds();
+            grid_bounds.Expand(bounds[i]);
+            const vec<T,dim> size = bounds[i].Size();
+            mean_size += *std::max_element(size.begin(), size.end());
+        }
+        if(collidables.empty()){grid_bounds = aabb<T,dim>(vec<T,dim>(0), vec<T,dim>(0));}
+        //By default about the size of the average collidable, so each touches a few cells, but never so small
+        //that the widest axis alone splits into more than the dim-th root of max_cells
+        const size_t max_cells = Max<size_t>(collidables.size() * SS_GRID_MAX_CELLS_PER_COLLIDABLE, 1);
+        if(requested_cell_size > 0){cell_size = requested_cell_size;}
+        else {
+            const vec<T,dim> extent = grid_bounds.Size();
+            const T widest = *std::max_element(extent.begin(), extent.end());
+            cell_size = collidables.empty() ? (T)0 : mean_size / (T)collidables.size();
+            cell_size = Max<T>(cell_size, widest / Pow<T>((T)max_cells, (T)1 / (T)dim));
+            if(!(cell_size > 0)){cell_size = 1;}
+        }
+        //A requested size is only grown past the most cells a uint32_t cell index reaches
+        const size_t limit = (requested_cell_size > 0) ? (size_t)std::numeric_limits<uint32_t>::max() : max_cells;
+        while(!FitCells(limit)){
+            cell_size *= (T)2;
+            if(!(cell_size < std::numeric_limits<T>::infinity())){
+                cells = vec<size_t,dim>(1);
+                break;
+            }
+        }
+
+        //Counted then filled, every cell's list contiguous in cell_items
+        cell_starts.assign(CellCount() + 1, 0);
+        for(size_t i = 0; i < collidables.size(); i++){
+            ForCells(bounds[i], [&](const size_t& cell){cell_starts[cell + 1]++;});
+        }
+        for(size_t c = 0; c < CellCount(); c++){cell_starts[c + 1] += cell_starts[c];}
+        cell_items.resize(cell_starts.back());
+        std::vector<uint32_t> fill(cell_starts.begin(), cell_starts.end() - 1);
+        for(size_t i = 0; i < collidables.size(); i++){
+            ForCells(bounds[i], [&](const size_t& cell){cell_items[fill[cell]++] = (uint32_t)i;});
+        }
+        dirty = false;
+    }
+
+public:
+    /**
+     * @brief Constructor
+     * @param cell_size The edge length of every cell, 0 to pick one from the collidables at each rebuild.
+     */
+    GridCollisionGroup(const T& cell_size = 0) : requested_cell_size(cell_size) {}
+
+    void AddCollidable(collidable_type* coll){
+        collidables.push_back(coll);
+        dirty = true;
+    }
+    void RemoveCollidable(collidable_type* coll){
+        auto iter = std::find(collidables.begin(), collidables.end(), coll);
+        if(iter != collidables.end()){
+            collidables.erase(iter);
+            dirty = true;
+        }
+    }
+    ///@fn Size @return size_t The number of collidables
+    size_t Size() const {return collidables.size();}
+    ///@fn Update Rebuilds the grid around where the collidables are now
+    void Update(){Rebuild();}
+    ///@fn CellSize @return T The edge length of every cell as of the last rebuild
+    T CellSize() const {return cell_size;}
+
+    /**
+     * @fn TrimSwept
+     * @brief Asks trim(collidable, move) for the move each collidable touching start swept by the move so far allows,
+     * visiting every cell of the sweep
+     */
+    template<typename F>
+    T TrimSwept(const aabb<T,dim>& start, const size_t& dir, const T& move, F trim) const {
+        if(dirty){Rebuild();}
+        if(collidables.empty() || move == 0){return move;}
+        aabb<T,dim> swept = start.Swept(dir, move);
+        T curr_move = move;
+        ForCells(swept, [&](const size_t& cell){
+            for(uint32_t k = cell_starts[cell]; k < cell_starts[cell + 1] && curr_move != 0; k++){
+                const uint32_t i = cell_items[k];
+                if(!bounds[i].Overlaps(swept)){continue;}
+                const T trimmed = trim(collidables[i], curr_move);
+                if(trimmed != curr_move){
+                    curr_move = trimmed;
+                    swept = start.Swept(dir, curr_move);
+                }
+            }
+        });
+        return curr_move;
+    }
+
+    T TrimMove(const vec<T,dim>& origin, const size_t& dir, const T& move) const override {
+        if(dirty){Rebuild();}
+        if(collidables.empty() || move == 0){return move;}
+        //The ray only spans cells along dir, visited from the origin outwards until past its trimmed end
+        size_t index = 0;
+        size_t stride = 1;
+        for(size_t i = 0; i < dir; i++){stride *= cells[i];}
+        for(size_t i = dim; i-- > 0;){index = (index * cells[i]) + ((i == dir) ? 0 : CellOf(origin[i], i));}
+        T curr_move = move;
+        const bool forward = move > 0;
+        const size_t start = CellOf(origin[dir], dir);
+        for(size_t cell = start;;){
+            aabb<T,dim> ray = aabb<T,dim>::Segment(origin, dir, curr_move);
+            const size_t base = index + (cell * stride);
+            for(uint32_t k = cell_starts[base]; k < cell_starts[base + 1]; k++){
+                const uint32_t i = cell_items[k];
+                if(!bounds[i].Overlaps(ray)){continue;}
+                const T trimmed = collidables[i]->TrimMove(origin, dir, curr_move);
+                if(trimmed != curr_move){
+                    curr_move = trimmed;
+                    if(curr_move == 0){return curr_move;}
+                    ray = aabb<T,dim>::Segment(origin, dir, curr_move);
+                }
+            }
+            //The trimmed end can round into a cell already passed, so stop at or past it, and at the grid's edge
+            const size_t end = CellOf(origin[dir] + curr_move, dir);
+            if(forward ? (cell >= end || cell + 1 >= cells[dir]) : (cell <= end || cell == 0)){break;}
+            cell = forward ? cell + 1 : cell - 1;
+        }
+        return curr_move;
+    }
+    ///@fn TrimMoves Visits every cell the packet's rays pass through together, rather than walking each ray
+    T TrimMoves(const std::array<const T*,dim>& origins, const size_t& count, const size_t& dir, const T& move) const override {
+        if(count == 0){return move;}
+        return TrimSwept(detail::LaneBounds<T,dim>(origins, count), dir, move, [&](const collidable_type* coll, const T& m){
+            return coll->TrimMoves(origins, count, dir, m);
+        });
+    }
+    T TrimBoxMove(const aabb<T,dim>& box, const size_t& dir, const T& move) const override {
+        return TrimSwept(box, dir, move, [&](const collidable_type* coll, const T& m){return coll->TrimBoxMove(box, dir, m);});
+    }
+};
+
+/**
+ * @class SpatialHashCollisionGroup
+ * @brief A RayCollisionGroup of IBoundedRayCollidables kept in a SpatialHash by the centres of their bounds.
+ *
+ * Unlike GridCollisionGroup only occupied cells are stored, so the world may be unbounded and sparse, and
+ * Update() moves each collidable between cells rather than rebuilding. A ray visits the cells within the
+ * largest collidable's half size of it, so this suits collidables of similar size. Call Update() after
+ * collidables move.
+ *
+ * @tparam dim number of dimensions, 1 to 3
+ */
+template<typename T, size_t dim>
+class SpatialHashCollisionGroup : public IRayCollidable<T,dim> {
+public:
+    using collidable_type = IBoundedRayCollidable<T,dim>;
+
+protected:
+    SpatialHash<T,dim,uint32_t> hash;
+    std::vector<collidable_type*> collidables;
+    std::vector<RegistryHandle> handles;
+    std::vector<aabb<T,dim>> bounds;
+    ///@brief The largest half size along each axis of any collidable, as of the last change
+    vec<T,dim> reach = vec<T,dim>(0);
+
+    void Reach(const aabb<T,dim>& b){
+        const vec<T,dim> size = b.Size();
+        for(size_t i = 0; i < dim; i++){reach[i] = Max<T>(reach[i], size[i] / (T)2);}
+    }
+
+public:
+    /**
+     * @brief Constructor
+     * @param cell_size The edge length of every cell, about the size of a collidable works well
+     */
+    SpatialHashCollisionGroup(const T& cell_size) : hash(cell_size) {}
+
+    void AddCollidable(collidable_type* coll){
+        const aabb<T,dim> b = coll->GetBounds();
+        handles.push_back(hash.Insert(b.Center(), (uint32_t)collidables.size()));
+        collidables.push_back(coll);
+        bounds.push_back(b);
+        Reach(b);
+    }
+    void RemoveCollidable(collidable_type* coll){
+        auto iter = std::find(collidables.begin(), collidables.end(), coll);
+        if(iter == collidables.end()){return;}
+        const size_t i = iter - collidables.begin();
+        hash.Remove(handles[i]);
+        //The last collidable fills the gap, its entry told where it went
+        collidables[i] = collidables.back();
+        handles[i] = handles.back();
+        bounds[i] = bounds.back();
+        collidables.pop_back();
+        handles.pop_back();
+        bounds.pop_back();
+        if(i < collidables.size()){*hash.Get(handles[i]) = (uint32_t)i;}
+    }
+    ///@fn Size @return size_t The number of collidables
+    size_t Size() const {return collidables.size();}
+    ///@fn Update Moves every collidable to the cell its bounds are centred in now
+    void Update(){
+        reach = vec<T,dim>(0);
+        for(size_t i = 0; i < collidables.size(); i++){
+            bounds[i] = collidables[i]->GetBounds();
+            hash.Move(handles[i], bounds[i].Center());
+            Reach(bounds[i]);
+        }
+    }
+
+    /**
+     * @fn TrimSwept
+     * @brief Asks trim(collidable, move) for the move each collidable touching start swept by the move so far allows,
+     * in one query of the hash
+     */
+    template<typename F>
+    T TrimSwept(const aabb<T,dim>& start, const size_t& dir, const T& move, F trim) const {
+        if(move == 0){return move;}
+        aabb<T,dim> swept = start.Swept(dir, move);
+        //Any collidable touching the sweep has its centre within reach of it
+        const aabb<T,dim> near(swept.min - reach, swept.max + reach);
+        T curr_move = move;
+        hash.QueryAABB(near, [&](const uint32_t& i, const vec<T,dim>&){
+            if(curr_move == 0 || !bounds[i].Overlaps(swept)){return;}
+            const T trimmed = trim(collidables[i], curr_move);
+            if(trimmed != curr_move){
+                curr_move = trimmed;
+                swept = start.Swept(dir, curr_move);
+            }
+        });
+        return curr_move;
+    }
+
+    T TrimMove(const vec<T,dim>& origin, const size_t& dir, const T& move) const override {
+        return TrimSwept(aabb<T,dim>(origin, origin), dir, move, [&](const collidable_type* coll, const T& m){
+            return coll->TrimMove(origin, dir, m);
+        });
+    }
+    ///@fn TrimMoves Queries the hash once for the whole packet, by the bounds of every ray in it
+    T TrimMoves(const std::array<const T*,dim>& origins, const size_t& count, const size_t& dir, const T& move) const override {
+        if(count == 0){return move;}
+        return TrimSwept(detail::LaneBounds<T,dim>(origins, count), dir, move, [&](const collidable_type* coll, const T& m){
+            return coll->TrimMoves(origins, count, dir, m);
+        });
+    }
+    T TrimBoxMove(const aabb<T,dim>& box, const size_t& dir, const T& move) const override {
+        return TrimSwept(box, dir, move, [&](const collidable_type* coll, const T& m){return coll->TrimBoxMove(box, dir, m);});
+    }
+};
+
+}
+
+#endif // SUBSTD_BROADPHASE_HPP
@@ -0,0 +1,450 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Variable length (LEB128 varint), zigzag and bit packed integer codecs.
+ * @include array cstddef cstdint type_traits vector math endian simd
+*/
+
+#ifndef SUBSTD_CODEC_HPP
+#define SUBSTD_CODEC_HPP
+
+#include<array>
+#include<cstddef>
+#include<cstdint>
+#include<type_traits>
+#include<vector>
+
+#include<substd/math.hpp>
+#include<substd/endian.hpp>
+#include<substd/simd.hpp>
+
+namespace ss
+{
+
+//ZigZag
+
+/**
+ * @fn ZigZagEncode
+ * @brief Maps signed integers to unsigned ones with small magnitudes first, 0, -1, 1, -2, 2... to 0, 1, 2, 3, 4...
+ * @remark The branch free equivalent of MapIntToPositive, returning the unsigned type.
+ */
+template<typename S>
+inline std::make_unsigned_t<S> ZigZagEncode(const S& s){
+    static_assert(std::is_integral_v<S> && std::is_signed_v<S>, "ss::ZigZagEncode() requires a signed integral type!");
+    using U = std::make_unsigned_t<S>;
+    return (U)(((U)s << 1) ^ (U)(s >> ((sizeof(S) * 8) - 1)));
+}
+///@fn ZigZagDecode The inverse of ZigZagEncode
+template<typename U>
+inline std::make_signed_t<U> ZigZagDecode(const U& u){
+    static_assert(std::is_integral_v<U> && std::is_unsigned_v<U>, "ss::ZigZagDecode() requires an unsigned integral type!");
+    return (std::make_signed_t<U>)((u >> 1) ^ (U)(~(u & 1) + 1));
+}
+
+//Varint
+
+///@brief The most bytes a varint of an unsigned T can take.
+template<typename T>
+constexpr size_t MAX_VARINT_SIZE = ((sizeof(T) * 8) + 6) / 7;
+
+///@fn VarintSize @return size_t The number of bytes EncodeVarint writes for v
+template<typename T>
+inline size_t VarintSize(T v){
+    size_t n = 1;
+    while(v >= 0x80){
+        v >>= 7;
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @fn EncodeVarint
+ * @brief Writes v as an unsigned LEB128 varint, 7 bits per byte, least significant first, the high bit set on all but the last.
+ * @param out Must have room for MAX_VARINT_SIZE<T> bytes
+ * @return size_t The number of bytes written
+ */
+template<typename T>
+inline size_t EncodeVarint(T v, uint8_t* out){
+    static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>, "ss::EncodeVarint() requires an unsigned integral type!");
+    size_t n = 0;
+    while(v >= 0x80){
+        out[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+/**
+ * @fn DecodeVarint
+ * @brief Reads an unsigned LEB128 varint from [in, end).
+ * @return size_t The number of bytes read, or 0 if the varint is truncated or does not fit in T.
+ */
+template<typename T>
+inline size_t DecodeVarint(const uint8_t* in, const uint8_t* end, T& value){
+    static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>, "ss::DecodeVarint() requires an unsigned integral type!");
+    constexpr size_t max_bytes = MAX_VARINT_SIZE<T>;
+    //Bits the last possible byte may carry
+    constexpr size_t last_bits = (sizeof(T) * 8) - (7 * (max_bytes - 1));
+    const size_t available = (size_t)(end - in);
+    if(available > 0 && in[0] < 0x80){
+        value = in[0];
+        return 1;
+    }
+    T v = 0;
+    for(size_t i = 0; i < max_bytes && i < available; i++){
+        const uint8_t b = in[i];
+        v |= (T)((T)(b & 0x7F) << (7 * i));
+        if((b & 0x80) == 0){
+            if(i == max_bytes - 1 && (b >> last_bits) != 0){return 0;}
+            value = v;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @fn EncodeVarintArray
+ * @param out Must have room for count * MAX_VARINT_SIZE<T> bytes
+ * @return size_t The number of bytes written
+ */
+template<typename T>
+inline size_t EncodeVarintArray(const T* in, const size_t& count, uint8_t* out){
+    size_t n = 0;
+    for(size_t i = 0; i < count; i++){n += EncodeVarint<T>(in[i], out + n);}
+    return n;
+}
+
+namespace detail
+{
+
+/**
+ * @class VarintShuffle
+ * @brief For every pattern of continuation bits in an 8 byte window, how the leading varints of 1 or 2 bytes
+ * are gathered into 16 bit lanes: the pshufb pattern, how many varints that is and how many bytes they span.
+ */
+struct VarintShuffle {
+    uint8_t shuffle[16];
+    uint8_t count;
+    uint8_t bytes;
+};
+
+constexpr std::array<VarintShuffle, 256> MakeVarintShuffles(){
+    std::array<VarintShuffle, 256> table{};
+    for(size_t mask = 0; mask < 256; mask++){
+        VarintShuffle entry{};
+        for(size_t b = 0; b < 16; b++){entry.shuffle[b] = 0x80;}
+        size_t pos = 0;
+        size_t count = 0;
+        while(pos < 8){
+            if(((mask >> pos) & 1) == 0){
+                entry.shuffle[2 * count] = (uint8_t)pos;
+                pos += 1;
+            }
+            else if(pos + 1 < 8 && ((mask >> (pos + 1)) & 1) == 0){
+                entry.shuffle[2 * count] = (uint8_t)pos;
+                entry.shuffle[(2 * count) + 1] = (uint8_t)(pos + 1);
+                pos += 2;
+            }
+            else{
+                break;
+            }
+            count++;
+        }
+        entry.count = (uint8_t)count;
+        entry.bytes = (uint8_t)pos;
+        table[mask] = entry;
+    }
+    return table;
+}
+
+constexpr std::array<VarintShuffle, 256> VARINT_SHUFFLES = MakeVarintShuffles();
+
+}
+
+namespace detail
+{
+
+#if !defined(SS_NO_SIMD) && defined(SS_SIMD_SSE41)
+///@fn ContinuationMask @return uint64_t The high bit of each of the 64 bytes at in, byte i in bit i
+inline uint64_t ContinuationMask(const uint8_t* in){
+#if defined(SS_SIMD_AVX512BW)
+    return (uint64_t)_mm512_movepi8_mask(_mm512_loadu_si512(in));
+#else
+    const uint64_t m0 = (uint32_t)_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)));
+    const uint64_t m1 = (uint32_t)_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16)));
+    const uint64_t m2 = (uint32_t)_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 32)));
+    const uint64_t m3 = (uint32_t)_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 48)));
+    return m0 | (m1 << 16) | (m2 << 32) | (m3 << 48);
+#endif
+}
+
+///@fn WidenBytes out[i] = in[i] for i in [0, 16)
+inline void WidenBytes(const uint8_t* in, uint32_t* out){
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_cvtepu8_epi32(bytes));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_cvtepu8_epi32(_mm_srli_si128(bytes, 4)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_cvtepu8_epi32(_mm_srli_si128(bytes, 8)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_cvtepu8_epi32(_mm_srli_si128(bytes, 12)));
+}
+
+///@fn GatherShort @return __m128i The 1 and 2 byte varints entry describes at in, decoded into 16 bit lanes
+inline __m128i GatherShort(const uint8_t* in, const VarintShuffle& entry){
+    const __m128i lanes = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(entry.shuffle)));
+    //(low & 0x7F) | ((high & 0x7F) << 7)
+    return _mm_or_si128(_mm_and_si128(lanes, _mm_set1_epi16(0x007F)), _mm_srli_epi16(_mm_and_si128(lanes, _mm_set1_epi16(0x7F00)), 1));
+}
+#endif
+
+}
+
+/**
+ * @fn DecodeVarintArray
+ * @brief Decodes up to count varints from the size bytes at in, stopping early at a truncated or invalid one.
+ *
+ * With SSE4.1 the continuation bits of 64 bytes are gathered into one mask, a block of single byte varints is
+ * widened straight to 64 values, otherwise a table indexed by 8 bits of the mask gathers the leading 1 and 2 byte
+ * varints at a position with one shuffle (the masked VByte approach).
+ * The table steps through a block one lookup after another, but with BMI2 a block holding no varint longer than
+ * 2 bytes is split into groups of 4, each group's start found from the mask by rank with pdep, so groups do not
+ * wait on one another.
+ * Longer varints, and the tail of the input, are decoded one at a time.
+ *
+ * @param consumed Set to the number of bytes the decoded varints span
+ * @return size_t The number of values decoded
+ */
+inline size_t DecodeVarintArray(const uint8_t* in, const size_t& size, uint32_t* out, const size_t& count, size_t& consumed){
+    size_t pos = 0;
+    size_t done = 0;
+#if !defined(SS_NO_SIMD) && defined(SS_SIMD_SSE41)
+    //A block decodes at most 64 values and stores at most 16 past the last, a group's load reads up to 16 past the block
+    while(pos + 80 <= size && done + 80 <= count){
+        const uint8_t* block = in + pos;
+        const uint64_t mask = detail::ContinuationMask(block);
+        if(mask == 0){
+            for(size_t i = 0; i < 64; i += 16){detail::WidenBytes(block + i, out + done + i);}
+            pos += 64;
+            done += 64;
+            continue;
+        }
+#if defined(SS_SIMD_BMI2)
+        //Two continuation bits in a row start a varint of 3 or more bytes, blocks without any are decoded in groups
+        if((mask & (mask << 1)) == 0){
+            //Only varints ending in the first 56 bytes, so each one's 8 bit window of the mask lies in the block
+            const uint64_t ends = ~mask & 0x00FFFFFFFFFFFFFFull;
+            const size_t groups = (size_t)__builtin_popcountll(ends) / 4;
+            for(size_t g = 0; g < groups; g++){
+                const size_t start = (g == 0) ? 0 : (size_t)__builtin_ctzll(_pdep_u64(1ull << ((4 * g) - 1), ends)) + 1;
+                const detail::VarintShuffle& entry = detail::VARINT_SHUFFLES[(mask >> start) & 0xFF];
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + done + (4 * g)), _mm_cvtepu16_epi32(detail::GatherShort(block + start, entry)));
+            }
+            pos += (size_t)__builtin_ctzll(_pdep_u64(1ull << ((4 * groups) - 1), ends)) + 1;
+            done += 4 * groups;
+            continue;
+        }
+#endif
+        size_t p = 0;
+        //Stop while 16 bits of the mask, and 16 bytes of the block, remain ahead of p
+        while(p <= 48){
+            const uint64_t window = mask >> p;
+            if((window & 0xFFFF) == 0){
+                detail::WidenBytes(block + p, out + done);
+                p += 16;
+                done += 16;
+                continue;
+            }
+            const detail::VarintShuffle& entry = detail::VARINT_SHUFFLES[window & 0xFF];
+            if(entry.count == 0){
+                //A varint of 3 or more bytes leads the window
+                uint32_t v;
+                const size_t n = DecodeVarint<uint32_t>(block + p, in + size, v);
+                if(n == 0){
+                    consumed = pos + p;
+                    return done;
+                }
+                out[done++] = v;
+                p += n;
+                continue;
+            }
+            const __m128i values = detail::GatherShort(block + p, entry);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + done), _mm_cvtepu16_epi32(values));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + done + 4), _mm_cvtepu16_epi32(_mm_srli_si128(values, 8)));
+            p += entry.bytes;
+            done += entry.count;
+        }
+        pos += p;
+    }
+#endif
+    while(done < count){
+        uint32_t v;
+        const size_t n = DecodeVarint<uint32_t>(in + pos, in + size, v);
+        if(n == 0){break;}
+        out[done++] = v;
+        pos += n;
+    }
+    consumed = pos;
+    return done;
+}
+
+/**
+ * @fn DecodeVarintArray
+ * @brief The 64 bit overload, decoded one varint at a time.
+ */
+inline size_t DecodeVarintArray(const uint8_t* in, const size_t& size, uint64_t* out, const size_t& count, size_t& consumed){
+    size_t pos = 0;
+    size_t done = 0;
+    while(done < count){
+        uint64_t v;
+        const size_t n = DecodeVarint<uint64_t>(in + pos, in + size, v);
+        if(n == 0){break;}
+        out[done++] = v;
+        pos += n;
+    }
+    consumed = pos;
+    return done;
+}
+
+//Bits
+
+/**
+ * @class BitWriter
+ * @brief Packs fields of any width from 1 to 64 bits into bytes appended to a std::vector, least significant bit first.
+ *
+ * Bits gather in a 64 bit accumulator and are appended 32 at a time. Flush() (or the destructor) writes
+ * the final partial byte, padded with zeros.
+ */
+class BitWriter {
+protected:
+    std::vector<uint8_t>* target;
+    uint64_t acc = 0;
+    unsigned filled = 0;
+
+public:
+    /**
+     * @brief Vector Constructor, bytes are appended to out, which must outlive the writer
+    */
+    BitWriter(std::vector<uint8_t>& out) : target(&out) {}
+
+    BitWriter(const BitWriter&) = delete;
+    BitWriter& operator=(const BitWriter&) = delete;
+
+    ~BitWriter(){
+        Flush();
+    }
+
+    ///@fn Write Appends the low bits bits of value
+    void Write(const uint64_t& value, const unsigned& bits){
+        if(bits > 32){
+            Write(value & 0xFFFFFFFFu, 32);
+            Write(value >> 32, bits - 32);
+            return;
+        }
+        const uint64_t masked = (bits == 32) ? (value & 0xFFFFFFFFu) : (value & ((1ull << bits) - 1));
+        acc |= masked << filled;
+        filled += bits;
+        if(filled >= 32){
+            uint8_t bytes[4];
+            StoreLE<uint32_t>(bytes, (uint32_t)acc);
+            target->insert(target->end(), bytes, bytes + 4);
+            acc >>= 32;
+            filled -= 32;
+        }
+    }
+    ///@fn WriteBit
+    void WriteBit(const bool& bit) {Write(bit ? 1 : 0, 1);}
+
+    ///@fn AlignToByte Pads with zeros to the next byte boundary
+    void AlignToByte(){
+        if(filled % 8 != 0){Write(0, 8 - (filled % 8));}
+    }
+
+    ///@fn Flush Appends every bit written so far, padding the final byte with zeros
+    void Flush(){
+        while(filled > 0){
+            target->push_back((uint8_t)acc);
+            acc >>= 8;
+            filled = (filled > 8) ? filled - 8 : 0;
+        }
+        acc = 0;
+    }
+};
+
+/**
+ * @class BitReader
+ * @brief Unpacks fields written by BitWriter from a contiguous buffer.
+ *
+ * The accumulator is refilled a whole 64 bit word at a time while at least 8 bytes remain. Reading past the
+ * end returns 0 and sets a sticky failure flag, as ByteReader does.
+ */
+class BitReader {
+protected:
+    const uint8_t* data;
+    size_t size;
+    size_t pos = 0;
+    uint64_t acc = 0;
+    unsigned filled = 0;
+    bool failed = false;
+
+    void Refill(){
+        if(size - pos >= 8){
+            acc |= LoadLE<uint64_t>(data + pos) << filled;
+            const unsigned bytes = (63 - filled) >> 3;
+            pos += bytes;
+            filled += bytes * 8;
+        }
+        else{
+            while(filled <= 56 && pos < size){
+                acc |= (uint64_t)data[pos++] << filled;
+                filled += 8;
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Buffer Constructor, the buffer is read in place and must outlive the reader
+    */
+    BitReader(const void* data, const size_t& size) : data(static_cast<const uint8_t*>(data)), size(size) {}
+
+    ///@fn Read @return uint64_t The next bits bits, 1 to 64
+    uint64_t Read(const unsigned& bits){
+        if(bits > 32){
+            const uint64_t low = Read(32);
+            return low | (Read(bits - 32) << 32);
+        }
+        if(filled < bits){
+            Refill();
+            if(filled < bits){
+                failed = true;
+                filled = 0;
+                acc = 0;
+                return 0;
+            }
+        }
+        const uint64_t ret = (bits == 32) ? (acc & 0xFFFFFFFFu) : (acc & ((1ull << bits) - 1));
+        acc >>= bits;
+        filled -= bits;
+        return ret;
+    }
+    ///@fn ReadBit
+    bool ReadBit() {return Read(1) != 0;}
+
+    ///@fn AlignToByte Skips to the next byte boundary
+    void AlignToByte(){
+        if(filled % 8 != 0){Read(filled % 8);}
+    }
+
+    ///@fn BitsRemaining
+    size_t BitsRemaining() const {return ((size - pos) * 8) + filled;}
+    ///@fn Failed @return bool Whether any read so far ran past the end
+    bool Failed() const {return failed;}
+    ///@fn Good
+    bool Good() const {return !failed;}
+};
+
+}
+
+#endif // SUBSTD_CODEC_HPP
@@ -0,0 +1,177 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Byte swapping and endian aware loads/stores of unsigned integers, singly and in bulk.
+ * @include cstddef cstdint cstring type_traits simd
+*/
+
+#ifndef SUBSTD_ENDIAN_HPP
+#define SUBSTD_ENDIAN_HPP
+
+#include<cstddef>
+#include<cstdint>
+#include<cstring>
+#include<type_traits>
+
+#include<substd/simd.hpp>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include<stdlib.h>
+#endif
+
+namespace ss
+{
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+///@brief True if the target stores integers most significant byte first.
+constexpr bool HOST_BIG_ENDIAN = true;
+#else
+constexpr bool HOST_BIG_ENDIAN = false;
+#endif
+
+/**
+ * @fn ByteSwap
+ * @return T u with the order of its bytes reversed, a single bswap instruction where the compiler has one.
+ */
+template<typename T>
+inline T ByteSwap(const T& u){
+    static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>, "ss::ByteSwap() requires an unsigned integral type!");
+    if constexpr(sizeof(T) == 1) {
+        return u;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    else if constexpr(sizeof(T) == 2) {
+        return __builtin_bswap16(u);
+    }
+    else if constexpr(sizeof(T) == 4) {
+        return __builtin_bswap32(u);
+    }
+    else if constexpr(sizeof(T) == 8) {
+        return __builtin_bswap64(u);
+    }
+#elif defined(_MSC_VER)
+    else if constexpr(sizeof(T) == 2) {
+        return _byteswap_ushort(u);
+    }
+    else if constexpr(sizeof(T) == 4) {
+        return _byteswap_ulong(u);
+    }
+    else if constexpr(sizeof(T) == 8) {
+        return _byteswap_uint64(u);
+    }
+#endif
+    else {
+        T ret = 0;
+        for(size_t i = 0; i < sizeof(T); i++){
+            ret = (T)((ret << 8) | ((u >> (8 * i)) & 0xFF));
+        }
+        return ret;
+    }
+}
+
+///@fn LoadBE @return T The big endian T stored at p, which need not be aligned
+template<typename T>
+inline T LoadBE(const void* p){
+    T u;
+    std::memcpy(&u, p, sizeof(T));
+    return HOST_BIG_ENDIAN ? u : ByteSwap(u);
+}
+///@fn LoadLE @return T The little endian T stored at p, which need not be aligned
+template<typename T>
+inline T LoadLE(const void* p){
+    T u;
+    std::memcpy(&u, p, sizeof(T));
+    return HOST_BIG_ENDIAN ? ByteSwap(u) : u;
+}
+///@fn StoreBE Stores u big endian at p, which need not be aligned
+template<typename T>
+inline void StoreBE(void* p, const T& u){
+    const T swapped = HOST_BIG_ENDIAN ? u : ByteSwap(u);
+    std::memcpy(p, &swapped, sizeof(T));
+}
+///@fn StoreLE Stores u little endian at p, which need not be aligned
+template<typename T>
+inline void StoreLE(void* p, const T& u){
+    const T swapped = HOST_BIG_ENDIAN ? ByteSwap(u) : u;
+    std::memcpy(p, &swapped, sizeof(T));
+}
+
+/**
+ * @fn ByteSwapArray
+ * @brief Copies count elements of sizeof(T) bytes from src to dst, reversing the bytes of each.
+ *
+ * Whole registers are swapped at once with byte shuffles (pshufb) where the target has them,
+ * the remainder one element at a time. src and dst need not be aligned, and may be the same array.
+ */
+template<typename T>
+inline void ByteSwapArray(const void* src, void* dst, const size_t& count){
+    static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>, "ss::ByteSwapArray() requires an unsigned integral type!");
+    const uint8_t* in = static_cast<const uint8_t*>(src);
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    const size_t bytes = count * sizeof(T);
+    size_t i = 0;
+    if constexpr(sizeof(T) == 1) {
+        if(in != out){std::memmove(out, in, bytes);}
+        return;
+    }
+#if !defined(SS_NO_SIMD) && defined(SS_SIMD_SSSE3)
+    //Byte b moves to the mirrored position within its element, the same pattern in every 16 byte lane
+    alignas(64) uint8_t order[64];
+    for(size_t b = 0; b < 64; b++){
+        order[b] = (uint8_t)(((b % 16) - (b % sizeof(T))) + (sizeof(T) - 1 - (b % sizeof(T))));
+    }
+#if defined(SS_SIMD_AVX512BW)
+    const __m512i mask512 = _mm512_load_si512(order);
+    for(; i + 64 <= bytes; i += 64){
+        _mm512_storeu_si512(out + i, _mm512_shuffle_epi8(_mm512_loadu_si512(in + i), mask512));
+    }
+#endif
+#if defined(SS_SIMD_AVX2)
+    const __m256i mask256 = _mm256_load_si256(reinterpret_cast<const __m256i*>(order));
+    for(; i + 32 <= bytes; i += 32){
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+            _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), mask256));
+    }
+#endif
+    const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(order));
+    for(; i + 16 <= bytes; i += 16){
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+            _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), mask));
+    }
+#endif
+    for(; i < bytes; i += sizeof(T)){
+        T u;
+        std::memcpy(&u, in + i, sizeof(T));
+        u = ByteSwap(u);
+        std::memcpy(out + i, &u, sizeof(T));
+    }
+}
+
+///@fn LoadBEArray Decodes count big endian Ts from the bytes at src into dst
+template<typename T>
+inline void LoadBEArray(const void* src, T* dst, const size_t& count){
+    if constexpr(HOST_BIG_ENDIAN) {std::memmove(dst, src, count * sizeof(T));}
+    else {ByteSwapArray<T>(src, dst, count);}
+}
+///@fn LoadLEArray Decodes count little endian Ts from the bytes at src into dst
+template<typename T>
+inline void LoadLEArray(const void* src, T* dst, const size_t& count){
+    if constexpr(HOST_BIG_ENDIAN) {ByteSwapArray<T>(src, dst, count);}
+    else {std::memmove(dst, src, count * sizeof(T));}
+}
+///@fn StoreBEArray Encodes count Ts from src as big endian bytes at dst
+template<typename T>
+inline void StoreBEArray(void* dst, const T* src, const size_t& count){
+    if constexpr(HOST_BIG_ENDIAN) {std::memmove(dst, src, count * sizeof(T));}
+    else {ByteSwapArray<T>(src, dst, count);}
+}
+///@fn StoreLEArray Encodes count Ts from src as little endian bytes at dst
+template<typename T>
+inline void StoreLEArray(void* dst, const T* src, const size_t& count){
+    if constexpr(HOST_BIG_ENDIAN) {ByteSwapArray<T>(src, dst, count);}
+    else {std::memmove(dst, src, count * sizeof(T));}
+}
+
+}
+
+#endif // SUBSTD_ENDIAN_HPP
@@ -0,0 +1,150 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Polynomial sine/cosine and Newton refined reciprocal square roots, evaluated on any simd pack.
+ * @include limits simd
+*/
+
+#ifndef SUBSTD_FASTMATH_HPP
+#define SUBSTD_FASTMATH_HPP
+
+#include<limits>
+
+#include<substd/simd.hpp>
+
+namespace ss
+{
+
+/**
+ * @enum Accuracy
+ * @brief Accuracy tiers of Sin, Cos, SinCos, Sqrt and RSqrt in math.hpp.
+ *
+ * Low: absolute error below 1e-3 for Sin/Cos and relative error below 1e-3 for Sqrt/RSqrt.
+ * Medium: the same bounds at 1e-6.
+ * Full: the standard library, to the precision of the type.
+ *
+ * The Low and Medium bounds hold for |theta| up to about 1e4 and for inputs of Sqrt/RSqrt in the normal float range.
+ */
+enum class Accuracy {
+    Low,
+    Medium,
+    Full
+};
+
+#ifndef SS_MATH_ACCURACY
+///@brief The Accuracy used by Sin, Cos, SinCos, Sqrt and RSqrt when none is given.
+#define SS_MATH_ACCURACY ss::Accuracy::Full
+#endif
+
+namespace fastmath
+{
+
+/**
+ * @fn SinCos
+ * @brief Sine and cosine of every lane of theta for the Low and Medium tiers.
+ *
+ * theta is reduced to r in [-pi/4, pi/4] around the nearest multiple k of pi/2, the minimax polynomials
+ * for sin(r) and cos(r) are both evaluated, and k mod 4 selects and negates them. The selection is done
+ * in floating point (multiplying by 0 or 1), so only the ops every pack provides are needed.
+ *
+ * @tparam P A simd::pack or simd::scalar of float or double
+ */
+template<Accuracy a, typename P>
+inline void SinCos(const typename P::reg& theta, typename P::reg& sin, typename P::reg& cos){
+    static_assert(a != Accuracy::Full, "ss::fastmath::SinCos() only implements the approximate tiers");
+    using T = typename P::value_type;
+    using reg = typename P::reg;
+
+    //r = theta - k*pi/2 with pi/2 split in three parts (Cody-Waite), so k times the first part is exact
+    const reg k = P::Floor(P::Fma(theta, P::Set1((T)0.63661977236758134308), P::Set1((T)0.5)));
+    reg r = P::Fma(k, P::Set1((T)-1.5703125), theta);
+    r = P::Fma(k, P::Set1((T)-4.837512969970703125e-4), r);
+    r = P::Fma(k, P::Set1((T)-7.54978995489188216e-8), r);
+    const reg r2 = P::Mul(r, r);
+
+    reg s, c;
+    if constexpr(a == Accuracy::Low) {
+        //|error| < 1.6e-4 and 1e-5 on [-pi/4, pi/4]
+        s = P::Mul(r, P::Fma(r2, P::Set1((T)-0.16034401672346188), P::Set1((T)0.9990314229131829)));
+        c = P::Fma(r2, P::Set1((T)0.04039853596906776), P::Set1((T)-0.49970814035693445));
+        c = P::Fma(r2, c, P::Set1((T)0.9999900349553448));
+    }
+    else {
+        //|error| < 5.7e-7 and 2.8e-8 on [-pi/4, pi/4]
+        s = P::Fma(r2, P::Set1((T)0.00812155792462514), P::Set1((T)-0.16660161988235425));
+        s = P::Mul(r, P::Fma(r2, s, P::Set1((T)0.9999949975616433)));
+        c = P::Fma(r2, P::Set1((T)-0.0013585908510622608), P::Set1((T)0.04165502688429943));
+        c = P::Fma(r2, c, P::Set1((T)-0.49999856695849865));
+        c = P::Fma(r2, c, P::Set1((T)0.9999999724233232));
+    }
+
+    //quadrant = k mod 4, odd quadrants swap sin and cos, sin is negated in 2 and 3, cos in 1 and 2
+    const reg one = P::Set1((T)1);
+    const reg minus_two = P::Set1((T)-2);
+    const reg quadrant = P::Fma(P::Floor(P::Mul(k, P::Set1((T)0.25))), P::Set1((T)-4), k);
+    const reg upper = P::Floor(P::Mul(quadrant, P::Set1((T)0.5)));
+    const reg odd = P::Fma(upper, minus_two, quadrant);
+    const reg sin_sign = P::Fma(upper, minus_two, one);
+    const reg cos_sign = P::Mul(sin_sign, P::Fma(odd, minus_two, one));
+    sin = P::Mul(P::Fma(odd, P::Sub(c, s), s), sin_sign);
+    cos = P::Mul(P::Fma(odd, P::Sub(s, c), c), cos_sign);
+}
+
+/**
+ * @fn NewtonSteps
+ * @return int The number of Newton iterations taking an estimate good to estimate_bits bits to at least target_bits.
+ */
+constexpr int NewtonSteps(int estimate_bits, const int& target_bits){
+    int steps = 0;
+    while(estimate_bits < target_bits){
+        estimate_bits = (2 * estimate_bits) - 1;
+        steps++;
+    }
+    return steps;
+}
+
+/**
+ * @fn RSqrt
+ * @brief 1/sqrt of every lane of x, from the pack's RSqrtEstimate refined by as many Newton steps as the tier needs.
+ * @remark The Full tier divides by Sqrt instead.
+ */
+template<Accuracy a, typename P>
+inline typename P::reg RSqrt(const typename P::reg& x){
+    using T = typename P::value_type;
+    using reg = typename P::reg;
+    if constexpr(a == Accuracy::Full) {
+        return P::Div(P::Set1((T)1), P::Sqrt(x));
+    }
+    else {
+        constexpr int steps = NewtonSteps(P::rsqrt_estimate_bits, (a == Accuracy::Low) ? 10 : 20);
+        reg y = P::RSqrtEstimate(x);
+        const reg neg_half_x = P::Mul(x, P::Set1((T)-0.5));
+        const reg three_halves = P::Set1((T)1.5);
+        for(int i = 0; i < steps; i++){
+            //y * (1.5 - 0.5*x*y*y)
+            y = P::Mul(y, P::Fma(P::Mul(neg_half_x, y), y, three_halves));
+        }
+        return y;
+    }
+}
+
+/**
+ * @fn Sqrt
+ * @brief sqrt of every lane of x, as x * RSqrt(x) for the approximate tiers.
+ * @remark x is clamped to the smallest normal float inside RSqrt, so Sqrt(0) is exactly 0.
+ */
+template<Accuracy a, typename P>
+inline typename P::reg Sqrt(const typename P::reg& x){
+    using T = typename P::value_type;
+    if constexpr(a == Accuracy::Full) {
+        return P::Sqrt(x);
+    }
+    else {
+        return P::Mul(x, RSqrt<a, P>(P::Max(x, P::Set1((T)std::numeric_limits<float>::min()))));
+    }
+}
+
+}
+}
+
+#endif // SUBSTD_FASTMATH_HPP
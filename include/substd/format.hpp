@@ -0,0 +1,140 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Text formatting and parsing of scalars with std::to_chars/std::from_chars, and the Format vec and mat text uses.
+ * @include charconv cstddef sstream string string_view system_error type_traits utility
+*/
+
+#ifndef SUBSTD_FORMAT_HPP
+#define SUBSTD_FORMAT_HPP
+
+#include<charconv>
+#include<cstddef>
+#include<sstream>
+#include<string>
+#include<string_view>
+#include<system_error>
+#include<type_traits>
+#include<utility>
+
+namespace ss
+{
+
+/**
+ * @class Format
+ * @brief The text around the components of a vec, or each row of a mat, and between mat rows.
+ *
+ * Parsing matches each of these ignoring whitespace, on either side, so text in one Format
+ * parses with another differing only in spacing.
+ */
+struct Format {
+    std::string_view open;
+    std::string_view separator;
+    std::string_view close;
+    ///@brief Written after every row of a mat
+    std::string_view row_end;
+
+    ///@fn Vec @return Format (x, y, z), what vec's operator<< writes
+    static constexpr Format Vec() {return Format{"(", ", ", ")", "\n"};}
+    ///@fn Mat @return Format [a, b] per row then a newline, what mat's operator<< writes
+    static constexpr Format Mat() {return Format{"[", ", ", "]", "\n"};}
+    ///@fn CSV @return Format x,y,z with rows on their own lines
+    static constexpr Format CSV() {return Format{"", ",", "", "\n"};}
+};
+
+namespace detail
+{
+
+/**
+ * @class FormatBuffer
+ * @brief A per thread string operator<< formats into, reused between calls.
+ *
+ * Taken out of its slot for as long as this lives, so a component's own operator<< called meanwhile formats
+ * into a fresh one rather than clearing what is being written.
+ */
+class FormatBuffer {
+protected:
+    std::string buffer;
+
+    static std::string& Slot(){
+        thread_local std::string slot;
+        return slot;
+    }
+
+public:
+    FormatBuffer() : buffer(std::move(Slot())) {buffer.clear();}
+    ~FormatBuffer() {Slot() = std::move(buffer);}
+    FormatBuffer(const FormatBuffer&) = delete;
+    FormatBuffer& operator=(const FormatBuffer&) = delete;
+
+    ///@fn Get @return std::string& The buffer, empty to begin with
+    std::string& Get() {return buffer;}
+};
+
+/**
+ * @fn AppendScalar
+ * @brief Appends t, arithmetic types with std::to_chars, floating point in the shortest form that reads back exactly.
+ * Anything else goes through its operator<<.
+ */
+template<typename T>
+inline void AppendScalar(std::string& s, const T& t){
+    if constexpr(std::is_same_v<T, bool>) {
+        s.push_back(t ? '1' : '0');
+    }
+    else if constexpr(std::is_arithmetic_v<T>) {
+        //Enough for the longest shortest form of a double, or a 64 bit integer with its sign
+        char buffer[32];
+        const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), t);
+        s.append(buffer, result.ptr);
+    }
+    else {
+        std::ostringstream o;
+        o<<t;
+        s.append(o.str());
+    }
+}
+
+///@fn SkipSpace @return const char* The first character in [first, last) that is not whitespace
+inline const char* SkipSpace(const char* first, const char* last){
+    while(first != last && (*first == ' ' || *first == '\t' || *first == '\n' || *first == '\r')){first++;}
+    return first;
+}
+
+///@fn MatchToken @return const char* Past token in [first, last), whitespace in either ignored, or nullptr if it is not there
+inline const char* MatchToken(const char* first, const char* last, const std::string_view& token){
+    for(const char c : token){
+        if(c == ' ' || c == '\t' || c == '\n' || c == '\r'){continue;}
+        first = SkipSpace(first, last);
+        if(first == last || *first != c){return nullptr;}
+        first++;
+    }
+    return first;
+}
+
+/**
+ * @fn ParseScalar
+ * @brief Reads an arithmetic t from [first, last) with std::from_chars, after any whitespace.
+ * @return const char* Past the value, or nullptr if there is none or it is out of range
+ */
+template<typename T>
+inline const char* ParseScalar(const char* first, const char* last, T& t){
+    static_assert(std::is_arithmetic_v<T>, "ss::Parse() requires an arithmetic type!");
+    first = SkipSpace(first, last);
+    if constexpr(std::is_same_v<T, bool>) {
+        if(first == last || (*first != '0' && *first != '1')){return nullptr;}
+        t = (*first == '1');
+        return first + 1;
+    }
+    else {
+        //from_chars does not take the '+' operator<< writes with showpos
+        if(first != last && *first == '+'){first++;}
+        const std::from_chars_result result = std::from_chars(first, last, t);
+        return (result.ec == std::errc()) ? result.ptr : nullptr;
+    }
+}
+
+}
+
+}
+
+#endif // SUBSTD_FORMAT_HPP
@@ -2,13 +2,18 @@
  * @file 
  * @author Kevin Hayes
  * @brief Contains general graph data structures
- * @include list
+ * @include list vector cstdint cstddef algorithm iterator
 */
 
 #ifndef SUBSTD_GRAPH_HPP
 #define SUBSTD_GRAPH_HPP
 
 #include<list>
+#include<vector>
+#include<cstdint>
+#include<cstddef>
+#include<algorithm>
+#include<iterator>
 
 namespace ss
 {
@@ -42,7 +47,7 @@ class Tree
          * @fn Destructor
          * @brief Calls delete on all child tree nodes.
         */
-        virtual ~Tree();
+        virtual ~Tree()
         {
             for(auto i = children.begin(); i != children.end(); i++)
             {delete *i;}
@@ -76,8 +81,9 @@ class Tree
          * @brief Removes child from this node and calls delete on that child is it is not nullptr.
         */
         virtual void DeleteChild(Tree<self>* child){
-            child->parent = nullptr;
             if(child != nullptr){
+                child->parent = nullptr;
+                children.remove(child);
                 delete child;
             }
         }
@@ -90,12 +96,13 @@ class Tree
          * 
          * Does nothing if either child or other is nullptr.
         */
-        virtual void GiveChild(Tree<self>* other, Tree<self>* child);
+        virtual void GiveChild(Tree<self>* other, Tree<self>* child)
         {
             if(other != nullptr && child != nullptr)
             {
-                other->AddChild(child);
+                //Removed first, so giving a child back to this same tree does not drop it
                 children.remove(child);
+                other->AddChild(child);
             }       
         }
 
@@ -110,24 +117,364 @@ class Tree
         bool IsRoot() const {return parent == nullptr;}
 
         ///@fn begin
-        const Tree<self>* begin() const {
+        typename std::list<Tree<self>*>::const_iterator begin() const {
             return children.begin();
         }
         ///@fn end
-        const Tree<self>* end() const {
+        typename std::list<Tree<self>*>::const_iterator end() const {
             return children.end();
         }
 
         ///@fn cbegin
-        const Tree<self>* cbegin() const {
+        typename std::list<Tree<self>*>::const_iterator cbegin() const {
             return children.cbegin();
         }
         ///@fn cend
-        const Tree<self>* cend() const {
+        typename std::list<Tree<self>*>::const_iterator cend() const {
             return children.cend();
         }
 };
 
+
+/**
+ * @class FlatTree
+ * @brief A forest of T stored contiguously in depth first pre-order, one array per field.
+ *
+ * Every node knows its parent and the size of its subtree, so the subtree of node i is exactly the range
+ * [i, i + SubtreeSize(i)), its first child is i + 1 and its next sibling is i + SubtreeSize(i). Pre-order
+ * traversal of anything is a linear scan, post-order steps through those same links without a stack, and
+ * breadth first order is a stable bucketing of the range by depth.
+ *
+ * Nodes are identified by their index into that order, which AddChild, Reparent and Erase shift. They only
+ * move the range of the arrays between a subtree's old and new place (appending to the last subtree is
+ * O(depth)), and a Handle stays valid across all of it until the node is erased.
+ *
+ * @tparam T Value stored per node
+ */
+template<typename T>
+class FlatTree
+{
+    public:
+        using index_type = uint32_t;
+        using handle_type = uint32_t;
+        ///@brief No node, the parent of a root
+        static constexpr index_type NONE = ~(index_type)0;
+
+        /**
+         * @class Range
+         * @brief A begin/end pair for range based for loops
+         */
+        template<typename It>
+        struct Range {
+            It first;
+            It last;
+            It begin() const {return first;}
+            It end() const {return last;}
+        };
+
+    protected:
+        std::vector<T> values;
+        std::vector<index_type> parents;
+        std::vector<index_type> sizes;
+        std::vector<index_type> depths;
+        std::vector<handle_type> handles;
+        std::vector<index_type> handle_index;
+        std::vector<handle_type> free_handles;
+
+        handle_type AllocateHandle(const index_type& index){
+            if(free_handles.empty()){
+                handle_index.push_back(index);
+                return (handle_type)(handle_index.size() - 1);
+            }
+            const handle_type h = free_handles.back();
+            free_handles.pop_back();
+            handle_index[h] = index;
+            return h;
+        }
+
+        ///@fn Rotate Moves [middle, last) in front of [first, middle) in every array
+        void Rotate(const index_type& first, const index_type& middle, const index_type& last){
+            std::rotate(values.begin() + first, values.begin() + middle, values.begin() + last);
+            std::rotate(parents.begin() + first, parents.begin() + middle, parents.begin() + last);
+            std::rotate(sizes.begin() + first, sizes.begin() + middle, sizes.begin() + last);
+            std::rotate(depths.begin() + first, depths.begin() + middle, depths.begin() + last);
+            std::rotate(handles.begin() + first, handles.begin() + middle, handles.begin() + last);
+        }
+
+    public:
+        FlatTree() {}
+
+        ///@fn Size @return size_t The number of nodes
+        size_t Size() const {return values.size();}
+        ///@fn Empty
+        bool Empty() const {return values.empty();}
+        ///@fn Reserve Reserves room for count nodes
+        void Reserve(const size_t& count){
+            values.reserve(count);
+            parents.reserve(count);
+            sizes.reserve(count);
+            depths.reserve(count);
+            handles.reserve(count);
+            handle_index.reserve(count);
+        }
+        ///@fn Clear
+        void Clear(){
+            values.clear();
+            parents.clear();
+            sizes.clear();
+            depths.clear();
+            handles.clear();
+            handle_index.clear();
+            free_handles.clear();
+        }
+
+        /**
+         * @fn AddRoot
+         * @brief Appends value as the root of a new tree, after every existing one.
+         * @return index_type The index of the new node
+         */
+        index_type AddRoot(const T& value){
+            const index_type index = (index_type)values.size();
+            values.push_back(value);
+            parents.push_back(NONE);
+            sizes.push_back(1);
+            depths.push_back(0);
+            handles.push_back(AllocateHandle(index));
+            return index;
+        }
+
+        /**
+         * @fn AddChild
+         * @brief Adds value as the last child of parent, O(depth) if parent's subtree is the last in the array.
+         * @return index_type The index of the new node, nodes after it in the array shift up one
+         */
+        index_type AddChild(const index_type& parent, const T& value){
+            return Reparent(AddRoot(value), parent);
+        }
+
+        /**
+         * @fn Reparent
+         * @brief Moves node, with its subtree, to be the last child of new_parent, or the last root if it is NONE.
+         *
+         * Only the nodes between the subtree's old and new place in the array move, with the parent
+         * links pointing into that range fixed up.
+         *
+         * @return index_type The new index of node, or NONE if new_parent is within node's own subtree
+         */
+        index_type Reparent(const index_type& node, const index_type& new_parent){
+            const index_type n = (index_type)values.size();
+            const index_type s = sizes[node];
+            if(new_parent != NONE && new_parent >= node && new_parent < node + s){return NONE;}
+            //Where the subtree lands, measured before anything moves
+            const index_type dest = (new_parent == NONE) ? n : new_parent + sizes[new_parent];
+            const index_type depth = (new_parent == NONE) ? 0 : depths[new_parent] + 1;
+
+            for(index_type a = parents[node]; a != NONE; a = parents[a]){sizes[a] -= s;}
+            for(index_type a = new_parent; a != NONE; a = parents[a]){sizes[a] += s;}
+            const index_type old_depth = depths[node];
+            for(index_type k = node; k < node + s; k++){depths[k] = depths[k] - old_depth + depth;}
+            parents[node] = new_parent;
+            if(dest == node || dest == node + s){return node;}
+
+            //The affected range [lo, hi), and where its indices go
+            const bool forward = dest > node;
+            const index_type lo = forward ? node : dest;
+            const index_type hi = forward ? dest : node + s;
+            auto remap = [&](const index_type& x) -> index_type {
+                if(x == NONE || x < lo || x >= hi){return x;}
+                if(x >= node && x < node + s){return forward ? x + (dest - node - s) : x - (node - dest);}
+                return forward ? x - s : x + s;
+            };
+            //Nodes after the range may be children of ancestors inside it, they are reached by skipping whole subtrees
+            std::vector<index_type> outside;
+            for(index_type x = hi; x < n && parents[x] != NONE && parents[x] >= lo && parents[x] < hi; x += sizes[x]){
+                outside.push_back(x);
+            }
+
+            if(forward){Rotate(node, node + s, dest);}
+            else{Rotate(dest, node, node + s);}
+            for(index_type k = lo; k < hi; k++){
+                parents[k] = remap(parents[k]);
+                handle_index[handles[k]] = k;
+            }
+            for(const index_type& x : outside){parents[x] = remap(parents[x]);}
+            return remap(node);
+        }
+
+        /**
+         * @fn Erase
+         * @brief Removes node and its whole subtree, nodes after it in the array shift down.
+         */
+        void Erase(const index_type& node){
+            const index_type s = sizes[node];
+            for(index_type a = parents[node]; a != NONE; a = parents[a]){sizes[a] -= s;}
+            for(index_type k = node; k < node + s; k++){
+                handle_index[handles[k]] = NONE;
+                free_handles.push_back(handles[k]);
+            }
+            values.erase(values.begin() + node, values.begin() + node + s);
+            parents.erase(parents.begin() + node, parents.begin() + node + s);
+            sizes.erase(sizes.begin() + node, sizes.begin() + node + s);
+            depths.erase(depths.begin() + node, depths.begin() + node + s);
+            handles.erase(handles.begin() + node, handles.begin() + node + s);
+            for(index_type k = node; k < (index_type)values.size(); k++){
+                if(parents[k] != NONE && parents[k] > node){parents[k] -= s;}
+                handle_index[handles[k]] = k;
+            }
+        }
+
+        //Access
+
+        ///@fn operator[] @return T& The value of the node at index
+        T& operator[](const index_type& index) {return values[index];}
+        const T& operator[](const index_type& index) const {return values[index];}
+        ///@fn Data @return T* Every value, in pre-order
+        T* Data() {return values.data();}
+        const T* Data() const {return values.data();}
+
+        ///@fn Parent @return index_type The parent of index, NONE for a root
+        index_type Parent(const index_type& index) const {return parents[index];}
+        ///@fn SubtreeSize @return index_type The number of nodes in the subtree rooted at index, itself included
+        index_type SubtreeSize(const index_type& index) const {return sizes[index];}
+        ///@fn Depth @return index_type The number of ancestors of index
+        index_type Depth(const index_type& index) const {return depths[index];}
+        ///@fn IsRoot
+        bool IsRoot(const index_type& index) const {return parents[index] == NONE;}
+        ///@fn IsLeaf
+        bool IsLeaf(const index_type& index) const {return sizes[index] == 1;}
+        ///@fn IsAncestor @return bool Whether descendant is within the subtree of ancestor, ancestor itself included
+        bool IsAncestor(const index_type& ancestor, const index_type& descendant) const {
+            return descendant >= ancestor && descendant < ancestor + sizes[ancestor];
+        }
+        ///@fn FirstChild @return index_type The first child of index, or NONE
+        index_type FirstChild(const index_type& index) const {return (sizes[index] > 1) ? index + 1 : NONE;}
+        ///@fn NextSibling @return index_type The next child of index's parent, the next root for a root, or NONE
+        index_type NextSibling(const index_type& index) const {
+            const index_type next = index + sizes[index];
+            const index_type p = parents[index];
+            const index_type end = (p == NONE) ? (index_type)values.size() : p + sizes[p];
+            return (next < end) ? next : NONE;
+        }
+
+        ///@fn HandleOf @return handle_type A reference to the node at index that survives other nodes moving
+        handle_type HandleOf(const index_type& index) const {return handles[index];}
+        ///@fn IndexOf @return index_type Where the node of h is now, or NONE if it was erased
+        index_type IndexOf(const handle_type& h) const {return handle_index[h];}
+
+        //Traversal
+
+        ///@fn begin Every value in pre-order
+        typename std::vector<T>::iterator begin() {return values.begin();}
+        ///@fn end
+        typename std::vector<T>::iterator end() {return values.end();}
+        typename std::vector<T>::const_iterator begin() const {return values.begin();}
+        typename std::vector<T>::const_iterator end() const {return values.end();}
+
+        ///@fn PreOrder @return Range The values of the subtree rooted at index in pre-order, a contiguous slice
+        Range<T*> PreOrder(const index_type& index) {return Range<T*>{values.data() + index, values.data() + index + sizes[index]};}
+        Range<const T*> PreOrder(const index_type& index) const {return Range<const T*>{values.data() + index, values.data() + index + sizes[index]};}
+
+        /**
+         * @class IndexIterator
+         * @brief Steps through node indices, by Step::Next(tree, index) until NONE
+         */
+        template<class Step>
+        class IndexIterator {
+            protected:
+                const FlatTree<T>* tree;
+                index_type current;
+                index_type root;
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = index_type;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const index_type*;
+                using reference = const index_type&;
+
+                IndexIterator(const FlatTree<T>* tree, const index_type& current, const index_type& root) : tree(tree), current(current), root(root) {}
+                const index_type& operator*() const {return current;}
+                IndexIterator& operator++(){
+                    current = Step::Next(*tree, current, root);
+                    return *this;
+                }
+                IndexIterator operator++(int){
+                    IndexIterator ret = *this;
+                    ++(*this);
+                    return ret;
+                }
+                bool operator==(const IndexIterator& other) const {return current == other.current;}
+                bool operator!=(const IndexIterator& other) const {return current != other.current;}
+        };
+
+    protected:
+        index_type LeftmostLeaf(index_type index) const {
+            while(sizes[index] > 1){index++;}
+            return index;
+        }
+
+        struct ChildStep {
+            static index_type Next(const FlatTree<T>& t, const index_type& current, const index_type& parent){
+                const index_type next = current + t.sizes[current];
+                const index_type end = (parent == NONE) ? (index_type)t.values.size() : parent + t.sizes[parent];
+                return (next < end) ? next : NONE;
+            }
+        };
+        struct PostOrderStep {
+            static index_type Next(const FlatTree<T>& t, const index_type& current, const index_type& root){
+                if(current == root){return NONE;}
+                const index_type sibling = t.NextSibling(current);
+                if(sibling != NONE){return t.LeftmostLeaf(sibling);}
+                return t.parents[current];
+            }
+        };
+
+    public:
+        using ChildIterator = IndexIterator<ChildStep>;
+        using PostOrderIterator = IndexIterator<PostOrderStep>;
+
+        ///@fn Children @return Range The indices of index's children, or of every root if index is NONE
+        Range<ChildIterator> Children(const index_type& index) const {
+            const index_type first = (index == NONE) ? (values.empty() ? NONE : 0) : FirstChild(index);
+            return Range<ChildIterator>{ChildIterator(this, first, index), ChildIterator(this, NONE, index)};
+        }
+        ///@fn Roots @return Range The index of every root
+        Range<ChildIterator> Roots() const {return Children(NONE);}
+
+        /**
+         * @fn PostOrder
+         * @return Range The indices of the subtree rooted at index, or the whole forest if index is NONE,
+         * every node after all of its descendants.
+         */
+        Range<PostOrderIterator> PostOrder(const index_type& index = NONE) const {
+            const index_type first = (index == NONE) ? (values.empty() ? NONE : LeftmostLeaf(0)) : LeftmostLeaf(index);
+            return Range<PostOrderIterator>{PostOrderIterator(this, first, index), PostOrderIterator(this, NONE, index)};
+        }
+
+        /**
+         * @fn BreadthFirst
+         * @return std::vector<index_type> The indices of the subtree rooted at index, or the whole forest if index is NONE,
+         * level by level. Bucketing the pre-order range by depth keeps each level in left to right order.
+         * @param level_starts If not nullptr, set to where each level begins in the result, with a final entry for the end
+         */
+        std::vector<index_type> BreadthFirst(const index_type& index = NONE, std::vector<size_t>* level_starts = nullptr) const {
+            const index_type first = (index == NONE) ? 0 : index;
+            const index_type last = (index == NONE) ? (index_type)values.size() : index + sizes[index];
+            const index_type base = (index == NONE) ? 0 : depths[index];
+            std::vector<size_t> starts;
+            for(index_type k = first; k < last; k++){
+                const size_t level = depths[k] - base;
+                if(level + 2 > starts.size()){starts.resize(level + 2, 0);}
+                starts[level + 1]++;
+            }
+            for(size_t l = 1; l < starts.size(); l++){starts[l] += starts[l - 1];}
+            std::vector<index_type> order(last - first);
+            std::vector<size_t> cursor(starts);
+            for(index_type k = first; k < last; k++){order[cursor[depths[k] - base]++] = k;}
+            if(level_starts != nullptr){*level_starts = std::move(starts);}
+            return order;
+        }
+};
+
 }
 
 #endif
\ No newline at end of file
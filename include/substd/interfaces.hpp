@@ -2,33 +2,68 @@
  * @file
  * @author Kevin Hayes
  * @brief Various abstract class interfaces
- * @include list type_traits vec mat template graph
+ * @include cstdint list type_traits vec mat affine template graph registry
 */
 
 #ifndef SUBSTD_INTERFACES_HPP
 #define SUBSTD_INTERFACES_HPP
 
+#include<cstdint>
 #include<list>
 #include<type_traits>
 
 #include<substd/vec.hpp>
 #include<substd/mat.hpp>
+#include<substd/affine.hpp>
 #include<substd/template.hpp>
 #include<substd/graph.hpp>
+#include<substd/registry.hpp>
 
 namespace ss{
+namespace detail
+{
+
+//Storages with a handle_type register through Insert/Erase, any other through push_back/remove
+template<class storage, class = void>
+struct RegistryHandleOf {
+    struct type {};
+    static constexpr bool handles = false;
+};
+template<class storage>
+struct RegistryHandleOf<storage, std::void_t<typename storage::handle_type>> {
+    using type = typename storage::handle_type;
+    static constexpr bool handles = true;
+};
+
+}
+
 /**
  * @class IRegistered
  * @brief derived classes are registered upon creation and removed on destruction
  * 
  * @tparam self Must be the inheriting class.
- * @tparam storage The storage class used for the registry. Must have functions storage::push_back(self*) and storage::remove(self*) defined.
+ * @tparam storage The storage class used for the registry. Either has handle_type, handle_type Insert(self*) and
+ * Erase(handle_type) defined, as DenseRegistry and ShardedRegistry do, or storage::push_back(self*) and
+ * storage::remove(self*).
  * 
+ * @remark With the default DenseRegistry both are O(1), but nothing may be constructed or destroyed while the
+ * registry is iterated, or from more than one thread at a time; ShardedRegistry allows the latter.
 */
-template<class self, class storage=std::list<self*>>
+template<class self, class storage=DenseRegistry<self>>
 class IRegistered 
 {
-    CRTP_ASSERT(IRegistered, self);
+    using handle_type = typename detail::RegistryHandleOf<storage>::type;
+    static constexpr bool HAS_HANDLES = detail::RegistryHandleOf<storage>::handles;
+
+    handle_type registryHandle;
+
+    void Register(){
+        static_assert(std::is_base_of_v<IRegistered, self>, "CRTP ASSERT FAILURE");
+        //self is not constructed yet, so its address is taken without a static_cast
+        if constexpr(HAS_HANDLES) {registryHandle = registry.Insert(reinterpret_cast<self*>(this));}
+        else {registry.push_back(reinterpret_cast<self*>(this));}
+    }
+
 public:
     /**
      * @var storage registry
@@ -37,18 +72,23 @@ public:
     static storage registry;
     /**
      * @fn IRegistered
-     * @brief calls registry.push_back() on this object.
+     * @brief registers this object.
     */
-    IRegistered(){
-        registry.push_back(reinterpret_cast<self*>(this));
-    }
+    IRegistered(){Register();}
+    ///@brief A copy is a separate object, registered in its own right
+    IRegistered(const IRegistered&){Register();}
+    IRegistered& operator=(const IRegistered&){return *this;}
     /**
      * @fn ~IRegistered
-     * @brief calls registry.remove() on this object before deletion
+     * @brief removes this object from the registry before deletion
     */
     virtual ~IRegistered(){
-        registry.remove(reinterpret_cast<self*>(this));
+        if constexpr(HAS_HANDLES) {registry.Erase(registryHandle);}
+        else {registry.remove(reinterpret_cast<self*>(this));}
     }
+
+    ///@fn GetRegistryHandle @return The handle this object is registered under, when storage has them
+    const handle_type& GetRegistryHandle() const {return registryHandle;}
 };
 template<class self, class storage> storage IRegistered<self, storage>::registry;
 
@@ -62,17 +102,19 @@ template<class self, class storage> storage IRegistered<self, storage>::registry
 */
 template<class self>
 class IBindable {
-    CRTP_ASSERT(IBindable, self);
 private:
     static IBindable<self>* currently_active;
 public:
+    //self is only complete once its members are, so the CRTP check waits for construction
+    IBindable(){CRTP_ASSERT(IBindable, self);}
+
     /**
      * @fn SmartBind
      * @brief Calls Bind() only if this object is not the currently bound instance.
     */
     void SmartBind(){
         if(this != currently_active){
-            this = currently_active;
+            currently_active = this;
             Bind();
         }
     }
@@ -87,7 +129,7 @@ public:
      * @fn Bind
      * @brief Binds the object globally.
     */
-    void Bind() = 0;
+    virtual void Bind() = 0;
 
     /**
      * @fn GetCurrentlyBound
@@ -107,13 +149,14 @@ template<class self> IBindable<self>* IBindable<self>::currently_active = nullpt
 */
 template<class T>
 class IConstrainable{
-    static_assert(!std::is_fundamental_v<T>() || std::is_scalar_v<T>(), 
+    static_assert(!std::is_fundamental_v<T> || std::is_scalar_v<T>, 
         "ERROR: IConstrainable Requires Fundemental Types To Be Scalar!");
 private:
     T value;
 public:
-    IConstrainable(){value = EvalValue((T)0);}
-    IConstrainable(const T& t){value = EvalValue(t);}
+    //EvalValue cannot be called virtually until the derived class exists, so its constructors apply it
+    IConstrainable() : value((T)0) {}
+    IConstrainable(const T& t) : value(t) {}
 
     T GetValue(){return value;}
     void SetValue(const T& t){
@@ -152,7 +195,9 @@ public:
 template<typename T>
 class NoConstraint : IConstrainable<T> {
 public:
-    T EvalValue(const T& t) const override (return t;)
+    NoConstraint() {}
+    NoConstraint(const T& t) : IConstrainable<T>(t) {}
+    T EvalValue(const T& t) const override {return t;}
 };
 
 //Transform Interfaces
@@ -162,6 +207,8 @@ class IMatrixCalculable {
 public:
     virtual mat<T,dim+1> GetLocalMatrix() const = 0;
     virtual mat<T,dim+1> GetGlobalMatrix() const {return GetLocalMatrix();}
+    ///@fn GetLocalAffine The local matrix without its constant bottom row, override where that is cheaper to build directly
+    virtual affine<T,dim> GetLocalAffine() const {return affine<T,dim>(GetLocalMatrix());}
 };
 
 ///@class IPositionable
@@ -185,59 +232,100 @@ public:
 ///@class IPluggable
 template<typename T, size_t dim>
 class IPluggable : public virtual IPositionable<T,dim>, public virtual IScalable<T,dim> {
-    virtual mat<T,dim+1> GetPlugMatrix() const = 0;
+public:
+    ///@fn GetPlugMatrix The translation and per-axis scale as one affine transform
+    virtual affine<T,dim> GetPlugMatrix() const = 0;
 };
 
 ///@class IRotatable
 template<typename T, size_t dim>
 class IRotatable {
 public:
-    constexpr size_t NRP = (dim*(dim-1))/2; //Number Of Rotational Planes
+    static constexpr size_t NRP = (dim*(dim-1))/2; //Number Of Rotational Planes
 
     virtual vec<T,NRP> GetRotation() const = 0;
-    virtual mat<T,dim+1> GetRotationMatrix() const = 0;
+    ///@fn GetRotationMatrix A rotation has no translation, so only the dim x dim linear part is given
+    virtual mat<T,dim> GetRotationMatrix() const = 0;
     virtual void SetRotation(const vec<T,NRP>& val) = 0;
     virtual void SetRotation(const T& val, const size_t& index) = 0;
 };
 
 /**
  * @class IOrientatable
+ * @tparam RT The type angles are constrained through on their way in, such as modulo_tau<T>, or T itself
  */
 template<typename T, typename RT, size_t dim>
-class IOrientatable : public virtual IMatrixCalculable<T,dim>, public virtual IPluggable<T, dim>, public virtual IRotatable<RT, dim> {};
+class IOrientatable : public virtual IMatrixCalculable<T,dim>, public virtual IPluggable<T, dim>, public virtual IRotatable<T, dim> {};
+template<typename T, size_t dim>
+class TransformLevels;
+
 /**
  * @class ITransformable
+ * @brief A node in a hierarchy of transforms, whose global matrix is its parent's global matrix times its local one.
+ *
+ * The global matrix is cached and recalculated when read after this node or an ancestor has changed.
+ * Derived classes call FlagLocalChange() whenever their local matrix changes. To bring a whole hierarchy
+ * up to date at once, level by level across threads, see TransformLevels in transform_batch.hpp.
+ *
+ * Changes are tracked with version numbers rather than by flagging every descendant: FlagLocalChange()
+ * bumps this node's localVersion, and every recalculation bumps its globalVersion. A cached global matrix
+ * is current while the local and parent versions it was calculated from still match, so a change is O(1)
+ * and a read checks its ancestors, O(depth), recalculating only those that are out of date.
+ *
+ * Global matrices are kept and composed as affine<T,dim>, from each node's GetLocalAffine().
  */
 template<typename T, size_t dim>
-class ITransformable : public virtual IMatrixCalculable, public Tree<ITransformable> {
+class ITransformable : public virtual IMatrixCalculable<T,dim>, public Tree<ITransformable<T,dim>> {
+    friend class TransformLevels<T,dim>;
 protected:
-    bool parentHasChanged;
-    mat<T,dim+1> globalMatrix;
+    uint64_t localVersion;
+    ///@brief The versions globalMatrix was calculated from
+    mutable uint64_t seenLocalVersion;
+    mutable uint64_t seenParentVersion;
+    mutable uint64_t globalVersion;
+    mutable affine<T,dim> globalMatrix;
 
-    void CalculateGlobalMatrix() const {
-        globalMatrix = GetLocalMatrix() * GetParentMatrix();
-        parentHasChanged = false;
+    const ITransformable<T,dim>* GetParentTransform() const {
+        return static_cast<const ITransformable<T,dim>*>(this->GetParent());
     }
 
-    mat<T,dim+1> GetParentMatrix() const {
-        IMatrixCalculable* parent = reinterpret_cast<IMatrixCalculable*>(Tree<IMatrixCalculable>::GetParent());
-        if(parent != nullptr){
-            return parent->GetGlobalMatrix();
-        }
-        else{
-            return mat<T,dim+1>(1);
-        }
-    }
-    void NotifyChildren() {
-        for(auto iter = this->begin(); iter != this->end(); iter++){
-            (*(*ITransformable)iter).parentHasChanged = true;
-            (*(*ITransformable)iter).NotifyChildren();
+    ///@fn UpdateGlobalMatrix Brings globalMatrix up to date, ancestors first
+    void UpdateGlobalMatrix() const {
+        const ITransformable<T,dim>* parent = GetParentTransform();
+        if(parent != nullptr){parent->UpdateGlobalMatrix();}
+        const uint64_t parentVersion = (parent != nullptr) ? parent->globalVersion : 0;
+        if(seenLocalVersion != localVersion || seenParentVersion != parentVersion){
+            globalMatrix = (parent != nullptr) ? (parent->globalMatrix * this->GetLocalAffine()) : this->GetLocalAffine();
+            seenLocalVersion = localVersion;
+            seenParentVersion = parentVersion;
+            globalVersion++;
         }
     }
 
 public:
+    ITransformable(ITransformable<T,dim>* parent = nullptr) : Tree<ITransformable<T,dim>>(parent),
+        localVersion(1), seenLocalVersion(0), seenParentVersion(0), globalVersion(0), globalMatrix(1) {}
+
+    ///@fn FlagLocalChange Marks the global matrices of this node and every descendant as needing recalculation, in O(1)
+    void FlagLocalChange() {localVersion++;}
+
+    void TrimChild(Tree<ITransformable<T,dim>>* child) override {
+        Tree<ITransformable<T,dim>>::TrimChild(child);
+        static_cast<ITransformable<T,dim>*>(child)->FlagLocalChange();
+    }
+    void GiveChild(Tree<ITransformable<T,dim>>* other, Tree<ITransformable<T,dim>>* child) override {
+        Tree<ITransformable<T,dim>>::GiveChild(other, child);
+        //The new parent's version may happen to match the one seen from the old parent
+        if(other != nullptr && child != nullptr){static_cast<ITransformable<T,dim>*>(child)->FlagLocalChange();}
+    }
+
     virtual mat<T,dim+1> GetGlobalMatrix() const override {
-        if(parentHasChanged){CalculateGlobalMatrix();}
+        UpdateGlobalMatrix();
+        return globalMatrix.ToMatrix();
+    }
+    ///@fn GetGlobalAffine The global matrix as it is kept, without the constant bottom row
+    affine<T,dim> GetGlobalAffine() const {
+        UpdateGlobalMatrix();
         return globalMatrix;
     }
 };
@@ -1,114 +1,604 @@
-#ifndef SUBSTD_UTIL_HPP
-#define SUBSTD_UTIL_HPP
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Endian aware reading and writing of unsigned integers, from streams and through buffered ByteReader/ByteWriter.
+ * @include cstddef cstdint cstring algorithm iostream optional streambuf vector math endian codec
+*/
 
+#ifndef SUBSTD_IO_HPP
+#define SUBSTD_IO_HPP
+
+#include<cstddef>
+#include<cstdint>
+#include<cstring>
+#include<algorithm>
 #include<iostream>
-#include<stdint>
+#include<optional>
+#include<streambuf>
+#include<vector>
+
+#include<substd/math.hpp>
+#include<substd/endian.hpp>
+#include<substd/codec.hpp>
 
 namespace ss {
 
+#ifndef SS_BYTE_IO_BUFFER
+///@brief The default buffer size, in bytes, of a ByteReader or ByteWriter over a stream.
+#define SS_BYTE_IO_BUFFER 65536
+#endif
+
 ///Read
 
-///@fn GetNextU8
-uint8_t GetNextU8(std::istream& istr, std::ostream& err = std::cerr) {
-    if(istr.eof()){err<<"substd IO Error: Expected Atleast One More Byte But EOF Reached."<<std::endl; return 0;}
-    else{
-        return istr.get();
+//Every read moves a whole word at once. The GetNext* functions write a message to err and return 0
+//when the stream runs out, the TryGetNext* functions only return std::nullopt. Either way the stream's failbit
+//is set and stays set, so a record can be read without checking each value and istr.fail() checked once after.
+//For hot loops, ByteReader and MappedFile avoid the per call stream overhead and keep a sticky flag of their own.
+
+/**
+ * @fn TryGetNextBytes
+ * @brief Reads n bytes straight from the stream's buffer, without logging anything.
+ *
+ * Skips istream::read's sentry (which would flush a tied stream on every call), but honours and sets the
+ * stream's state the same way: nothing is read once the stream has failed, and a short read sets eofbit and failbit.
+ * @return bool False if fewer were available.
+ */
+inline bool TryGetNextBytes(std::istream& istr, void* dst, const size_t& n){
+    if(!istr.good() || istr.rdbuf() == nullptr){
+        istr.setstate(std::ios::failbit);
+        return false;
     }
+    if((size_t)istr.rdbuf()->sgetn(static_cast<char*>(dst), (std::streamsize)n) != n){
+        istr.setstate(std::ios::eofbit | std::ios::failbit);
+        return false;
+    }
+    return true;
+}
+
+///@fn ReportEOF Kept out of line so the logging never weighs on the inlined read paths
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((noinline, cold))
+#endif
+inline void ReportEOF(std::ostream& err, const size_t& n){
+    err<<"substd IO Error: Expected "<<n<<" More Bytes But EOF Reached."<<std::endl;
+}
+
+/**
+ * @fn GetNextBytes
+ * @brief Reads n bytes straight from the stream's buffer, as TryGetNextBytes does, logging to err on a short read.
+ * @return bool False if fewer were available.
+ */
+inline bool GetNextBytes(std::istream& istr, void* dst, const size_t& n, std::ostream& err = std::cerr){
+    if(TryGetNextBytes(istr, dst, n)){return true;}
+    ReportEOF(err, n);
+    return false;
+}
+
+///@fn TryGetNextBE @return std::optional<T> The next sizeof(T) bytes as a big endian T, or std::nullopt if there were not enough.
+template<typename T>
+inline std::optional<T> TryGetNextBE(std::istream& istr){
+    uint8_t bytes[sizeof(T)];
+    if(!TryGetNextBytes(istr, bytes, sizeof(T))){return std::nullopt;}
+    return LoadBE<T>(bytes);
+}
+///@fn TryGetNextLE @return std::optional<T> The next sizeof(T) bytes as a little endian T, or std::nullopt if there were not enough.
+template<typename T>
+inline std::optional<T> TryGetNextLE(std::istream& istr){
+    uint8_t bytes[sizeof(T)];
+    if(!TryGetNextBytes(istr, bytes, sizeof(T))){return std::nullopt;}
+    return LoadLE<T>(bytes);
+}
+
+///@fn TryGetNextU8
+inline std::optional<uint8_t> TryGetNextU8(std::istream& istr) {return TryGetNextBE<uint8_t>(istr);}
+///@fn TryGetNextBEU16
+inline std::optional<uint16_t> TryGetNextBEU16(std::istream& istr) {return TryGetNextBE<uint16_t>(istr);}
+///@fn TryGetNextBEU32
+inline std::optional<uint32_t> TryGetNextBEU32(std::istream& istr) {return TryGetNextBE<uint32_t>(istr);}
+///@fn TryGetNextBEU64
+inline std::optional<uint64_t> TryGetNextBEU64(std::istream& istr) {return TryGetNextBE<uint64_t>(istr);}
+///@fn TryGetNextLEU16
+inline std::optional<uint16_t> TryGetNextLEU16(std::istream& istr) {return TryGetNextLE<uint16_t>(istr);}
+///@fn TryGetNextLEU32
+inline std::optional<uint32_t> TryGetNextLEU32(std::istream& istr) {return TryGetNextLE<uint32_t>(istr);}
+///@fn TryGetNextLEU64
+inline std::optional<uint64_t> TryGetNextLEU64(std::istream& istr) {return TryGetNextLE<uint64_t>(istr);}
+
+///@fn GetNextU8
+inline uint8_t GetNextU8(std::istream& istr, std::ostream& err = std::cerr) {
+    const std::istream::int_type c = istr.get();
+    if(c == std::istream::traits_type::eof()){ReportEOF(err, 1); return 0;}
+    return (uint8_t)c;
 }
 
 //Big Endian
 
+///@fn GetNextBE @return T The next sizeof(T) bytes as a big endian T, or 0 if there were not enough.
+template<typename T>
+inline T GetNextBE(std::istream& istr, std::ostream& err = std::cerr){
+    uint8_t bytes[sizeof(T)];
+    if(!GetNextBytes(istr, bytes, sizeof(T), err)){return 0;}
+    return LoadBE<T>(bytes);
+}
+
 ///@fn GetNextBEU16
-uint16_t GetNextBEU16(std::istream& istr, std::ostream& err = std::cerr){
-    uint16_t u = ((uint16_t)GetNextU8(istr, err)) << 8;
-    u |= (uint16_t)GetNextU8(istr, err);
-    return u;   
+inline uint16_t GetNextBEU16(std::istream& istr, std::ostream& err = std::cerr){
+    return GetNextBE<uint16_t>(istr, err);
 }
 
 ///@fn GetNextBEU32
-uint32_t GetNextBEU32(std::istream& istr, std::ostream& err = std::cerr){
-    uint32_t u = ((uint32_t)GetNextBEU16(istr, err)) << 16;
-    u |= (uint32_t)GetNextBEU16(istr, err);
-    return u;
+inline uint32_t GetNextBEU32(std::istream& istr, std::ostream& err = std::cerr){
+    return GetNextBE<uint32_t>(istr, err);
 }
 
 ///@fn GetNextBEU64
-uint64_t GetNextBEU64(std::istream& istr, std::ostream& err = std::cerr){
-    uint64_t u = ((uint64_t)GetNextBEU32(istr, err)) << 32;
-    u |= (uint64_t)GetNextBEU32(istr, err);    
-    return u;
+inline uint64_t GetNextBEU64(std::istream& istr, std::ostream& err = std::cerr){
+    return GetNextBE<uint64_t>(istr, err);
 }
 
 //Little Endian
 
-///@fn GetNextLEU16
-uint16_t GetNextLEU16(std::istream& istr, std::ostream& err = std::cerr){
-    uint16_t u = (uint16_t)GetNextU8(istr);
-    u |= (((uint16_t)GetNextU8(istr)) << 8);
-    return u;
+///@fn GetNextLE @return T The next sizeof(T) bytes as a little endian T, or 0 if there were not enough.
+template<typename T>
+inline T GetNextLE(std::istream& istr, std::ostream& err = std::cerr){
+    uint8_t bytes[sizeof(T)];
+    if(!GetNextBytes(istr, bytes, sizeof(T), err)){return 0;}
+    return LoadLE<T>(bytes);
 }
 
 ///@fn GetNextLEU16
-uint32_t GetNextLEU32(std::istream& istr, std::ostream& err = std::cerr){
-    uint32_t u = (uint32_t)GetNextLEU16(istr);
-    u |= (((uint32_t)GetNextLEU16(istr)) << 16);
-    return u;
+inline uint16_t GetNextLEU16(std::istream& istr, std::ostream& err = std::cerr){
+    return GetNextLE<uint16_t>(istr, err);
 }
 
-///@fn GetNextLEU16
-uint64_t GetNextLEU64(std::istream& istr, std::ostream& err = std::cerr){
-    uint64_t u = (uint64_t)GetNextLEU32(istr);
-    u |= (((uint64_t)GetNextLEU32(istr)) << 32);
-    return u;
+///@fn GetNextLEU32
+inline uint32_t GetNextLEU32(std::istream& istr, std::ostream& err = std::cerr){
+    return GetNextLE<uint32_t>(istr, err);
+}
+
+///@fn GetNextLEU64
+inline uint64_t GetNextLEU64(std::istream& istr, std::ostream& err = std::cerr){
+    return GetNextLE<uint64_t>(istr, err);
 }
 
 ///Write
 
 ///@fn PutU8
-void PutU8(std::ostream& ostr, const uint8_t& i) {
-    ostr.write((char*)(&i), 1);
+inline void PutU8(std::ostream& ostr, const uint8_t& i) {
+    ostr.write((const char*)(&i), 1);
 }
 
 //Big Endian
 
+///@fn PutBE Writes i as sizeof(T) big endian bytes with a single ostream::write
+template<typename T>
+inline void PutBE(std::ostream& ostr, const T& i) {
+    uint8_t bytes[sizeof(T)];
+    StoreBE<T>(bytes, i);
+    ostr.write((const char*)bytes, sizeof(T));
+}
+
 ///@fn PutBEU16
-void PutBEU16(std::ostream& ostr, const uint16_t& i) {
-    PutU8(ostr, ((i&0xFF00)>>8));
-    PutU8(ostr, (i&0x00FF)); 
+inline void PutBEU16(std::ostream& ostr, const uint16_t& i) {
+    PutBE<uint16_t>(ostr, i);
 }
 
 ///@fn PutBEU32
-void PutBEU32(std::ostream& ostr, const uint32_t& i) {
-    PutBEU16(ostr, ((i&0xFFFF0000)>>16));
-    PutBEU16(ostr, (i&0x0000FFFF)); 
+inline void PutBEU32(std::ostream& ostr, const uint32_t& i) {
+    PutBE<uint32_t>(ostr, i);
 }
 
 ///@fn PutBEU64
-void PutBEU64(std::ostream& ostr, const uint64_t& i) {
-    PutBEU32(ostr, ((i&0xFFFFFFFF00000000)>>32));
-    PutBEU32(ostr, (i&0x00000000FFFFFFFF)); 
+inline void PutBEU64(std::ostream& ostr, const uint64_t& i) {
+    PutBE<uint64_t>(ostr, i);
 }
 
 //Little Endian
 
+///@fn PutLE Writes i as sizeof(T) little endian bytes with a single ostream::write
+template<typename T>
+inline void PutLE(std::ostream& ostr, const T& i) {
+    uint8_t bytes[sizeof(T)];
+    StoreLE<T>(bytes, i);
+    ostr.write((const char*)bytes, sizeof(T));
+}
+
 ///@fn PutLEU16
-void PutLEU16(std::ostream& ostr, const uint16_t& i) {
-    PutU8(ostr, (i&0x00FF)); 
-    PutU8(ostr, ((i&0xFF00)>>8));
+inline void PutLEU16(std::ostream& ostr, const uint16_t& i) {
+    PutLE<uint16_t>(ostr, i);
 }
 
 ///@fn PutLEU32
-void PutLEU32(std::ostream& ostr, const uint32_t& i) {
-    PutLEU16(ostr, (i&0x0000FFFF)); 
-    PutLEU16(ostr, ((i&0xFFFF0000)>>16));
+inline void PutLEU32(std::ostream& ostr, const uint32_t& i) {
+    PutLE<uint32_t>(ostr, i);
 }
 
 ///@fn PutLEU64
-void PutLEU64(std::ostream& ostr, const uint64_t& i) {
-    PutLEU32(ostr, (i&0x00000000FFFFFFFF)); 
-    PutLEU32(ostr, ((i&0xFFFFFFFF00000000)>>32));
+inline void PutLEU64(std::ostream& ostr, const uint64_t& i) {
+    PutLE<uint64_t>(ostr, i);
 }
 
+/**
+ * @class ByteReader
+ * @brief Decodes endian specific integers from a contiguous buffer, or from a std::streambuf through an internal buffer.
+ *
+ * Every read is a bounds check and an unaligned whole word load (byte swapped with a single instruction when
+ * the endianness differs from the host's), the stream is only touched when the buffer runs dry. Array reads copy
+ * straight into the destination and byte swap it in place a register at a time.
+ *
+ * Reading past the end returns 0 and sets a sticky failure flag, so a whole record can be read and Failed()
+ * checked once afterwards.
+ * @remark A reader over a stream buffers ahead, so the stream's position afterwards is unspecified.
+ */
+class ByteReader {
+protected:
+    std::streambuf* source = nullptr;
+    std::vector<uint8_t> storage;
+    const uint8_t* cur = nullptr;
+    const uint8_t* end = nullptr;
+    bool failed = false;
+
+    ///@fn Fill Makes at least n bytes available at cur, if the source has them. @return bool Whether it could
+    bool Fill(const size_t& n){
+        const size_t left = (size_t)(end - cur);
+        if(left >= n){return true;}
+        if(source == nullptr){return false;}
+        if(storage.size() < n){
+            std::vector<uint8_t> bigger(n);
+            if(left > 0){std::memcpy(bigger.data(), cur, left);}
+            storage.swap(bigger);
+        }
+        else if(left > 0){
+            std::memmove(storage.data(), cur, left);
+        }
+        size_t have = left;
+        while(have < n){
+            const std::streamsize got = source->sgetn((char*)storage.data() + have, (std::streamsize)(storage.size() - have));
+            if(got <= 0){break;}
+            have += (size_t)got;
+        }
+        cur = storage.data();
+        end = cur + have;
+        return have >= n;
+    }
+
+    template<typename T, bool big_endian>
+    T Read(){
+        if((size_t)(end - cur) >= sizeof(T) || Fill(sizeof(T))){
+            const T u = big_endian ? LoadBE<T>(cur) : LoadLE<T>(cur);
+            cur += sizeof(T);
+            return u;
+        }
+        failed = true;
+        cur = end;
+        return 0;
+    }
+
+    template<typename T, bool big_endian>
+    size_t ReadArray(T* out, const size_t& count){
+        const size_t n = ReadBytes(out, count * sizeof(T)) / sizeof(T);
+        if(big_endian){LoadBEArray<T>(out, out, n);}
+        else{LoadLEArray<T>(out, out, n);}
+        return n;
+    }
+
+    template<typename T>
+    T ReadVar(){
+        if((size_t)(end - cur) < MAX_VARINT_SIZE<T>){Fill(MAX_VARINT_SIZE<T>);}
+        T v;
+        const size_t n = DecodeVarint<T>(cur, end, v);
+        if(n == 0){
+            failed = true;
+            cur = end;
+            return 0;
+        }
+        cur += n;
+        return v;
+    }
+
+    template<typename T>
+    size_t ReadVarArray(T* out, const size_t& count){
+        size_t done = 0;
+        while(done < count){
+            size_t used;
+            done += DecodeVarintArray(cur, (size_t)(end - cur), out + done, count - done, used);
+            cur += used;
+            if(done == count){break;}
+            //Either the varint at cur is malformed, or it continues past what is buffered
+            const size_t left = (size_t)(end - cur);
+            if(left >= MAX_VARINT_SIZE<T> || !Fill(left + 1)){
+                failed = true;
+                break;
+            }
+        }
+        return done;
+    }
+
+public:
+    /**
+     * @brief Buffer Constructor, the buffer is read in place and must outlive the reader
+    */
+    ByteReader(const void* data, const size_t& size){
+        cur = static_cast<const uint8_t*>(data);
+        end = cur + size;
+    }
+    /**
+     * @brief Stream Constructor
+     * @param buffer_size Bytes requested from the stream at a time
+    */
+    ByteReader(std::streambuf& sb, const size_t& buffer_size = SS_BYTE_IO_BUFFER) : source(&sb), storage(Max<size_t>(buffer_size, 16)) {}
+    ByteReader(std::istream& istr, const size_t& buffer_size = SS_BYTE_IO_BUFFER) : ByteReader(*istr.rdbuf(), buffer_size) {}
+
+    ByteReader(const ByteReader&) = delete;
+    ByteReader& operator=(const ByteReader&) = delete;
+
+    ///@fn Failed @return bool Whether any read so far ran out of bytes
+    bool Failed() const {return failed;}
+    ///@fn Good
+    bool Good() const {return !failed;}
+    ///@fn AtEnd @return bool Whether every byte has been read
+    bool AtEnd() {return (cur == end) && !Fill(1);}
+
+    ///@fn ReadU8
+    uint8_t ReadU8() {return Read<uint8_t, true>();}
+    ///@fn ReadBEU16
+    uint16_t ReadBEU16() {return Read<uint16_t, true>();}
+    ///@fn ReadBEU32
+    uint32_t ReadBEU32() {return Read<uint32_t, true>();}
+    ///@fn ReadBEU64
+    uint64_t ReadBEU64() {return Read<uint64_t, true>();}
+    ///@fn ReadLEU16
+    uint16_t ReadLEU16() {return Read<uint16_t, false>();}
+    ///@fn ReadLEU32
+    uint32_t ReadLEU32() {return Read<uint32_t, false>();}
+    ///@fn ReadLEU64
+    uint64_t ReadLEU64() {return Read<uint64_t, false>();}
+
+    /**
+     * @fn ReadBytes
+     * @brief Copies the next n bytes to dst, large reads from a stream bypass the internal buffer.
+     * @return size_t The number of bytes copied, less than n only if the end was reached.
+     */
+    size_t ReadBytes(void* dst, const size_t& n){
+        uint8_t* out = static_cast<uint8_t*>(dst);
+        size_t done = Min<size_t>(n, (size_t)(end - cur));
+        if(done > 0){std::memcpy(out, cur, done);}
+        cur += done;
+        if(done < n && source != nullptr){
+            if(n - done >= storage.size()){
+                while(done < n){
+                    const std::streamsize got = source->sgetn((char*)out + done, (std::streamsize)(n - done));
+                    if(got <= 0){break;}
+                    done += (size_t)got;
+                }
+            }
+            else if(Fill(n - done) || cur != end){
+                const size_t more = Min<size_t>(n - done, (size_t)(end - cur));
+                std::memcpy(out + done, cur, more);
+                cur += more;
+                done += more;
+            }
+        }
+        if(done < n){failed = true;}
+        return done;
+    }
+
+    ///@fn Skip Discards the next n bytes @return bool Whether there were n bytes to discard
+    bool Skip(size_t n){
+        while(n > 0){
+            if(cur == end && !Fill(1)){
+                failed = true;
+                return false;
+            }
+            const size_t step = Min<size_t>(n, (size_t)(end - cur));
+            cur += step;
+            n -= step;
+        }
+        return true;
+    }
+
+    ///@fn ReadBEU16Array @return size_t The number of elements read into out
+    size_t ReadBEU16Array(uint16_t* out, const size_t& count) {return ReadArray<uint16_t, true>(out, count);}
+    ///@fn ReadBEU32Array @return size_t The number of elements read into out
+    size_t ReadBEU32Array(uint32_t* out, const size_t& count) {return ReadArray<uint32_t, true>(out, count);}
+    ///@fn ReadBEU64Array @return size_t The number of elements read into out
+    size_t ReadBEU64Array(uint64_t* out, const size_t& count) {return ReadArray<uint64_t, true>(out, count);}
+    ///@fn ReadLEU16Array @return size_t The number of elements read into out
+    size_t ReadLEU16Array(uint16_t* out, const size_t& count) {return ReadArray<uint16_t, false>(out, count);}
+    ///@fn ReadLEU32Array @return size_t The number of elements read into out
+    size_t ReadLEU32Array(uint32_t* out, const size_t& count) {return ReadArray<uint32_t, false>(out, count);}
+    ///@fn ReadLEU64Array @return size_t The number of elements read into out
+    size_t ReadLEU64Array(uint64_t* out, const size_t& count) {return ReadArray<uint64_t, false>(out, count);}
+
+    ///@fn ReadVarU32 Reads an LEB128 varint, a malformed one fails like running out
+    uint32_t ReadVarU32() {return ReadVar<uint32_t>();}
+    ///@fn ReadVarU64
+    uint64_t ReadVarU64() {return ReadVar<uint64_t>();}
+    ///@fn ReadVarS32 Reads a zigzag encoded varint
+    int32_t ReadVarS32() {return ZigZagDecode<uint32_t>(ReadVar<uint32_t>());}
+    ///@fn ReadVarS64
+    int64_t ReadVarS64() {return ZigZagDecode<uint64_t>(ReadVar<uint64_t>());}
+
+    ///@fn ReadVarU32Array Decodes count varints with DecodeVarintArray @return size_t The number of elements read into out
+    size_t ReadVarU32Array(uint32_t* out, const size_t& count) {return ReadVarArray<uint32_t>(out, count);}
+    ///@fn ReadVarU64Array @return size_t The number of elements read into out
+    size_t ReadVarU64Array(uint64_t* out, const size_t& count) {return ReadVarArray<uint64_t>(out, count);}
+};
+
+/**
+ * @class ByteWriter
+ * @brief Encodes endian specific integers into a std::vector, or into a std::streambuf through an internal buffer.
+ *
+ * A vector is appended to in place, grown geometrically and trimmed to the bytes written by Flush(),
+ * a stream is written a whole buffer at a time. The destructor flushes.
+ */
+class ByteWriter {
+protected:
+    std::streambuf* sink = nullptr;
+    std::vector<uint8_t>* target = nullptr;
+    std::vector<uint8_t> storage;
+    uint8_t* cur = nullptr;
+    uint8_t* end = nullptr;
+    bool failed = false;
+
+    ///@fn Drain Hands everything buffered to the sink, or trims the target to what has been written
+    void Drain(){
+        if(target != nullptr){
+            const size_t written = (size_t)(cur - target->data());
+            target->resize(written);
+            cur = target->data() + written;
+            end = cur;
+        }
+        else if(sink != nullptr){
+            const std::streamsize n = (std::streamsize)(cur - storage.data());
+            if(n > 0 && sink->sputn((const char*)storage.data(), n) != n){failed = true;}
+            cur = storage.data();
+            end = cur + storage.size();
+        }
+    }
+
+    ///@fn Reserve Makes room for at least n bytes at cur, n must not exceed the buffer size when writing to a stream
+    void Reserve(const size_t& n){
+        if((size_t)(end - cur) >= n){return;}
+        if(target != nullptr){
+            const size_t written = (size_t)(cur - target->data());
+            target->resize(Max<size_t>(Max<size_t>(target->size() * 2, written + n), 64));
+            cur = target->data() + written;
+            end = target->data() + target->size();
+        }
+        else{
+            Drain();
+        }
+    }
+
+    template<typename T, bool big_endian>
+    void Write(const T& u){
+        Reserve(sizeof(T));
+        if(big_endian){StoreBE<T>(cur, u);}
+        else{StoreLE<T>(cur, u);}
+        cur += sizeof(T);
+    }
+
+    template<typename T, bool big_endian>
+    void WriteArray(const T* in, size_t count){
+        //Whole elements per step, at most a buffer's worth when writing to a stream
+        const size_t step = (target != nullptr) ? count : Max<size_t>(storage.size() / sizeof(T), 1);
+        while(count > 0){
+            const size_t n = Min(count, step);
+            Reserve(n * sizeof(T));
+            if(big_endian){StoreBEArray<T>(cur, in, n);}
+            else{StoreLEArray<T>(cur, in, n);}
+            cur += n * sizeof(T);
+            in += n;
+            count -= n;
+        }
+    }
+
+    template<typename T>
+    void WriteVar(const T& u){
+        Reserve(MAX_VARINT_SIZE<T>);
+        cur += EncodeVarint<T>(u, cur);
+    }
+
+    template<typename T>
+    void WriteVarArray(const T* in, size_t count){
+        const size_t step = (target != nullptr) ? count : Max<size_t>(storage.size() / MAX_VARINT_SIZE<T>, 1);
+        while(count > 0){
+            const size_t n = Min(count, step);
+            Reserve(n * MAX_VARINT_SIZE<T>);
+            cur += EncodeVarintArray<T>(in, n, cur);
+            in += n;
+            count -= n;
+        }
+    }
+
+public:
+    /**
+     * @brief Vector Constructor, bytes are appended to out, which must outlive the writer
+    */
+    ByteWriter(std::vector<uint8_t>& out) : target(&out) {
+        cur = target->data() + target->size();
+        end = cur;
+    }
+    /**
+     * @brief Stream Constructor
+     * @param buffer_size Bytes handed to the stream at a time
+    */
+    ByteWriter(std::streambuf& sb, const size_t& buffer_size = SS_BYTE_IO_BUFFER) : sink(&sb), storage(Max<size_t>(buffer_size, 16)) {
+        cur = storage.data();
+        end = cur + storage.size();
+    }
+    ByteWriter(std::ostream& ostr, const size_t& buffer_size = SS_BYTE_IO_BUFFER) : ByteWriter(*ostr.rdbuf(), buffer_size) {}
+
+    ByteWriter(const ByteWriter&) = delete;
+    ByteWriter& operator=(const ByteWriter&) = delete;
+
+    ~ByteWriter(){
+        Drain();
+    }
+
+    /**
+     * @fn Flush
+     * @brief Writes everything buffered to the stream and syncs it, or trims the vector to the bytes written.
+     * @return bool False if the stream refused any bytes so far.
+     */
+    bool Flush(){
+        Drain();
+        if(sink != nullptr && sink->pubsync() != 0){failed = true;}
+        return !failed;
+    }
+
+    ///@fn Failed @return bool Whether the stream refused any bytes so far
+    bool Failed() const {return failed;}
+
+    ///@fn WriteU8
+    void WriteU8(const uint8_t& u) {Write<uint8_t, true>(u);}
+    ///@fn WriteBEU16
+    void WriteBEU16(const uint16_t& u) {Write<uint16_t, true>(u);}
+    ///@fn WriteBEU32
+    void WriteBEU32(const uint32_t& u) {Write<uint32_t, true>(u);}
+    ///@fn WriteBEU64
+    void WriteBEU64(const uint64_t& u) {Write<uint64_t, true>(u);}
+    ///@fn WriteLEU16
+    void WriteLEU16(const uint16_t& u) {Write<uint16_t, false>(u);}
+    ///@fn WriteLEU32
+    void WriteLEU32(const uint32_t& u) {Write<uint32_t, false>(u);}
+    ///@fn WriteLEU64
+    void WriteLEU64(const uint64_t& u) {Write<uint64_t, false>(u);}
+
+    ///@fn WriteBytes
+    void WriteBytes(const void* src, const size_t& n){
+        WriteArray<uint8_t, true>(static_cast<const uint8_t*>(src), n);
+    }
+
+    ///@fn WriteBEU16Array
+    void WriteBEU16Array(const uint16_t* in, const size_t& count) {WriteArray<uint16_t, true>(in, count);}
+    ///@fn WriteBEU32Array
+    void WriteBEU32Array(const uint32_t* in, const size_t& count) {WriteArray<uint32_t, true>(in, count);}
+    ///@fn WriteBEU64Array
+    void WriteBEU64Array(const uint64_t* in, const size_t& count) {WriteArray<uint64_t, true>(in, count);}
+    ///@fn WriteLEU16Array
+    void WriteLEU16Array(const uint16_t* in, const size_t& count) {WriteArray<uint16_t, false>(in, count);}
+    ///@fn WriteLEU32Array
+    void WriteLEU32Array(const uint32_t* in, const size_t& count) {WriteArray<uint32_t, false>(in, count);}
+    ///@fn WriteLEU64Array
+    void WriteLEU64Array(const uint64_t* in, const size_t& count) {WriteArray<uint64_t, false>(in, count);}
+
+    ///@fn WriteVarU32 Writes an LEB128 varint
+    void WriteVarU32(const uint32_t& u) {WriteVar<uint32_t>(u);}
+    ///@fn WriteVarU64
+    void WriteVarU64(const uint64_t& u) {WriteVar<uint64_t>(u);}
+    ///@fn WriteVarS32 Writes a zigzag encoded varint
+    void WriteVarS32(const int32_t& i) {WriteVar<uint32_t>(ZigZagEncode<int32_t>(i));}
+    ///@fn WriteVarS64
+    void WriteVarS64(const int64_t& i) {WriteVar<uint64_t>(ZigZagEncode<int64_t>(i));}
+
+    ///@fn WriteVarU32Array
+    void WriteVarU32Array(const uint32_t* in, const size_t& count) {WriteVarArray<uint32_t>(in, count);}
+    ///@fn WriteVarU64Array
+    void WriteVarU64Array(const uint64_t* in, const size_t& count) {WriteVarArray<uint64_t>(in, count);}
+};
+
 }
 
-#endif
\ No newline at end of file
+#endif // SUBSTD_IO_HPP
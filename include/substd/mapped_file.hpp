@@ -0,0 +1,374 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Read only memory mapped files with an endian aware cursor and lazily decoded array views.
+ * @include cstddef cstdint fstream string utility vector math endian
+*/
+
+#ifndef SUBSTD_MAPPED_FILE_HPP
+#define SUBSTD_MAPPED_FILE_HPP
+
+#include<cstddef>
+#include<cstdint>
+#include<fstream>
+#include<string>
+#include<utility>
+#include<vector>
+
+#include<substd/math.hpp>
+#include<substd/endian.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SS_HAS_MMAP 1
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#endif
+
+namespace ss
+{
+
+/**
+ * @class EndianArrayView
+ * @brief count Ts stored with the given byte order at bytes, decoded one element at a time on access.
+ *
+ * Nothing is copied or decoded up front, so a view over a mapping only touches the pages whose elements are read.
+ * The bytes need not be aligned and must outlive the view.
+ */
+template<typename T, bool big_endian>
+class EndianArrayView {
+protected:
+    const uint8_t* bytes = nullptr;
+    size_t count = 0;
+
+public:
+    class const_iterator {
+    protected:
+        const uint8_t* p;
+    public:
+        const_iterator(const uint8_t* p) : p(p) {}
+        T operator*() const {return big_endian ? LoadBE<T>(p) : LoadLE<T>(p);}
+        const_iterator& operator++() {p += sizeof(T); return *this;}
+        bool operator==(const const_iterator& other) const {return p == other.p;}
+        bool operator!=(const const_iterator& other) const {return p != other.p;}
+    };
+
+    /**
+     * @brief Default Constructor, an empty view
+    */
+    EndianArrayView(){}
+    /**
+     * @brief Bytes Constructor
+    */
+    EndianArrayView(const void* bytes, const size_t& count) : bytes(static_cast<const uint8_t*>(bytes)), count(count) {}
+
+    ///@fn size
+    size_t size() const {return count;}
+    ///@fn empty
+    bool empty() const {return count == 0;}
+    ///@fn Bytes @return const uint8_t* The undecoded storage
+    const uint8_t* Bytes() const {return bytes;}
+
+    ///@fn operator[] @return T Element i, decoded
+    T operator[](const size_t& i) const {
+        const uint8_t* p = bytes + (i * sizeof(T));
+        return big_endian ? LoadBE<T>(p) : LoadLE<T>(p);
+    }
+
+    ///@fn CopyTo Decodes every element into out, a register at a time
+    void CopyTo(T* out) const {
+        if(big_endian){LoadBEArray<T>(bytes, out, count);}
+        else{LoadLEArray<T>(bytes, out, count);}
+    }
+    ///@fn ToVector
+    std::vector<T> ToVector() const {
+        std::vector<T> ret(count);
+        CopyTo(ret.data());
+        return ret;
+    }
+
+    const_iterator begin() const {return const_iterator(bytes);}
+    const_iterator end() const {return const_iterator(bytes + (count * sizeof(T)));}
+};
+
+template<typename T>
+using BEArrayView = EndianArrayView<T, true>;
+template<typename T>
+using LEArrayView = EndianArrayView<T, false>;
+
+/**
+ * @class MappedFile
+ * @brief A whole file mapped read only, with a cursor speaking the GetNext / Peek vocabulary of io.hpp.
+ *
+ * Opening costs the same regardless of the file's size, pages are read by the OS as they are first touched,
+ * and every read decodes straight from the mapping without copying. Where mmap is unavailable the file is
+ * read into memory instead, behind the same interface.
+ *
+ * Reading past the end returns 0 (or an empty view) and sets a sticky failure flag, as ByteReader does.
+ */
+class MappedFile {
+public:
+    ///@enum Access Hints about how the mapping will be read, passed on to madvise
+    enum class Access {
+        Normal,
+        Sequential,
+        Random,
+        WillNeed
+    };
+
+protected:
+    const uint8_t* data = nullptr;
+    size_t length = 0;
+    size_t cursor = 0;
+    bool open = false;
+    bool mapped = false;
+    bool failed = false;
+    std::vector<uint8_t> fallback;
+
+    ///@fn Take @return const uint8_t* The next n bytes, advancing the cursor, or nullptr if there are fewer
+    const uint8_t* Take(const size_t& n){
+        if(length - cursor < n){
+            failed = true;
+            cursor = length;
+            return nullptr;
+        }
+        const uint8_t* p = data + cursor;
+        cursor += n;
+        return p;
+    }
+
+    ///@fn TakeArray @return const uint8_t* The next count Ts, as Take, with count checked first so its size cannot wrap
+    template<typename T>
+    const uint8_t* TakeArray(const size_t& count){
+        if(count > (length - cursor) / sizeof(T)){
+            failed = true;
+            cursor = length;
+            return nullptr;
+        }
+        return Take(count * sizeof(T));
+    }
+
+    template<typename T, bool big_endian>
+    T GetNext(){
+        const uint8_t* p = Take(sizeof(T));
+        if(p == nullptr){return 0;}
+        return big_endian ? LoadBE<T>(p) : LoadLE<T>(p);
+    }
+    template<typename T, bool big_endian>
+    T Peek() const {
+        if(length - cursor < sizeof(T)){return 0;}
+        return big_endian ? LoadBE<T>(data + cursor) : LoadLE<T>(data + cursor);
+    }
+
+public:
+    /**
+     * @brief Default Constructor, no file is open
+    */
+    MappedFile(){}
+    /**
+     * @brief Path Constructor, check IsOpen() afterwards
+    */
+    MappedFile(const std::string& path, const Access& hint = Access::Normal){
+        Open(path, hint);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other){
+        *this = std::move(other);
+    }
+    MappedFile& operator=(MappedFile&& other){
+        if(this == &other){return *this;}
+        Close();
+        data = other.data;
+        length = other.length;
+        cursor = other.cursor;
+        open = other.open;
+        mapped = other.mapped;
+        failed = other.failed;
+        fallback = std::move(other.fallback);
+        if(!mapped){data = fallback.data();}
+        other.data = nullptr;
+        other.length = 0;
+        other.cursor = 0;
+        other.open = false;
+        other.mapped = false;
+        return *this;
+    }
+    ~MappedFile(){
+        Close();
+    }
+
+    /**
+     * @fn Open
+     * @brief Maps the file at path, closing any file already open.
+     * @return bool Whether the file could be opened, an empty file opens with Size() 0.
+     */
+    bool Open(const std::string& path, const Access& hint = Access::Normal){
+        Close();
+#if defined(SS_HAS_MMAP)
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0){return false;}
+        struct stat info;
+        if(::fstat(fd, &info) != 0){
+            ::close(fd);
+            return false;
+        }
+        length = (size_t)info.st_size;
+        if(length > 0){
+            void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(p == MAP_FAILED){
+                ::close(fd);
+                length = 0;
+                return false;
+            }
+            data = static_cast<const uint8_t*>(p);
+            mapped = true;
+        }
+        //The mapping keeps the file referenced on its own
+        ::close(fd);
+        open = true;
+        Advise(hint);
+        return true;
+#else
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if(!file){return false;}
+        fallback.resize((size_t)file.tellg());
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(fallback.data()), (std::streamsize)fallback.size());
+        data = fallback.data();
+        length = fallback.size();
+        open = true;
+        return true;
+#endif
+    }
+
+    ///@fn Close Unmaps the file, if one is open
+    void Close(){
+#if defined(SS_HAS_MMAP)
+        if(mapped){::munmap(const_cast<uint8_t*>(data), length);}
+#endif
+        fallback.clear();
+        data = nullptr;
+        length = 0;
+        cursor = 0;
+        open = false;
+        mapped = false;
+        failed = false;
+    }
+
+    /**
+     * @fn Advise
+     * @brief Passes hint on to the OS for the bytes [offset, offset + size), by default the whole file.
+     * @remark Does nothing where mmap is unavailable.
+     */
+    void Advise(const Access& hint, size_t offset = 0, size_t size = (size_t)-1) const {
+#if defined(SS_HAS_MMAP)
+        if(!mapped || offset >= length){return;}
+        size = Min(size, length - offset);
+        //madvise needs a page aligned start
+        const size_t page = (size_t)::sysconf(_SC_PAGESIZE);
+        const size_t aligned = offset - (offset % page);
+        size += offset - aligned;
+        int advice = MADV_NORMAL;
+        switch(hint){
+            case Access::Sequential: advice = MADV_SEQUENTIAL; break;
+            case Access::Random: advice = MADV_RANDOM; break;
+            case Access::WillNeed: advice = MADV_WILLNEED; break;
+            default: break;
+        }
+        ::madvise(const_cast<uint8_t*>(data) + aligned, size, advice);
+#endif
+    }
+
+    ///@fn IsOpen
+    bool IsOpen() const {return open;}
+    ///@fn Data @return const uint8_t* The whole file
+    const uint8_t* Data() const {return data;}
+    ///@fn Size @return size_t The size of the whole file in bytes
+    size_t Size() const {return length;}
+
+    //Cursor
+
+    ///@fn Tell @return size_t The cursor's offset from the start of the file
+    size_t Tell() const {return cursor;}
+    ///@fn Seek @return bool Whether offset is within the file, the cursor is left unchanged if not
+    bool Seek(const size_t& offset){
+        if(offset > length){return false;}
+        cursor = offset;
+        return true;
+    }
+    ///@fn Skip Advances the cursor n bytes @return bool Whether there were n bytes to skip
+    bool Skip(const size_t& n){return Take(n) != nullptr;}
+    ///@fn Remaining @return size_t Bytes between the cursor and the end of the file
+    size_t Remaining() const {return length - cursor;}
+    ///@fn AtEnd
+    bool AtEnd() const {return cursor == length;}
+    ///@fn Failed @return bool Whether any read so far ran past the end
+    bool Failed() const {return failed;}
+    ///@fn Good
+    bool Good() const {return !failed;}
+
+    ///@fn GetNextU8
+    uint8_t GetNextU8() {return GetNext<uint8_t, true>();}
+    ///@fn GetNextBEU16
+    uint16_t GetNextBEU16() {return GetNext<uint16_t, true>();}
+    ///@fn GetNextBEU32
+    uint32_t GetNextBEU32() {return GetNext<uint32_t, true>();}
+    ///@fn GetNextBEU64
+    uint64_t GetNextBEU64() {return GetNext<uint64_t, true>();}
+    ///@fn GetNextLEU16
+    uint16_t GetNextLEU16() {return GetNext<uint16_t, false>();}
+    ///@fn GetNextLEU32
+    uint32_t GetNextLEU32() {return GetNext<uint32_t, false>();}
+    ///@fn GetNextLEU64
+    uint64_t GetNextLEU64() {return GetNext<uint64_t, false>();}
+
+    ///@fn PeekU8 @return uint8_t The byte at the cursor without advancing, 0 at the end
+    uint8_t PeekU8() const {return Peek<uint8_t, true>();}
+    ///@fn PeekBEU16
+    uint16_t PeekBEU16() const {return Peek<uint16_t, true>();}
+    ///@fn PeekBEU32
+    uint32_t PeekBEU32() const {return Peek<uint32_t, true>();}
+    ///@fn PeekBEU64
+    uint64_t PeekBEU64() const {return Peek<uint64_t, true>();}
+    ///@fn PeekLEU16
+    uint16_t PeekLEU16() const {return Peek<uint16_t, false>();}
+    ///@fn PeekLEU32
+    uint32_t PeekLEU32() const {return Peek<uint32_t, false>();}
+    ///@fn PeekLEU64
+    uint64_t PeekLEU64() const {return Peek<uint64_t, false>();}
+
+    ///@fn GetNextBytes @return const uint8_t* The next n bytes in place, advancing the cursor, or nullptr if there are fewer
+    const uint8_t* GetNextBytes(const size_t& n) {return Take(n);}
+
+    ///@fn GetNextBEArray @return BEArrayView<T> A view of the next count big endian Ts, advancing the cursor past them
+    template<typename T>
+    BEArrayView<T> GetNextBEArray(const size_t& count){
+        const uint8_t* p = TakeArray<T>(count);
+        return (p == nullptr) ? BEArrayView<T>() : BEArrayView<T>(p, count);
+    }
+    ///@fn GetNextLEArray @return LEArrayView<T> A view of the next count little endian Ts, advancing the cursor past them
+    template<typename T>
+    LEArrayView<T> GetNextLEArray(const size_t& count){
+        const uint8_t* p = TakeArray<T>(count);
+        return (p == nullptr) ? LEArrayView<T>() : LEArrayView<T>(p, count);
+    }
+    ///@fn BEArrayAt @return BEArrayView<T> A view of count big endian Ts at offset, empty if they run past the end
+    template<typename T>
+    BEArrayView<T> BEArrayAt(const size_t& offset, const size_t& count) const {
+        if(offset > length || (length - offset) / sizeof(T) < count){return BEArrayView<T>();}
+        return BEArrayView<T>(data + offset, count);
+    }
+    ///@fn LEArrayAt @return LEArrayView<T> A view of count little endian Ts at offset, empty if they run past the end
+    template<typename T>
+    LEArrayView<T> LEArrayAt(const size_t& offset, const size_t& count) const {
+        if(offset > length || (length - offset) / sizeof(T) < count){return LEArrayView<T>();}
+        return LEArrayView<T>(data + offset, count);
+    }
+};
+
+}
+
+#endif // SUBSTD_MAPPED_FILE_HPP
@@ -2,14 +2,72 @@
 #define SUBSTD_MAT_HPP
 
 #include<algorithm>
-#include<functional>
+#include<string>
+#include<string_view>
+#include<utility>
 
 #include<substd/math.hpp>
 #include<substd/vec.hpp>
+#include<substd/simd.hpp>
+#include<substd/format.hpp>
 
 namespace ss
 {
 
+#ifndef SS_MAT_PRODUCT_BLOCK
+#define SS_MAT_PRODUCT_BLOCK 64
+#endif
+
+/**
+ * @fn MatrixProduct
+ * @brief out(r x c) = a(r x k) * b(k x c), all three column major and contiguous.
+ *
+ * Uses a simd::matmul_kernel when one exists for the shape, otherwise accumulates whole columns
+ * of a scaled by elements of b (so the innermost loop is contiguous and vectorizable), tiled into
+ * SS_MAT_PRODUCT_BLOCK sized blocks once any dimension exceeds it.
+ *
+ * @remark out must not alias a or b.
+ */
+template<typename T, typename OT, size_t r, size_t k, size_t c>
+void MatrixProduct(const T* a, const OT* b, T* out){
+    if constexpr(std::is_same_v<T, OT> && simd::matmul_kernel<T, r, k, c>::enabled) {
+        simd::matmul_kernel<T, r, k, c>::Mul(a, b, out);
+    }
+    else if constexpr(r <= SS_MAT_PRODUCT_BLOCK && k <= SS_MAT_PRODUCT_BLOCK && c <= SS_MAT_PRODUCT_BLOCK) {
+        for(size_t col = 0; col < c; col++){
+            T* out_col = out + (col*r);
+            const OT* b_col = b + (col*k);
+            for(size_t row = 0; row < r; row++){out_col[row] = a[row] * b_col[0];}
+            for(size_t p = 1; p < k; p++){
+                const T* a_col = a + (p*r);
+                const T scale = (T)b_col[p];
+                for(size_t row = 0; row < r; row++){out_col[row] += a_col[row] * scale;}
+            }
+        }
+    }
+    else {
+        constexpr size_t block = SS_MAT_PRODUCT_BLOCK;
+        std::fill(out, out + (r*c), T(0));
+        for(size_t col_block = 0; col_block < c; col_block += block){
+            const size_t col_end = Min(col_block + block, c);
+            for(size_t p_block = 0; p_block < k; p_block += block){
+                const size_t p_end = Min(p_block + block, k);
+                for(size_t row_block = 0; row_block < r; row_block += block){
+                    const size_t row_end = Min(row_block + block, r);
+                    for(size_t col = col_block; col < col_end; col++){
+                        T* out_col = out + (col*r);
+                        for(size_t p = p_block; p < p_end; p++){
+                            const T* a_col = a + (p*r);
+                            const T scale = (T)b[(col*k) + p];
+                            for(size_t row = row_block; row < row_end; row++){out_col[row] += a_col[row] * scale;}
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
 /**
  * @class mat
  * 
@@ -17,8 +75,16 @@ namespace ss
  * @tparam r number of matrix rows
  * @tparam c number of matrix columns
  */
+template<typename T, size_t r, size_t c>
+class mat;
+
+template<typename T, size_t r, size_t c>
+void AppendTo(std::string& s, const mat<T, r, c>& m, const Format& f = Format::Mat());
+
 template<typename T, size_t r, size_t c = r>
 class mat : public std::array<ss::vec<T,r>,c> {
+    static_assert(sizeof(std::array<ss::vec<T,r>,c>) == sizeof(T)*r*c, "ss::mat<> requires its columns to be stored without padding");
+    template<typename OT, size_t Or, size_t Oc> friend class mat;
 protected:
     using M = mat<T, r, c>;
     using Col = vec<T, r>;
@@ -37,6 +103,10 @@ protected:
         return vec<Col,c>(((std::array<Col, c>)*this));
     };
 
+    ///@brief Column major view of every element, columns are stored back to back without padding.
+    T* Elements() {return this->front().data();}
+    const T* Elements() const {return this->front().data();}
+
 public:
     /**
      * @brief Default Constructor
@@ -62,41 +132,53 @@ public:
 
     ///@fn Sum
     template<typename OT, size_t Or, size_t Oc>
-    M Sum(const mat<OT, Or, Oc>& other) const;
+    M Sum(const mat<OT, Or, Oc>& other) const {M ret(*this); ret.Add(other); return ret;}
     ///@fn Dif
     template<typename OT, size_t Or, size_t Oc>
-    M Dif(const mat<OT, Or, Oc>& other) const;
+    M Dif(const mat<OT, Or, Oc>& other) const {M ret(*this); ret.Sub(other); return ret;}
     ///@fn Prod
     template<typename S>
-    M Prod(const S& scalar) const;
+    M Prod(const S& scalar) const {M ret(*this); ret.Mul(scalar); return ret;}
     ///@fn Quot
     template<typename S>
-    M Quot(const S& scalar) const;
+    M Quot(const S& scalar) const {M ret(*this); ret.Div(scalar); return ret;}
     ///@fn LeftProd
     template<typename S>
-    M LeftProd(const S& scalar) const;
+    M LeftProd(const S& scalar) const {M ret(*this); ret.LeftMul(scalar); return ret;}
     ///@fn LeftQuot
     template<typename S>
-    M LeftQuot(const S& scalar) const;
+    M LeftQuot(const S& scalar) const {M ret(*this); ret.LeftDiv(scalar); return ret;}
     
     ///@fn Add
     template<typename OT, size_t Or, size_t Oc>
-    void Add(const mat<OT, Or, Oc>& other);
+    void Add(const mat<OT, Or, Oc>& other) {
+        for(size_t col = 0; col < c && col < Oc; col++){this->at(col).Add(other[col]);}
+    }
     ///@fn Sub
     template<typename OT, size_t Or, size_t Oc>
-    void Sub(const mat<OT, Or, Oc>& other);
+    void Sub(const mat<OT, Or, Oc>& other) {
+        for(size_t col = 0; col < c && col < Oc; col++){this->at(col).Sub(other[col]);}
+    }
     ///@fn Mul
     template<typename S>
-    void Mul(const S& scalar);
+    void Mul(const S& scalar) {
+        for(size_t col = 0; col < c; col++){this->at(col).Mul(scalar);}
+    }
     ///@fn Div
     template<typename S>
-    void Div(const S& scalar);
+    void Div(const S& scalar) {
+        for(size_t col = 0; col < c; col++){this->at(col).Div(scalar);}
+    }
     ///@fn LeftMul
     template<typename S>
-    void LeftMul(const S& scalar);
+    void LeftMul(const S& scalar) {
+        for(size_t col = 0; col < c; col++){this->at(col).LeftMul(scalar);}
+    }
     ///@fn LeftDiv
     template<typename S>
-    void LeftDiv(const S& scalar);
+    void LeftDiv(const S& scalar) {
+        for(size_t col = 0; col < c; col++){this->at(col).LeftDiv(scalar);}
+    }
     
     /**
      * @fn GetRow
@@ -126,29 +208,258 @@ public:
         return this->at(index);
     }
 
-    ///@fn MatProd
+    /**
+     * @fn MatProd
+     * @return mat<T,r,Oc> The product (this * other), other must have as many rows as this has columns.
+     */
     template<typename OT, size_t Or, size_t Oc>
-    M MatProd(const mat<OT, Or, Oc>& other) const {
-        M ret;
-        for(size_t col = 0; col < c; col++){
-            for(size_t row = 0; row < r; row++){
-                ret[col][row] = this->GetRow(row).Dot(other[col]);
-            }
-        }
+    mat<T, r, Oc> MatProd(const mat<OT, Or, Oc>& other) const {
+        static_assert(Or == c, "ss::mat<>::MatProd() requires the other matrix to have as many rows as this has columns");
+        mat<T, r, Oc> ret;
+        MatrixProduct<T, OT, r, c, Oc>(Elements(), other.Elements(), ret.Elements());
         return ret;
     }
     ///@fn MatMul
     template<typename OT, size_t Or, size_t Oc>
     void MatMul(const mat<OT, Or, Oc>& other) {
-        M prod = MatProd(other);
-        for(size_t col = 0; col < c; col++){
-            this->at(col) = other->at(col);
-        }
+        static_assert(Oc == c, "ss::mat<>::MatMul() requires a square right hand side so the shape of this matrix is unchanged");
+        *this = MatProd(other);
     }
-    ///@fn VecProd
+    /**
+     * @fn VecProd
+     * @return Col The product (this * v), accumulated a column at a time straight from the matrix storage.
+     * @remark To transform many vectors by the same matrix see mat_batch.hpp.
+     */
     template<typename OT, size_t Odim>
     Col VecProd(const vec<OT, Odim>& v) const {
-        return AsVecOfVec().Dot(v);
+        Col ret(0);
+        for(size_t col = 0; col < c && col < Odim; col++){
+            const T scale = (T)v[col];
+            const Col& column = (*this)[col];
+            for(size_t row = 0; row < r; row++){
+                ret[row] += column[row] * scale;
+            }
+        }
+        return ret;
+    }
+
+    ///@fn Transpose
+    mat<T, c, r> Transpose() const {
+        mat<T, c, r> ret;
+        for(size_t col = 0; col < c; col++){
+            for(size_t row = 0; row < r; row++){
+                ret[row][col] = (*this)[col][row];
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * @fn Determinant
+     * @remark Closed form for 2x2, 3x3 and 4x4, LU decomposition with partial pivoting otherwise.
+     */
+    T Determinant() const {
+        static_assert(r == c, "ss::mat<>::Determinant() requires a square matrix");
+        const M& m = *this;
+        if constexpr(r == 1) {
+            return m[0][0];
+        }
+        else if constexpr(r == 2) {
+            return (m[0][0] * m[1][1]) - (m[1][0] * m[0][1]);
+        }
+        else if constexpr(r == 3) {
+            return m[0][0] * ((m[1][1] * m[2][2]) - (m[2][1] * m[1][2]))
+                 - m[1][0] * ((m[0][1] * m[2][2]) - (m[2][1] * m[0][2]))
+                 + m[2][0] * ((m[0][1] * m[1][2]) - (m[1][1] * m[0][2]));
+        }
+        else if constexpr(r == 4) {
+            const T s0 = (m[0][0] * m[1][1]) - (m[0][1] * m[1][0]);
+            const T s1 = (m[0][0] * m[2][1]) - (m[0][1] * m[2][0]);
+            const T s2 = (m[0][0] * m[3][1]) - (m[0][1] * m[3][0]);
+            const T s3 = (m[1][0] * m[2][1]) - (m[1][1] * m[2][0]);
+            const T s4 = (m[1][0] * m[3][1]) - (m[1][1] * m[3][0]);
+            const T s5 = (m[2][0] * m[3][1]) - (m[2][1] * m[3][0]);
+            const T c5 = (m[2][2] * m[3][3]) - (m[2][3] * m[3][2]);
+            const T c4 = (m[1][2] * m[3][3]) - (m[1][3] * m[3][2]);
+            const T c3 = (m[1][2] * m[2][3]) - (m[1][3] * m[2][2]);
+            const T c2 = (m[0][2] * m[3][3]) - (m[0][3] * m[3][2]);
+            const T c1 = (m[0][2] * m[2][3]) - (m[0][3] * m[2][2]);
+            const T c0 = (m[0][2] * m[1][3]) - (m[0][3] * m[1][2]);
+            return (s0 * c5) - (s1 * c4) + (s2 * c3) + (s3 * c2) - (s4 * c1) + (s5 * c0);
+        }
+        else {
+            //LU decomposition in place on a row major copy
+            T lu[r][r];
+            for(size_t row = 0; row < r; row++){
+                for(size_t col = 0; col < r; col++){lu[row][col] = m[col][row];}
+            }
+            T det = 1;
+            for(size_t k = 0; k < r; k++){
+                size_t pivot = k;
+                for(size_t row = k+1; row < r; row++){
+                    if(Abs<T>(lu[row][k]) > Abs<T>(lu[pivot][k])){pivot = row;}
+                }
+                if(lu[pivot][k] == (T)0){return (T)0;}
+                if(pivot != k){
+                    std::swap(lu[pivot], lu[k]);
+                    det = -det;
+                }
+                det *= lu[k][k];
+                for(size_t row = k+1; row < r; row++){
+                    const T factor = lu[row][k] / lu[k][k];
+                    for(size_t col = k+1; col < r; col++){lu[row][col] -= factor * lu[k][col];}
+                }
+            }
+            return det;
+        }
+    }
+
+    /**
+     * @fn Inverse
+     * @remark Closed form (cofactors) for 2x2, 3x3 and 4x4, with a SIMD kernel for mat<float,4>,
+     * Gauss-Jordan elimination with partial pivoting otherwise.
+     * Singular matrices produce non-finite elements; check Determinant() first if that is possible.
+     * @see AffineInverse for the much cheaper inverse of rotation/scale/translation matrices.
+     */
+    M Inverse() const {
+        static_assert(r == c, "ss::mat<>::Inverse() requires a square matrix");
+        const M& m = *this;
+        M ret;
+        if constexpr(simd::inverse_kernel<T, r>::enabled) {
+            simd::inverse_kernel<T, r>::Inverse(Elements(), ret.Elements());
+        }
+        else if constexpr(r == 1) {
+            ret[0][0] = (T)1 / m[0][0];
+        }
+        else if constexpr(r == 2) {
+            const T inv = (T)1 / Determinant();
+            ret[0][0] = m[1][1] * inv;
+            ret[0][1] = -m[0][1] * inv;
+            ret[1][0] = -m[1][0] * inv;
+            ret[1][1] = m[0][0] * inv;
+        }
+        else if constexpr(r == 3) {
+            ret[0][0] = (m[1][1] * m[2][2]) - (m[2][1] * m[1][2]);
+            ret[0][1] = (m[2][1] * m[0][2]) - (m[0][1] * m[2][2]);
+            ret[0][2] = (m[0][1] * m[1][2]) - (m[1][1] * m[0][2]);
+            ret[1][0] = (m[2][0] * m[1][2]) - (m[1][0] * m[2][2]);
+            ret[1][1] = (m[0][0] * m[2][2]) - (m[2][0] * m[0][2]);
+            ret[1][2] = (m[1][0] * m[0][2]) - (m[0][0] * m[1][2]);
+            ret[2][0] = (m[1][0] * m[2][1]) - (m[2][0] * m[1][1]);
+            ret[2][1] = (m[2][0] * m[0][1]) - (m[0][0] * m[2][1]);
+            ret[2][2] = (m[0][0] * m[1][1]) - (m[1][0] * m[0][1]);
+            const T inv = (T)1 / ((m[0][0] * ret[0][0]) + (m[1][0] * ret[0][1]) + (m[2][0] * ret[0][2]));
+            ret.Mul(inv);
+        }
+        else if constexpr(r == 4) {
+            //a(row, col) = m[col][row], written out so the 2x2 sub-determinants are shared
+            const T s0 = (m[0][0] * m[1][1]) - (m[0][1] * m[1][0]);
+            const T s1 = (m[0][0] * m[2][1]) - (m[0][1] * m[2][0]);
+            const T s2 = (m[0][0] * m[3][1]) - (m[0][1] * m[3][0]);
+            const T s3 = (m[1][0] * m[2][1]) - (m[1][1] * m[2][0]);
+            const T s4 = (m[1][0] * m[3][1]) - (m[1][1] * m[3][0]);
+            const T s5 = (m[2][0] * m[3][1]) - (m[2][1] * m[3][0]);
+            const T c5 = (m[2][2] * m[3][3]) - (m[2][3] * m[3][2]);
+            const T c4 = (m[1][2] * m[3][3]) - (m[1][3] * m[3][2]);
+            const T c3 = (m[1][2] * m[2][3]) - (m[1][3] * m[2][2]);
+            const T c2 = (m[0][2] * m[3][3]) - (m[0][3] * m[3][2]);
+            const T c1 = (m[0][2] * m[2][3]) - (m[0][3] * m[2][2]);
+            const T c0 = (m[0][2] * m[1][3]) - (m[0][3] * m[1][2]);
+            const T inv = (T)1 / ((s0 * c5) - (s1 * c4) + (s2 * c3) + (s3 * c2) - (s4 * c1) + (s5 * c0));
+
+            ret[0][0] = ( m[1][1] * c5 - m[2][1] * c4 + m[3][1] * c3) * inv;
+            ret[1][0] = (-m[1][0] * c5 + m[2][0] * c4 - m[3][0] * c3) * inv;
+            ret[2][0] = ( m[1][3] * s5 - m[2][3] * s4 + m[3][3] * s3) * inv;
+            ret[3][0] = (-m[1][2] * s5 + m[2][2] * s4 - m[3][2] * s3) * inv;
+            ret[0][1] = (-m[0][1] * c5 + m[2][1] * c2 - m[3][1] * c1) * inv;
+            ret[1][1] = ( m[0][0] * c5 - m[2][0] * c2 + m[3][0] * c1) * inv;
+            ret[2][1] = (-m[0][3] * s5 + m[2][3] * s2 - m[3][3] * s1) * inv;
+            ret[3][1] = ( m[0][2] * s5 - m[2][2] * s2 + m[3][2] * s1) * inv;
+            ret[0][2] = ( m[0][1] * c4 - m[1][1] * c2 + m[3][1] * c0) * inv;
+            ret[1][2] = (-m[0][0] * c4 + m[1][0] * c2 - m[3][0] * c0) * inv;
+            ret[2][2] = ( m[0][3] * s4 - m[1][3] * s2 + m[3][3] * s0) * inv;
+            ret[3][2] = (-m[0][2] * s4 + m[1][2] * s2 - m[3][2] * s0) * inv;
+            ret[0][3] = (-m[0][1] * c3 + m[1][1] * c1 - m[2][1] * c0) * inv;
+            ret[1][3] = ( m[0][0] * c3 - m[1][0] * c1 + m[2][0] * c0) * inv;
+            ret[2][3] = (-m[0][3] * s3 + m[1][3] * s1 - m[2][3] * s0) * inv;
+            ret[3][3] = ( m[0][2] * s3 - m[1][2] * s1 + m[2][2] * s0) * inv;
+        }
+        else {
+            //Gauss-Jordan on row major copies of m and the identity
+            T a[r][r], b[r][r];
+            for(size_t row = 0; row < r; row++){
+                for(size_t col = 0; col < r; col++){
+                    a[row][col] = m[col][row];
+                    b[row][col] = (row == col) ? (T)1 : (T)0;
+                }
+            }
+            for(size_t k = 0; k < r; k++){
+                size_t pivot = k;
+                for(size_t row = k+1; row < r; row++){
+                    if(Abs<T>(a[row][k]) > Abs<T>(a[pivot][k])){pivot = row;}
+                }
+                if(pivot != k){
+                    std::swap(a[pivot], a[k]);
+                    std::swap(b[pivot], b[k]);
+                }
+                const T inv = (T)1 / a[k][k];
+                for(size_t col = 0; col < r; col++){
+                    a[k][col] *= inv;
+                    b[k][col] *= inv;
+                }
+                for(size_t row = 0; row < r; row++){
+                    if(row == k){continue;}
+                    const T factor = a[row][k];
+                    if(factor == (T)0){continue;}
+                    for(size_t col = 0; col < r; col++){
+                        a[row][col] -= factor * a[k][col];
+                        b[row][col] -= factor * b[k][col];
+                    }
+                }
+            }
+            for(size_t row = 0; row < r; row++){
+                for(size_t col = 0; col < r; col++){ret[col][row] = b[row][col];}
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * @fn AffineInverse
+     * @brief Inverse of a homogeneous affine matrix whose linear part has mutually orthogonal rows,
+     * i.e. a rotation optionally followed by a per-axis scale, plus a translation.
+     * This covers every matrix built by Plug, Rotation and Orientation in transform.hpp.
+     *
+     * The linear part is inverted as its transpose divided by the squared row lengths, and the
+     * translation as the negated, inverse transformed origin; no general elimination is performed.
+     * @remark The result is wrong for shears or a scale applied before the rotation, use Inverse() for those.
+     */
+    M AffineInverse() const {
+        static_assert(r == c && r >= 2, "ss::mat<>::AffineInverse() requires a square homogeneous matrix");
+        constexpr size_t dim = r - 1;
+        const M& m = *this;
+        M ret;
+        if constexpr(simd::affine_inverse_kernel<T, r>::enabled) {
+            simd::affine_inverse_kernel<T, r>::Inverse(Elements(), ret.Elements());
+            return ret;
+        }
+        //Every loop runs down the rows innermost, so each is a handful of whole-column SIMD operations
+        T inv_sqr[dim] = {};
+        for(size_t col = 0; col < dim; col++){
+            for(size_t row = 0; row < dim; row++){inv_sqr[row] += m[col][row] * m[col][row];}
+        }
+        for(size_t row = 0; row < dim; row++){inv_sqr[row] = (T)1 / inv_sqr[row];}
+        for(size_t col = 0; col < dim; col++){
+            for(size_t row = 0; row < dim; row++){ret[col][row] = m[row][col] * inv_sqr[col];}
+            ret[col][dim] = 0;
+        }
+        for(size_t row = 0; row < dim; row++){ret[dim][row] = 0;}
+        for(size_t col = 0; col < dim; col++){
+            const T t = m[dim][col];
+            for(size_t row = 0; row < dim; row++){ret[dim][row] -= ret[col][row] * t;}
+        }
+        ret[dim][dim] = 1;
+        return ret;
     }
 
     //Operators
@@ -165,7 +476,7 @@ public:
     template<typename OT, size_t Odim>
     Col operator*(const vec<OT, Odim>& v) const {return VecProd(v);}
     template<typename OT, size_t Or, size_t Oc>
-    M operator*(const mat<OT, Or, Oc>& other) const {return MatProd(other);}
+    mat<T, r, Oc> operator*(const mat<OT, Or, Oc>& other) const {return MatProd(other);}
     template<typename OT, size_t Or, size_t Oc>
     void operator*=(const mat<OT, Or, Oc>& other){MatMul(other);} 
 
@@ -174,7 +485,7 @@ public:
     //template<typename S>
     //friend S operator*(const S& scalar,const M& m){return m.LeftProd(scalar);}
     template<typename S>
-    void operator*=(const S& scalar) {Mult(scalar);}
+    void operator*=(const S& scalar) {Mul(scalar);}
     
     template<typename S>
     M operator/(const S& scalar) const {return Quot(scalar);}
@@ -183,21 +494,12 @@ public:
     template<typename S>
     void operator/=(const S& scalar) {Div(scalar);}
 
-#ifndef SS_MAT_OSTREAM_ROW_END
-#define SS_MAT_OSTREAM_ROW_END "\n"
-#endif
-
+    ///@remark Formats with AppendTo in Format::Mat(), pass another Format to AppendTo or ToString for other separators
     friend std::ostream& operator<<(std::ostream& o, const M& m)
     {
-        for(size_t row = 0; row < m.NumberOfRows(); row++){
-            Row curr = m.GetRow(row);
-            o<<"["<<curr[0];
-            for(size_t i = 1; i < curr.Dimension(); i++){
-                o<<", "<<curr[i];
-            }
-            o<<"]"<<SS_MAT_OSTREAM_ROW_END;
-        }
-        return o;
+        detail::FormatBuffer buffer;
+        AppendTo(buffer.Get(), m);
+        return o.write(buffer.Get().data(), (std::streamsize)buffer.Get().size());
     }
 
 //static
@@ -205,68 +507,143 @@ public:
     static constexpr size_t NumberOfColumns() { return c; }
 };
 
-//These Functions Are Limiting Transform's Potentcial, 
-//I should try to figure out a generic way to generate rotation matrices
-//but I'm too lazy rn so this will work for what I need right now.
-
-///@fn CreateRotationMatrix
-template<typename T, size_t dim>
-mat<T,dim> CreateRotationMatrix(const vec<T,(dim*(dim-1))/2>);
+//Text, a row at a time
 
-template<typename T>
-mat<T, 2> CreateRotationMatrix<T,2>(const vec<T,1>& rot){
-    if(rot == 0){return mat<T,2>(1);}
-    else{
-        mat<T, 2> ret;
-        ss_trig cos, sin;
-        cos = ss::Cos(rot[0]);
-        sin = ss::Sin(rot[0]);
-        ret[0][0] = cos;
-        ret[0][1] = sin;
-        ret[1][0] = -sin;
-        ret[1][1] = cos;
-        return ret;
+/**
+ * @fn AppendTo
+ * @brief Appends m to s in the Format f, each row wrapped in open and close and followed by row_end,
+ * read in place from the columns.
+ */
+template<typename T, size_t r, size_t c>
+void AppendTo(std::string& s, const mat<T, r, c>& m, const Format& f){
+    for(size_t row = 0; row < r; row++){
+        s.append(f.open);
+        detail::AppendScalar<T>(s, m[0][row]);
+        for(size_t col = 1; col < c; col++){
+            s.append(f.separator);
+            detail::AppendScalar<T>(s, m[col][row]);
+        }
+        s.append(f.close);
+        s.append(f.row_end);
     }
 }
+///@fn ToString @return std::string m in the Format f
+template<typename T, size_t r, size_t c>
+std::string ToString(const mat<T, r, c>& m, const Format& f = Format::Mat()){
+    std::string s;
+    AppendTo(s, m, f);
+    return s;
+}
 
-template<typename T>
-mat<T, 3> CreateRotationMatrix<T,3>(const vec<T,3>& rot){
-    mat<T, 3> ret(1);
-    ss_trig cos, sin;
-    if(rotation[2] != (T)0)
-    {
-        cos = ss::Cos(rotation[2]);
-        sin = ss::Sin(rotation[2]);
-        ret[0][0] = cos;
-        ret[0][1] = sin;
-        ret[1][0] = -sin;
-        ret[1][1] = cos;
+/**
+ * @fn Parse
+ * @brief Reads a mat written in the Format f from [first, last) with std::from_chars.
+ * @return const char* Past the mat, or nullptr if [first, last) does not start with one, leaving m partly written
+ */
+template<typename T, size_t r, size_t c>
+const char* Parse(const char* first, const char* last, mat<T, r, c>& m, const Format& f = Format::Mat()){
+    for(size_t row = 0; row < r && first != nullptr; row++){
+        first = detail::MatchToken(first, last, f.open);
+        for(size_t col = 0; col < c && first != nullptr; col++){
+            if(col > 0){first = detail::MatchToken(first, last, f.separator);}
+            if(first != nullptr){first = detail::ParseScalar<T>(first, last, m[col][row]);}
+        }
+        if(first != nullptr){first = detail::MatchToken(first, last, f.close);}
+        if(first != nullptr){first = detail::MatchToken(first, last, f.row_end);}
     }
-    if(rotation[1] != (T)0)
-    {
-        cos = ss::Cos(rotation[1]);
-        sin = std::sin(rotation[1]);
-        mat<T,3> yrot;
-        yrot[0][0] = cos;
-        yrot[0][2] = -sin;
-        yrot[2[[0] = sin;
-        yrot[2[[2] = cos;
-        ret = yrot*ret;
+    return first;
+}
+///@fn FromString @return bool Whether text is exactly one mat in the Format f, give or take whitespace
+template<typename T, size_t r, size_t c>
+bool FromString(const std::string_view& text, mat<T, r, c>& m, const Format& f = Format::Mat()){
+    const char* last = text.data() + text.size();
+    const char* end = Parse(text.data(), last, m, f);
+    return end != nullptr && detail::SkipSpace(end, last) == last;
+}
+
+//Rotations
+//
+//A rotation in dim dimensions is parameterized by one angle per rotational plane, (dim*(dim-1))/2 of them.
+//Angle k rotates in the plane RotationPlane<dim>(k) = (i, j), i < j, with the planes enumerated in reverse
+//lexicographic order and a positive angle turning axis i towards axis j when i+j is odd (and j towards i
+//otherwise). In 3D this makes rot[k] a right handed rotation about axis k, and in 2D a counter clockwise one.
+//The full rotation is G(0) * G(1) * ... * G(n-1), so in 3D the z rotation is applied first and x last.
+
+/**
+ * @fn RotationPlane
+ * @return std::pair<size_t,size_t> The axes (i, j), i < j, spanning rotational plane k of a dim dimensional rotation.
+ */
+template<size_t dim>
+constexpr std::pair<size_t, size_t> RotationPlane(const size_t& k){
+    size_t lex = ((dim*(dim-1))/2) - 1 - k;
+    for(size_t i = 0; i < dim; i++){
+        const size_t planes = dim - 1 - i;
+        if(lex < planes){return std::pair<size_t, size_t>(i, i + 1 + lex);}
+        lex -= planes;
     }
-    if(rotation[0] != (T)0)
-    {
-        cos = std::cos(rotation[0]);
-        sin = std::sin(rotation[0]);
-        mat<T,3> xrot;
-        xrot[1][1] = cos;
-        xrot[1][2] = sin;
-        xrot[2[[1] = -sin;
-        xrot[2[[2] = cos;
-        ret = xrot*ret;    
+    return std::pair<size_t, size_t>(0, 0);
+}
+
+/**
+ * @fn CreateRotationMatrix
+ * @brief Builds a rotation matrix from precomputed sines and cosines of every plane angle (see RotationPlane).
+ *
+ * Starts from the identity and applies each plane (Givens) rotation directly to the two columns it mixes,
+ * O(dim) work per non-zero angle, instead of multiplying full matrices.
+ * @remark Useful when the sines and cosines are cached between rebuilds.
+ */
+template<typename T, size_t dim>
+mat<T, dim> CreateRotationMatrix(const vec<T,(dim*(dim-1))/2>& sin, const vec<T,(dim*(dim-1))/2>& cos){
+    mat<T, dim> ret(1);
+    for(size_t k = 0; k < (dim*(dim-1))/2; k++){
+        if(sin[k] == (T)0 && cos[k] == (T)1){continue;}
+        const std::pair<size_t, size_t> plane = RotationPlane<dim>(k);
+        const T s = ((plane.first + plane.second) % 2 == 1) ? sin[k] : -sin[k];
+        const T c = cos[k];
+        vec<T, dim>& col_i = ret[plane.first];
+        vec<T, dim>& col_j = ret[plane.second];
+        for(size_t row = 0; row < dim; row++){
+            const T a = col_i[row];
+            const T b = col_j[row];
+            col_i[row] = (c * a) + (s * b);
+            col_j[row] = (c * b) - (s * a);
+        }
     }
     return ret;
 }
 
+/**
+ * @fn CreateRotationMatrix
+ * @brief Builds a rotation matrix from one angle (in radians) per rotational plane (see RotationPlane).
+ */
+template<typename T, size_t dim>
+mat<T, dim> CreateRotationMatrix(const vec<T,(dim*(dim-1))/2>& rot){
+    constexpr size_t NRP = (dim*(dim-1))/2;
+    vec<T, NRP> sin, cos;
+    for(size_t k = 0; k < NRP; k++){
+        if(rot[k] == (T)0){
+            sin[k] = 0;
+            cos[k] = 1;
+        }
+        else{
+            SinCos<T>(rot[k], sin[k], cos[k]);
+        }
+    }
+    return CreateRotationMatrix<T, dim>(sin, cos);
+}
+
+///@fn CreateRotationMatrix
+template<typename T>
+mat<T, 2> CreateRotationMatrix(const vec<T,1>& rot){
+    return CreateRotationMatrix<T, 2>(rot);
+}
+
+///@fn CreateRotationMatrix
+template<typename T>
+mat<T, 3> CreateRotationMatrix(const vec<T,3>& rot){
+    return CreateRotationMatrix<T, 3>(rot);
+}
+
 }
 
 #endif // SUBSTD_MAT_HPP
\ No newline at end of file
@@ -0,0 +1,169 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Transforming many vectors by a single ss::mat in one pass.
+ * @include array vector vec vec_soa mat simd parallel
+*/
+
+#ifndef SUBSTD_MAT_BATCH_HPP
+#define SUBSTD_MAT_BATCH_HPP
+
+#include<array>
+#include<vector>
+
+#include<substd/vec.hpp>
+#include<substd/vec_soa.hpp>
+#include<substd/mat.hpp>
+#include<substd/simd.hpp>
+#include<substd/parallel.hpp>
+
+namespace ss
+{
+
+/**
+ * @class AffineLanes
+ * @brief The linear part and (if translate is true) translation column of a mat<T,dim+1>, applied to lanes of components.
+ *
+ * The matrix is copied once, so it stays in registers across the loop, and each step transforms a whole
+ * simd::pack<T> of points. Every input component is loaded before any output is stored, so in and out may
+ * be the same lanes.
+ */
+template<typename T, size_t dim, bool translate>
+class AffineLanes {
+protected:
+    std::array<std::array<T,dim>,dim+1> columns;
+
+public:
+    AffineLanes(const mat<T,dim+1>& m){
+        for(size_t col = 0; col <= dim; col++){
+            for(size_t row = 0; row < dim; row++){
+                columns[col][row] = m[col][row];
+            }
+        }
+    }
+
+    ///@fn Apply Transforms the points [begin, end) of the lanes in into the lanes out
+    void Apply(const std::array<const T*,dim>& in, const std::array<T*,dim>& out, const size_t& begin, const size_t& end) const {
+        const auto& m = columns;
+        simd::ForEachPack<T>(end - begin, [&m, &in, &out, &begin](auto p, const size_t& offset){
+            using P = decltype(p);
+            const size_t i = begin + offset;
+            typename P::reg x[dim];
+            for(size_t c = 0; c < dim; c++){x[c] = P::Load(in[c] + i);}
+            typename P::reg y[dim];
+            for(size_t row = 0; row < dim; row++){
+                auto acc = translate ? P::Fma(x[0], P::Set1(m[0][row]), P::Set1(m[dim][row])) : P::Mul(x[0], P::Set1(m[0][row]));
+                for(size_t c = 1; c < dim; c++){
+                    acc = P::Fma(x[c], P::Set1(m[c][row]), acc);
+                }
+                y[row] = acc;
+            }
+            for(size_t row = 0; row < dim; row++){P::Store(out[row] + i, y[row]);}
+        });
+    }
+
+    ///@fn Apply Transforms the array of structs in[begin, end) into out, a pack sized block at a time
+    void Apply(const vec<T,dim>* in, vec<T,dim>* out, const size_t& begin, const size_t& end) const {
+        constexpr size_t block = 4 * simd::pack<T>::width;
+        alignas(64) T lanes[dim][block];
+        std::array<const T*,dim> lanes_in;
+        std::array<T*,dim> lanes_out;
+        for(size_t c = 0; c < dim; c++){
+            lanes_in[c] = lanes[c];
+            lanes_out[c] = lanes[c];
+        }
+        for(size_t first = begin; first < end; first += block){
+            const size_t n = Min(block, end - first);
+            for(size_t i = 0; i < n; i++){
+                for(size_t c = 0; c < dim; c++){lanes[c][i] = in[first + i][c];}
+            }
+            Apply(lanes_in, lanes_out, 0, n);
+            for(size_t i = 0; i < n; i++){
+                for(size_t c = 0; c < dim; c++){out[first + i][c] = lanes[c][i];}
+            }
+        }
+    }
+};
+
+/**
+ * @fn TransformPoints
+ * @brief out[i] = m * in[i] with in[i] treated as a homogeneous point (w = 1), the w row of m is never computed.
+ *
+ * @param count Number of points in both in and out, which may be the same array.
+ * @param threads Maximum number of threads to split the work across (see ParallelFor), 0 uses every hardware thread.
+ */
+template<typename T, size_t dim>
+void TransformPoints(const mat<T,dim+1>& m, const vec<T,dim>* in, vec<T,dim>* out, const size_t& count, const size_t& threads = 1){
+    const AffineLanes<T,dim,true> lanes(m);
+    ParallelFor(count, threads, [&lanes, in, out](const size_t& begin, const size_t& end){
+        lanes.Apply(in, out, begin, end);
+    });
+}
+template<typename T, size_t dim>
+std::vector<vec<T,dim>> TransformPoints(const mat<T,dim+1>& m, const std::vector<vec<T,dim>>& in, const size_t& threads = 1){
+    std::vector<vec<T,dim>> ret(in.size());
+    TransformPoints(m, in.data(), ret.data(), in.size(), threads);
+    return ret;
+}
+/**
+ * @fn TransformPoints
+ * @brief Structure of arrays overload, out is resized to match in and may be the same object.
+ */
+template<typename T, size_t dim>
+void TransformPoints(const mat<T,dim+1>& m, const vec_soa<T,dim>& in, vec_soa<T,dim>& out, const size_t& threads = 1){
+    out.resize(in.size());
+    std::array<const T*,dim> lanes_in;
+    std::array<T*,dim> lanes_out;
+    for(size_t c = 0; c < dim; c++){
+        lanes_in[c] = in.Lane(c);
+        lanes_out[c] = out.Lane(c);
+    }
+    const AffineLanes<T,dim,true> lanes(m);
+    ParallelFor(in.size(), threads, [&](const size_t& begin, const size_t& end){
+        lanes.Apply(lanes_in, lanes_out, begin, end);
+    });
+}
+
+/**
+ * @fn TransformDirections
+ * @brief out[i] = m * in[i] with in[i] treated as a homogeneous direction (w = 0), so translation is ignored.
+ */
+template<typename T, size_t dim>
+void TransformDirections(const mat<T,dim+1>& m, const vec<T,dim>* in, vec<T,dim>* out, const size_t& count, const size_t& threads = 1){
+    const AffineLanes<T,dim,false> lanes(m);
+    ParallelFor(count, threads, [&lanes, in, out](const size_t& begin, const size_t& end){
+        lanes.Apply(in, out, begin, end);
+    });
+}
+template<typename T, size_t dim>
+void TransformDirections(const mat<T,dim+1>& m, const vec_soa<T,dim>& in, vec_soa<T,dim>& out, const size_t& threads = 1){
+    out.resize(in.size());
+    std::array<const T*,dim> lanes_in;
+    std::array<T*,dim> lanes_out;
+    for(size_t c = 0; c < dim; c++){
+        lanes_in[c] = in.Lane(c);
+        lanes_out[c] = out.Lane(c);
+    }
+    const AffineLanes<T,dim,false> lanes(m);
+    ParallelFor(in.size(), threads, [&](const size_t& begin, const size_t& end){
+        lanes.Apply(lanes_in, lanes_out, begin, end);
+    });
+}
+
+/**
+ * @fn TransformVectors
+ * @brief out[i] = m * in[i] for a general r x c matrix, including every row.
+ */
+template<typename T, size_t r, size_t c>
+void TransformVectors(const mat<T,r,c>& m, const vec<T,c>* in, vec<T,r>* out, const size_t& count, const size_t& threads = 1){
+    ParallelFor(count, threads, [&m, in, out](const size_t& begin, const size_t& end){
+        const mat<T,r,c> local(m);
+        for(size_t i = begin; i < end; i++){
+            out[i] = local.VecProd(in[i]);
+        }
+    });
+}
+
+}
+
+#endif // SUBSTD_MAT_BATCH_HPP
@@ -4,8 +4,11 @@
 #include<type_traits>
 #include<iterator>
 #include<cmath>
+#include<cstddef>
 
 #include<substd/constants.hpp>
+#include<substd/simd.hpp>
+#include<substd/fastmath.hpp>
 
 namespace ss{
     /**
@@ -32,10 +35,27 @@ namespace ss{
     }
 
     /**
-     * @fn Sqrt 
+     * @fn Sqrt
+     * @brief Floating point T is computed in its own precision to the given Accuracy, anything else through double.
      */
-    template<typename T> constexpr T Sqrt(const T& base){
-        return (T)std::sqrt((double)base);
+    template<typename T, Accuracy a = SS_MATH_ACCURACY> inline T Sqrt(const T& base){
+        if constexpr(!std::is_floating_point_v<T>) {
+            return (T)std::sqrt((double)base);
+        }
+        else if constexpr(a == Accuracy::Full) {
+            return std::sqrt(base);
+        }
+        else {
+            return fastmath::Sqrt<a, simd::scalar<T>>(base);
+        }
+    }
+    /**
+     * @fn RSqrt
+     * @return T 1/Sqrt(base)
+     */
+    template<typename T, Accuracy a = SS_MATH_ACCURACY> inline T RSqrt(const T& base){
+        static_assert(std::is_floating_point_v<T>, "RSqrt() requires a floating point type!");
+        return fastmath::RSqrt<a, simd::scalar<T>>(base);
     }
 
     /**
@@ -58,7 +78,7 @@ namespace ss{
      * @remark If the two values are equal, which value is returned is undefined.
      */
     template<class T> constexpr T Nearest(const T& a, const T& b, const T& p){
-        return Min<T>(Abs<T>(to-a),Abs<T>(to-b));
+        return (Abs<T>(p-a) <= Abs<T>(p-b)) ? a : b;
     }
 
     ///@fn InclusiveBetween
@@ -103,45 +123,153 @@ namespace ss{
     inline constexpr trig_t RadToDegree(const trig_t& rad){
         return rad * _180_DIV_PI;
     }
+    ///@typedef trig_type The type Sin, Cos and SinCos compute and return for T, T itself if it is floating point, trig_t otherwise.
+    template<typename T>
+    using trig_type = std::conditional_t<std::is_floating_point_v<T>, T, trig_t>;
+
+    /**
+     * @fn SinCos
+     * @brief Computes the sine and cosine of theta together, in the precision of T rather than through trig_t.
+     * @param theta In Radians
+     */
+    template<typename T, Accuracy a = SS_MATH_ACCURACY> inline void SinCos(const T& theta, T& sin, T& cos) {
+        static_assert(std::is_floating_point_v<T>, "SinCos() requires a floating point type!");
+        if constexpr(a == Accuracy::Full) {
+            //Written as a pair so the compiler can fuse both into one sincos call
+            sin = std::sin(theta);
+            cos = std::cos(theta);
+        }
+        else {
+            fastmath::SinCos<a, simd::scalar<T>>(theta, sin, cos);
+        }
+    }
     /**
      * @fn Sin
      * @param theta In Radians
      */
-    inline constexpr trig_t Sin(const trig_t& theta) {
-        return (trig_t)std::sin((double)theta);;
+    template<typename T, Accuracy a = SS_MATH_ACCURACY> inline trig_type<T> Sin(const T& theta) {
+        using R = trig_type<T>;
+        if constexpr(a == Accuracy::Full) {
+            return std::sin((R)theta);
+        }
+        else {
+            R sin, cos;
+            fastmath::SinCos<a, simd::scalar<R>>((R)theta, sin, cos);
+            return sin;
+        }
     }
     /**
      * @fn Cos
      * @param theta In Radians
      */
-    inline constexpr trig_t Cos(const trig_t& theta) {
-        return (trig_t)std::cos((double)theta);
+    template<typename T, Accuracy a = SS_MATH_ACCURACY> inline trig_type<T> Cos(const T& theta) {
+        using R = trig_type<T>;
+        if constexpr(a == Accuracy::Full) {
+            return std::cos((R)theta);
+        }
+        else {
+            R sin, cos;
+            fastmath::SinCos<a, simd::scalar<R>>((R)theta, sin, cos);
+            return cos;
+        }
+    }
+
+    //Array Overloads, evaluating a whole simd::pack per step for the approximate tiers
+
+    /**
+     * @fn SinCos
+     * @brief sin[i], cos[i] = Sin(theta[i]), Cos(theta[i]) for i in [0, count)
+     */
+    template<typename T, Accuracy a = SS_MATH_ACCURACY>
+    void SinCos(const T* theta, T* sin, T* cos, const size_t& count) {
+        if constexpr(a == Accuracy::Full) {
+            for(size_t i = 0; i < count; i++){SinCos<T, a>(theta[i], sin[i], cos[i]);}
+        }
+        else {
+            simd::ForEachPack<T>(count, [theta, sin, cos](auto p, const size_t& i){
+                using P = decltype(p);
+                typename P::reg s, c;
+                fastmath::SinCos<a, P>(P::Load(theta + i), s, c);
+                P::Store(sin + i, s);
+                P::Store(cos + i, c);
+            });
+        }
+    }
+    ///@fn Sin out[i] = Sin(theta[i]) for i in [0, count)
+    template<typename T, Accuracy a = SS_MATH_ACCURACY>
+    void Sin(const T* theta, T* out, const size_t& count) {
+        if constexpr(a == Accuracy::Full) {
+            for(size_t i = 0; i < count; i++){out[i] = std::sin(theta[i]);}
+        }
+        else {
+            simd::ForEachPack<T>(count, [theta, out](auto p, const size_t& i){
+                using P = decltype(p);
+                typename P::reg s, c;
+                fastmath::SinCos<a, P>(P::Load(theta + i), s, c);
+                P::Store(out + i, s);
+            });
+        }
+    }
+    ///@fn Cos out[i] = Cos(theta[i]) for i in [0, count)
+    template<typename T, Accuracy a = SS_MATH_ACCURACY>
+    void Cos(const T* theta, T* out, const size_t& count) {
+        if constexpr(a == Accuracy::Full) {
+            for(size_t i = 0; i < count; i++){out[i] = std::cos(theta[i]);}
+        }
+        else {
+            simd::ForEachPack<T>(count, [theta, out](auto p, const size_t& i){
+                using P = decltype(p);
+                typename P::reg s, c;
+                fastmath::SinCos<a, P>(P::Load(theta + i), s, c);
+                P::Store(out + i, c);
+            });
+        }
+    }
+    ///@fn Sqrt out[i] = Sqrt(in[i]) for i in [0, count)
+    template<typename T, Accuracy a = SS_MATH_ACCURACY>
+    void Sqrt(const T* in, T* out, const size_t& count) {
+        simd::ForEachPack<T>(count, [in, out](auto p, const size_t& i){
+            using P = decltype(p);
+            P::Store(out + i, fastmath::Sqrt<a, P>(P::Load(in + i)));
+        });
+    }
+    ///@fn RSqrt out[i] = RSqrt(in[i]) for i in [0, count)
+    template<typename T, Accuracy a = SS_MATH_ACCURACY>
+    void RSqrt(const T* in, T* out, const size_t& count) {
+        simd::ForEachPack<T>(count, [in, out](auto p, const size_t& i){
+            using P = decltype(p);
+            P::Store(out + i, fastmath::RSqrt<a, P>(P::Load(in + i)));
+        });
     }
 
     //Pairing Functions
-    
+
+    /**
+     * @fn MapIntToPositive
+     * @brief Maps 0, -1, 1, -2, 2... to 0, 1, 2, 3, 4..., the zigzag mapping ZigZagEncode in codec.hpp computes branch free.
+     */
     template<class T> T MapIntToPositive(const T& i){
-        static_assert(std::is_integral_v<T>(), "MapIntToPositive() requires an integral type!");
+        static_assert(std::is_integral_v<T>, "MapIntToPositive() requires an integral type!");
         if(i>=0){return i<<1;}
-        return (-2*i) + 1;
+        return (-2*i) - 1;
     }
     template<class T> T CantorPair(const T& x, const T& y){
-        static_assert(std::is_integral_v<T>(), "CantorPair() requires an integral type!");
+        static_assert(std::is_integral_v<T>, "CantorPair() requires an integral type!");
         return (
-            ((T)(((x+y)*(x+y+1))*0.5f))+y
+            (((x+y)*(x+y+1))/2)+y
         );
     }
     template<class T> T SignedCantorPair(const T& x, const T& y){
-        static_assert(std::is_integral_v<T>(), "SignedCantorPair() requires an integral type!");
+        static_assert(std::is_integral_v<T>, "SignedCantorPair() requires an integral type!");
         return CantorPair(MapIntToPositive<T>(x), MapIntToPositive<T>(y));
     }
     template<class T> T SzudzikPair(const T& x, const T& y){
-        static_assert(std::is_integral_v<T>(), "SzudzikPair() requires an integral type!");
+        static_assert(std::is_integral_v<T>, "SzudzikPair() requires an integral type!");
         if(x>=y){return (x*x)+x+y;}
         return (y*y)+x;
     }
     template<class T> T SignedSzudzikPair(const T& x, const T& y){
-        static_assert(std::is_integral_v<T>(), "SignedSzudzikPair() requires an integral type!");
+        static_assert(std::is_integral_v<T>, "SignedSzudzikPair() requires an integral type!");
         return SzudzikPair(MapIntToPositive<T>(x), MapIntToPositive<T>(y));
     }
 }
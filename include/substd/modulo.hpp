@@ -12,32 +12,31 @@ namespace ss{
 template<class self, typename T>
 class modular : public IConstrainable<T> {
 public:
-    static constexpr T Modulus();
-    T EvalValue(const T& t) override {return fmod(t, Modulus());}
+    T EvalValue(const T& t) const override {return std::fmod(t, self::Modulus());}
 };
 
 ///@class modulo_pi
 template<class T>
 class modulo_pi : public modular<modulo_pi<T>, T> {
 public:
-    modulo_pi(const T& t):IConstrainable<T>(t){}
-    constexpr T Modulus() {
-        return (T)SS_PI;
+    modulo_pi(const T& t = 0){this->SetValue(t);}
+    static constexpr T Modulus() {
+        return (T)PI;
     }
-    void operator=(const T& eq){return IConstrainable<T>::operator=(eq);}
+    void operator=(const T& eq){IConstrainable<T>::operator=(eq);}
 };
 ///@class modulo_tau
 ///@remark Especially useful for storing rotations.
 template<class T>
 class modulo_tau : public modular<modulo_tau<T>, T> {
 public:
-    modulo_tau(const T& t):IConstrainable<T>(t){}
-    constexpr T Modulus() {
-        return (T)SS_TAU;
+    modulo_tau(const T& t = 0){this->SetValue(t);}
+    static constexpr T Modulus() {
+        return (T)TAU;
     }
-    void operator=(const T& eq){return IConstrainable<T>::operator=(eq);}
+    void operator=(const T& eq){IConstrainable<T>::operator=(eq);}
 };
 
 }
 
-#endif //GLEWY_MODULO_HPP
\ No newline at end of file
+#endif //SUBSTD_MODULO_HPP
@@ -0,0 +1,168 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Minimal helpers for splitting loops across threads.
+ * @include thread vector algorithm atomic mutex condition_variable cstdint
+*/
+
+#ifndef SUBSTD_PARALLEL_HPP
+#define SUBSTD_PARALLEL_HPP
+
+#include<thread>
+#include<vector>
+#include<algorithm>
+#include<atomic>
+#include<mutex>
+#include<condition_variable>
+#include<cstdint>
+
+namespace ss
+{
+
+#ifndef SS_PARALLEL_MIN_CHUNK
+///@brief The fewest iterations ParallelFor will hand to a single thread.
+#define SS_PARALLEL_MIN_CHUNK 4096
+#endif
+
+/**
+ * @fn HardwareThreads
+ * @return size_t The number of hardware threads, or 1 if it cannot be determined.
+ */
+inline size_t HardwareThreads(){
+    size_t n = std::thread::hardware_concurrency();
+    return (n == 0) ? 1 : n;
+}
+
+/**
+ * @fn ParallelFor
+ * @brief Splits [0, count) into contiguous chunks and calls f(begin, end) for each, on up to threads threads.
+ *
+ * The calling thread processes the first chunk itself. No chunk is smaller than SS_PARALLEL_MIN_CHUNK,
+ * so small inputs run entirely on the calling thread without spawning anything.
+ *
+ * @param threads The maximum number of threads to use, 0 uses HardwareThreads().
+ */
+template<typename F>
+void ParallelFor(const size_t& count, size_t threads, F f){
+    if(threads == 0){threads = HardwareThreads();}
+    threads = std::max<size_t>(1, std::min(threads, count / SS_PARALLEL_MIN_CHUNK));
+    if(threads == 1){
+        if(count > 0){f((size_t)0, count);}
+        return;
+    }
+    const size_t chunk = (count + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for(size_t begin = chunk; begin < count; begin += chunk){
+        const size_t end = std::min(begin + chunk, count);
+        workers.emplace_back([&f, begin, end]{f(begin, end);});
+    }
+    f((size_t)0, std::min(chunk, count));
+    for(auto& worker : workers){worker.join();}
+}
+
+
+/**
+ * @class ThreadPool
+ * @brief Worker threads kept waiting between ParallelFor calls, for loops run too often to spawn threads each time.
+ *
+ * The calling thread works alongside the pool and every call returns only once all its chunks are done.
+ * Chunks are handed out dynamically, so uneven work balances itself. Calls must not overlap, from
+ * different threads or from inside f.
+ */
+class ThreadPool
+{
+    protected:
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        uint64_t generation = 0;
+        size_t pending = 0;
+        bool stopping = false;
+
+        //The current loop, written before generation is bumped so workers see it once they wake
+        void (*job)(void*, const size_t&, const size_t&) = nullptr;
+        void* context = nullptr;
+        size_t job_count = 0;
+        size_t job_chunk = 1;
+        std::atomic<size_t> next_chunk{0};
+
+        void RunChunks(){
+            for(size_t begin = next_chunk.fetch_add(1) * job_chunk; begin < job_count; begin = next_chunk.fetch_add(1) * job_chunk){
+                job(context, begin, std::min(begin + job_chunk, job_count));
+            }
+        }
+
+        void Work(){
+            uint64_t seen = 0;
+            while(true){
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wake.wait(lock, [&]{return stopping || generation != seen;});
+                    if(stopping){return;}
+                    seen = generation;
+                }
+                RunChunks();
+                std::lock_guard<std::mutex> lock(mutex);
+                if(--pending == 0){done.notify_one();}
+            }
+        }
+
+    public:
+        /**
+         * @fn Constructor
+         * @param threads The threads loops run on, the caller's included, 0 uses HardwareThreads().
+         */
+        explicit ThreadPool(size_t threads = 0){
+            if(threads == 0){threads = HardwareThreads();}
+            workers.reserve(threads - 1);
+            for(size_t i = 1; i < threads; i++){workers.emplace_back([this]{Work();});}
+        }
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ~ThreadPool(){
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for(auto& worker : workers){worker.join();}
+        }
+
+        ///@fn Threads @return size_t The threads loops run on, the caller's included
+        size_t Threads() const {return workers.size() + 1;}
+
+        /**
+         * @fn ParallelFor
+         * @brief Splits [0, count) into chunks of at least SS_PARALLEL_MIN_CHUNK and calls f(begin, end) for each
+         * across the pool, like the free ParallelFor.
+         */
+        template<typename F>
+        void ParallelFor(const size_t& count, F f){
+            const size_t threads = std::max<size_t>(1, std::min(Threads(), count / SS_PARALLEL_MIN_CHUNK));
+            if(threads == 1){
+                if(count > 0){f((size_t)0, count);}
+                return;
+            }
+            //A few chunks per thread, so one slow chunk does not hold up the rest
+            job_chunk = std::max<size_t>(SS_PARALLEL_MIN_CHUNK, (count + (threads * 4) - 1) / (threads * 4));
+            job_count = count;
+            job = [](void* c, const size_t& begin, const size_t& end){(*static_cast<F*>(c))(begin, end);};
+            context = &f;
+            next_chunk.store(0);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                pending = workers.size();
+                generation++;
+            }
+            wake.notify_all();
+            RunChunks();
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [&]{return pending == 0;});
+        }
+};
+
+}
+
+#endif // SUBSTD_PARALLEL_HPP
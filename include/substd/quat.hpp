@@ -0,0 +1,186 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Quaternions for 3D rotations
+ * @include vec mat math
+*/
+
+#ifndef SUBSTD_QUAT_HPP
+#define SUBSTD_QUAT_HPP
+
+#include<substd/math.hpp>
+#include<substd/vec.hpp>
+#include<substd/mat.hpp>
+
+namespace ss
+{
+
+/**
+ * @class quat
+ * @brief A quaternion stored as (x, y, z, w), w being the real part.
+ *
+ * Rotations follow the same convention as CreateRotationMatrix<T,3>, so FromRotation(rot).ToMatrix()
+ * equals CreateRotationMatrix<T,3>(rot).
+ *
+ * @tparam T Floating point type of the components
+ */
+template<typename T>
+class quat : public vec<T,4> {
+protected:
+    using Q = quat<T>;
+    using base = vec<T,4>;
+
+public:
+    /**
+     * @brief Default Constructor
+    */
+    quat(){}
+    /**
+     * @brief Component Constructor
+    */
+    quat(const T& x, const T& y, const T& z, const T& w){
+        (*this)[0] = x;
+        (*this)[1] = y;
+        (*this)[2] = z;
+        (*this)[3] = w;
+    }
+    /**
+     * @brief vec Constructor, v is taken as (x, y, z, w)
+    */
+    quat(const vec<T,4>& v) : base(v) {}
+
+    const T& X() const {return (*this)[0];}
+    const T& Y() const {return (*this)[1];}
+    const T& Z() const {return (*this)[2];}
+    const T& W() const {return (*this)[3];}
+
+    ///@fn Conjugate
+    Q Conjugate() const {
+        return Q(-X(), -Y(), -Z(), W());
+    }
+    ///@fn Inverse
+    Q Inverse() const {
+        const T inv = (T)1 / this->MagnitudeSqr();
+        return Q(-X() * inv, -Y() * inv, -Z() * inv, W() * inv);
+    }
+    ///@fn Normalized
+    Q Normalized() const {
+        return Q(base::Prod((T)1 / Sqrt<T>(this->MagnitudeSqr())));
+    }
+
+    ///@fn HamiltonProd @return Q The rotation other followed by this
+    Q HamiltonProd(const Q& other) const {
+        const Q& a = *this;
+        return Q(
+            (a[3] * other[0]) + (a[0] * other[3]) + (a[1] * other[2]) - (a[2] * other[1]),
+            (a[3] * other[1]) - (a[0] * other[2]) + (a[1] * other[3]) + (a[2] * other[0]),
+            (a[3] * other[2]) + (a[0] * other[1]) - (a[1] * other[0]) + (a[2] * other[3]),
+            (a[3] * other[3]) - (a[0] * other[0]) - (a[1] * other[1]) - (a[2] * other[2])
+        );
+    }
+
+    ///@fn Rotate @return vec<T,3> v rotated by this unit quaternion
+    vec<T,3> Rotate(const vec<T,3>& v) const {
+        //v + 2w(q x v) + 2(q x (q x v))
+        const T tx = (T)2 * ((Y() * v[2]) - (Z() * v[1]));
+        const T ty = (T)2 * ((Z() * v[0]) - (X() * v[2]));
+        const T tz = (T)2 * ((X() * v[1]) - (Y() * v[0]));
+        return vec<T,3>{
+            v[0] + (W() * tx) + ((Y() * tz) - (Z() * ty)),
+            v[1] + (W() * ty) + ((Z() * tx) - (X() * tz)),
+            v[2] + (W() * tz) + ((X() * ty) - (Y() * tx))
+        };
+    }
+
+    ///@fn ToMatrix @return mat<T,3> The rotation matrix of this unit quaternion
+    mat<T,3> ToMatrix() const {
+        const T xx = X() * X(), yy = Y() * Y(), zz = Z() * Z();
+        const T xy = X() * Y(), xz = X() * Z(), yz = Y() * Z();
+        const T wx = W() * X(), wy = W() * Y(), wz = W() * Z();
+        mat<T,3> ret;
+        ret[0][0] = (T)1 - (T)2 * (yy + zz);
+        ret[0][1] = (T)2 * (xy + wz);
+        ret[0][2] = (T)2 * (xz - wy);
+        ret[1][0] = (T)2 * (xy - wz);
+        ret[1][1] = (T)1 - (T)2 * (xx + zz);
+        ret[1][2] = (T)2 * (yz + wx);
+        ret[2][0] = (T)2 * (xz + wy);
+        ret[2][1] = (T)2 * (yz - wx);
+        ret[2][2] = (T)1 - (T)2 * (xx + yy);
+        return ret;
+    }
+    ///@fn ToHomogeneousMatrix @return mat<T,4> ToMatrix() embedded in the upper left of an identity matrix
+    mat<T,4> ToHomogeneousMatrix() const {
+        const mat<T,3> rot = ToMatrix();
+        mat<T,4> ret(1);
+        for(size_t col = 0; col < 3; col++){
+            for(size_t row = 0; row < 3; row++){ret[col][row] = rot[col][row];}
+        }
+        return ret;
+    }
+
+    //Operators
+
+    Q operator*(const Q& other) const {return HamiltonProd(other);}
+    void operator*=(const Q& other) {*this = HamiltonProd(other);}
+
+//static
+    ///@fn Identity
+    static Q Identity(){
+        return Q(0, 0, 0, 1);
+    }
+    ///@fn FromAxisAngle @param axis Must be unit length
+    static Q FromAxisAngle(const vec<T,3>& axis, const T& angle){
+        T sin, cos;
+        SinCos<T>(angle * (T)0.5, sin, cos);
+        return Q(axis[0] * sin, axis[1] * sin, axis[2] * sin, cos);
+    }
+    /**
+     * @fn FromRotation
+     * @param rot Angles in radians about the x, y and z axes, as taken by CreateRotationMatrix<T,3>
+     */
+    static Q FromRotation(const vec<T,3>& rot){
+        T sx, cx, sy, cy, sz, cz;
+        SinCos<T>(rot[0] * (T)0.5, sx, cx);
+        SinCos<T>(rot[1] * (T)0.5, sy, cy);
+        SinCos<T>(rot[2] * (T)0.5, sz, cz);
+        //x * y * z
+        return Q(
+            (sx * cy * cz) + (cx * sy * sz),
+            (cx * sy * cz) - (sx * cy * sz),
+            (cx * cy * sz) + (sx * sy * cz),
+            (cx * cy * cz) - (sx * sy * sz)
+        );
+    }
+    /**
+     * @fn Slerp
+     * @brief Spherical linear interpolation between unit quaternions a and b along the shorter arc.
+     * @remark Falls back to a normalized lerp when a and b are nearly parallel.
+     */
+    static Q Slerp(const Q& a, const Q& b, const T& t){
+        T cos_theta = a.Dot(b);
+        Q to = b;
+        if(cos_theta < (T)0){
+            cos_theta = -cos_theta;
+            to = Q(b.Prod((T)-1));
+        }
+        T wa, wb;
+        if(cos_theta > (T)0.9995){
+            wa = (T)1 - t;
+            wb = t;
+            return Q(a.Prod(wa).Sum(to.Prod(wb))).Normalized();
+        }
+        const T theta = (T)std::acos(cos_theta);
+        const T inv_sin = (T)1 / (T)std::sin(theta);
+        wa = (T)std::sin(((T)1 - t) * theta) * inv_sin;
+        wb = (T)std::sin(t * theta) * inv_sin;
+        return Q(a.Prod(wa).Sum(to.Prod(wb)));
+    }
+};
+
+using quatf = quat<float>;
+using quatd = quat<double>;
+
+}
+
+#endif // SUBSTD_QUAT_HPP
@@ -1,11 +1,26 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Movement checked one axis at a time, by casting rays from check points or sweeping a box against collidables.
+ * @include array list vec vec_soa mat mat_batch aabb affine interfaces math simd transform
+*/
+
 #ifndef SUBSTD_RAYCOLL_HPP
 #define SUBSTD_RAYCOLL_HPP
 
+#include<array>
+#include<list>
+
 #include<substd/vec.hpp>
+#include<substd/vec_soa.hpp>
 #include<substd/mat.hpp>
+#include<substd/mat_batch.hpp>
+#include<substd/aabb.hpp>
+#include<substd/affine.hpp>
 #include<substd/interfaces.hpp>
 #include<substd/math.hpp>
-#include<substd/util.hpp>
+#include<substd/simd.hpp>
+#include<substd/transform.hpp>
 
 namespace ss{
 
@@ -15,130 +30,331 @@ namespace ss{
  */
 template<typename T, size_t dim>
 std::list<vec<T,dim>> PointsBetween(const vec<T,dim>& a, const vec<T,dim>& b, const int& n){
-    vec<T,dim> jump = (b-a) * (1/((T)(num-1)));
     std::list<vec<T,dim>> list;
-    for(int i = 0; i<num; i++)
+    if(n == 1){list.push_back(a);}
+    if(n <= 1){return list;}
+    const vec<T,dim> jump = (b-a) * ((T)1/((T)(n-1)));
+    for(int i = 0; i < n; i++)
     {
-	    list.push_back(a+(jump*i));
+        list.push_back(a+(jump*(T)i));
     }
     return list;
 }
 
+/**
+ * @class IRayCollidable
+ * @brief Anything a ray cast along one axis can run into.
+ */
+template<typename T, size_t dim>
+class IRayCollidable {
+public:
+    virtual ~IRayCollidable(){}
+    /**
+     * @fn TrimMove
+     * @return T move, shortened if moving origin by move along axis dir would run into this.
+     */
+    virtual T TrimMove(const vec<T,dim>& origin, const size_t& dir, const T& move) const = 0;
+    /**
+     * @fn TrimMoves
+     * @brief TrimMove for count rays at once, all moving move along dir, their origins given as one lane per component.
+     * @return T move, shortened as far as the most restricted of the rays needs. By default each ray is trimmed
+     * by TrimMove in turn, overridden where testing a packet of rays together is faster.
+     */
+    virtual T TrimMoves(const std::array<const T*,dim>& origins, const size_t& count, const size_t& dir, const T& move) const {
+        T curr_move = move;
+        for(size_t k = 0; k < count && curr_move != 0; k++){
+            vec<T,dim> origin;
+            for(size_t i = 0; i < dim; i++){origin[i] = origins[i][k];}
+            curr_move = TrimMove(origin, dir, curr_move);
+        }
+        return curr_move;
+    }
+    /**
+     * @fn TrimBoxMove
+     * @return T move, shortened if moving box by move along axis dir would run into this. By default rays are cast
+     * from the corners of the box's leading face, exact only where overridden.
+     */
+    virtual T TrimBoxMove(const aabb<T,dim>& box, const size_t& dir, const T& move) const {
+        constexpr size_t corners = (size_t)1 << (dim - 1);
+        T lanes[dim][corners];
+        std::array<const T*,dim> origins;
+        for(size_t c = 0; c < corners; c++){
+            size_t bit = 0;
+            for(size_t i = 0; i < dim; i++){
+                if(i == dir){lanes[i][c] = (move > 0) ? box.max[i] : box.min[i];}
+                else {lanes[i][c] = ((c >> bit++) & 1) ? box.max[i] : box.min[i];}
+            }
+        }
+        for(size_t i = 0; i < dim; i++){origins[i] = lanes[i];}
+        return TrimMoves(origins, corners, dir, move);
+    }
+};
+
+namespace detail {
+    ///@fn LaneBounds @return aabb The bounds of the count points given as one lane per component
+    template<typename T, size_t dim>
+    aabb<T,dim> LaneBounds(const std::array<const T*,dim>& points, const size_t& count){
+        aabb<T,dim> ret = aabb<T,dim>::Empty();
+        for(size_t i = 0; i < dim; i++){
+            for(size_t k = 0; k < count; k++){
+                ret.min[i] = Min(ret.min[i], points[i][k]);
+                ret.max[i] = Max(ret.max[i], points[i][k]);
+            }
+        }
+        return ret;
+    }
+}
+
+/**
+ * @class IBoundedRayCollidable
+ * @brief A collidable nothing outside of its bounds can run into, for the broad phases in broadphase.hpp.
+ */
+template<typename T, size_t dim>
+class IBoundedRayCollidable : public virtual IRayCollidable<T,dim> {
+public:
+    ///@fn GetBounds @return aabb A box no ray outside of is trimmed by this
+    virtual aabb<T,dim> GetBounds() const = 0;
+};
+
 /**
  * @class RayMoveChecker
+ * @brief Checks a move against a collidable one axis at a time, casting a ray from each of the check points for that axis.
+ *
+ * Check points are in local space, kept one lane per component so each axis' points are transformed into place
+ * by GetGlobalMatrix() a SIMD pack at a time, then handed to the collidable as a packet by TrimMoves().
  */
 template<typename T, size_t dim>
 class RayMoveChecker : public virtual IPositionable<T, dim>, public virtual IMatrixCalculable<T,dim> {
 protected:
-    std::array<std::list<vec<T,dim>>dim> checkPoints;
+    std::array<vec_soa<T,dim>, dim> checkPoints;
 
 public:
-    virtual T AllowedMove(const size_t& dir, const T& move, const IRayCollidable& collidable){
-        if(move == 0){return move;}
-        MT curr_move = move;
-        for(auto iter = checkPoints[dir].begin(); iter != checkPoints[dir].end(); iter++){
-            curr_move = collidable->TrimMove(this->GetGlobalMatrix() * (*iter).Homogenized(), dir, curr_move);
+    /**
+     * @fn AllowedMove
+     * @return T The part of move along dir that no check point's ray is trimmed short of, with every check point
+     * displaced by offset first.
+     */
+    virtual T AllowedMove(const size_t& dir, const T& move, const IRayCollidable<T,dim>& collidable, const vec<T,dim>& offset = vec<T,dim>(0)) const {
+        const vec_soa<T,dim>& points = checkPoints[dir];
+        if(move == 0 || points.size() == 0){return move;}
+        mat<T,dim+1> global = this->GetGlobalMatrix();
+        for(size_t i = 0; i < dim; i++){global[dim][i] += offset[i];}
+        const AffineLanes<T,dim,true> transform(global);
+        //Transformed a block at a time on the stack, however many check points there are
+        constexpr size_t block = 4 * simd::pack<T>::width;
+        alignas(64) T lanes[dim][block];
+        std::array<const T*,dim> in, origins;
+        std::array<T*,dim> out;
+        for(size_t c = 0; c < dim; c++){
+            origins[c] = lanes[c];
+            out[c] = lanes[c];
+        }
+        T curr_move = move;
+        for(size_t first = 0; first < points.size(); first += block){
+            const size_t n = Min(block, points.size() - first);
+            for(size_t c = 0; c < dim; c++){in[c] = points.Lane(c) + first;}
+            transform.Apply(in, out, 0, n);
+            curr_move = collidable.TrimMoves(origins, n, dir, curr_move);
             if(curr_move == 0){return curr_move;}
         }
         return curr_move;
     }
-    virtual vec<T,dim> AllowedMove(const vec<T,dim>& move, const IRayCollidable& collidable) const {
-        vec<T,dim> curr_move = move;
+    /**
+     * @fn AllowedMove
+     * @return vec<T,dim> move trimmed an axis at a time, each axis checked from where the previous ones moved to.
+     */
+    virtual vec<T,dim> AllowedMove(const vec<T,dim>& move, const IRayCollidable<T,dim>& collidable) const {
+        vec<T,dim> curr_move(0);
         for(size_t curr_dir = 0; curr_dir < dim; curr_dir++){
-            curr_move[curr_dir] = AllowedMove(curr_dir, curr_move[curr_dir], collidable);
-            this->AddPosition(curr_move[curr_dir], curr_dir);
+            curr_move[curr_dir] = AllowedMove(curr_dir, move[curr_dir], collidable, curr_move);
         }
-        this->AddPosition(curr_move * -1);
         return curr_move;
     }
-    virtual vec<T,dim> MoveAsAllowed(const vec<T,dim>& move, const IRayCollidable& collidable) const {
-        vec<T,dim> curr_move = move;
-        for(size_t curr_dir = 0; curr_dir < dim; curr_dir++){
-            curr_move[curr_dir] = AllowedMove(curr_dir, curr_move[curr_dir], collidable);
-            this->AddPosition(curr_move[curr_dir], curr_dir);
-        }
-        return curr_move;
+    ///@fn MoveAsAllowed Moves by AllowedMove(move, collidable) @return vec<T,dim> The move made
+    virtual vec<T,dim> MoveAsAllowed(const vec<T,dim>& move, const IRayCollidable<T,dim>& collidable) {
+        const vec<T,dim> allowed = AllowedMove(move, collidable);
+        this->SetPosition(this->GetPosition() + allowed);
+        return allowed;
     }
 };
 
-///@class RectRayMoveChecker
+/**
+ * @class AABBRayMoveChecker
+ * @brief Check points along the edges of the unit square centred on the origin, horizontal_res along the top and
+ * bottom for vertical moves and vertical_res down each side for horizontal ones.
+ */
 template<typename T>
 class AABBRayMoveChecker : public RayMoveChecker<T,2> {
 public:
-    RectRayMoveChecker(const int& horizontal_res, const int& vertical_res) {
-        std::list<T> r = PointsBetween({0.5, -0.5}, [0.5, 0.5], vertical_res);
-        std::list<T> l = PointsBetween({-0.5, -0.5}, [-0.5, 0.5], vertical_res);
-        std::list<T> t = PointsBetween({-0.5, 0.5}, [0.5, 0.5], horizontal_res);
-        std::list<T> b = PointsBetween({0.5, -0.5}, [-0.5, -0.5], horizontal_res);
-        for(int v = 0; v < vertical_res; v++){
-            RayMoveChecker<T,2>::checkPoints[0].push_back(r[v]);
-            RayMoveChecker<T,2>::checkPoints[0].push_back[l[v]];
-        }
-        for(int h = 0; h < horizontal_res; h++){    
-            RayMoveChecker<T,2>::checkPoints[1].push_back(t[h]);
-            RayMoveChecker<T,2>::checkPoints[1].push_back[b[h]];
+    AABBRayMoveChecker(const int& horizontal_res, const int& vertical_res) {
+        const T h = (T)0.5;
+        const std::list<vec<T,2>> r = PointsBetween<T,2>(vec<T,2>{h, -h}, vec<T,2>{h, h}, vertical_res);
+        const std::list<vec<T,2>> l = PointsBetween<T,2>(vec<T,2>{-h, -h}, vec<T,2>{-h, h}, vertical_res);
+        const std::list<vec<T,2>> t = PointsBetween<T,2>(vec<T,2>{-h, h}, vec<T,2>{h, h}, horizontal_res);
+        const std::list<vec<T,2>> b = PointsBetween<T,2>(vec<T,2>{h, -h}, vec<T,2>{-h, -h}, horizontal_res);
+        for(const auto& lists : {std::make_pair(0, &r), std::make_pair(0, &l), std::make_pair(1, &t), std::make_pair(1, &b)}){
+            for(const vec<T,2>& p : *lists.second){RayMoveChecker<T,2>::checkPoints[lists.first].push_back(p);}
         }
     }
 };
 
 /**
- * @class IRayCollidable
+ * @class SweptAABBMoveChecker
+ * @brief Checks moves by sweeping a whole box along each axis with TrimBoxMove(), rather than casting rays from
+ * points sampled along its edges, so nothing slips between samples and the cost is one test per collidable.
+ *
+ * The box is given in local space and moved into place by GetGlobalMatrix(), the checked box being the bounds
+ * of its transformed corners.
  */
 template<typename T, size_t dim>
-class IRayCollidable {
+class SweptAABBMoveChecker : public RayMoveChecker<T,dim> {
+protected:
+    aabb<T,dim> localBox;
+
 public:
-    virtual T TrimMove(const vec<T,dim>& origin, const size_t& dir, const T& move) const = 0;
+    ///@brief Constructor, checking the unit box centred on the origin
+    SweptAABBMoveChecker() : localBox(vec<T,dim>((T)-0.5), vec<T,dim>((T)0.5)) {}
+    SweptAABBMoveChecker(const aabb<T,dim>& box) : localBox(box) {}
+
+    ///@fn GetCheckedBox @return aabb The box moves are checked for, in global space
+    aabb<T,dim> GetCheckedBox() const {
+        const affine<T,dim> global(this->GetGlobalMatrix());
+        aabb<T,dim> ret = aabb<T,dim>::Empty();
+        for(size_t c = 0; c < ((size_t)1 << dim); c++){
+            vec<T,dim> corner;
+            for(size_t i = 0; i < dim; i++){corner[i] = ((c >> i) & 1) ? localBox.max[i] : localBox.min[i];}
+            ret.Expand(global.TransformPoint(corner));
+        }
+        return ret;
+    }
+
+    T AllowedMove(const size_t& dir, const T& move, const IRayCollidable<T,dim>& collidable, const vec<T,dim>& offset = vec<T,dim>(0)) const override {
+        if(move == 0){return move;}
+        const aabb<T,dim> box = GetCheckedBox();
+        return collidable.TrimBoxMove(aabb<T,dim>(box.min + offset, box.max + offset), dir, move);
+    }
+    using RayMoveChecker<T,dim>::AllowedMove;
 };
 
-///@class RayCollisionGroup
+///@class RayCollisionGroup Trims against every collidable added, one after the other
 template<typename T, size_t dim>
 class RayCollisionGroup : public IRayCollidable<T,dim> {
 protected:
     std::list<IRayCollidable<T,dim>*> collidables;
 public:
     void AddCollidable(IRayCollidable<T,dim>* coll){collidables.push_back(coll);}
-    void RemoveCollidablee(IRayCollidable<T,dim>* coll){collidables.remove(coll);}
+    void RemoveCollidable(IRayCollidable<T,dim>* coll){collidables.remove(coll);}
 
     T TrimMove(const vec<T,dim>& origin, const size_t& dir, const T& move) const override {
         T curr_move = move;
         for(auto iter = collidables.begin(); iter != collidables.end(); iter++){
             curr_move = (*iter)->TrimMove(origin, dir, curr_move);
+            if(curr_move == 0){break;}
         }
         return curr_move;
     }
-};
-
-///@class AABBRayCollidable
-template<typename T>
-class AABBRayCollidable : public virtual IRayCollidable<T,2>, public Plug<T,2> {
-protected:
-    T TrimHor(const T& origin, const T& move){
-
+    T TrimMoves(const std::array<const T*,dim>& origins, const size_t& count, const size_t& dir, const T& move) const override {
+        T curr_move = move;
+        for(auto iter = collidables.begin(); iter != collidables.end(); iter++){
+            curr_move = (*iter)->TrimMoves(origins, count, dir, curr_move);
+            if(curr_move == 0){break;}
+        }
+        return curr_move;
     }
-    T TrimVer(const T& origin, const T& move){
-        
+    T TrimBoxMove(const aabb<T,dim>& box, const size_t& dir, const T& move) const override {
+        T curr_move = move;
+        for(auto iter = collidables.begin(); iter != collidables.end(); iter++){
+            curr_move = (*iter)->TrimBoxMove(box, dir, curr_move);
+            if(curr_move == 0){break;}
+        }
+        return curr_move;
     }
+};
 
-public:
-    T TrimMove(const vec<T,2>& origin, const size_t& dir, const T& move) const override {
-        if(dir == 0 && ss::ExclusiveBetween()){
-            T half_ver_scale = GetScale(1) * 0.5;
-            T ver_pos = GetPosition(1);
-            if(ss::ExclusiveBetween(ver_pos-half_ver_scale, ver_pos+half_ver_scale, origin[1])){
-                return TrimHor(origin[0], move);
-            }
+namespace detail {
+    //low and high are the box's faces along the move's axis, origin the leading edge of what moves
+    template<typename T>
+    T TrimAxis(const T& origin, const T& move, const T& low, const T& high){
+        if(move > 0 && origin <= low){return Min<T>(move, low - origin);}
+        if(move < 0 && origin >= high){return Max<T>(move, high - origin);}
+        return move;
+    }
+    ///@fn TrimRayBox The move a ray may make before crossing into bounds, see AABBRayCollidable
+    template<typename T, size_t dim>
+    T TrimRayBox(const aabb<T,dim>& bounds, const vec<T,dim>& origin, const size_t& dir, const T& move){
+        for(size_t i = 0; i < dim; i++){
+            if(i != dir && !ss::ExclusiveBetween(bounds.min[i], bounds.max[i], origin[i])){return move;}
         }
-        else{
-            T half_hor_scale = GetScale(0) * 0.5;
-            T hor_pos = GetPosition(0);
-            if(ss::ExclusiveBetween(hor_pos-half_hor_scale, hor_pos+half_hor_scale, origin[0])){
-                return TrimVer(origin[1], move);
+        return TrimAxis(origin[dir], move, bounds.min[dir], bounds.max[dir]);
+    }
+    ///@fn TrimRaysBox TrimRayBox for a SIMD pack of rays at a time, each lane's move picked without branching then reduced
+    template<typename T, size_t dim>
+    T TrimRaysBox(const aabb<T,dim>& bounds, const std::array<const T*,dim>& origins, const size_t& count, const size_t& dir, const T& move){
+        if(move == 0){return move;}
+        const bool forward = move > 0;
+        const T face = forward ? bounds.min[dir] : bounds.max[dir];
+        T curr_move = move;
+        simd::ForEachPack<T>(count, [&](auto p, const size_t& i){
+            using P = decltype(p);
+            const typename P::reg along = P::Load(origins[dir] + i);
+            const typename P::reg face_reg = P::Set1(face);
+            //Only rays that start on the near side of the face reach it
+            auto hits = forward ? P::LessEqual(along, face_reg) : P::LessEqual(face_reg, along);
+            for(size_t axis = 0; axis < dim; axis++){
+                if(axis == dir){continue;}
+                const typename P::reg across = P::Load(origins[axis] + i);
+                hits = P::And(hits, P::And(P::Less(P::Set1(bounds.min[axis]), across), P::Less(across, P::Set1(bounds.max[axis]))));
             }
+            const typename P::reg trimmed = P::Select(hits, P::Sub(face_reg, along), P::Set1(curr_move));
+            alignas(64) T lanes[P::width];
+            P::Store(lanes, forward ? P::Min(trimmed, P::Set1(curr_move)) : P::Max(trimmed, P::Set1(curr_move)));
+            for(size_t k = 0; k < P::width; k++){curr_move = forward ? Min(curr_move, lanes[k]) : Max(curr_move, lanes[k]);}
+        });
+        return curr_move;
+    }
+    ///@fn TrimBoxBox The move box may make before running into bounds, the slab test of one swept box against the other
+    template<typename T, size_t dim>
+    T TrimBoxBox(const aabb<T,dim>& bounds, const aabb<T,dim>& box, const size_t& dir, const T& move){
+        for(size_t i = 0; i < dim; i++){
+            if(i != dir && !(box.min[i] < bounds.max[i] && bounds.min[i] < box.max[i])){return move;}
         }
-        return move;
+        return TrimAxis((move > 0) ? box.max[dir] : box.min[dir], move, bounds.min[dir], bounds.max[dir]);
+    }
+}
+
+/**
+ * @class AABBRayCollidable
+ * @brief A solid axis aligned box, its position the centre and its scale the size.
+ *
+ * A ray is stopped at the face it would cross, if its origin is strictly within the box's extent on every
+ * other axis, and a swept box likewise if the two overlap with some thickness on every other axis, so boxes
+ * side by side slide past each other. Anything starting inside is never trimmed, so it can move out.
+ *
+ * @tparam dim number of dimensions, 2 by default
+ */
+template<typename T, size_t dim = 2>
+class AABBRayCollidable : public virtual IBoundedRayCollidable<T,dim>, public Plug<T,dim> {
+public:
+    AABBRayCollidable() {}
+    AABBRayCollidable(const vec<T,dim>& pos, const vec<T,dim>& scale) : Plug<T,dim>(pos, scale) {}
+
+    aabb<T,dim> GetBounds() const override {
+        return aabb<T,dim>::FromCenter(this->GetPosition(), this->GetScale());
+    }
+
+    T TrimMove(const vec<T,dim>& origin, const size_t& dir, const T& move) const override {
+        return detail::TrimRayBox(GetBounds(), origin, dir, move);
+    }
+    ///@fn TrimMoves TrimMove for a SIMD pack of rays at a time
+    T TrimMoves(const std::array<const T*,dim>& origins, const size_t& count, const size_t& dir, const T& move) const override {
+        return detail::TrimRaysBox(GetBounds(), origins, count, dir, move);
+    }
+    ///@fn TrimBoxMove Exact, the slab test of the swept box against this, so the same work whatever either's size
+    T TrimBoxMove(const aabb<T,dim>& box, const size_t& dir, const T& move) const override {
+        return detail::TrimBoxBox(GetBounds(), box, dir, move);
     }
 };
 
 }
 
-#endif
\ No newline at end of file
+#endif//SUBSTD_RAYCOLL_HPP
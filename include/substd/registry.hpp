@@ -0,0 +1,449 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Registries of live objects: dense arrays with O(1) insertion and removal by handle, optionally sharded by
+ * thread, and a lock free registry for concurrent construction.
+ * @include algorithm atomic cstdint mutex vector parallel
+*/
+
+#ifndef SUBSTD_REGISTRY_HPP
+#define SUBSTD_REGISTRY_HPP
+
+#include<algorithm>
+#include<atomic>
+#include<cstdint>
+#include<mutex>
+#include<vector>
+
+#include<substd/parallel.hpp>
+
+namespace ss
+{
+
+#ifndef SS_CONCURRENT_REGISTRY_SEGMENT
+///@brief The slots in the first segment of a ConcurrentRegistry, each segment after doubling it. A power of two.
+#define SS_CONCURRENT_REGISTRY_SEGMENT 1024
+#endif
+
+#ifndef SS_REGISTRY_SHARDS
+///@brief The default number of shards a ShardedRegistry spreads its threads across.
+#define SS_REGISTRY_SHARDS 8
+#endif
+
+/**
+ * @class RegistryHandle
+ * @brief Names an entry of a registry for as long as it is registered, wherever removals move it to.
+ *
+ * The generation changes every time an index is reused, so a handle to a removed entry stays invalid.
+ */
+struct RegistryHandle {
+    ///@brief No entry, what a default constructed handle holds
+    static constexpr uint32_t NONE = ~(uint32_t)0;
+
+    uint32_t index = NONE;
+    uint32_t generation = 0;
+
+    bool operator==(const RegistryHandle& other) const {return index == other.index && generation == other.generation;}
+    bool operator!=(const RegistryHandle& other) const {return !(*this == other);}
+};
+
+/**
+ * @class DenseRegistry
+ * @brief Pointers to registered objects kept back to back, for iteration at the speed of a plain array.
+ *
+ * Insert() appends and Erase() moves the last entry into the gap (swap and pop), both O(1), with each
+ * handle's current slot looked up in a side table. Removals reorder the entries, so iteration order is
+ * not registration order. Not thread safe, see ShardedRegistry.
+ *
+ * @tparam T The type of object registered, stored as T*
+ */
+template<typename T>
+class DenseRegistry {
+public:
+    using handle_type = RegistryHandle;
+    using const_iterator = typename std::vector<T*>::const_iterator;
+
+protected:
+    std::vector<T*> items;
+    ///@brief The handle index of each slot of items
+    std::vector<uint32_t> owners;
+    ///@brief By handle index: the slot of a registered entry, or the next free index for a free one
+    std::vector<uint32_t> slots;
+    std::vector<uint32_t> generations;
+    uint32_t free_head = RegistryHandle::NONE;
+
+public:
+    DenseRegistry() {}
+    DenseRegistry(const DenseRegistry&) = delete;
+    DenseRegistry& operator=(const DenseRegistry&) = delete;
+
+    ///@fn Insert @return handle_type The handle t is registered under
+    handle_type Insert(T* t){
+        uint32_t index = free_head;
+        if(index != RegistryHandle::NONE){
+            free_head = slots[index];
+        }
+        else {
+            index = (uint32_t)slots.size();
+            slots.push_back(0);
+            generations.push_back(0);
+        }
+        slots[index] = (uint32_t)items.size();
+        items.push_back(t);
+        owners.push_back(index);
+        return handle_type{index, generations[index]};
+    }
+    /**
+     * @fn Erase
+     * @brief Removes the entry of h, the last entry taking its slot.
+     * @return bool False if h was not registered
+     */
+    bool Erase(const handle_type& h){
+        if(!Valid(h)){return false;}
+        const uint32_t slot = slots[h.index];
+        items[slot] = items.back();
+        owners[slot] = owners.back();
+        slots[owners[slot]] = slot;
+        items.pop_back();
+        owners.pop_back();
+        generations[h.index]++;
+        slots[h.index] = free_head;
+        free_head = h.index;
+        return true;
+    }
+
+    ///@fn Valid @return bool Whether h names a registered entry
+    bool Valid(const handle_type& h) const {return h.index < generations.size() && generations[h.index] == h.generation;}
+    ///@fn Get @return T* The object registered under h, nullptr if it is no longer registered
+    T* Get(const handle_type& h) const {return Valid(h) ? items[slots[h.index]] : nullptr;}
+
+    ///@fn Reserve Makes room for count entries without reallocating
+    void Reserve(const size_t& count){
+        items.reserve(count);
+        owners.reserve(count);
+        slots.reserve(count);
+        generations.reserve(count);
+    }
+
+    size_t size() const {return items.size();}
+    bool empty() const {return items.empty();}
+    T* operator[](const size_t& slot) const {return items[slot];}
+    T* const* data() const {return items.data();}
+    const_iterator begin() const {return items.begin();}
+    const_iterator end() const {return items.end();}
+
+    ///@fn ForEach Calls f(T*) for every entry, which must not register or remove anything meanwhile
+    template<typename F>
+    void ForEach(F f) const {
+        for(T* t : items){f(t);}
+    }
+    /**
+     * @fn ForEachParallel
+     * @brief Calls f(T*) for every entry, split across up to threads threads (see ParallelFor).
+     * f runs concurrently on different entries and nothing may be registered or removed meanwhile.
+     */
+    template<typename F>
+    void ForEachParallel(F f, const size_t& threads = 0) const {
+        ParallelFor(items.size(), threads, [&](const size_t& begin, const size_t& end){
+            for(size_t i = begin; i < end; i++){f(items[i]);}
+        });
+    }
+    ///@fn ForEachParallel As above on the threads of pool
+    template<typename F>
+    void ForEachParallel(ThreadPool& pool, F f) const {
+        pool.ParallelFor(items.size(), [&](const size_t& begin, const size_t& end){
+            for(size_t i = begin; i < end; i++){f(items[i]);}
+        });
+    }
+};
+
+namespace detail
+{
+
+///@fn ThreadIndex @return size_t A small number unique to the calling thread, handed out in the order threads first ask
+inline size_t ThreadIndex(){
+    static std::atomic<size_t> next{0};
+    thread_local const size_t index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+///@fn FloorLog2 @return unsigned The index of the highest set bit of x, which must not be 0
+inline unsigned FloorLog2(const uint64_t& x){
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - (unsigned)__builtin_clzll(x);
+#else
+    unsigned ret = 0;
+    for(uint64_t y = x; y > 1; y >>= 1){ret++;}
+    return ret;
+#endif
+}
+
+}
+
+/**
+ * @class ShardedRegistry
+ * @brief shards DenseRegistries behind a mutex each, threads registering into different shards so concurrent
+ * construction rarely contends.
+ *
+ * Any thread may remove any entry: the shard is part of the handle. Iteration visits the shards one at a
+ * time, each locked while it is visited.
+ *
+ * @tparam T The type of object registered, stored as T*
+ * @tparam shards The number of shards, ideally at least the number of threads registering at once
+ */
+template<typename T, size_t shards = SS_REGISTRY_SHARDS>
+class ShardedRegistry {
+    static_assert(shards > 0, "ss::ShardedRegistry requires at least one shard!");
+public:
+    using handle_type = RegistryHandle;
+
+protected:
+    //Each on its own cache lines, so threads working in neighbouring shards do not slow each other down
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        DenseRegistry<T> registry;
+    };
+    Shard shard_array[shards];
+
+    //A shard's handle index i becomes i * shards + shard
+    static handle_type Local(const handle_type& h){return handle_type{h.index / (uint32_t)shards, h.generation};}
+
+public:
+    ShardedRegistry() {}
+    ShardedRegistry(const ShardedRegistry&) = delete;
+    ShardedRegistry& operator=(const ShardedRegistry&) = delete;
+
+    ///@fn Insert @return handle_type The handle t is registered under, in the calling thread's shard
+    handle_type Insert(T* t){
+        const size_t shard = detail::ThreadIndex() % shards;
+        std::lock_guard<std::mutex> lock(shard_array[shard].mutex);
+        const handle_type h = shard_array[shard].registry.Insert(t);
+        return handle_type{(h.index * (uint32_t)shards) + (uint32_t)shard, h.generation};
+    }
+    ///@fn Erase @return bool False if h was not registered
+    bool Erase(const handle_type& h){
+        if(h.index == RegistryHandle::NONE){return false;}
+        Shard& shard = shard_array[h.index % shards];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.registry.Erase(Local(h));
+    }
+    ///@fn Get @return T* The object registered under h, nullptr if it is no longer registered
+    T* Get(const handle_type& h) const {
+        if(h.index == RegistryHandle::NONE){return nullptr;}
+        const Shard& shard = shard_array[h.index % shards];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.registry.Get(Local(h));
+    }
+
+    ///@fn size @return size_t The entries across every shard, which other threads may be changing
+    size_t size() const {
+        size_t count = 0;
+        for(const Shard& shard : shard_array){
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            count += shard.registry.size();
+        }
+        return count;
+    }
+    bool empty() const {return size() == 0;}
+
+    ///@fn ForEach Calls f(T*) for every entry, f must not register or remove anything itself
+    template<typename F>
+    void ForEach(F f) const {
+        for(const Shard& shard : shard_array){
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.registry.ForEach(f);
+        }
+    }
+    ///@fn ForEachParallel Calls f(T*) for every entry, each shard split across the threads of pool in turn
+    template<typename F>
+    void ForEachParallel(ThreadPool& pool, F f) const {
+        for(const Shard& shard : shard_array){
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.registry.ForEachParallel(pool, f);
+        }
+    }
+    ///@fn ForEachParallel As above on up to threads threads (see ParallelFor)
+    template<typename F>
+    void ForEachParallel(F f, const size_t& threads = 0) const {
+        for(const Shard& shard : shard_array){
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.registry.ForEachParallel(f, threads);
+        }
+    }
+};
+
+/**
+ * @class ConcurrentRegistry
+ * @brief A registry any number of threads register into and remove from at once without locking.
+ *
+ * Entries live in slots allocated a segment at a time, each segment twice the size of the last, so a slot
+ * never moves. Insert() reuses a removed slot if one is free and otherwise claims the next with an atomic
+ * tail. Erase() leaves a null tombstone, moves the slot's generation on and pushes the slot on a lock free
+ * free list, its head tagged against ABA. Segments are only freed with the registry, so a thread reading a
+ * slot another has just removed or reused still reads valid memory and nothing has to wait for readers.
+ *
+ * ForEach() visits a snapshot, the slots claimed when it starts, and never blocks writers: entries
+ * registered and not removed throughout are visited once, ones added or removed meanwhile may or may not be.
+ *
+ * @tparam T The type of object registered, stored as T*
+ */
+template<typename T>
+class ConcurrentRegistry {
+public:
+    using handle_type = RegistryHandle;
+
+protected:
+    static constexpr uint64_t SEGMENT = SS_CONCURRENT_REGISTRY_SEGMENT;
+    static_assert((SEGMENT & (SEGMENT - 1)) == 0, "SS_CONCURRENT_REGISTRY_SEGMENT must be a power of two!");
+    //Enough doubling segments for every index a RegistryHandle can hold
+    static constexpr size_t SEGMENTS = 33;
+
+    struct Slot {
+        std::atomic<T*> item;
+        std::atomic<uint32_t> generation;
+        ///@brief The slot below this one on the free list
+        std::atomic<uint32_t> next;
+    };
+
+    std::atomic<Slot*> segments[SEGMENTS] = {};
+    std::atomic<uint64_t> tail{0};
+    std::atomic<size_t> count{0};
+    ///@brief The top free slot in the low 32 bits, RegistryHandle::NONE for none, and a tag bumped by every change above
+    std::atomic<uint64_t> free_head{RegistryHandle::NONE};
+
+    //Segment k holds slots [SEGMENT * (2^k - 1), SEGMENT * (2^(k+1) - 1))
+    static size_t SegmentOf(const uint64_t& index){return detail::FloorLog2((index / SEGMENT) + 1);}
+    static uint64_t SegmentStart(const size_t& k){return SEGMENT * ((1ull << k) - 1);}
+    static uint64_t SegmentSize(const size_t& k){return SEGMENT << k;}
+
+    ///@fn At @return Slot& Slot index, allocating its segment if nobody has yet
+    Slot& At(const uint64_t& index){
+        const size_t k = SegmentOf(index);
+        Slot* segment = segments[k].load(std::memory_order_acquire);
+        if(segment == nullptr){
+            //Value initialized, so every slot starts empty; whoever loses the race frees theirs
+            Slot* fresh = new Slot[SegmentSize(k)]();
+            if(segments[k].compare_exchange_strong(segment, fresh, std::memory_order_acq_rel, std::memory_order_acquire)){
+                segment = fresh;
+            }
+            else {
+                delete[] fresh;
+            }
+        }
+        return segment[index - SegmentStart(k)];
+    }
+
+    uint32_t PopFree(){
+        uint64_t head = free_head.load(std::memory_order_acquire);
+        while((uint32_t)head != RegistryHandle::NONE){
+            const uint32_t next = At((uint32_t)head).next.load(std::memory_order_relaxed);
+            const uint64_t replacement = (((head >> 32) + 1) << 32) | next;
+            if(free_head.compare_exchange_weak(head, replacement, std::memory_order_acquire, std::memory_order_acquire)){
+                return (uint32_t)head;
+            }
+        }
+        return RegistryHandle::NONE;
+    }
+    void PushFree(const uint32_t& index){
+        Slot& slot = At(index);
+        uint64_t head = free_head.load(std::memory_order_relaxed);
+        uint64_t replacement;
+        do {
+            slot.next.store((uint32_t)head, std::memory_order_relaxed);
+            replacement = (((head >> 32) + 1) << 32) | index;
+        } while(!free_head.compare_exchange_weak(head, replacement, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    //f(T*) for each live entry among slots [begin, end), walking whole segments
+    template<typename F>
+    void ForRange(uint64_t begin, const uint64_t& end, F& f) const {
+        while(begin < end){
+            const size_t k = SegmentOf(begin);
+            const uint64_t segment_end = std::min(end, SegmentStart(k) + SegmentSize(k));
+            const Slot* segment = segments[k].load(std::memory_order_acquire);
+            if(segment != nullptr){
+                for(uint64_t i = begin; i < segment_end; i++){
+                    T* t = segment[i - SegmentStart(k)].item.load(std::memory_order_acquire);
+                    if(t != nullptr){f(t);}
+                }
+            }
+            begin = segment_end;
+        }
+    }
+
+public:
+    ConcurrentRegistry() {}
+    ConcurrentRegistry(const ConcurrentRegistry&) = delete;
+    ConcurrentRegistry& operator=(const ConcurrentRegistry&) = delete;
+    ~ConcurrentRegistry(){
+        for(auto& segment : segments){delete[] segment.load();}
+    }
+
+    ///@fn Insert @return handle_type The handle t is registered under
+    handle_type Insert(T* t){
+        uint32_t index = PopFree();
+        if(index == RegistryHandle::NONE){index = (uint32_t)tail.fetch_add(1, std::memory_order_relaxed);}
+        Slot& slot = At(index);
+        const uint32_t generation = slot.generation.load(std::memory_order_relaxed);
+        slot.item.store(t, std::memory_order_release);
+        count.fetch_add(1, std::memory_order_relaxed);
+        return handle_type{index, generation};
+    }
+    /**
+     * @fn Erase
+     * @brief Tombstones the entry of h and frees its slot for reuse. Each handle must be erased by one thread only.
+     * @return bool False if h was not registered
+     */
+    bool Erase(const handle_type& h){
+        if(h.index == RegistryHandle::NONE || h.index >= tail.load(std::memory_order_acquire)){return false;}
+        Slot& slot = At(h.index);
+        if(slot.generation.load(std::memory_order_relaxed) != h.generation){return false;}
+        slot.item.store(nullptr, std::memory_order_release);
+        slot.generation.fetch_add(1, std::memory_order_release);
+        count.fetch_sub(1, std::memory_order_relaxed);
+        PushFree(h.index);
+        return true;
+    }
+    ///@fn Get @return T* The object registered under h, nullptr if it is no longer registered
+    T* Get(const handle_type& h) const {
+        if(h.index == RegistryHandle::NONE || h.index >= tail.load(std::memory_order_acquire)){return nullptr;}
+        const Slot* segment = segments[SegmentOf(h.index)].load(std::memory_order_acquire);
+        if(segment == nullptr){return nullptr;}
+        const Slot& slot = segment[h.index - SegmentStart(SegmentOf(h.index))];
+        //Only trusted if the generation was the same on both sides of reading the item
+        if(slot.generation.load(std::memory_order_acquire) != h.generation){return nullptr;}
+        T* t = slot.item.load(std::memory_order_acquire);
+        return (slot.generation.load(std::memory_order_acquire) == h.generation) ? t : nullptr;
+    }
+
+    ///@fn size @return size_t The entries registered, which other threads may be changing
+    size_t size() const {return count.load(std::memory_order_relaxed);}
+    bool empty() const {return size() == 0;}
+    ///@fn Capacity @return size_t The slots claimed so far, live or free
+    size_t Capacity() const {return (size_t)tail.load(std::memory_order_acquire);}
+
+    ///@fn ForEach Calls f(T*) for every entry in a snapshot of the registry, see the class description
+    template<typename F>
+    void ForEach(F f) const {
+        ForRange(0, tail.load(std::memory_order_acquire), f);
+    }
+    ///@fn Snapshot Replaces out's contents with the entries ForEach would visit
+    void Snapshot(std::vector<T*>& out) const {
+        out.clear();
+        ForEach([&out](T* t){out.push_back(t);});
+    }
+    ///@fn ForEachParallel As ForEach, the snapshot split across up to threads threads (see ParallelFor)
+    template<typename F>
+    void ForEachParallel(F f, const size_t& threads = 0) const {
+        ParallelFor(Capacity(), threads, [&](const size_t& begin, const size_t& end){ForRange(begin, end, f);});
+    }
+    ///@fn ForEachParallel As above on the threads of pool
+    template<typename F>
+    void ForEachParallel(ThreadPool& pool, F f) const {
+        pool.ParallelFor(Capacity(), [&](const size_t& begin, const size_t& end){ForRange(begin, end, f);});
+    }
+};
+
+}
+
+#endif // SUBSTD_REGISTRY_HPP
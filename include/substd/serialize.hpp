@@ -0,0 +1,266 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Compact little endian binary serialization of vec and mat, singly and as arrays behind a one time header.
+ * @include cstddef cstdint cstring type_traits vector vec mat io endian
+*/
+
+#ifndef SUBSTD_SERIALIZE_HPP
+#define SUBSTD_SERIALIZE_HPP
+
+#include<cstddef>
+#include<cstdint>
+#include<cstring>
+#include<type_traits>
+#include<vector>
+
+#include<substd/vec.hpp>
+#include<substd/mat.hpp>
+#include<substd/io.hpp>
+#include<substd/endian.hpp>
+
+namespace ss
+{
+
+namespace detail
+{
+
+///@typedef bits_type The unsigned integer holding the bit pattern of an arithmetic T
+template<typename T>
+using bits_type = std::conditional_t<sizeof(T) == 1, uint8_t,
+    std::conditional_t<sizeof(T) == 2, uint16_t,
+    std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+template<typename T>
+constexpr bool IsSerializable(){
+    return std::is_arithmetic_v<T> && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+}
+
+///@fn WriteScalar Writes the bit pattern of t, so floating point values round trip exactly, NaN payloads included
+template<typename T>
+inline void WriteScalar(ByteWriter& w, const T& t){
+    static_assert(IsSerializable<T>(), "ss::Write() requires an arithmetic type of 1, 2, 4 or 8 bytes!");
+    bits_type<T> u;
+    std::memcpy(&u, &t, sizeof(T));
+    if constexpr(sizeof(T) == 1) {w.WriteU8(u);}
+    else if constexpr(sizeof(T) == 2) {w.WriteLEU16(u);}
+    else if constexpr(sizeof(T) == 4) {w.WriteLEU32(u);}
+    else {w.WriteLEU64(u);}
+}
+
+///@fn ReadScalar
+template<typename T>
+inline T ReadScalar(ByteReader& r){
+    static_assert(IsSerializable<T>(), "ss::Read() requires an arithmetic type of 1, 2, 4 or 8 bytes!");
+    bits_type<T> u;
+    if constexpr(sizeof(T) == 1) {u = r.ReadU8();}
+    else if constexpr(sizeof(T) == 2) {u = r.ReadLEU16();}
+    else if constexpr(sizeof(T) == 4) {u = r.ReadLEU32();}
+    else {u = r.ReadLEU64();}
+    T t;
+    std::memcpy(&t, &u, sizeof(T));
+    return t;
+}
+
+///@fn WriteScalars Writes count Ts, a single copy of the payload on little endian hosts
+template<typename T>
+inline void WriteScalars(ByteWriter& w, const T* data, const size_t& count){
+    if constexpr(HOST_BIG_ENDIAN) {
+        for(size_t i = 0; i < count; i++){WriteScalar<T>(w, data[i]);}
+    }
+    else {
+        w.WriteBytes(data, count * sizeof(T));
+    }
+}
+
+///@fn ReadScalars @return size_t The number of Ts read into data
+template<typename T>
+inline size_t ReadScalars(ByteReader& r, T* data, const size_t& count){
+    const size_t n = r.ReadBytes(data, count * sizeof(T)) / sizeof(T);
+    if constexpr(HOST_BIG_ENDIAN) {ByteSwapArray<bits_type<T>>(data, data, n);}
+    return n;
+}
+
+}
+
+/**
+ * @class ArrayHeader
+ * @brief Precedes the payload of WriteArray: the scalar type, the shape of each element and how many there are.
+ *
+ * 16 bytes, little endian: the magic "SSAR", the scalar kind and size in bytes, rows and columns
+ * (columns is 1 for a vec), then the element count as a uint64.
+ */
+struct ArrayHeader {
+    ///@brief "SSAR" read as a little endian uint32
+    static constexpr uint32_t MAGIC = 0x52415353u;
+    enum class Kind : uint8_t {Unsigned = 0, Signed = 1, Float = 2};
+
+    Kind kind = Kind::Unsigned;
+    uint8_t scalar_size = 0;
+    uint8_t rows = 0;
+    uint8_t cols = 0;
+    uint64_t count = 0;
+
+    ///@fn Of @return ArrayHeader The header of count r by c elements of T
+    template<typename T, size_t r, size_t c>
+    static ArrayHeader Of(const uint64_t& count){
+        static_assert(detail::IsSerializable<T>(), "ss::ArrayHeader requires an arithmetic type of 1, 2, 4 or 8 bytes!");
+        static_assert(r < 256 && c < 256, "ss::ArrayHeader stores the shape in a byte per dimension!");
+        ArrayHeader h;
+        h.kind = std::is_floating_point_v<T> ? Kind::Float : (std::is_signed_v<T> ? Kind::Signed : Kind::Unsigned);
+        h.scalar_size = (uint8_t)sizeof(T);
+        h.rows = (uint8_t)r;
+        h.cols = (uint8_t)c;
+        h.count = count;
+        return h;
+    }
+
+    ///@fn Matches @return bool Whether the payload holds r by c elements of T
+    template<typename T, size_t r, size_t c>
+    bool Matches() const {
+        const ArrayHeader expected = Of<T, r, c>(count);
+        return kind == expected.kind && scalar_size == expected.scalar_size && rows == expected.rows && cols == expected.cols;
+    }
+
+    ///@fn PayloadSize @return uint64_t The bytes following the header
+    uint64_t PayloadSize() const {return count * scalar_size * rows * cols;}
+};
+
+///@fn Write Writes h
+inline void Write(ByteWriter& w, const ArrayHeader& h){
+    w.WriteLEU32(ArrayHeader::MAGIC);
+    w.WriteU8((uint8_t)h.kind);
+    w.WriteU8(h.scalar_size);
+    w.WriteU8(h.rows);
+    w.WriteU8(h.cols);
+    w.WriteLEU64(h.count);
+}
+///@fn Read @return bool Whether a whole header with the right magic was read
+inline bool Read(ByteReader& r, ArrayHeader& h){
+    const uint32_t magic = r.ReadLEU32();
+    h.kind = (ArrayHeader::Kind)r.ReadU8();
+    h.scalar_size = r.ReadU8();
+    h.rows = r.ReadU8();
+    h.cols = r.ReadU8();
+    h.count = r.ReadLEU64();
+    return r.Good() && magic == ArrayHeader::MAGIC;
+}
+
+//Single Objects, the components back to back with no header
+
+///@fn Write Writes the dim components of v
+template<typename T, size_t dim>
+inline void Write(ByteWriter& w, const vec<T, dim>& v){
+    for(size_t i = 0; i < dim; i++){detail::WriteScalar<T>(w, v[i]);}
+}
+///@fn Read @return bool Whether all of v could be read
+template<typename T, size_t dim>
+inline bool Read(ByteReader& r, vec<T, dim>& v){
+    for(size_t i = 0; i < dim; i++){v[i] = detail::ReadScalar<T>(r);}
+    return r.Good();
+}
+
+///@fn Write Writes the components of m column by column, as it is stored
+template<typename T, size_t rows, size_t cols>
+inline void Write(ByteWriter& w, const mat<T, rows, cols>& m){
+    for(size_t i = 0; i < cols; i++){Write<T, rows>(w, m[i]);}
+}
+///@fn Read @return bool Whether all of m could be read
+template<typename T, size_t rows, size_t cols>
+inline bool Read(ByteReader& r, mat<T, rows, cols>& m){
+    for(size_t i = 0; i < cols; i++){Read<T, rows>(r, m[i]);}
+    return r.Good();
+}
+
+//Arrays, an ArrayHeader then every element's components as one contiguous payload
+
+/**
+ * @fn WriteArray
+ * @brief Writes a header and the count vecs at data, on little endian hosts the payload is written with one copy.
+ */
+template<typename T, size_t dim>
+inline void WriteArray(ByteWriter& w, const vec<T, dim>* data, const size_t& count){
+    static_assert(sizeof(vec<T, dim>) == sizeof(T) * dim, "ss::WriteArray() requires vecs without padding!");
+    Write(w, ArrayHeader::Of<T, dim, 1>(count));
+    detail::WriteScalars<T>(w, count > 0 ? data->data() : nullptr, count * dim);
+}
+///@fn WriteArray
+template<typename T, size_t dim>
+inline void WriteArray(ByteWriter& w, const std::vector<vec<T, dim>>& data){
+    WriteArray<T, dim>(w, data.data(), data.size());
+}
+
+///@fn WriteArray Writes a header and the count mats at data
+template<typename T, size_t rows, size_t cols>
+inline void WriteArray(ByteWriter& w, const mat<T, rows, cols>* data, const size_t& count){
+    static_assert(sizeof(mat<T, rows, cols>) == sizeof(T) * rows * cols, "ss::WriteArray() requires mats without padding!");
+    Write(w, ArrayHeader::Of<T, rows, cols>(count));
+    detail::WriteScalars<T>(w, count > 0 ? data->front().data() : nullptr, count * rows * cols);
+}
+///@fn WriteArray
+template<typename T, size_t rows, size_t cols>
+inline void WriteArray(ByteWriter& w, const std::vector<mat<T, rows, cols>>& data){
+    WriteArray<T, rows, cols>(w, data.data(), data.size());
+}
+
+namespace detail
+{
+
+///@fn ScalarData @return T* The first component of v
+template<typename T, size_t dim>
+inline T* ScalarData(vec<T, dim>& v) {return v.data();}
+///@fn ScalarData @return T* The first component of m
+template<typename T, size_t rows, size_t cols>
+inline T* ScalarData(mat<T, rows, cols>& m) {return m.front().data();}
+
+/**
+ * @fn ReadElements
+ * @brief Reads count Es of per Ts each into out. out grows a bounded chunk at a time rather than by count up front,
+ * so a corrupt count fails on the short payload instead of allocating whatever it claims.
+ */
+template<typename T, size_t per, typename E>
+inline bool ReadElements(ByteReader& r, const uint64_t& count, std::vector<E>& out){
+    const size_t chunk = Max<size_t>((size_t)SS_BYTE_IO_BUFFER * 16 / sizeof(E), 1);
+    size_t have = 0;
+    while(have < count){
+        const size_t step = (size_t)Min<uint64_t>(count - have, chunk);
+        out.resize(have + step);
+        const size_t n = ReadScalars<T>(r, ScalarData(out[have]), step * per) / per;
+        have += n;
+        if(n != step){break;}
+    }
+    out.resize(have);
+    return have == count;
+}
+
+}
+
+/**
+ * @fn ReadArray
+ * @brief Reads an array written by WriteArray into out, replacing its contents. The payload is read straight into
+ * out's storage, byte swapped in place only on big endian hosts.
+ * @return bool False if the header is malformed or for another type or shape, or the payload is cut short,
+ * in which case out holds only the elements read whole.
+ */
+template<typename T, size_t dim>
+inline bool ReadArray(ByteReader& r, std::vector<vec<T, dim>>& out){
+    static_assert(sizeof(vec<T, dim>) == sizeof(T) * dim, "ss::ReadArray() requires vecs without padding!");
+    ArrayHeader h;
+    out.clear();
+    if(!Read(r, h) || !h.Matches<T, dim, 1>()){return false;}
+    return detail::ReadElements<T, dim>(r, h.count, out);
+}
+
+///@fn ReadArray The mat overload
+template<typename T, size_t rows, size_t cols>
+inline bool ReadArray(ByteReader& r, std::vector<mat<T, rows, cols>>& out){
+    static_assert(sizeof(mat<T, rows, cols>) == sizeof(T) * rows * cols, "ss::ReadArray() requires mats without padding!");
+    ArrayHeader h;
+    out.clear();
+    if(!Read(r, h) || !h.Matches<T, rows, cols>()){return false;}
+    return detail::ReadElements<T, rows * cols>(r, h.count, out);
+}
+
+}
+
+#endif // SUBSTD_SERIALIZE_HPP
@@ -0,0 +1,984 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief SIMD kernels for small fixed size vectors and matrices, register wide packs for long arrays, and an aligned allocator.
+ * @include cstddef cstdint cmath cstring new type_traits immintrin.h
+*/
+
+#ifndef SUBSTD_SIMD_HPP
+#define SUBSTD_SIMD_HPP
+
+#include<cstddef>
+#include<cstdint>
+#include<cmath>
+#include<cstring>
+#include<new>
+#include<type_traits>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define SS_SIMD_SSE 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SS_SIMD_SSE2 1
+#endif
+#if defined(__SSSE3__) || defined(__AVX__)
+#define SS_SIMD_SSSE3 1
+#endif
+#if defined(__SSE4_1__) || defined(__AVX__)
+#define SS_SIMD_SSE41 1
+#endif
+#if defined(__AVX__)
+#define SS_SIMD_AVX 1
+#endif
+#if defined(__AVX2__)
+#define SS_SIMD_AVX2 1
+#endif
+#if defined(__FMA__)
+#define SS_SIMD_FMA 1
+#endif
+#if defined(__BMI2__)
+#define SS_SIMD_BMI2 1
+#endif
+#if defined(__AVX512F__)
+#define SS_SIMD_AVX512 1
+#endif
+#if defined(__AVX512BW__)
+#define SS_SIMD_AVX512BW 1
+#endif
+
+#if defined(SS_SIMD_SSE) && !defined(SS_NO_SIMD)
+#include<immintrin.h>
+#endif
+
+namespace ss
+{
+namespace simd
+{
+
+/**
+ * @class kernel
+ * @brief Element-wise kernels over contiguous arrays of exactly dim elements of T.
+ *
+ * The primary template is disabled; each specialization with enabled set to true provides
+ * Add, Sub, Mul, Scale and Dot over unaligned pointers, and Div/ScaleDiv if has_div is true.
+ * Defining SS_NO_SIMD disables every specialization.
+ *
+ * @tparam T Scalar type
+ * @tparam dim Number of elements
+ */
+template<typename T, size_t dim>
+struct kernel {
+    static constexpr bool enabled = false;
+    static constexpr bool has_div = false;
+};
+
+#if !defined(SS_NO_SIMD)
+
+#if defined(SS_SIMD_SSE)
+template<>
+struct kernel<float, 4> {
+    static constexpr bool enabled = true;
+    static constexpr bool has_div = true;
+
+    static void Add(const float* a, const float* b, float* out){
+        _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+    }
+    static void Sub(const float* a, const float* b, float* out){
+        _mm_storeu_ps(out, _mm_sub_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+    }
+    static void Mul(const float* a, const float* b, float* out){
+        _mm_storeu_ps(out, _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+    }
+    static void Div(const float* a, const float* b, float* out){
+        _mm_storeu_ps(out, _mm_div_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+    }
+    static void Scale(const float* a, const float& s, float* out){
+        _mm_storeu_ps(out, _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(s)));
+    }
+    static void ScaleDiv(const float* a, const float& s, float* out){
+        _mm_storeu_ps(out, _mm_div_ps(_mm_loadu_ps(a), _mm_set1_ps(s)));
+    }
+    static float Dot(const float* a, const float* b){
+        __m128 p = _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b));
+        __m128 s = _mm_add_ps(p, _mm_movehl_ps(p, p));
+        s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+        return _mm_cvtss_f32(s);
+    }
+};
+#endif
+
+#if defined(SS_SIMD_SSE2)
+template<>
+struct kernel<double, 2> {
+    static constexpr bool enabled = true;
+    static constexpr bool has_div = true;
+
+    static void Add(const double* a, const double* b, double* out){
+        _mm_storeu_pd(out, _mm_add_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+    }
+    static void Sub(const double* a, const double* b, double* out){
+        _mm_storeu_pd(out, _mm_sub_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+    }
+    static void Mul(const double* a, const double* b, double* out){
+        _mm_storeu_pd(out, _mm_mul_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+    }
+    static void Div(const double* a, const double* b, double* out){
+        _mm_storeu_pd(out, _mm_div_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+    }
+    static void Scale(const double* a, const double& s, double* out){
+        _mm_storeu_pd(out, _mm_mul_pd(_mm_loadu_pd(a), _mm_set1_pd(s)));
+    }
+    static void ScaleDiv(const double* a, const double& s, double* out){
+        _mm_storeu_pd(out, _mm_div_pd(_mm_loadu_pd(a), _mm_set1_pd(s)));
+    }
+    static double Dot(const double* a, const double* b){
+        __m128d p = _mm_mul_pd(_mm_loadu_pd(a), _mm_loadu_pd(b));
+        return _mm_cvtsd_f64(_mm_add_sd(p, _mm_unpackhi_pd(p, p)));
+    }
+};
+
+template<>
+struct kernel<int32_t, 4> {
+    static constexpr bool enabled = true;
+    static constexpr bool has_div = false;
+
+    static __m128i Load(const int32_t* p){return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));}
+    static void Store(int32_t* p, const __m128i& v){_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);}
+    static __m128i MulLo(const __m128i& a, const __m128i& b){
+#if defined(SS_SIMD_SSE41)
+        return _mm_mullo_epi32(a, b);
+#else
+        __m128i even = _mm_mul_epu32(a, b);
+        __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+        return _mm_unpacklo_epi32(
+            _mm_shuffle_epi32(even, _MM_SHUFFLE(0,0,2,0)),
+            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0,0,2,0))
+        );
+#endif
+    }
+
+    static void Add(const int32_t* a, const int32_t* b, int32_t* out){
+        Store(out, _mm_add_epi32(Load(a), Load(b)));
+    }
+    static void Sub(const int32_t* a, const int32_t* b, int32_t* out){
+        Store(out, _mm_sub_epi32(Load(a), Load(b)));
+    }
+    static void Mul(const int32_t* a, const int32_t* b, int32_t* out){
+        Store(out, MulLo(Load(a), Load(b)));
+    }
+    static void Scale(const int32_t* a, const int32_t& s, int32_t* out){
+        Store(out, MulLo(Load(a), _mm_set1_epi32(s)));
+    }
+    static int32_t Dot(const int32_t* a, const int32_t* b){
+        __m128i p = MulLo(Load(a), Load(b));
+        p = _mm_add_epi32(p, _mm_shuffle_epi32(p, _MM_SHUFFLE(1,0,3,2)));
+        p = _mm_add_epi32(p, _mm_shuffle_epi32(p, _MM_SHUFFLE(2,3,0,1)));
+        return _mm_cvtsi128_si32(p);
+    }
+};
+#endif
+
+#if defined(SS_SIMD_AVX)
+template<>
+struct kernel<double, 4> {
+    static constexpr bool enabled = true;
+    static constexpr bool has_div = true;
+
+    static void Add(const double* a, const double* b, double* out){
+        _mm256_storeu_pd(out, _mm256_add_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+    }
+    static void Sub(const double* a, const double* b, double* out){
+        _mm256_storeu_pd(out, _mm256_sub_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+    }
+    static void Mul(const double* a, const double* b, double* out){
+        _mm256_storeu_pd(out, _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+    }
+    static void Div(const double* a, const double* b, double* out){
+        _mm256_storeu_pd(out, _mm256_div_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+    }
+    static void Scale(const double* a, const double& s, double* out){
+        _mm256_storeu_pd(out, _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_set1_pd(s)));
+    }
+    static void ScaleDiv(const double* a, const double& s, double* out){
+        _mm256_storeu_pd(out, _mm256_div_pd(_mm256_loadu_pd(a), _mm256_set1_pd(s)));
+    }
+    static double Dot(const double* a, const double* b){
+        __m256d p = _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b));
+        __m128d s = _mm_add_pd(_mm256_castpd256_pd128(p), _mm256_extractf128_pd(p, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+    }
+};
+#endif
+
+#endif // SS_NO_SIMD
+
+/**
+ * @class matmul_kernel
+ * @brief Hand unrolled products of column major matrices, out(r x c) = a(r x k) * b(k x c).
+ *
+ * Specializations with enabled set to true provide Mul(a, b, out); out must not alias a or b.
+ */
+template<typename T, size_t r, size_t k, size_t c>
+struct matmul_kernel {
+    static constexpr bool enabled = false;
+};
+
+#if !defined(SS_NO_SIMD)
+
+#if defined(SS_SIMD_SSE)
+template<>
+struct matmul_kernel<float, 4, 4, 4> {
+    static constexpr bool enabled = true;
+
+    static void Mul(const float* a, const float* b, float* out){
+        const __m128 a0 = _mm_loadu_ps(a);
+        const __m128 a1 = _mm_loadu_ps(a+4);
+        const __m128 a2 = _mm_loadu_ps(a+8);
+        const __m128 a3 = _mm_loadu_ps(a+12);
+        for(size_t col = 0; col < 4; col++){
+            const float* bc = b + (col*4);
+            __m128 acc = _mm_mul_ps(a0, _mm_set1_ps(bc[0]));
+            acc = _mm_add_ps(acc, _mm_mul_ps(a1, _mm_set1_ps(bc[1])));
+            acc = _mm_add_ps(acc, _mm_mul_ps(a2, _mm_set1_ps(bc[2])));
+            acc = _mm_add_ps(acc, _mm_mul_ps(a3, _mm_set1_ps(bc[3])));
+            _mm_storeu_ps(out + (col*4), acc);
+        }
+    }
+};
+
+template<>
+struct matmul_kernel<float, 3, 3, 3> {
+    static constexpr bool enabled = true;
+
+    static void Mul(const float* a, const float* b, float* out){
+        //Columns 0 and 1 are loaded 4 wide (the extra lane is the next column's first element),
+        //column 2 is loaded from a+5 and shifted down so nothing is read past the end.
+        const __m128 a0 = _mm_loadu_ps(a);
+        const __m128 a1 = _mm_loadu_ps(a+3);
+        const __m128 a5 = _mm_loadu_ps(a+5);
+        const __m128 a2 = _mm_shuffle_ps(a5, a5, _MM_SHUFFLE(3,3,2,1));
+        __m128 cols[3];
+        for(size_t col = 0; col < 3; col++){
+            const float* bc = b + (col*3);
+            __m128 acc = _mm_mul_ps(a0, _mm_set1_ps(bc[0]));
+            acc = _mm_add_ps(acc, _mm_mul_ps(a1, _mm_set1_ps(bc[1])));
+            cols[col] = _mm_add_ps(acc, _mm_mul_ps(a2, _mm_set1_ps(bc[2])));
+        }
+        _mm_storeu_ps(out, cols[0]);
+        _mm_storeu_ps(out+3, cols[1]);
+        _mm_storel_pi(reinterpret_cast<__m64*>(out+6), cols[2]);
+        _mm_store_ss(out+8, _mm_movehl_ps(cols[2], cols[2]));
+    }
+};
+#endif
+
+#if defined(SS_SIMD_AVX)
+template<>
+struct matmul_kernel<double, 4, 4, 4> {
+    static constexpr bool enabled = true;
+
+    static void Mul(const double* a, const double* b, double* out){
+        const __m256d a0 = _mm256_loadu_pd(a);
+        const __m256d a1 = _mm256_loadu_pd(a+4);
+        const __m256d a2 = _mm256_loadu_pd(a+8);
+        const __m256d a3 = _mm256_loadu_pd(a+12);
+        for(size_t col = 0; col < 4; col++){
+            const double* bc = b + (col*4);
+            __m256d acc = _mm256_mul_pd(a0, _mm256_set1_pd(bc[0]));
+            acc = _mm256_add_pd(acc, _mm256_mul_pd(a1, _mm256_set1_pd(bc[1])));
+            acc = _mm256_add_pd(acc, _mm256_mul_pd(a2, _mm256_set1_pd(bc[2])));
+            acc = _mm256_add_pd(acc, _mm256_mul_pd(a3, _mm256_set1_pd(bc[3])));
+            _mm256_storeu_pd(out + (col*4), acc);
+        }
+    }
+};
+#elif defined(SS_SIMD_SSE2)
+template<>
+struct matmul_kernel<double, 4, 4, 4> {
+    static constexpr bool enabled = true;
+
+    static void Mul(const double* a, const double* b, double* out){
+        for(size_t half = 0; half < 4; half += 2){
+            const __m128d a0 = _mm_loadu_pd(a+half);
+            const __m128d a1 = _mm_loadu_pd(a+4+half);
+            const __m128d a2 = _mm_loadu_pd(a+8+half);
+            const __m128d a3 = _mm_loadu_pd(a+12+half);
+            for(size_t col = 0; col < 4; col++){
+                const double* bc = b + (col*4);
+                __m128d acc = _mm_mul_pd(a0, _mm_set1_pd(bc[0]));
+                acc = _mm_add_pd(acc, _mm_mul_pd(a1, _mm_set1_pd(bc[1])));
+                acc = _mm_add_pd(acc, _mm_mul_pd(a2, _mm_set1_pd(bc[2])));
+                acc = _mm_add_pd(acc, _mm_mul_pd(a3, _mm_set1_pd(bc[3])));
+                _mm_storeu_pd(out + (col*4) + half, acc);
+            }
+        }
+    }
+};
+#endif
+
+#endif // SS_NO_SIMD
+
+/**
+ * @class inverse_kernel
+ * @brief SIMD inverse of an n x n column major matrix.
+ *
+ * Specializations with enabled set to true provide Inverse(m, out), which returns the determinant of m.
+ * out must not alias m, and is filled with non-finite values if m is singular.
+ */
+template<typename T, size_t n>
+struct inverse_kernel {
+    static constexpr bool enabled = false;
+};
+
+#if !defined(SS_NO_SIMD) && defined(SS_SIMD_SSE2)
+template<>
+struct inverse_kernel<float, 4> {
+    static constexpr bool enabled = true;
+
+    template<int x, int y, int z, int w>
+    static __m128 Swizzle(const __m128& v){return _mm_shuffle_ps(v, v, _MM_SHUFFLE(w,z,y,x));}
+    template<int x, int y, int z, int w>
+    static __m128 Shuffle(const __m128& a, const __m128& b){return _mm_shuffle_ps(a, b, _MM_SHUFFLE(w,z,y,x));}
+
+    //2x2 matrices packed (m00, m01, m10, m11)
+    static __m128 Mat2Mul(const __m128& a, const __m128& b){
+        return _mm_add_ps(_mm_mul_ps(a, Swizzle<0,3,0,3>(b)), _mm_mul_ps(Swizzle<1,0,3,2>(a), Swizzle<2,1,2,1>(b)));
+    }
+    static __m128 Mat2AdjMul(const __m128& a, const __m128& b){
+        return _mm_sub_ps(_mm_mul_ps(Swizzle<3,3,0,0>(a), b), _mm_mul_ps(Swizzle<1,1,2,2>(a), Swizzle<2,3,0,1>(b)));
+    }
+    static __m128 Mat2MulAdj(const __m128& a, const __m128& b){
+        return _mm_sub_ps(_mm_mul_ps(a, Swizzle<3,0,3,0>(b)), _mm_mul_ps(Swizzle<1,0,3,2>(a), Swizzle<2,1,2,1>(b)));
+    }
+
+    //Block inverse through 2x2 adjugates. The algorithm is written for row major storage, applying it to
+    //column major storage inverts the transpose, whose column major storage is the inverse's.
+    static float Inverse(const float* m, float* out){
+        const __m128 m0 = _mm_loadu_ps(m);
+        const __m128 m1 = _mm_loadu_ps(m+4);
+        const __m128 m2 = _mm_loadu_ps(m+8);
+        const __m128 m3 = _mm_loadu_ps(m+12);
+
+        const __m128 A = _mm_movelh_ps(m0, m1);
+        const __m128 B = _mm_movehl_ps(m1, m0);
+        const __m128 C = _mm_movelh_ps(m2, m3);
+        const __m128 D = _mm_movehl_ps(m3, m2);
+
+        //(|A|, |B|, |C|, |D|)
+        const __m128 det_sub = _mm_sub_ps(
+            _mm_mul_ps(Shuffle<0,2,0,2>(m0, m2), Shuffle<1,3,1,3>(m1, m3)),
+            _mm_mul_ps(Shuffle<1,3,1,3>(m0, m2), Shuffle<0,2,0,2>(m1, m3))
+        );
+        const __m128 det_A = Swizzle<0,0,0,0>(det_sub);
+        const __m128 det_B = Swizzle<1,1,1,1>(det_sub);
+        const __m128 det_C = Swizzle<2,2,2,2>(det_sub);
+        const __m128 det_D = Swizzle<3,3,3,3>(det_sub);
+
+        const __m128 D_C = Mat2AdjMul(D, C);
+        const __m128 A_B = Mat2AdjMul(A, B);
+        __m128 X = _mm_sub_ps(_mm_mul_ps(det_D, A), Mat2Mul(B, D_C));
+        __m128 W = _mm_sub_ps(_mm_mul_ps(det_A, D), Mat2Mul(C, A_B));
+        __m128 Y = _mm_sub_ps(_mm_mul_ps(det_B, C), Mat2MulAdj(D, A_B));
+        __m128 Z = _mm_sub_ps(_mm_mul_ps(det_C, B), Mat2MulAdj(A, D_C));
+
+        //|M| = |A||D| + |B||C| - tr((A#B)(D#C))
+        __m128 tr = _mm_mul_ps(A_B, Swizzle<0,2,1,3>(D_C));
+        tr = _mm_add_ps(tr, Swizzle<2,3,0,1>(tr));
+        tr = _mm_add_ps(tr, Swizzle<1,0,3,2>(tr));
+        const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_A, det_D), _mm_mul_ps(det_B, det_C)), tr);
+
+        const __m128 inv_det = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+        X = _mm_mul_ps(X, inv_det);
+        Y = _mm_mul_ps(Y, inv_det);
+        Z = _mm_mul_ps(Z, inv_det);
+        W = _mm_mul_ps(W, inv_det);
+
+        _mm_storeu_ps(out, Shuffle<3,1,3,1>(X, Y));
+        _mm_storeu_ps(out+4, Shuffle<2,0,2,0>(X, Y));
+        _mm_storeu_ps(out+8, Shuffle<3,1,3,1>(Z, W));
+        _mm_storeu_ps(out+12, Shuffle<2,0,2,0>(Z, W));
+        return _mm_cvtss_f32(det);
+    }
+};
+#endif
+
+/**
+ * @class affine_inverse_kernel
+ * @brief SIMD inverse of an n x n column major homogeneous affine matrix whose linear part has orthogonal rows.
+ *
+ * Specializations with enabled set to true provide Inverse(m, out); out must not alias m.
+ */
+template<typename T, size_t n>
+struct affine_inverse_kernel {
+    static constexpr bool enabled = false;
+};
+
+#if !defined(SS_NO_SIMD) && defined(SS_SIMD_SSE)
+template<>
+struct affine_inverse_kernel<float, 4> {
+    static constexpr bool enabled = true;
+
+    static void Inverse(const float* m, float* out){
+        __m128 c0 = _mm_loadu_ps(m);
+        __m128 c1 = _mm_loadu_ps(m+4);
+        __m128 c2 = _mm_loadu_ps(m+8);
+        const __m128 t = _mm_loadu_ps(m+12);
+        const __m128 w = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+
+        //Squared row lengths, the w lane is forced to 1 so it stays finite
+        __m128 sqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, c0), _mm_mul_ps(c1, c1)), _mm_mul_ps(c2, c2));
+        sqr = _mm_add_ps(_mm_and_ps(sqr, _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0))), w);
+        const __m128 inv_sqr = _mm_div_ps(_mm_set1_ps(1.0f), sqr);
+
+        __m128 c3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        c0 = _mm_mul_ps(c0, _mm_shuffle_ps(inv_sqr, inv_sqr, _MM_SHUFFLE(0,0,0,0)));
+        c1 = _mm_mul_ps(c1, _mm_shuffle_ps(inv_sqr, inv_sqr, _MM_SHUFFLE(1,1,1,1)));
+        c2 = _mm_mul_ps(c2, _mm_shuffle_ps(inv_sqr, inv_sqr, _MM_SHUFFLE(2,2,2,2)));
+
+        __m128 translation = _mm_mul_ps(c0, _mm_shuffle_ps(t, t, _MM_SHUFFLE(0,0,0,0)));
+        translation = _mm_add_ps(translation, _mm_mul_ps(c1, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1,1,1,1))));
+        translation = _mm_add_ps(translation, _mm_mul_ps(c2, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2,2,2,2))));
+        translation = _mm_sub_ps(w, translation);
+
+        _mm_storeu_ps(out, c0);
+        _mm_storeu_ps(out+4, c1);
+        _mm_storeu_ps(out+8, c2);
+        _mm_storeu_ps(out+12, translation);
+    }
+};
+#endif
+
+#if !defined(SS_NO_SIMD) && defined(SS_SIMD_AVX)
+template<>
+struct affine_inverse_kernel<double, 4> {
+    static constexpr bool enabled = true;
+
+    static void Inverse(const double* m, double* out){
+        const __m256d c0 = _mm256_loadu_pd(m);
+        const __m256d c1 = _mm256_loadu_pd(m+4);
+        const __m256d c2 = _mm256_loadu_pd(m+8);
+        const __m256d c3 = _mm256_setzero_pd();
+        const __m256d w = _mm256_setr_pd(0.0, 0.0, 0.0, 1.0);
+
+        //Squared row lengths, the w lane is forced to 1 so it stays finite
+        __m256d sqr = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(c0, c0), _mm256_mul_pd(c1, c1)), _mm256_mul_pd(c2, c2));
+        sqr = _mm256_blend_pd(sqr, w, 0x8);
+        alignas(32) double inv_sqr[4];
+        _mm256_store_pd(inv_sqr, _mm256_div_pd(_mm256_set1_pd(1.0), sqr));
+
+        const __m256d lo01 = _mm256_unpacklo_pd(c0, c1);
+        const __m256d hi01 = _mm256_unpackhi_pd(c0, c1);
+        const __m256d lo23 = _mm256_unpacklo_pd(c2, c3);
+        const __m256d hi23 = _mm256_unpackhi_pd(c2, c3);
+        const __m256d r0 = _mm256_mul_pd(_mm256_permute2f128_pd(lo01, lo23, 0x20), _mm256_broadcast_sd(inv_sqr));
+        const __m256d r1 = _mm256_mul_pd(_mm256_permute2f128_pd(hi01, hi23, 0x20), _mm256_broadcast_sd(inv_sqr+1));
+        const __m256d r2 = _mm256_mul_pd(_mm256_permute2f128_pd(lo01, lo23, 0x31), _mm256_broadcast_sd(inv_sqr+2));
+
+        __m256d translation = _mm256_mul_pd(r0, _mm256_broadcast_sd(m+12));
+        translation = _mm256_add_pd(translation, _mm256_mul_pd(r1, _mm256_broadcast_sd(m+13)));
+        translation = _mm256_add_pd(translation, _mm256_mul_pd(r2, _mm256_broadcast_sd(m+14)));
+
+        _mm256_storeu_pd(out, r0);
+        _mm256_storeu_pd(out+4, r1);
+        _mm256_storeu_pd(out+8, r2);
+        _mm256_storeu_pd(out+12, _mm256_sub_pd(w, translation));
+    }
+};
+#endif
+
+/**
+ * @class affine_kernel
+ * @brief SIMD operations on column major dim x (dim+1) affine transforms, the homogeneous matrices with an
+ * implied (0, ..., 0, 1) bottom row.
+ *
+ * Specializations with enabled set to true provide Compose(a, b, out) for out = a * b, TransformPoint(a, p, out),
+ * Inverse(a, out) and OrthogonalInverse(a, out), the last for linear parts with orthogonal rows as in
+ * affine_inverse_kernel; out must not alias the inputs.
+ */
+template<typename T, size_t dim>
+struct affine_kernel {
+    static constexpr bool enabled = false;
+};
+
+#if !defined(SS_NO_SIMD) && defined(SS_SIMD_SSE)
+template<>
+struct affine_kernel<float, 3> {
+    static constexpr bool enabled = true;
+
+    //Columns are loaded 4 wide, the spare lane being the next column's first element, and the
+    //translation from a+8 shifted down so nothing is read past the 12 floats
+    static void Load(const float* a, __m128& c0, __m128& c1, __m128& c2, __m128& c3){
+        c0 = _mm_loadu_ps(a);
+        c1 = _mm_loadu_ps(a+3);
+        c2 = _mm_loadu_ps(a+6);
+        const __m128 a8 = _mm_loadu_ps(a+8);
+        c3 = _mm_shuffle_ps(a8, a8, _MM_SHUFFLE(3,3,2,1));
+    }
+    //Packs the first 3 lanes of each column into 3 whole registers, so the 12 floats are stored without
+    //overlapping writes a following load would have to wait on
+    static void Store(float* out, const __m128& c0, const __m128& c1, const __m128& c2, const __m128& c3){
+        const __m128 t01 = _mm_shuffle_ps(c0, c1, _MM_SHUFFLE(0,0,2,2));
+        const __m128 t23 = _mm_shuffle_ps(c2, c3, _MM_SHUFFLE(0,0,2,2));
+        _mm_storeu_ps(out, _mm_shuffle_ps(c0, t01, _MM_SHUFFLE(2,0,1,0)));
+        _mm_storeu_ps(out+4, _mm_shuffle_ps(c1, c2, _MM_SHUFFLE(1,0,2,1)));
+        _mm_storeu_ps(out+8, _mm_shuffle_ps(t23, c3, _MM_SHUFFLE(2,1,2,0)));
+    }
+    //c0 * v[0] + c1 * v[1] + c2 * v[2]
+    static __m128 Combine(const __m128& c0, const __m128& c1, const __m128& c2, const float* v){
+        __m128 acc = _mm_mul_ps(c0, _mm_set1_ps(v[0]));
+        acc = _mm_add_ps(acc, _mm_mul_ps(c1, _mm_set1_ps(v[1])));
+        return _mm_add_ps(acc, _mm_mul_ps(c2, _mm_set1_ps(v[2])));
+    }
+    static __m128 Cross(const __m128& x, const __m128& y){
+        const __m128 x_yzx = _mm_shuffle_ps(x, x, _MM_SHUFFLE(3,0,2,1));
+        const __m128 y_yzx = _mm_shuffle_ps(y, y, _MM_SHUFFLE(3,0,2,1));
+        const __m128 c = _mm_sub_ps(_mm_mul_ps(x, y_yzx), _mm_mul_ps(x_yzx, y));
+        return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3,0,2,1));
+    }
+    //The rows r0, r1, r2 back as columns, with the translation moved by them and negated
+    static void StoreInverse(float* out, __m128 r0, __m128 r1, __m128 r2, const __m128& t){
+        __m128 r3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        __m128 translation = _mm_mul_ps(r0, _mm_shuffle_ps(t, t, _MM_SHUFFLE(0,0,0,0)));
+        translation = _mm_add_ps(translation, _mm_mul_ps(r1, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1,1,1,1))));
+        translation = _mm_add_ps(translation, _mm_mul_ps(r2, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2,2,2,2))));
+        Store(out, r0, r1, r2, _mm_sub_ps(_mm_setzero_ps(), translation));
+    }
+
+    static void Compose(const float* a, const float* b, float* out){
+        __m128 a0, a1, a2, a3;
+        Load(a, a0, a1, a2, a3);
+        Store(out, Combine(a0, a1, a2, b), Combine(a0, a1, a2, b+3), Combine(a0, a1, a2, b+6),
+            _mm_add_ps(Combine(a0, a1, a2, b+9), a3));
+    }
+
+    static void TransformPoint(const float* a, const float* p, float* out){
+        __m128 a0, a1, a2, a3;
+        Load(a, a0, a1, a2, a3);
+        const __m128 result = _mm_add_ps(Combine(a0, a1, a2, p), a3);
+        _mm_storel_pi(reinterpret_cast<__m64*>(out), result);
+        _mm_store_ss(out+2, _mm_movehl_ps(result, result));
+    }
+
+    static void Inverse(const float* a, float* out){
+        __m128 c0, c1, c2, t;
+        Load(a, c0, c1, c2, t);
+        //The rows of the inverse are the cross products of pairs of columns over the determinant
+        const __m128 r0 = Cross(c1, c2);
+        const __m128 r1 = Cross(c2, c0);
+        const __m128 r2 = Cross(c0, c1);
+        __m128 det = _mm_mul_ps(c0, r0);
+        det = _mm_add_ss(_mm_add_ss(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(1,1,1,1))), _mm_movehl_ps(det, det));
+        const __m128 inv_det = _mm_div_ps(_mm_set1_ps(1.0f), _mm_shuffle_ps(det, det, _MM_SHUFFLE(0,0,0,0)));
+        StoreInverse(out, _mm_mul_ps(r0, inv_det), _mm_mul_ps(r1, inv_det), _mm_mul_ps(r2, inv_det), t);
+    }
+
+    static void OrthogonalInverse(const float* a, float* out){
+        __m128 c0, c1, c2, t;
+        Load(a, c0, c1, c2, t);
+        //Squared row lengths; the spare lanes only ever reach the discarded fourth row StoreInverse transposes out
+        const __m128 sqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, c0), _mm_mul_ps(c1, c1)), _mm_mul_ps(c2, c2));
+        const __m128 inv_sqr = _mm_div_ps(_mm_set1_ps(1.0f), sqr);
+        //Element col of row row of the inverse is m[row][col] / sqr[col], the stored columns scaled lane by lane
+        const __m128 r0 = _mm_mul_ps(c0, inv_sqr);
+        const __m128 r1 = _mm_mul_ps(c1, inv_sqr);
+        const __m128 r2 = _mm_mul_ps(c2, inv_sqr);
+        StoreInverse(out, r0, r1, r2, t);
+    }
+};
+#endif
+
+#if !defined(SS_NO_SIMD) && defined(SS_SIMD_AVX2)
+template<>
+struct affine_kernel<double, 3> {
+    static constexpr bool enabled = true;
+
+    //As in affine_kernel<float, 3>, 4 wide columns whose spare lane is the next column's first element
+    static void Load(const double* a, __m256d& c0, __m256d& c1, __m256d& c2, __m256d& c3){
+        c0 = _mm256_loadu_pd(a);
+        c1 = _mm256_loadu_pd(a+3);
+        c2 = _mm256_loadu_pd(a+6);
+        c3 = _mm256_permute4x64_pd(_mm256_loadu_pd(a+8), _MM_SHUFFLE(3,3,2,1));
+    }
+    static void Store(double* out, const __m256d& c0, const __m256d& c1, const __m256d& c2, const __m256d& c3){
+        _mm256_storeu_pd(out, _mm256_blend_pd(c0, _mm256_permute4x64_pd(c1, _MM_SHUFFLE(0,0,0,0)), 0x8));
+        _mm256_storeu_pd(out+4, _mm256_blend_pd(_mm256_permute4x64_pd(c1, _MM_SHUFFLE(0,0,2,1)), _mm256_permute4x64_pd(c2, _MM_SHUFFLE(1,0,0,0)), 0xC));
+        _mm256_storeu_pd(out+8, _mm256_blend_pd(_mm256_permute4x64_pd(c3, _MM_SHUFFLE(2,1,0,0)), _mm256_permute4x64_pd(c2, _MM_SHUFFLE(2,2,2,2)), 0x1));
+    }
+    static __m256d Combine(const __m256d& c0, const __m256d& c1, const __m256d& c2, const double* v){
+        __m256d acc = _mm256_mul_pd(c0, _mm256_set1_pd(v[0]));
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(c1, _mm256_set1_pd(v[1])));
+        return _mm256_add_pd(acc, _mm256_mul_pd(c2, _mm256_set1_pd(v[2])));
+    }
+    static __m256d Cross(const __m256d& x, const __m256d& y){
+        const __m256d x_yzx = _mm256_permute4x64_pd(x, _MM_SHUFFLE(3,0,2,1));
+        const __m256d y_yzx = _mm256_permute4x64_pd(y, _MM_SHUFFLE(3,0,2,1));
+        const __m256d c = _mm256_sub_pd(_mm256_mul_pd(x, y_yzx), _mm256_mul_pd(x_yzx, y));
+        return _mm256_permute4x64_pd(c, _MM_SHUFFLE(3,0,2,1));
+    }
+    static void StoreInverse(double* out, const __m256d& r0, const __m256d& r1, const __m256d& r2, const __m256d& t){
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d lo01 = _mm256_unpacklo_pd(r0, r1);
+        const __m256d hi01 = _mm256_unpackhi_pd(r0, r1);
+        const __m256d lo23 = _mm256_unpacklo_pd(r2, zero);
+        const __m256d hi23 = _mm256_unpackhi_pd(r2, zero);
+        const __m256d c0 = _mm256_permute2f128_pd(lo01, lo23, 0x20);
+        const __m256d c1 = _mm256_permute2f128_pd(hi01, hi23, 0x20);
+        const __m256d c2 = _mm256_permute2f128_pd(lo01, lo23, 0x31);
+        __m256d translation = _mm256_mul_pd(c0, _mm256_permute4x64_pd(t, _MM_SHUFFLE(0,0,0,0)));
+        translation = _mm256_add_pd(translation, _mm256_mul_pd(c1, _mm256_permute4x64_pd(t, _MM_SHUFFLE(1,1,1,1))));
+        translation = _mm256_add_pd(translation, _mm256_mul_pd(c2, _mm256_permute4x64_pd(t, _MM_SHUFFLE(2,2,2,2))));
+        Store(out, c0, c1, c2, _mm256_sub_pd(zero, translation));
+    }
+
+    static void Compose(const double* a, const double* b, double* out){
+        __m256d a0, a1, a2, a3;
+        Load(a, a0, a1, a2, a3);
+        Store(out, Combine(a0, a1, a2, b), Combine(a0, a1, a2, b+3), Combine(a0, a1, a2, b+6),
+            _mm256_add_pd(Combine(a0, a1, a2, b+9), a3));
+    }
+
+    static void TransformPoint(const double* a, const double* p, double* out){
+        __m256d a0, a1, a2, a3;
+        Load(a, a0, a1, a2, a3);
+        const __m256d result = _mm256_add_pd(Combine(a0, a1, a2, p), a3);
+        _mm_storeu_pd(out, _mm256_castpd256_pd128(result));
+        _mm_store_sd(out+2, _mm256_extractf128_pd(result, 1));
+    }
+
+    static void Inverse(const double* a, double* out){
+        __m256d c0, c1, c2, t;
+        Load(a, c0, c1, c2, t);
+        const __m256d r0 = Cross(c1, c2);
+        const __m256d r1 = Cross(c2, c0);
+        const __m256d r2 = Cross(c0, c1);
+        alignas(32) double det[4];
+        _mm256_store_pd(det, _mm256_mul_pd(c0, r0));
+        const __m256d inv_det = _mm256_set1_pd(1.0 / (det[0] + det[1] + det[2]));
+        StoreInverse(out, _mm256_mul_pd(r0, inv_det), _mm256_mul_pd(r1, inv_det), _mm256_mul_pd(r2, inv_det), t);
+    }
+
+    static void OrthogonalInverse(const double* a, double* out){
+        __m256d c0, c1, c2, t;
+        Load(a, c0, c1, c2, t);
+        const __m256d sqr = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(c0, c0), _mm256_mul_pd(c1, c1)), _mm256_mul_pd(c2, c2));
+        const __m256d inv_sqr = _mm256_div_pd(_mm256_set1_pd(1.0), sqr);
+        StoreInverse(out, _mm256_mul_pd(c0, inv_sqr), _mm256_mul_pd(c1, inv_sqr), _mm256_mul_pd(c2, inv_sqr), t);
+    }
+};
+#endif
+
+/**
+ * @class scalar
+ * @brief A pack of width 1, used for the remainder of loops written against pack<T>.
+ */
+template<typename T>
+struct scalar {
+    static constexpr size_t width = 1;
+    static constexpr int rsqrt_estimate_bits = std::is_floating_point_v<T> ? 4 : 64;
+    using value_type = T;
+    using reg = T;
+    using mask = bool;
+
+    static reg Load(const T* p){return *p;}
+    static void Store(T* p, const reg& v){*p = v;}
+    static reg Set1(const T& t){return t;}
+    static reg Add(const reg& a, const reg& b){return a + b;}
+    static reg Sub(const reg& a, const reg& b){return a - b;}
+    static reg Mul(const reg& a, const reg& b){return a * b;}
+    static reg Div(const reg& a, const reg& b){return a / b;}
+    static reg Fma(const reg& a, const reg& b, const reg& c){return a * b + c;}
+    static reg Sqrt(const reg& a){return (T)std::sqrt(a);}
+    static reg Floor(const reg& a){return (T)std::floor(a);}
+    ///@fn RSqrtEstimate Approximates 1/sqrt(a) to rsqrt_estimate_bits bits, by the exponent halving bit trick for floating point T.
+    static reg RSqrtEstimate(const reg& a){
+        if constexpr(std::is_same_v<T, float>) {
+            uint32_t bits;
+            std::memcpy(&bits, &a, sizeof(bits));
+            bits = 0x5f375a86u - (bits >> 1);
+            float ret;
+            std::memcpy(&ret, &bits, sizeof(ret));
+            return ret;
+        }
+        else if constexpr(std::is_same_v<T, double>) {
+            uint64_t bits;
+            std::memcpy(&bits, &a, sizeof(bits));
+            bits = 0x5fe6eb50c7b537a9ull - (bits >> 1);
+            double ret;
+            std::memcpy(&ret, &bits, sizeof(ret));
+            return ret;
+        }
+        else {
+            return (T)(1 / std::sqrt(a));
+        }
+    }
+    static reg Min(const reg& a, const reg& b){return (a < b) ? a : b;}
+    static reg Max(const reg& a, const reg& b){return (a > b) ? a : b;}
+    static mask Less(const reg& a, const reg& b){return a < b;}
+    static mask LessEqual(const reg& a, const reg& b){return a <= b;}
+    static mask And(const mask& a, const mask& b){return a && b;}
+    static reg Select(const mask& m, const reg& a, const reg& b){return m ? a : b;}
+};
+
+/**
+ * @class pack
+ * @brief The widest register of T available on the target, for loops over long contiguous arrays.
+ *
+ * Every specialization provides width, the register type reg, value_type, and Load, Store, Set1, Add, Sub,
+ * Mul, Div, Fma (a*b+c), Sqrt, Floor, Min and Max, plus RSqrtEstimate, an approximate 1/sqrt whose
+ * relative error is below 2^-rsqrt_estimate_bits. Comparisons Less and LessEqual give a per lane mask,
+ * combined by And and consumed by Select(m, a, b), lane by lane m ? a : b. The primary template falls back to scalar<T>,
+ * so loops written against pack<T> still compile, and auto-vectorize if they can, on any target.
+ *
+ * @tparam T Scalar type
+ */
+template<typename T>
+struct pack : public scalar<T> {};
+
+#if !defined(SS_NO_SIMD)
+
+#if defined(SS_SIMD_AVX512)
+template<>
+struct pack<float> {
+    static constexpr size_t width = 16;
+    static constexpr int rsqrt_estimate_bits = 14;
+    using value_type = float;
+    using reg = __m512;
+    using mask = __mmask16;
+
+    static reg Load(const float* p){return _mm512_loadu_ps(p);}
+    static void Store(float* p, const reg& v){_mm512_storeu_ps(p, v);}
+    static reg Set1(const float& t){return _mm512_set1_ps(t);}
+    static reg Add(const reg& a, const reg& b){return _mm512_add_ps(a, b);}
+    static reg Sub(const reg& a, const reg& b){return _mm512_sub_ps(a, b);}
+    static reg Mul(const reg& a, const reg& b){return _mm512_mul_ps(a, b);}
+    static reg Div(const reg& a, const reg& b){return _mm512_div_ps(a, b);}
+    static reg Fma(const reg& a, const reg& b, const reg& c){return _mm512_fmadd_ps(a, b, c);}
+    static reg Sqrt(const reg& a){return _mm512_sqrt_ps(a);}
+    static reg Floor(const reg& a){return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);}
+    static reg RSqrtEstimate(const reg& a){return _mm512_rsqrt14_ps(a);}
+    static reg Min(const reg& a, const reg& b){return _mm512_min_ps(a, b);}
+    static reg Max(const reg& a, const reg& b){return _mm512_max_ps(a, b);}
+    static mask Less(const reg& a, const reg& b){return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);}
+    static mask LessEqual(const reg& a, const reg& b){return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ);}
+    static mask And(const mask& a, const mask& b){return a & b;}
+    static reg Select(const mask& m, const reg& a, const reg& b){return _mm512_mask_blend_ps(m, b, a);}
+};
+template<>
+struct pack<double> {
+    static constexpr size_t width = 8;
+    static constexpr int rsqrt_estimate_bits = 14;
+    using value_type = double;
+    using reg = __m512d;
+    using mask = __mmask8;
+
+    static reg Load(const double* p){return _mm512_loadu_pd(p);}
+    static void Store(double* p, const reg& v){_mm512_storeu_pd(p, v);}
+    static reg Set1(const double& t){return _mm512_set1_pd(t);}
+    static reg Add(const reg& a, const reg& b){return _mm512_add_pd(a, b);}
+    static reg Sub(const reg& a, const reg& b){return _mm512_sub_pd(a, b);}
+    static reg Mul(const reg& a, const reg& b){return _mm512_mul_pd(a, b);}
+    static reg Div(const reg& a, const reg& b){return _mm512_div_pd(a, b);}
+    static reg Fma(const reg& a, const reg& b, const reg& c){return _mm512_fmadd_pd(a, b, c);}
+    static reg Sqrt(const reg& a){return _mm512_sqrt_pd(a);}
+    static reg Floor(const reg& a){return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);}
+    static reg RSqrtEstimate(const reg& a){return _mm512_rsqrt14_pd(a);}
+    static reg Min(const reg& a, const reg& b){return _mm512_min_pd(a, b);}
+    static reg Max(const reg& a, const reg& b){return _mm512_max_pd(a, b);}
+    static mask Less(const reg& a, const reg& b){return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);}
+    static mask LessEqual(const reg& a, const reg& b){return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ);}
+    static mask And(const mask& a, const mask& b){return a & b;}
+    static reg Select(const mask& m, const reg& a, const reg& b){return _mm512_mask_blend_pd(m, b, a);}
+};
+#elif defined(SS_SIMD_AVX)
+template<>
+struct pack<float> {
+    static constexpr size_t width = 8;
+    static constexpr int rsqrt_estimate_bits = 11;
+    using value_type = float;
+    using reg = __m256;
+    using mask = __m256;
+
+    static reg Load(const float* p){return _mm256_loadu_ps(p);}
+    static void Store(float* p, const reg& v){_mm256_storeu_ps(p, v);}
+    static reg Set1(const float& t){return _mm256_set1_ps(t);}
+    static reg Add(const reg& a, const reg& b){return _mm256_add_ps(a, b);}
+    static reg Sub(const reg& a, const reg& b){return _mm256_sub_ps(a, b);}
+    static reg Mul(const reg& a, const reg& b){return _mm256_mul_ps(a, b);}
+    static reg Div(const reg& a, const reg& b){return _mm256_div_ps(a, b);}
+#if defined(SS_SIMD_FMA)
+    static reg Fma(const reg& a, const reg& b, const reg& c){return _mm256_fmadd_ps(a, b, c);}
+#else
+    static reg Fma(const reg& a, const reg& b, const reg& c){return _mm256_add_ps(_mm256_mul_ps(a, b), c);}
+#endif
+    static reg Sqrt(const reg& a){return _mm256_sqrt_ps(a);}
+    static reg Floor(const reg& a){return _mm256_floor_ps(a);}
+    static reg RSqrtEstimate(const reg& a){return _mm256_rsqrt_ps(a);}
+    static reg Min(const reg& a, const reg& b){return _mm256_min_ps(a, b);}
+    static reg Max(const reg& a, const reg& b){return _mm256_max_ps(a, b);}
+    static mask Less(const reg& a, const reg& b){return _mm256_cmp_ps(a, b, _CMP_LT_OQ);}
+    static mask LessEqual(const reg& a, const reg& b){return _mm256_cmp_ps(a, b, _CMP_LE_OQ);}
+    static mask And(const mask& a, const mask& b){return _mm256_and_ps(a, b);}
+    static reg Select(const mask& m, const reg& a, const reg& b){return _mm256_blendv_ps(b, a, m);}
+};
+template<>
+struct pack<double> {
+    static constexpr size_t width = 4;
+    static constexpr int rsqrt_estimate_bits = 11;
+    using value_type = double;
+    using reg = __m256d;
+    using mask = __m256d;
+
+    static reg Load(const double* p){return _mm256_loadu_pd(p);}
+    static void Store(double* p, const reg& v){_mm256_storeu_pd(p, v);}
+    static reg Set1(const double& t){return _mm256_set1_pd(t);}
+    static reg Add(const reg& a, const reg& b){return _mm256_add_pd(a, b);}
+    static reg Sub(const reg& a, const reg& b){return _mm256_sub_pd(a, b);}
+    static reg Mul(const reg& a, const reg& b){return _mm256_mul_pd(a, b);}
+    static reg Div(const reg& a, const reg& b){return _mm256_div_pd(a, b);}
+#if defined(SS_SIMD_FMA)
+    static reg Fma(const reg& a, const reg& b, const reg& c){return _mm256_fmadd_pd(a, b, c);}
+#else
+    static reg Fma(const reg& a, const reg& b, const reg& c){return _mm256_add_pd(_mm256_mul_pd(a, b), c);}
+#endif
+    static reg Sqrt(const reg& a){return _mm256_sqrt_pd(a);}
+    static reg Floor(const reg& a){return _mm256_floor_pd(a);}
+    //There is no double precision estimate below AVX-512, so the float one is widened
+    static reg RSqrtEstimate(const reg& a){return _mm256_cvtps_pd(_mm_rsqrt_ps(_mm256_cvtpd_ps(a)));}
+    static reg Min(const reg& a, const reg& b){return _mm256_min_pd(a, b);}
+    static reg Max(const reg& a, const reg& b){return _mm256_max_pd(a, b);}
+    static mask Less(const reg& a, const reg& b){return _mm256_cmp_pd(a, b, _CMP_LT_OQ);}
+    static mask LessEqual(const reg& a, const reg& b){return _mm256_cmp_pd(a, b, _CMP_LE_OQ);}
+    static mask And(const mask& a, const mask& b){return _mm256_and_pd(a, b);}
+    static reg Select(const mask& m, const reg& a, const reg& b){return _mm256_blendv_pd(b, a, m);}
+};
+#elif defined(SS_SIMD_SSE2)
+template<>
+struct pack<float> {
+    static constexpr size_t width = 4;
+    static constexpr int rsqrt_estimate_bits = 11;
+    using value_type = float;
+    using reg = __m128;
+    using mask = __m128;
+
+    static reg Load(const float* p){return _mm_loadu_ps(p);}
+    static void Store(float* p, const reg& v){_mm_storeu_ps(p, v);}
+    static reg Set1(const float& t){return _mm_set1_ps(t);}
+    static reg Add(const reg& a, const reg& b){return _mm_add_ps(a, b);}
+    static reg Sub(const reg& a, const reg& b){return _mm_sub_ps(a, b);}
+    static reg Mul(const reg& a, const reg& b){return _mm_mul_ps(a, b);}
+    static reg Div(const reg& a, const reg& b){return _mm_div_ps(a, b);}
+    static reg Fma(const reg& a, const reg& b, const reg& c){return _mm_add_ps(_mm_mul_ps(a, b), c);}
+    static reg Sqrt(const reg& a){return _mm_sqrt_ps(a);}
+#if defined(SS_SIMD_SSE41)
+    static reg Floor(const reg& a){return _mm_floor_ps(a);}
+#else
+    static reg Floor(const reg& a){
+        const __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+        return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a), _mm_set1_ps(1.0f)));
+    }
+#endif
+    static reg RSqrtEstimate(const reg& a){return _mm_rsqrt_ps(a);}
+    static reg Min(const reg& a, const reg& b){return _mm_min_ps(a, b);}
+    static reg Max(const reg& a, const reg& b){return _mm_max_ps(a, b);}
+    static mask Less(const reg& a, const reg& b){return _mm_cmplt_ps(a, b);}
+    static mask LessEqual(const reg& a, const reg& b){return _mm_cmple_ps(a, b);}
+    static mask And(const mask& a, const mask& b){return _mm_and_ps(a, b);}
+#if defined(SS_SIMD_SSE41)
+    static reg Select(const mask& m, const reg& a, const reg& b){return _mm_blendv_ps(b, a, m);}
+#else
+    static reg Select(const mask& m, const reg& a, const reg& b){return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));}
+#endif
+};
+template<>
+struct pack<double> {
+    static constexpr size_t width = 2;
+    static constexpr int rsqrt_estimate_bits = 11;
+    using value_type = double;
+    using reg = __m128d;
+    using mask = __m128d;
+
+    static reg Load(const double* p){return _mm_loadu_pd(p);}
+    static void Store(double* p, const reg& v){_mm_storeu_pd(p, v);}
+    static reg Set1(const double& t){return _mm_set1_pd(t);}
+    static reg Add(const reg& a, const reg& b){return _mm_add_pd(a, b);}
+    static reg Sub(const reg& a, const reg& b){return _mm_sub_pd(a, b);}
+    static reg Mul(const reg& a, const reg& b){return _mm_mul_pd(a, b);}
+    static reg Div(const reg& a, const reg& b){return _mm_div_pd(a, b);}
+    static reg Fma(const reg& a, const reg& b, const reg& c){return _mm_add_pd(_mm_mul_pd(a, b), c);}
+    static reg Sqrt(const reg& a){return _mm_sqrt_pd(a);}
+#if defined(SS_SIMD_SSE41)
+    static reg Floor(const reg& a){return _mm_floor_pd(a);}
+#else
+    static reg Floor(const reg& a){
+        const __m128d t = _mm_cvtepi32_pd(_mm_cvttpd_epi32(a));
+        return _mm_sub_pd(t, _mm_and_pd(_mm_cmpgt_pd(t, a), _mm_set1_pd(1.0)));
+    }
+#endif
+    static reg RSqrtEstimate(const reg& a){return _mm_cvtps_pd(_mm_rsqrt_ps(_mm_cvtpd_ps(a)));}
+    static reg Min(const reg& a, const reg& b){return _mm_min_pd(a, b);}
+    static reg Max(const reg& a, const reg& b){return _mm_max_pd(a, b);}
+    static mask Less(const reg& a, const reg& b){return _mm_cmplt_pd(a, b);}
+    static mask LessEqual(const reg& a, const reg& b){return _mm_cmple_pd(a, b);}
+    static mask And(const mask& a, const mask& b){return _mm_and_pd(a, b);}
+#if defined(SS_SIMD_SSE41)
+    static reg Select(const mask& m, const reg& a, const reg& b){return _mm_blendv_pd(b, a, m);}
+#else
+    static reg Select(const mask& m, const reg& a, const reg& b){return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b));}
+#endif
+};
+#endif
+
+#endif // SS_NO_SIMD
+
+/**
+ * @fn ForEachPack
+ * @brief Calls f(pack<T>{}, i) for each full pack in [0, n), then f(scalar<T>{}, i) for each remaining element.
+ * @remark f is usually a generic lambda taking the pack type by value as a tag.
+ */
+template<typename T, typename F>
+void ForEachPack(const size_t& n, F f){
+    using P = pack<T>;
+    size_t i = 0;
+    if constexpr(P::width > 1) {
+        for(; i + P::width <= n; i += P::width){
+            f(P{}, i);
+        }
+    }
+    for(; i < n; i++){
+        f(scalar<T>{}, i);
+    }
+}
+
+/**
+ * @class aligned_allocator
+ * @brief Allocator returning storage aligned to alignment bytes, so arrays start on a cache line/register boundary.
+ */
+template<typename T, size_t alignment = 64>
+struct aligned_allocator {
+    using value_type = T;
+    template<typename U>
+    struct rebind {using other = aligned_allocator<U, alignment>;};
+
+    aligned_allocator(){}
+    template<typename U>
+    aligned_allocator(const aligned_allocator<U, alignment>&){}
+
+    T* allocate(const size_t& n){
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+    }
+    void deallocate(T* p, const size_t&){
+        ::operator delete(p, std::align_val_t(alignment));
+    }
+
+    template<typename U>
+    bool operator==(const aligned_allocator<U, alignment>&) const {return true;}
+    template<typename U>
+    bool operator!=(const aligned_allocator<U, alignment>&) const {return false;}
+};
+
+}
+}
+
+#endif // SUBSTD_SIMD_HPP
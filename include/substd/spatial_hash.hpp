@@ -0,0 +1,349 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief A spatial hash: points sorted into a sparse grid of cells, for neighbour queries among many moving entities.
+ * @include cstdint limits vector vec aabb math registry
+*/
+
+#ifndef SUBSTD_SPATIAL_HASH_HPP
+#define SUBSTD_SPATIAL_HASH_HPP
+
+#include<cstdint>
+#include<limits>
+#include<vector>
+
+#include<substd/vec.hpp>
+#include<substd/aabb.hpp>
+#include<substd/math.hpp>
+#include<substd/registry.hpp>
+
+namespace ss
+{
+
+namespace detail {
+    //Spreads the low 21 bits of x out to every third bit
+    inline uint64_t MortonSpread3(uint64_t x){
+        x &= 0x1fffff;
+        x = (x | (x << 32)) & 0x1f00000000ffffull;
+        x = (x | (x << 16)) & 0x1f0000ff0000ffull;
+        x = (x | (x << 8)) & 0x100f00f00f00f00full;
+        x = (x | (x << 4)) & 0x10c30c30c30c30c3ull;
+        x = (x | (x << 2)) & 0x1249249249249249ull;
+        return x;
+    }
+}
+
+/**
+ * @fn SpatialKey
+ * @brief Names a grid cell by one integer, different for every cell in range: the zigzagged coordinate in 1D, its
+ * Szudzik pairing in 2D and the Morton code (bits interleaved) in 3D.
+ *
+ * Unique while coordinates fit in 32 bits in 1D and 2D, and within [-2^20, 2^20) in 3D. Beyond that cells may share
+ * keys, slowing SpatialHash queries and letting one report an entry twice.
+ */
+template<size_t dim>
+uint64_t SpatialKey(const vec<int64_t,dim>& cell){
+    static_assert(dim >= 1 && dim <= 3, "SpatialKey() supports 1 to 3 dimensions!");
+    if constexpr(dim == 1){return (uint64_t)MapIntToPositive<int64_t>(cell[0]);}
+    else if constexpr(dim == 2){
+        return SzudzikPair<uint64_t>((uint64_t)MapIntToPositive<int64_t>(cell[0]), (uint64_t)MapIntToPositive<int64_t>(cell[1]));
+    }
+    else {
+        return detail::MortonSpread3((uint64_t)MapIntToPositive<int64_t>(cell[0]))
+            | (detail::MortonSpread3((uint64_t)MapIntToPositive<int64_t>(cell[1])) << 1)
+            | (detail::MortonSpread3((uint64_t)MapIntToPositive<int64_t>(cell[2])) << 2);
+    }
+}
+///@brief SpatialKey() is unique for cells within [-SpatialKeyReach, SpatialKeyReach) on every axis
+template<size_t dim>
+constexpr int64_t SpatialKeyReach = (dim == 3) ? ((int64_t)1 << 20) : ((int64_t)1 << 31);
+
+/**
+ * @class SpatialHash
+ * @brief Entries at points, kept in a grid of cells of which only the occupied ones are stored.
+ *
+ * Cells are keyed by SpatialKey() in an open addressing hash table, each holding a linked list of its entries,
+ * so inserting, removing and moving an entry are O(1) and never allocate once the storage has grown. Queries
+ * visit the cells a box overlaps, or every occupied cell when there are fewer of those, passing each entry's payload
+ * as const; Get() a handle's payload to change it. Queries may run from many threads at once, changes may not.
+ *
+ * @tparam T type of the coordinates
+ * @tparam dim number of dimensions, 1 to 3
+ * @tparam Payload what each entry carries
+ */
+template<typename T, size_t dim, typename Payload>
+class SpatialHash {
+    static_assert(dim >= 1 && dim <= 3, "SpatialHash supports 1 to 3 dimensions!");
+public:
+    using handle_type = RegistryHandle;
+    static constexpr uint32_t NONE = RegistryHandle::NONE;
+
+protected:
+    struct Entry {
+        vec<T,dim> position;
+        Payload payload;
+        uint64_t key;
+        ///@brief The neighbours in the cell's list, or for a free entry next is the next free one
+        uint32_t prev;
+        uint32_t next;
+        uint32_t generation = 0;
+        bool live = false;
+    };
+    struct Slot {
+        uint64_t key;
+        ///@brief The cell's first entry, NONE for an empty slot
+        uint32_t head = NONE;
+    };
+
+    T cell_size;
+    T inv_cell_size;
+    std::vector<Entry> entries;
+    uint32_t free_head = NONE;
+    size_t count = 0;
+    std::vector<Slot> slots;
+    size_t cells = 0;
+
+    //Fibonacci hashing, as nearby cells have nearby keys
+    size_t Home(const uint64_t& key) const {
+        return (size_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & (slots.size() - 1);
+    }
+    size_t Find(const uint64_t& key) const {
+        if(slots.empty()){return NONE;}
+        for(size_t i = Home(key);; i = (i + 1) & (slots.size() - 1)){
+            if(slots[i].head == NONE){return NONE;}
+            if(slots[i].key == key){return i;}
+        }
+    }
+    void Grow(){
+        std::vector<Slot> old(Max<size_t>(slots.size() * 2, 16));
+        old.swap(slots);
+        for(const Slot& s : old){
+            if(s.head == NONE){continue;}
+            size_t i = Home(s.key);
+            while(slots[i].head != NONE){i = (i + 1) & (slots.size() - 1);}
+            slots[i] = s;
+        }
+    }
+    //Empties slot i, shifting back the entries that probed past it so no lookup stops short
+    void EraseSlot(size_t i){
+        const size_t mask = slots.size() - 1;
+        for(size_t j = (i + 1) & mask; slots[j].head != NONE; j = (j + 1) & mask){
+            const size_t home = Home(slots[j].key);
+            //Whether home lies cyclically in (i, j], in which case j may stay
+            const bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+            if(!stays){
+                slots[i] = slots[j];
+                i = j;
+            }
+        }
+        slots[i].head = NONE;
+        cells--;
+    }
+
+    void Link(const uint32_t& e){
+        if((cells + 1) * 2 > slots.size()){Grow();}
+        Entry& entry = entries[e];
+        size_t i = Home(entry.key);
+        while(slots[i].head != NONE && slots[i].key != entry.key){i = (i + 1) & (slots.size() - 1);}
+        if(slots[i].head == NONE){
+            slots[i].key = entry.key;
+            cells++;
+        }
+        else {entries[slots[i].head].prev = e;}
+        entry.prev = NONE;
+        entry.next = slots[i].head;
+        slots[i].head = e;
+    }
+    void Unlink(const uint32_t& e){
+        const Entry& entry = entries[e];
+        if(entry.next != NONE){entries[entry.next].prev = entry.prev;}
+        if(entry.prev != NONE){
+            entries[entry.prev].next = entry.next;
+            return;
+        }
+        const size_t i = Find(entry.key);
+        if(entry.next == NONE){EraseSlot(i);}
+        else {slots[i].head = entry.next;}
+    }
+
+    template<typename F>
+    void ForCell(const uint64_t& key, F& f) const {
+        const size_t i = Find(key);
+        if(i == NONE){return;}
+        for(uint32_t e = slots[i].head; e != NONE; e = entries[e].next){f(e);}
+    }
+    //Calls f(entry index) for every entry in a cell box overlaps, but not only those inside box
+    template<typename F>
+    void ForCandidates(const aabb<T,dim>& box, F f) const {
+        if(count == 0){return;}
+        const vec<int64_t,dim> low = CellOf(box.min), high = CellOf(box.max);
+        T range = 1;
+        for(size_t i = 0; i < dim; i++){range *= (T)(high[i] - low[i] + 1);}
+        //Cheaper to look at every occupied cell than probe for mostly empty ones
+        if(range > (T)cells){
+            for(const Slot& s : slots){
+                if(s.head == NONE){continue;}
+                for(uint32_t e = s.head; e != NONE; e = entries[e].next){f(e);}
+            }
+            return;
+        }
+        vec<int64_t,dim> at = low;
+        while(true){
+            ForCell(SpatialKey<dim>(at), f);
+            size_t i = 0;
+            for(; i < dim; i++){
+                if(at[i] < high[i]){
+                    at[i]++;
+                    break;
+                }
+                at[i] = low[i];
+            }
+            if(i == dim){return;}
+        }
+    }
+
+public:
+    /**
+     * @brief Constructor
+     * @param cell_size The edge length of every cell, ideally about the radius most queries use
+     */
+    SpatialHash(const T& cell_size = 1) : cell_size(cell_size), inv_cell_size((T)1 / cell_size) {}
+
+    /**
+     * @fn CellOf
+     * @brief Clamped in T to the cells SpatialKey() keeps apart, so far off points share the border cells and NaN
+     * goes to the lowest.
+     * @return vec<int64_t,dim> The coordinates of the cell p is in
+     */
+    vec<int64_t,dim> CellOf(const vec<T,dim>& p) const {
+        constexpr int64_t reach = SpatialKeyReach<dim>;
+        vec<int64_t,dim> ret;
+        for(size_t i = 0; i < dim; i++){
+            const T cell = Floor<T>(p[i] * inv_cell_size);
+            if(!(cell >= (T)-reach)){ret[i] = -reach;}
+            else if(!(cell < (T)reach)){ret[i] = reach - 1;}
+            else {ret[i] = (int64_t)cell;}
+        }
+        return ret;
+    }
+    ///@fn CellSize
+    T CellSize() const {return cell_size;}
+    ///@fn size @return size_t The number of entries
+    size_t size() const {return count;}
+    bool empty() const {return count == 0;}
+    ///@fn CellCount @return size_t The number of occupied cells
+    size_t CellCount() const {return cells;}
+
+    ///@fn Reserve Grows the storage to hold n entries in as many cells without allocating
+    void Reserve(const size_t& n){
+        entries.reserve(n);
+        while(n * 2 > slots.size()){Grow();}
+    }
+    ///@fn Clear Removes every entry, invalidating every handle
+    void Clear(){
+        for(Entry& entry : entries){
+            if(entry.live){entry.generation++;}
+            entry.live = false;
+        }
+        free_head = NONE;
+        for(size_t e = entries.size(); e-- > 0;){
+            entries[e].next = free_head;
+            free_head = (uint32_t)e;
+        }
+        for(Slot& s : slots){s.head = NONE;}
+        count = 0;
+        cells = 0;
+    }
+
+    ///@fn Insert @return handle_type The handle of the new entry at position
+    handle_type Insert(const vec<T,dim>& position, const Payload& payload){
+        uint32_t e = free_head;
+        if(e != NONE){free_head = entries[e].next;}
+        else {
+            e = (uint32_t)entries.size();
+            entries.emplace_back();
+        }
+        Entry& entry = entries[e];
+        entry.position = position;
+        entry.payload = payload;
+        entry.key = SpatialKey<dim>(CellOf(position));
+        entry.live = true;
+        Link(e);
+        count++;
+        return handle_type{e, entry.generation};
+    }
+    ///@fn Valid @return bool Whether h names an entry still in the hash
+    bool Valid(const handle_type& h) const {
+        return h.index < entries.size() && entries[h.index].live && entries[h.index].generation == h.generation;
+    }
+    ///@fn Remove @return bool Whether h named an entry, now removed
+    bool Remove(const handle_type& h){
+        if(!Valid(h)){return false;}
+        Unlink(h.index);
+        Entry& entry = entries[h.index];
+        entry.live = false;
+        entry.generation++;
+        entry.next = free_head;
+        free_head = h.index;
+        count--;
+        return true;
+    }
+    ///@fn Move Moves h's entry to position, relinking it only if it changed cell @return bool Whether h named an entry
+    bool Move(const handle_type& h, const vec<T,dim>& position){
+        if(!Valid(h)){return false;}
+        Entry& entry = entries[h.index];
+        entry.position = position;
+        const uint64_t key = SpatialKey<dim>(CellOf(position));
+        if(key != entry.key){
+            Unlink(h.index);
+            entry.key = key;
+            Link(h.index);
+        }
+        return true;
+    }
+    ///@fn Get @return Payload* h's payload, nullptr if h is not Valid()
+    Payload* Get(const handle_type& h){return Valid(h) ? &entries[h.index].payload : nullptr;}
+    const Payload* Get(const handle_type& h) const {return Valid(h) ? &entries[h.index].payload : nullptr;}
+    ///@fn Position @return vec<T,dim> Where h's entry is, h must be Valid()
+    const vec<T,dim>& Position(const handle_type& h) const {return entries[h.index].position;}
+
+    /**
+     * @fn QueryAABB
+     * @brief Calls f(payload, position) for every entry in the closed box
+     */
+    template<typename F>
+    void QueryAABB(const aabb<T,dim>& box, F f) const {
+        ForCandidates(box, [&](const uint32_t& e){
+            const Entry& entry = entries[e];
+            if(box.Contains(entry.position)){f(entry.payload, entry.position);}
+        });
+    }
+    /**
+     * @fn QueryRadius
+     * @brief Calls f(payload, position) for every entry no further than radius from center
+     */
+    template<typename F>
+    void QueryRadius(const vec<T,dim>& center, const T& radius, F f) const {
+        const T radius_sq = radius * radius;
+        ForCandidates(aabb<T,dim>::FromCenter(center, vec<T,dim>(radius * (T)2)), [&](const uint32_t& e){
+            const Entry& entry = entries[e];
+            T dist_sq = 0;
+            for(size_t i = 0; i < dim; i++){
+                const T d = entry.position[i] - center[i];
+                dist_sq += d * d;
+            }
+            if(dist_sq <= radius_sq){f(entry.payload, entry.position);}
+        });
+    }
+    ///@fn ForEach Calls f(payload, position) for every entry
+    template<typename F>
+    void ForEach(F f) const {
+        for(const Entry& entry : entries){
+            if(entry.live){f(entry.payload, entry.position);}
+        }
+    }
+};
+
+}
+
+#endif // SUBSTD_SPATIAL_HASH_HPP
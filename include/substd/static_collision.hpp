@@ -0,0 +1,355 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Plain collision shapes, and a collision group storing each kind contiguously and trimming against them without virtual calls.
+ * @include array tuple type_traits vector vec vec_soa aabb math simd raycoll
+*/
+
+#ifndef SUBSTD_STATIC_COLLISION_HPP
+#define SUBSTD_STATIC_COLLISION_HPP
+
+#include<array>
+#include<tuple>
+#include<type_traits>
+#include<vector>
+
+#include<substd/vec.hpp>
+#include<substd/vec_soa.hpp>
+#include<substd/aabb.hpp>
+#include<substd/math.hpp>
+#include<substd/simd.hpp>
+#include<substd/raycoll.hpp>
+
+namespace ss
+{
+
+/**
+ * @class ShapeList
+ * @brief The default storage of one shape type in a StaticCollisionGroup, a vector trimming against each shape in turn.
+ */
+template<typename S>
+class ShapeList : public std::vector<S> {
+public:
+    using T = typename S::value_type;
+    static constexpr size_t dim = S::dimension;
+
+    using std::vector<S>::vector;
+
+    T TrimMove(const vec<T,dim>& origin, const size_t& dir, const T& move) const {
+        T curr_move = move;
+        for(size_t i = 0; i < this->size() && curr_move != 0; i++){curr_move = (*this)[i].TrimMove(origin, dir, curr_move);}
+        return curr_move;
+    }
+    T TrimMoves(const std::array<const T*,dim>& origins, const size_t& count, const size_t& dir, const T& move) const {
+        T curr_move = move;
+        for(size_t i = 0; i < this->size() && curr_move != 0; i++){curr_move = (*this)[i].TrimMoves(origins, count, dir, curr_move);}
+        return curr_move;
+    }
+    T TrimBoxMove(const aabb<T,dim>& box, const size_t& dir, const T& move) const {
+        T curr_move = move;
+        for(size_t i = 0; i < this->size() && curr_move != 0; i++){curr_move = (*this)[i].TrimBoxMove(box, dir, curr_move);}
+        return curr_move;
+    }
+};
+
+template<typename T, size_t dim>
+class BoxList;
+
+/**
+ * @class BoxShape
+ * @brief A solid axis aligned box, trimming rays and swept boxes as AABBRayCollidable does.
+ */
+template<typename T, size_t dim>
+struct BoxShape {
+    using value_type = T;
+    static constexpr size_t dimension = dim;
+    using list_type = BoxList<T,dim>;
+
+    aabb<T,dim> bounds;
+
+    BoxShape(){}
+    BoxShape(const aabb<T,dim>& bounds) : bounds(bounds) {}
+
+    T TrimMove(const vec<T,dim>& origin, const size_t& dir, const T& move) const {
+        return detail::TrimRayBox(bounds, origin, dir, move);
+    }
+    T TrimMoves(const std::array<const T*,dim>& origins, const size_t& count, const size_t& dir, const T& move) const {
+        return detail::TrimRaysBox(bounds, origins, count, dir, move);
+    }
+    T TrimBoxMove(const aabb<T,dim>& box, const size_t& dir, const T& move) const {
+        return detail::TrimBoxBox(bounds, box, dir, move);
+    }
+};
+
+/**
+ * @class BoxList
+ * @brief The storage of BoxShapes in a StaticCollisionGroup, each corner's components in their own lane, so a ray
+ * or swept box is trimmed against a SIMD pack of boxes at a time.
+ */
+template<typename T, size_t dim>
+class BoxList {
+protected:
+    vec_soa<T,dim> mins;
+    vec_soa<T,dim> maxs;
+
+    //One pack of boxes from i, curr_move trimmed by each whose extent strictly overlaps [low, high] on every other axis
+    template<typename P>
+    typename P::reg TrimPack(const size_t& i, const vec<T,dim>& low, const vec<T,dim>& high, const size_t& dir, const bool& forward, const typename P::reg& curr_move) const {
+        const typename P::reg lead = P::Set1(forward ? high[dir] : low[dir]);
+        const typename P::reg face = P::Load((forward ? mins.Lane(dir) : maxs.Lane(dir)) + i);
+        //Only boxes on the far side of the leading face can be run into
+        auto hits = forward ? P::LessEqual(lead, face) : P::LessEqual(face, lead);
+        for(size_t axis = 0; axis < dim; axis++){
+            if(axis == dir){continue;}
+            hits = P::And(hits, P::And(P::Less(P::Load(mins.Lane(axis) + i), P::Set1(high[axis])), P::Less(P::Set1(low[axis]), P::Load(maxs.Lane(axis) + i))));
+        }
+        const typename P::reg trimmed = P::Select(hits, P::Sub(face, lead), curr_move);
+        return forward ? P::Min(trimmed, curr_move) : P::Max(trimmed, curr_move);
+    }
+    //What moves is a ray when low == high
+    T TrimSpan(const vec<T,dim>& low, const vec<T,dim>& high, const size_t& dir, const T& move) const {
+        if(move == 0 || empty()){return move;}
+        using P = simd::pack<T>;
+        using S = simd::scalar<T>;
+        const bool forward = move > 0;
+        T curr_move = move;
+        size_t i = 0;
+        if constexpr(P::width > 1) {
+            if(size() >= P::width){
+                typename P::reg best = P::Set1(move);
+                for(; i + P::width <= size(); i += P::width){best = TrimPack<P>(i, low, high, dir, forward, best);}
+                alignas(64) T lanes[P::width];
+                P::Store(lanes, best);
+                for(size_t k = 0; k < P::width; k++){curr_move = forward ? Min(curr_move, lanes[k]) : Max(curr_move, lanes[k]);}
+            }
+        }
+        for(; i < size(); i++){curr_move = TrimPack<S>(i, low, high, dir, forward, curr_move);}
+        return curr_move;
+    }
+
+public:
+    size_t size() const {return mins.size();}
+    bool empty() const {return mins.empty();}
+    void reserve(const size_t& n){
+        mins.reserve(n);
+        maxs.reserve(n);
+    }
+    void clear(){
+        mins.clear();
+        maxs.clear();
+    }
+    void push_back(const BoxShape<T,dim>& shape){
+        mins.push_back(shape.bounds.min);
+        maxs.push_back(shape.bounds.max);
+    }
+    void pop_back(){
+        mins.pop_back();
+        maxs.pop_back();
+    }
+    ///@fn Get
+    BoxShape<T,dim> Get(const size_t& index) const {
+        return BoxShape<T,dim>(aabb<T,dim>(mins.Get(index), maxs.Get(index)));
+    }
+    ///@fn Set
+    void Set(const size_t& index, const BoxShape<T,dim>& shape){
+        mins.Set(index, shape.bounds.min);
+        maxs.Set(index, shape.bounds.max);
+    }
+
+    T TrimMove(const vec<T,dim>& origin, const size_t& dir, const T& move) const {
+        return TrimSpan(origin, origin, dir, move);
+    }
+    ///@fn TrimMoves Each ray in turn against a pack of boxes at a time, the boxes being the longer run
+    T TrimMoves(const std::array<const T*,dim>& origins, const size_t& count, const size_t& dir, const T& move) const {
+        T curr_move = move;
+        for(size_t k = 0; k < count && curr_move != 0; k++){
+            vec<T,dim> origin;
+            for(size_t i = 0; i < dim; i++){origin[i] = origins[i][k];}
+            curr_move = TrimSpan(origin, origin, dir, curr_move);
+        }
+        return curr_move;
+    }
+    T TrimBoxMove(const aabb<T,dim>& box, const size_t& dir, const T& move) const {
+        return TrimSpan(box.min, box.max, dir, move);
+    }
+};
+
+/**
+ * @class SphereShape
+ * @brief A solid sphere, a circle in 2D.
+ *
+ * As with boxes, only rays passing strictly within the radius are trimmed, and nothing starting inside.
+ */
+template<typename T, size_t dim>
+struct SphereShape {
+    using value_type = T;
+    static constexpr size_t dimension = dim;
+
+    vec<T,dim> center;
+    T radius;
+
+    SphereShape(){}
+    SphereShape(const vec<T,dim>& center, const T& radius) : center(center), radius(radius) {}
+
+protected:
+    //sqr_distance is how far off the line of the move, squared, the nearest point of what moves passes the centre
+    T TrimFrom(const T& sqr_distance, const T& low, const T& high, const T& move) const {
+        if(sqr_distance >= radius * radius){return move;}
+        const T half_chord = Sqrt<T>((radius * radius) - sqr_distance);
+        return detail::TrimAxis((move > 0) ? high : low, move, -half_chord, half_chord);
+    }
+
+public:
+    T TrimMove(const vec<T,dim>& origin, const size_t& dir, const T& move) const {
+        T sqr_distance = 0;
+        for(size_t i = 0; i < dim; i++){
+            if(i != dir){sqr_distance += (origin[i] - center[i]) * (origin[i] - center[i]);}
+        }
+        const T along = origin[dir] - center[dir];
+        return TrimFrom(sqr_distance, along, along, move);
+    }
+    T TrimMoves(const std::array<const T*,dim>& origins, const size_t& count, const size_t& dir, const T& move) const {
+        T curr_move = move;
+        for(size_t k = 0; k < count && curr_move != 0; k++){
+            vec<T,dim> origin;
+            for(size_t i = 0; i < dim; i++){origin[i] = origins[i][k];}
+            curr_move = TrimMove(origin, dir, curr_move);
+        }
+        return curr_move;
+    }
+    ///@fn TrimBoxMove Exact, the box's nearest point to the centre across the move is what reaches the sphere first
+    T TrimBoxMove(const aabb<T,dim>& box, const size_t& dir, const T& move) const {
+        T sqr_distance = 0;
+        for(size_t i = 0; i < dim; i++){
+            if(i == dir){continue;}
+            const T off = Min(Max(center[i], box.min[i]), box.max[i]) - center[i];
+            sqr_distance += off * off;
+        }
+        return TrimFrom(sqr_distance, box.min[dir] - center[dir], box.max[dir] - center[dir], move);
+    }
+};
+
+/**
+ * @class HalfSpaceShape
+ * @brief Everything on one side of a plane, a line in 2D: the points x with Dot(normal, x) <= offset.
+ *
+ * Good for level bounds and floors. Anything starting strictly inside is never trimmed.
+ */
+template<typename T, size_t dim>
+struct HalfSpaceShape {
+    using value_type = T;
+    static constexpr size_t dimension = dim;
+
+    vec<T,dim> normal;
+    T offset;
+
+    HalfSpaceShape(){}
+    HalfSpaceShape(const vec<T,dim>& normal, const T& offset) : normal(normal), offset(offset) {}
+
+    T TrimMove(const vec<T,dim>& origin, const size_t& dir, const T& move) const {
+        T height = -offset;
+        for(size_t i = 0; i < dim; i++){height += normal[i] * origin[i];}
+        //Only trimmed from outside or on the surface, heading in
+        if(height < 0 || !(move * normal[dir] < 0)){return move;}
+        const T reach = -height / normal[dir];
+        return (move > 0) ? Min(move, reach) : Max(move, reach);
+    }
+    T TrimMoves(const std::array<const T*,dim>& origins, const size_t& count, const size_t& dir, const T& move) const {
+        T curr_move = move;
+        for(size_t k = 0; k < count && curr_move != 0; k++){
+            vec<T,dim> origin;
+            for(size_t i = 0; i < dim; i++){origin[i] = origins[i][k];}
+            curr_move = TrimMove(origin, dir, curr_move);
+        }
+        return curr_move;
+    }
+    ///@fn TrimBoxMove Exact, the corner of the box deepest along -normal is the first to enter
+    T TrimBoxMove(const aabb<T,dim>& box, const size_t& dir, const T& move) const {
+        vec<T,dim> corner;
+        for(size_t i = 0; i < dim; i++){corner[i] = (normal[i] > 0) ? box.min[i] : box.max[i];}
+        return TrimMove(corner, dir, move);
+    }
+};
+
+namespace detail {
+    //S::list_type if S names one, ShapeList<S> otherwise
+    template<typename S, typename = void>
+    struct ShapeListOf {using type = ShapeList<S>;};
+    template<typename S>
+    struct ShapeListOf<S, std::void_t<typename S::list_type>> {using type = typename S::list_type;};
+}
+
+/**
+ * @class StaticCollisionGroup
+ * @brief A collision group of shapes stored by value, each kind contiguously and trimmed against in a loop of its
+ * own, so no shape is called virtually and each loop can be inlined.
+ *
+ * Usable anywhere an IRayCollidable is, at the cost of one virtual call for the whole group. Every shape type
+ * provides value_type and dimension (the same for all of them), and non-virtual TrimMove, TrimMoves and
+ * TrimBoxMove with IRayCollidable's signatures, as BoxShape, SphereShape and HalfSpaceShape do. A shape type
+ * may also name a list_type to be stored in, with the same three methods over every shape, as BoxShape does
+ * to be trimmed against a SIMD pack at a time; otherwise it is stored in a ShapeList.
+ *
+ * @tparam Shapes The shape types stored, each once
+ */
+template<typename... Shapes>
+class StaticCollisionGroup : public IRayCollidable<typename std::tuple_element_t<0, std::tuple<Shapes...>>::value_type,
+                                                   std::tuple_element_t<0, std::tuple<Shapes...>>::dimension> {
+public:
+    using value_type = typename std::tuple_element_t<0, std::tuple<Shapes...>>::value_type;
+    static constexpr size_t dimension = std::tuple_element_t<0, std::tuple<Shapes...>>::dimension;
+    template<typename S>
+    using list_type = typename detail::ShapeListOf<S>::type;
+
+protected:
+    using T = value_type;
+    static constexpr size_t dim = dimension;
+    static_assert(((std::is_same_v<typename Shapes::value_type, T> && Shapes::dimension == dim) && ...),
+        "StaticCollisionGroup requires shapes of one coordinate type and dimension!");
+
+    std::tuple<list_type<Shapes>...> shapes;
+
+    //Trims move by each list in turn, stopping at 0
+    template<typename F>
+    T TrimEach(const T& move, F trim) const {
+        T curr_move = move;
+        std::apply([&](const auto&... lists){((curr_move = (curr_move == 0) ? curr_move : trim(lists, curr_move)), ...);}, shapes);
+        return curr_move;
+    }
+
+public:
+    ///@fn Add Adds a copy of shape @return size_t Its index among the shapes of type S
+    template<typename S>
+    size_t Add(const S& shape){
+        list_type<S>& list = std::get<list_type<S>>(shapes);
+        list.push_back(shape);
+        return list.size() - 1;
+    }
+    ///@fn Get @return list_type<S>& Every shape of type S, to edit or remove from directly
+    template<typename S>
+    list_type<S>& Get(){return std::get<list_type<S>>(shapes);}
+    template<typename S>
+    const list_type<S>& Get() const {return std::get<list_type<S>>(shapes);}
+    ///@fn Size @return size_t The number of shapes of every type
+    size_t Size() const {
+        return std::apply([](const auto&... lists){return (lists.size() + ...);}, shapes);
+    }
+    ///@fn Clear Removes every shape
+    void Clear(){
+        std::apply([](auto&... lists){(lists.clear(), ...);}, shapes);
+    }
+
+    T TrimMove(const vec<T,dim>& origin, const size_t& dir, const T& move) const override {
+        return TrimEach(move, [&](const auto& list, const T& m){return list.TrimMove(origin, dir, m);});
+    }
+    T TrimMoves(const std::array<const T*,dim>& origins, const size_t& count, const size_t& dir, const T& move) const override {
+        return TrimEach(move, [&](const auto& list, const T& m){return list.TrimMoves(origins, count, dir, m);});
+    }
+    T TrimBoxMove(const aabb<T,dim>& box, const size_t& dir, const T& move) const override {
+        return TrimEach(move, [&](const auto& list, const T& m){return list.TrimBoxMove(box, dir, m);});
+    }
+};
+
+}
+
+#endif // SUBSTD_STATIC_COLLISION_HPP
@@ -3,6 +3,7 @@
 
 #include<substd/vec.hpp>
 #include<substd/mat.hpp>
+#include<substd/affine.hpp>
 #include<substd/interfaces.hpp>
 #include<substd/modulo.hpp>
 
@@ -11,33 +12,33 @@ namespace ss {
 template<typename T, size_t dim>
 class Plug : public virtual IPluggable<T, dim> {
 protected:
-    mat<T,dim+1> plugMatrix;
+    affine<T,dim> plugMatrix;
 
 public:
-    Plug() : plugMatrix(1) {}
-    Plug(const vec<T,dim>& pos) : plugMatrix(1) {
+    Plug() : plugMatrix((T)1) {}
+    Plug(const vec<T,dim>& pos) : plugMatrix((T)1) {
         plugMatrix[dim] = pos;
     }
-    Plug(const vec<T,dim>& pos, const vec<T,dim>& scale) : plugMatrix(1) {
+    Plug(const vec<T,dim>& pos, const vec<T,dim>& scale) : plugMatrix((T)1) {
         plugMatrix[dim] = pos;
-        for(int i = 0; i < dim; i++){
+        for(size_t i = 0; i < dim; i++){
             plugMatrix[i][i] = scale[i];
         }
     }
 
-    vec<T,dim> GetPosition() const override {return vec<T,dim>(plugMatrix[dim])}
-    virtual void SetPosition(const vec<T,dim>& val) override {plugMatrix[dim] = val}
+    vec<T,dim> GetPosition() const override {return plugMatrix[dim];}
+    virtual void SetPosition(const vec<T,dim>& val) override {plugMatrix[dim] = val;}
     virtual void SetPosition(const T& val, const size_t& index) override {plugMatrix.at(dim).at(index) = val;}
 
     vec<T,dim> GetScale() const override {
         vec<T,dim> ret;
-        for(int i = 0; i < dim; i++){
+        for(size_t i = 0; i < dim; i++){
             ret[i] = plugMatrix[i][i];
         }
         return ret;
     }
     virtual void SetScale(const vec<T,dim>& val) override {
-        for(int i = 0; i < dim; i++){
+        for(size_t i = 0; i < dim; i++){
             plugMatrix[i][i] = val[i];
         }
     }
@@ -45,95 +46,129 @@ public:
         plugMatrix[index][index] = val;
     }
 
-    mat<T,dim> GetPlugMatrix() const override {return plugMatrix;}
+    affine<T,dim> GetPlugMatrix() const override {return plugMatrix;}
 };
 
-template<typename T, size_t dim>
+/**
+ * @class Rotation
+ * @tparam RT The type each angle is passed through when set, such as modulo_tau<T> to keep them within one turn.
+ * That wraps with std::fmod, so angles keep their sign, in (-tau, tau).
+ */
+template<typename T, size_t dim, typename RT = T>
 class Rotation : public virtual IRotatable<T, dim> {
 protected:
-    bool rotationHasChanged;
+    static constexpr size_t NRP = (dim*(dim-1))/2;
+
+    mutable bool rotationHasChanged;
     vec<T,NRP> rotation;
-    volatile mat<T,dim+1> rotationMatrix;
+    mutable mat<T,dim> rotationMatrix;
 
-    void CalculateRotationMatrix(){
-        rotationMatrix = mat<T,dim+1>(0);
-        rotationMatrix.at(dim).at(dim) = 1;
-        rotationMatrix += CreateRotationMatrix<T,dim>(rotation);
+    void CalculateRotationMatrix() const {
+        rotationMatrix = CreateRotationMatrix<T,dim>(rotation);
         rotationHasChanged = false;
     }
+    static T Constrain(const T& angle){return (T)RT(angle);}
 
 public:
     Rotation() : rotationHasChanged(false), rotation(0), rotationMatrix(1) {}
-    Rotation(const vec<T,dim>& rot) : rotation(rot), rotationHasChanged(true) {}
+    Rotation(const vec<T,NRP>& rot) : rotationHasChanged(true) {
+        for(size_t i = 0; i < NRP; i++){rotation[i] = Constrain(rot[i]);}
+    }
 
     vec<T,NRP> GetRotation() const override {return rotation;}
-    vec<T,NRP> GetRotationMatrix() const override {
+    mat<T,dim> GetRotationMatrix() const override {
         if(rotationHasChanged){CalculateRotationMatrix();}
         return rotationMatrix;
     }
     virtual void SetRotation(const vec<T,NRP>& val) override {
-        rotation = val;
+        for(size_t i = 0; i < NRP; i++){rotation[i] = Constrain(val[i]);}
         rotationHasChanged = true;
     }
     virtual void SetRotation(const T& val, const size_t& index) override {
-        rotation[index] = val;
+        rotation[index] = Constrain(val);
         rotationHasChanged = true;
     }
 };
 
+/**
+ * @class Orientation
+ * @brief A local transform of a translation, a per-axis scale and a rotation, rotated first and translated last.
+ *
+ * The local matrix is kept as an affine<T,dim> and rebuilt when read after a change.
+ */
 template<typename T, typename RT, size_t dim>
-class Orientation : public virtual IOrientatable<T,RT,dim>, public Plug<T,dim>, public Rotation<RT,dim> {
+class Orientation : public virtual IOrientatable<T,RT,dim>, public Plug<T,dim>, public Rotation<T,dim,RT> {
 protected:
-    bool orientationHasChanged;
-    mat<T,dim+1> orientationMatrix;
+    static constexpr size_t NRP = (dim*(dim-1))/2;
+
+    mutable bool orientationHasChanged;
+    mutable affine<T,dim> orientationMatrix;
 
     void CalculateOrientationMatrix() const {
-        orientationMatrix = GetPlugMatrix() * GetRotationMatrix();
+        //The plug is the scale on the diagonal and the position, so build the whole thing in one pass
+        orientationMatrix = CreateTRS<T,dim>(this->plugMatrix[dim], this->GetScale(), this->rotation);
         orientationHasChanged = false;
-    };
+    }
+    ///@fn LocalMatrixChanged Called by every setter after the change, for derived classes to pass it on
+    virtual void LocalMatrixChanged() {
+        orientationHasChanged = true;
+    }
 
 public:
-    Orientation(){}
+    Orientation() : orientationHasChanged(true) {}
 
-
-    mat<T,dim+1> GetLocalMatrix() const override {
+    affine<T,dim> GetLocalAffine() const override {
         if(orientationHasChanged){CalculateOrientationMatrix();}
-        return orietationMatrix;
+        return orientationMatrix;
+    }
+    mat<T,dim+1> GetLocalMatrix() const override {
+        return GetLocalAffine().ToMatrix();
     }
 
 //Overriding Inherited Setters
     void SetPosition(const vec<T,dim>& val) override {
-        plugMatrix[dim] = val; 
-        orientationHasChanged = true;
+        this->plugMatrix[dim] = val;
+        LocalMatrixChanged();
     }
     void SetPosition(const T& val, const size_t& index) override {
-        plugMatrix.at(dim).at(index) = val;
-        orientationHasChanged = true;    
+        this->plugMatrix.at(dim).at(index) = val;
+        LocalMatrixChanged();
     }
     void SetScale(const vec<T,dim>& val) override {
-        for(int i = 0; i < dim; i++){
-            plugMatrix[i][i] = val[i];
+        for(size_t i = 0; i < dim; i++){
+            this->plugMatrix[i][i] = val[i];
         }
-        orientationHasChanged = true;
+        LocalMatrixChanged();
     }
     void SetScale(const T& val, const size_t& index) override {
-        plugMatrix[index][index] = val;
-        orientationHasChanged = true;
+        this->plugMatrix[index][index] = val;
+        LocalMatrixChanged();
     }
-    void SetRotation(const vec<RT,NRP>& val) override {
-        rotation = val;
-        rotationHasChanged = true;
-        orientationHasChanged = true;
+    void SetRotation(const vec<T,NRP>& val) override {
+        Rotation<T,dim,RT>::SetRotation(val);
+        LocalMatrixChanged();
     }
-    void SetRotation(const RT& val, const size_t& index) override {
-        rotation[index] = val;
-        rotationHasChanged = true;
-        orientationHasChanged = true;
+    void SetRotation(const T& val, const size_t& index) override {
+        Rotation<T,dim,RT>::SetRotation(val, index);
+        LocalMatrixChanged();
     }
 };
 
+/**
+ * @class BaseTransform
+ * @brief An Orientation as a node of an ITransformable hierarchy, every change to it flagged for its descendants.
+ */
 template<typename T, typename RT, size_t dim>
-class BaseTransform : public virtual ITransformable<T,dim>, public Orientation<T,RT,dim> {};
+class BaseTransform : public virtual ITransformable<T,dim>, public Orientation<T,RT,dim> {
+protected:
+    void LocalMatrixChanged() override {
+        Orientation<T,RT,dim>::LocalMatrixChanged();
+        this->FlagLocalChange();
+    }
+
+public:
+    BaseTransform(ITransformable<T,dim>* parent = nullptr) : ITransformable<T,dim>(parent) {}
+};
 template<typename T, size_t dim>
 using Transform = BaseTransform<T, modulo_tau<T>, dim>;
 
@@ -144,4 +179,4 @@ using Transform2f = Transform<float, 2>;
 
 }
 
-#endif//SUBSTD_TRANSFORM_HPP
\ No newline at end of file
+#endif//SUBSTD_TRANSFORM_HPP
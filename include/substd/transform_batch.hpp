@@ -0,0 +1,193 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Bringing the global matrices of a whole ITransformable hierarchy up to date in one level by level pass.
+ * @include algorithm atomic cstdint functional utility vector affine interfaces parallel
+*/
+
+#ifndef SUBSTD_TRANSFORM_BATCH_HPP
+#define SUBSTD_TRANSFORM_BATCH_HPP
+
+#include<algorithm>
+#include<atomic>
+#include<cstdint>
+#include<functional>
+#include<utility>
+#include<vector>
+
+#include<substd/affine.hpp>
+#include<substd/interfaces.hpp>
+#include<substd/parallel.hpp>
+
+namespace ss
+{
+
+#ifndef SS_TRANSFORM_PREFETCH_DISTANCE
+///@brief How many nodes ahead TransformLevels::Update prefetches, the nodes themselves being scattered over the heap.
+#define SS_TRANSFORM_PREFETCH_DISTANCE 8
+#endif
+
+namespace detail
+{
+
+///@fn PrefetchBytes Hints that the bytes [address, address + size) are about to be read
+inline void PrefetchBytes(const void* address, const size_t& size){
+#if defined(__GNUC__) || defined(__clang__)
+    for(size_t offset = 0; offset < size; offset += 64){
+        __builtin_prefetch(static_cast<const char*>(address) + offset, 0);
+    }
+#endif
+}
+
+}
+
+/**
+ * @class TransformLevels
+ * @brief The nodes of ITransformable trees grouped by depth, with every global matrix in one contiguous array of affine.
+ *
+ * Update() walks the levels in order, so each node's parent was finished a level earlier, and splits each
+ * level across threads. Only nodes whose local or parent version has moved on since their global matrix was
+ * calculated are multiplied, and matrices a read brought up to date in between are just copied. Results are
+ * also written back to each node, so GetGlobalMatrix() agrees with the array afterwards without recalculating.
+ *
+ * The grouping is a snapshot: call Rebuild() after adding, removing or moving nodes.
+ */
+template<typename T, size_t dim>
+class TransformLevels {
+public:
+    using index_type = uint32_t;
+    ///@brief No node, the parent of a root
+    static constexpr index_type NONE = ~(index_type)0;
+
+protected:
+    std::vector<ITransformable<T,dim>*> nodes;
+    std::vector<index_type> parents;
+    std::vector<size_t> level_starts;
+    std::vector<affine<T,dim>> globals;
+    ///@brief The globalVersion of each node the matrix in globals is from, read by its children a level later
+    std::vector<uint64_t> versions;
+    ///@brief The parents outside these trees of any roots, each once
+    std::vector<const ITransformable<T,dim>*> outside_parents;
+
+    size_t UpdateRange(const size_t& begin, const size_t& end){
+        size_t count = 0;
+        for(size_t k = begin; k < end; k++){
+            if(k + SS_TRANSFORM_PREFETCH_DISTANCE < end){
+                detail::PrefetchBytes(nodes[k + SS_TRANSFORM_PREFETCH_DISTANCE], sizeof(ITransformable<T,dim>) + sizeof(affine<T,dim>));
+            }
+            ITransformable<T,dim>* node = nodes[k];
+            const index_type p = parents[k];
+            if(p == NONE){
+                //A root here may still have a parent outside these trees, already brought up to date, so this only reads it
+                const uint64_t before = node->globalVersion;
+                node->UpdateGlobalMatrix();
+                count += (node->globalVersion != before);
+            }
+            else if(node->seenLocalVersion != node->localVersion || node->seenParentVersion != versions[p]){
+                globals[k] = globals[p] * node->GetLocalAffine();
+                node->globalMatrix = globals[k];
+                node->seenLocalVersion = node->localVersion;
+                node->seenParentVersion = versions[p];
+                versions[k] = ++node->globalVersion;
+                count++;
+                continue;
+            }
+            if(versions[k] != node->globalVersion){
+                globals[k] = node->globalMatrix;
+                versions[k] = node->globalVersion;
+            }
+        }
+        return count;
+    }
+
+    template<typename For>
+    size_t UpdateLevels(For parallel_for){
+        std::atomic<size_t> count{0};
+        //Roots sharing a parent outside these trees would otherwise race to update it and its ancestors
+        for(const ITransformable<T,dim>* parent : outside_parents){parent->UpdateGlobalMatrix();}
+        for(size_t level = 0; level + 1 < level_starts.size(); level++){
+            const size_t first = level_starts[level];
+            parallel_for(level_starts[level + 1] - first, [&](const size_t& begin, const size_t& end){
+                count.fetch_add(UpdateRange(first + begin, first + end), std::memory_order_relaxed);
+            });
+        }
+        return count.load();
+    }
+
+public:
+    TransformLevels() {}
+    TransformLevels(ITransformable<T,dim>* root) {Rebuild(&root, 1);}
+
+    /**
+     * @fn Rebuild
+     * @brief Groups the trees under roots by depth, children after their parents within each level.
+     */
+    void Rebuild(ITransformable<T,dim>* const* roots, const size_t& count){
+        nodes.assign(roots, roots + count);
+        parents.assign(count, NONE);
+        outside_parents.clear();
+        for(size_t k = 0; k < count; k++){
+            if(roots[k]->GetParentTransform() != nullptr){outside_parents.push_back(roots[k]->GetParentTransform());}
+        }
+        std::sort(outside_parents.begin(), outside_parents.end(), std::less<const void*>());
+        outside_parents.erase(std::unique(outside_parents.begin(), outside_parents.end()), outside_parents.end());
+        level_starts.assign(1, 0);
+        std::vector<std::pair<ITransformable<T,dim>*, index_type>> level;
+        for(size_t begin = 0; begin < nodes.size();){
+            const size_t end = nodes.size();
+            level_starts.push_back(end);
+            level.clear();
+            for(size_t k = begin; k < end; k++){
+                for(auto iter = nodes[k]->begin(); iter != nodes[k]->end(); iter++){
+                    level.emplace_back(static_cast<ITransformable<T,dim>*>(*iter), (index_type)k);
+                }
+            }
+            //Any order within a level works, so visit the nodes in address order, usually the order they were allocated in
+            std::sort(level.begin(), level.end(), [](const auto& x, const auto& y){return std::less<const void*>()(x.first, y.first);});
+            for(const auto& node : level){
+                nodes.push_back(node.first);
+                parents.push_back(node.second);
+            }
+            begin = end;
+        }
+        globals.resize(nodes.size());
+        //Matches no version, so every matrix is filled in by the next Update
+        versions.assign(nodes.size(), ~(uint64_t)0);
+    }
+    ///@fn Rebuild
+    void Rebuild(ITransformable<T,dim>* root) {Rebuild(&root, 1);}
+
+    /**
+     * @fn Update
+     * @brief Recalculates every stale global matrix, each level split across up to threads threads (see ParallelFor).
+     * @return size_t The number of matrices recalculated
+     */
+    size_t Update(const size_t& threads = 1){
+        return UpdateLevels([&threads](const size_t& count, auto f){ParallelFor(count, threads, f);});
+    }
+    ///@fn Update As above on the threads of pool, which avoids starting threads for every level
+    size_t Update(ThreadPool& pool){
+        return UpdateLevels([&pool](const size_t& count, auto f){pool.ParallelFor(count, f);});
+    }
+
+    ///@fn Size @return size_t The number of nodes
+    size_t Size() const {return nodes.size();}
+    ///@fn Levels @return size_t The depth of the deepest tree, plus one
+    size_t Levels() const {return level_starts.size() - 1;}
+    ///@fn LevelStart @return size_t The index of the first node at depth level, Size() for level == Levels()
+    size_t LevelStart(const size_t& level) const {return level_starts[level];}
+
+    ///@fn Node @return ITransformable* The node at index
+    ITransformable<T,dim>* Node(const size_t& index) const {return nodes[index];}
+    ///@fn Parent @return index_type The index of the parent of index, NONE for a root
+    index_type Parent(const size_t& index) const {return parents[index];}
+
+    ///@fn Globals @return const affine* Every global matrix, level by level, as of the last Update
+    const affine<T,dim>* Globals() const {return globals.data();}
+    ///@fn Global @return const affine& The global matrix of the node at index as of the last Update
+    const affine<T,dim>& Global(const size_t& index) const {return globals[index];}
+};
+
+}
+
+#endif // SUBSTD_TRANSFORM_BATCH_HPP
@@ -1,7 +1,7 @@
 /**
  * @file
  * @author Kevin Hayes
- * @include array iterator algorithm functional type_traits iostream
+ * @include array iterator algorithm utility type_traits iostream string string_view format
 */
 
 #ifndef SUBSTD_VEC_HPP
@@ -10,15 +10,26 @@
 #include<array>
 #include<iterator>
 #include<algorithm>
-#include<functional>
+#include<utility>
 #include<type_traits>
 #include<iostream>
+#include<string>
+#include<string_view>
 
 #include "substd/constants.hpp"
+#include "substd/format.hpp"
+#include "substd/math.hpp"
+#include "substd/simd.hpp"
 
 namespace ss
 {
 
+template<typename T, size_t dim>
+class vec;
+
+template<typename T, size_t dim>
+void AppendTo(std::string& s, const vec<T, dim>& v, const Format& f = Format::Vec());
+
 /**
  * @class vec
  * 
@@ -28,52 +39,71 @@ namespace ss
 template<typename T, size_t dim=1> 
 class vec : public std::array<T, dim> {
     static_assert(!((std::is_fundamental_v<T>)^(std::is_arithmetic_v<T>)), "Fundamental types passed as the template parameter of ss::vec<> are required to be arithmetic");
-    static_assert(dim > 0, "ss::vec<> requires at least l dimension");
+    static_assert(dim > 0, "ss::vec<> requires at least 1 dimension");
 
 protected:
     using base = std::array<T, dim>;
     using V = vec<T, dim>;
-    
-    template<typename OT, size_t Odim>
-    V GenerateBinary(const vec<OT, Odim>& other, const std::function<T(const T&, const OT&)>& f) const {
-        V ret;
-        if constexpr(dim >= Odim){
-            std::transform(other.begin(), other.end(), base::begin(), ret.begin(), f);
-        }
-        else {
-            std::transform(base::begin(), base::end(), other.begin(), ret.begin(), f);
-        }
-        return ret;
+    using kernel = simd::kernel<T, dim>;
+
+    template<size_t Odim>
+    static constexpr size_t Overlap = (dim < Odim) ? dim : Odim;
+
+    template<typename OT, size_t Odim, typename F, size_t... I>
+    void ApplyBinary(const vec<OT, Odim>& other, F& f, std::index_sequence<I...>){
+        (f(base::operator[](I), other[I]), ...);
     }
-    V GenerateUnary(const std::function<T(const T&)>& f) const {
-        V ret;
-        std::transform(base::begin(), base::end(), ret.begin(), f);
-        return ret;
+    template<typename F, size_t... I>
+    void ApplyUnary(F& f, std::index_sequence<I...>){
+        (f(base::operator[](I)), ...);
     }
-    template<typename S>
-    vec<S,dim> GenerateLeftUnary(const std::function<S(const T&)>& f) const {
+    template<typename S, typename F, size_t... I>
+    vec<S,dim> MapUnary(F& f, std::index_sequence<I...>) const {
         vec<S,dim> ret;
-        std::transform(base::begin(), base::end(), ret.begin(), f);
+        ((ret[I] = f(base::operator[](I))), ...);
         return ret;
     }
+    template<typename OT, size_t Odim, size_t... I>
+    T DotOver(const vec<OT, Odim>& other, std::index_sequence<I...>) const {
+        return (T(0) + ... + (T)(base::operator[](I) * other[I]));
+    }
 
-    template<typename OT, size_t Odim>
-    void ReflexiveBinary(const vec<OT, Odim>& other, const std::function<void(T&, const OT&)>& f){
-        if constexpr(dim >= Odim){
-            for(int i = 0; i < Odim; i++){
-                f(base::at(i), other.at(i));
-            }
-        }
-        else {
-            for(int i = 0; i < dim; i++){
-                f(base::at(i), other.at(i));
-            }
-        }
+    /**
+     * @brief Applies f(this[i], other[i]) over the overlapping elements, any extra elements keep the value of this.
+     * @tparam F Callable taking (const T&, const OT&) and returning T
+    */
+    template<typename OT, size_t Odim, typename F>
+    V GenerateBinary(const vec<OT, Odim>& other, F f) const {
+        V ret(*this);
+        ret.ReflexiveBinary(other, [&f](T& a, const OT& b)->void{a = f(a, b);});
+        return ret;
+    }
+    template<typename F>
+    V GenerateUnary(F f) const {
+        return MapUnary<T>(f, std::make_index_sequence<dim>{});
+    }
+    template<typename S, typename F>
+    vec<S,dim> GenerateLeftUnary(F f) const {
+        return MapUnary<S>(f, std::make_index_sequence<dim>{});
+    }
+
+    /**
+     * @brief Calls f(this[i], other[i]) over the overlapping elements.
+     * @tparam F Callable taking (T&, const OT&)
+    */
+    template<typename OT, size_t Odim, typename F>
+    void ReflexiveBinary(const vec<OT, Odim>& other, F f){
+        ApplyBinary(other, f, std::make_index_sequence<Overlap<Odim>>{});
     }
-    void ReflexiveUnary(const std::function<void(T&)>& f){
-        std::transform(base::begin(), base::end(), base::begin(), f);
+    template<typename F>
+    void ReflexiveUnary(F f){
+        ApplyUnary(f, std::make_index_sequence<dim>{});
     }
 
+    ///@brief True if a kernel specialization exists and other has the exact same type as this.
+    template<typename OT, size_t Odim>
+    static constexpr bool UseKernel = kernel::enabled && std::is_same_v<OT, T> && (Odim == dim);
+
 public:
     /**
      * @brief Default Constructor
@@ -128,99 +158,139 @@ public:
     ///@fn Sum
     template<typename OT, size_t Odim>
     V Sum(const vec<OT, Odim>& other) const {
-        return GenerateBinary<OT, Odim>(other, [](const T& a, const OT& b)->T{return (T)(a+b);});
+        if constexpr(UseKernel<OT, Odim>) {
+            V ret;
+            kernel::Add(base::data(), other.data(), ret.data());
+            return ret;
+        }
+        else {
+            return GenerateBinary(other, [](const T& a, const OT& b)->T{return (T)(a+b);});
+        }
     }
     ///@fn Dif
     template<typename OT, size_t Odim>
     V Dif(const vec<OT, Odim>& other) const {
-        return GenerateBinary(other, [](const T& a, const OT& b)->T{return (T)(a-b);});
+        if constexpr(UseKernel<OT, Odim>) {
+            V ret;
+            kernel::Sub(base::data(), other.data(), ret.data());
+            return ret;
+        }
+        else {
+            return GenerateBinary(other, [](const T& a, const OT& b)->T{return (T)(a-b);});
+        }
     }
     ///@fn Prod
     template<typename S>
     V Prod(const S& s) const {
-        return GenerateUnary([s](const T& a)->T{return (T)(a*s);});
+        if constexpr(kernel::enabled && std::is_same_v<S, T>) {
+            V ret;
+            kernel::Scale(base::data(), s, ret.data());
+            return ret;
+        }
+        else {
+            return GenerateUnary([&s](const T& a)->T{return (T)(a*s);});
+        }
     }
     ///@fn Quot
     template<typename S>
     V Quot(const S& s) const {
-        return GenerateUnary([s](const T& a)->T{return (T)(a/s);});
+        if constexpr(kernel::has_div && std::is_same_v<S, T>) {
+            V ret;
+            kernel::ScaleDiv(base::data(), s, ret.data());
+            return ret;
+        }
+        else {
+            return GenerateUnary([&s](const T& a)->T{return (T)(a/s);});
+        }
     }
     ///@fn LeftProd
     template<typename S>
     vec<S, dim> LeftProd(const S& s) const {
-        return GenerateLeftUnary<S>([s](const T& a)->S{return (S)(s*a);});
+        return GenerateLeftUnary<S>([&s](const T& a)->S{return (S)(s*a);});
     }
     ///@fn LeftQuot
     template<typename S>
     vec<S, dim> LeftQuot(const S& s) const {
-        return GenerateLeftUnary<S>([s](const T& a)->S{return (S)(s/a);});
+        return GenerateLeftUnary<S>([&s](const T& a)->S{return (S)(s/a);});
     }
     
     ///@fn Add
     template<typename OT, size_t Odim>
     void Add(const vec<OT, Odim>& other) {
-        ReflexiveBinary<OT, Odim>(other, [](T& a, const OT& b)->void{a += b;});
+        if constexpr(UseKernel<OT, Odim>) {
+            kernel::Add(base::data(), other.data(), base::data());
+        }
+        else {
+            ReflexiveBinary(other, [](T& a, const OT& b)->void{a += b;});
+        }
     }
     ///@fn Sub
     template<typename OT, size_t Odim>
     void Sub(const vec<OT, Odim>& other) {
-        ReflexiveBinary(other, [](T& a, const OT& b)->void{a -= b;});
+        if constexpr(UseKernel<OT, Odim>) {
+            kernel::Sub(base::data(), other.data(), base::data());
+        }
+        else {
+            ReflexiveBinary(other, [](T& a, const OT& b)->void{a -= b;});
+        }
     }
     ///@fn Mul
     template<typename S>
     void Mul(const S& s){
-        ReflexiveUnary([s](T& a)->void{a *= s;});
+        if constexpr(kernel::enabled && std::is_same_v<S, T>) {
+            kernel::Scale(base::data(), s, base::data());
+        }
+        else {
+            ReflexiveUnary([&s](T& a)->void{a *= s;});
+        }
     }
     ///@fn Div
     template<typename S>
     void Div(const S& s){
-        ReflexiveUnary([s](T& a)->void{a /= s;});
+        if constexpr(kernel::has_div && std::is_same_v<S, T>) {
+            kernel::ScaleDiv(base::data(), s, base::data());
+        }
+        else {
+            ReflexiveUnary([&s](T& a)->void{a /= s;});
+        }
     }
     ///@fn LeftMul
     template<typename S>
     void LeftMul(const S& s){
-        ReflexiveUnary([s](T& a)->void{a = s*a;});
+        ReflexiveUnary([&s](T& a)->void{a = s*a;});
     }
     ///@fn LeftDiv
     template<typename S>
     void LeftDiv(const S& s){
-        ReflexiveUnary([s](T& a)->void{a = s/a;});
+        ReflexiveUnary([&s](T& a)->void{a = s/a;});
     }
 
     ///@fn Dot
     template<typename OT, size_t Odim>
     T Dot(const vec<OT, Odim>& other) const {
-        T sum = 0;
-        if constexpr (dim >= Odim){
-            for(int i = 0; i < Odim; i++){
-                sum += (base::at(i) * other.at(i));
-            }
+        if constexpr(UseKernel<OT, Odim>) {
+            return kernel::Dot(base::data(), other.data());
         }
-        else{
-            for(int i = 0; i < dim; i++){
-                sum += (base::at(i) * other.at(i));
-            }
+        else {
+            return DotOver(other, std::make_index_sequence<Overlap<Odim>>{});
         }
-        return sum;
     }
     
     ///@fn MagnitudeSqr
     auto MagnitudeSqr() const {
-        auto sum = T(0) * T(0);
-        std::for_each(base::begin(), base::end(), [sum](const T& t)->void{sum += (t*t);});
-        return sum;
+        return Dot(*this);
     }
 
     ///@fn Magnitude
-    template<typename OT = ss_trig>
+    template<typename OT = trig_t>
     auto Magnitude() const {
-        return Sqrt<OT>(MagnitudeSqr());
+        return Sqrt<OT>((OT)MagnitudeSqr());
     }
 
     ///@fn Normalized
-    template<typename OT = ss_trig>
+    template<typename OT = trig_t>
     vec<OT, dim> Normalized() const {
-        return LeftProd<OT>(1/Magnitude());
+        return LeftProd<OT>(RSqrt<OT>((OT)MagnitudeSqr()));
     }
 
     ///@fn Homogenized
@@ -245,7 +315,7 @@ public:
     //template<typename S>
     //friend S operator*(const S& scalar,const V& v){return v.LeftProd(scalar);}
     template<typename S>
-    void operator*=(const S& scalar) {Mult(scalar);}
+    void operator*=(const S& scalar) {Mul(scalar);}
     
     template<typename S>
     V operator/(const S& scalar) const {return Quot(scalar);}
@@ -254,14 +324,12 @@ public:
     template<typename S>
     void operator/=(const S& scalar) {Div(scalar);}
 
+    ///@remark Formats with AppendTo in Format::Vec(), so floating point values are written in their shortest exact form
     friend std::ostream& operator<<(std::ostream& o, const V& v)
     {
-        o<<"("<<v.front();
-        for(auto iter = v.begin()+1; iter!=v.end(); iter++){
-            o<<", "<<(*iter);
-        }
-        o<<")";
-        return o;
+        detail::FormatBuffer buffer;
+        AppendTo(buffer.Get(), v);
+        return o.write(buffer.Get().data(), (std::streamsize)buffer.Get().size());
     }
 
 //static
@@ -296,5 +364,52 @@ using vec2i = vec2<int>;
 using vec3i = vec3<int>;
 using vec4i = vec4<int>;
 
+//Text
+
+/**
+ * @fn AppendTo
+ * @brief Appends v to s in the Format f, each component with std::to_chars, so a reused s costs no allocations.
+ */
+template<typename T, size_t dim>
+void AppendTo(std::string& s, const vec<T, dim>& v, const Format& f){
+    using S = std::remove_cv_t<std::remove_reference_t<T>>;
+    s.append(f.open);
+    detail::AppendScalar<S>(s, v[0]);
+    for(size_t i = 1; i < dim; i++){
+        s.append(f.separator);
+        detail::AppendScalar<S>(s, v[i]);
+    }
+    s.append(f.close);
+}
+///@fn ToString @return std::string v in the Format f
+template<typename T, size_t dim>
+std::string ToString(const vec<T, dim>& v, const Format& f = Format::Vec()){
+    std::string s;
+    AppendTo(s, v, f);
+    return s;
+}
+
+/**
+ * @fn Parse
+ * @brief Reads a vec written in the Format f from [first, last) with std::from_chars.
+ * @return const char* Past the vec, or nullptr if [first, last) does not start with one, leaving v partly written
+ */
+template<typename T, size_t dim>
+const char* Parse(const char* first, const char* last, vec<T, dim>& v, const Format& f = Format::Vec()){
+    first = detail::MatchToken(first, last, f.open);
+    for(size_t i = 0; i < dim && first != nullptr; i++){
+        if(i > 0){first = detail::MatchToken(first, last, f.separator);}
+        if(first != nullptr){first = detail::ParseScalar<T>(first, last, v[i]);}
+    }
+    return (first == nullptr) ? nullptr : detail::MatchToken(first, last, f.close);
+}
+///@fn FromString @return bool Whether text is exactly one vec in the Format f, give or take whitespace
+template<typename T, size_t dim>
+bool FromString(const std::string_view& text, vec<T, dim>& v, const Format& f = Format::Vec()){
+    const char* last = text.data() + text.size();
+    const char* end = Parse(text.data(), last, v, f);
+    return end != nullptr && detail::SkipSpace(end, last) == last;
+}
+
 }
 #endif // SUBSTD_VEC_HPP
\ No newline at end of file
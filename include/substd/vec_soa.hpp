@@ -0,0 +1,335 @@
+/**
+ * @file
+ * @author Kevin Hayes
+ * @brief Structure of arrays storage for large batches of ss::vec
+ * @include array vector algorithm vec simd
+*/
+
+#ifndef SUBSTD_VEC_SOA_HPP
+#define SUBSTD_VEC_SOA_HPP
+
+#include<array>
+#include<vector>
+#include<algorithm>
+
+#include "substd/vec.hpp"
+#include "substd/simd.hpp"
+
+namespace ss
+{
+
+/**
+ * @class vec_soa
+ * @brief A sequence of vec<T,dim> stored as dim separate, aligned, contiguous lanes (one per component).
+ *
+ * Bulk operations walk the lanes a full SIMD register (ss::simd::pack<T>) at a time.
+ * Binary bulk operations between two vec_soa's only cover the shorter of the two.
+ *
+ * @tparam T Type of the vector components
+ * @tparam dim The size of each vector. Must be greater than zero.
+*/
+template<typename T, size_t dim>
+class vec_soa {
+    static_assert(dim > 0, "ss::vec_soa<> requires at least 1 dimension");
+    template<typename OT, size_t Odim> friend class vec_soa;
+
+public:
+    using lane_type = std::vector<T, simd::aligned_allocator<T>>;
+    using value_type = vec<T, dim>;
+
+    /**
+     * @class basic_reference
+     * @brief Proxy for the vector at one index, convertible to and assignable from vec<T,dim>.
+    */
+    template<typename S>
+    class basic_reference {
+    protected:
+        S* owner;
+        size_t index;
+    public:
+        basic_reference(S* owner, const size_t& index) : owner(owner), index(index) {}
+
+        decltype(auto) operator[](const size_t& component) const {return owner->lanes[component][index];}
+        value_type Get() const {return owner->Get(index);}
+        operator value_type() const {return Get();}
+
+        template<typename OT, size_t Odim>
+        const basic_reference& operator=(const vec<OT, Odim>& v) const {
+            static_assert(!std::is_const_v<S>, "Cannot assign through a const vec_soa reference");
+            owner->Set(index, v);
+            return *this;
+        }
+        const basic_reference& operator=(const basic_reference& other) const {
+            return operator=(other.Get());
+        }
+    };
+    using reference = basic_reference<vec_soa>;
+    using const_reference = basic_reference<const vec_soa>;
+
+protected:
+    using soa = vec_soa<T, dim>;
+    using V = vec<T, dim>;
+    template<typename F>
+    static void ForEachPack(const size_t& n, F f){simd::ForEachPack<T>(n, f);}
+
+    std::array<lane_type, dim> lanes;
+
+public:
+    ///@brief Default Constructor
+    vec_soa(){}
+    ///@brief Fill Constructor
+    vec_soa(const size_t& n, const V& fill = V(0)){
+        for(size_t c = 0; c < dim; c++){
+            lanes[c].assign(n, fill[c]);
+        }
+    }
+    ///@brief Array Of Structs Constructor, Transposes v Into Lanes
+    vec_soa(const std::vector<V>& v){
+        Assign(v.data(), v.size());
+    }
+
+    ///@fn Assign Replaces the contents with the n vectors starting at v
+    void Assign(const V* v, const size_t& n){
+        for(size_t c = 0; c < dim; c++){
+            lanes[c].resize(n);
+            T* lane = lanes[c].data();
+            for(size_t i = 0; i < n; i++){
+                lane[i] = v[i][c];
+            }
+        }
+    }
+    ///@fn CopyTo Writes every vector into out, which must have room for size() elements
+    void CopyTo(V* out) const {
+        for(size_t c = 0; c < dim; c++){
+            const T* lane = lanes[c].data();
+            for(size_t i = 0; i < size(); i++){
+                out[i][c] = lane[i];
+            }
+        }
+    }
+    ///@fn ToVector
+    std::vector<V> ToVector() const {
+        std::vector<V> ret(size());
+        CopyTo(ret.data());
+        return ret;
+    }
+
+    //Container
+
+    size_t size() const {return lanes[0].size();}
+    bool empty() const {return lanes[0].empty();}
+    void resize(const size_t& n, const V& fill = V(0)){
+        for(size_t c = 0; c < dim; c++){lanes[c].resize(n, fill[c]);}
+    }
+    void reserve(const size_t& n){
+        for(size_t c = 0; c < dim; c++){lanes[c].reserve(n);}
+    }
+    void clear(){
+        for(size_t c = 0; c < dim; c++){lanes[c].clear();}
+    }
+    void push_back(const V& v){
+        for(size_t c = 0; c < dim; c++){lanes[c].push_back(v[c]);}
+    }
+    void pop_back(){
+        for(size_t c = 0; c < dim; c++){lanes[c].pop_back();}
+    }
+
+    reference operator[](const size_t& index) {return reference(this, index);}
+    const_reference operator[](const size_t& index) const {return const_reference(this, index);}
+    reference at(const size_t& index) {lanes[0].at(index); return reference(this, index);}
+    const_reference at(const size_t& index) const {lanes[0].at(index); return const_reference(this, index);}
+
+    ///@fn Get
+    V Get(const size_t& index) const {
+        V ret;
+        for(size_t c = 0; c < dim; c++){ret[c] = lanes[c][index];}
+        return ret;
+    }
+    ///@fn Set
+    template<typename OT, size_t Odim>
+    void Set(const size_t& index, const vec<OT, Odim>& v){
+        for(size_t c = 0; c < dim && c < Odim; c++){lanes[c][index] = (T)v[c];}
+    }
+
+    ///@fn Lane @return The contiguous array of component c for every vector
+    T* Lane(const size_t& c){return lanes[c].data();}
+    const T* Lane(const size_t& c) const {return lanes[c].data();}
+
+    //Bulk Operations
+
+    ///@fn Add Adds each vector of other to the vector at the same index
+    void Add(const soa& other){
+        const size_t n = Min(size(), other.size());
+        for(size_t c = 0; c < dim; c++){
+            T* a = lanes[c].data();
+            const T* b = other.lanes[c].data();
+            ForEachPack(n, [a, b](auto p, const size_t& i){
+                using P = decltype(p);
+                P::Store(a+i, P::Add(P::Load(a+i), P::Load(b+i)));
+            });
+        }
+    }
+    ///@fn Sub
+    void Sub(const soa& other){
+        const size_t n = Min(size(), other.size());
+        for(size_t c = 0; c < dim; c++){
+            T* a = lanes[c].data();
+            const T* b = other.lanes[c].data();
+            ForEachPack(n, [a, b](auto p, const size_t& i){
+                using P = decltype(p);
+                P::Store(a+i, P::Sub(P::Load(a+i), P::Load(b+i)));
+            });
+        }
+    }
+    ///@fn Add Adds v to every vector
+    void Add(const V& v){
+        for(size_t c = 0; c < dim; c++){
+            T* a = lanes[c].data();
+            const T t = v[c];
+            ForEachPack(size(), [a, t](auto p, const size_t& i){
+                using P = decltype(p);
+                P::Store(a+i, P::Add(P::Load(a+i), P::Set1(t)));
+            });
+        }
+    }
+    ///@fn Sub Subtracts v from every vector
+    void Sub(const V& v){
+        Add(v * (T)-1);
+    }
+    ///@fn Mul Scales every vector by s
+    void Mul(const T& s){
+        for(size_t c = 0; c < dim; c++){
+            T* a = lanes[c].data();
+            ForEachPack(size(), [a, s](auto p, const size_t& i){
+                using P = decltype(p);
+                P::Store(a+i, P::Mul(P::Load(a+i), P::Set1(s)));
+            });
+        }
+    }
+    ///@fn Div
+    void Div(const T& s){
+        for(size_t c = 0; c < dim; c++){
+            T* a = lanes[c].data();
+            ForEachPack(size(), [a, s](auto p, const size_t& i){
+                using P = decltype(p);
+                P::Store(a+i, P::Div(P::Load(a+i), P::Set1(s)));
+            });
+        }
+    }
+
+    ///@fn Sum
+    soa Sum(const soa& other) const {soa ret(*this); ret.Add(other); return ret;}
+    ///@fn Dif
+    soa Dif(const soa& other) const {soa ret(*this); ret.Sub(other); return ret;}
+    ///@fn Prod
+    soa Prod(const T& s) const {soa ret(*this); ret.Mul(s); return ret;}
+    ///@fn Quot
+    soa Quot(const T& s) const {soa ret(*this); ret.Div(s); return ret;}
+
+    /**
+     * @fn Dot
+     * @param out Receives the dot product of every pair of vectors, must have room for Min(size(), other.size()) elements
+    */
+    void Dot(const soa& other, T* out) const {
+        const size_t n = Min(size(), other.size());
+        std::array<const T*, dim> a, b;
+        for(size_t c = 0; c < dim; c++){
+            a[c] = lanes[c].data();
+            b[c] = other.lanes[c].data();
+        }
+        ForEachPack(n, [&a, &b, out](auto p, const size_t& i){
+            using P = decltype(p);
+            auto acc = P::Mul(P::Load(a[0]+i), P::Load(b[0]+i));
+            for(size_t c = 1; c < dim; c++){
+                acc = P::Fma(P::Load(a[c]+i), P::Load(b[c]+i), acc);
+            }
+            P::Store(out+i, acc);
+        });
+    }
+    std::vector<T> Dot(const soa& other) const {
+        std::vector<T> ret(Min(size(), other.size()));
+        Dot(other, ret.data());
+        return ret;
+    }
+
+    ///@fn MagnitudeSqr @param out Must have room for size() elements
+    void MagnitudeSqr(T* out) const {Dot(*this, out);}
+    std::vector<T> MagnitudeSqr() const {return Dot(*this);}
+
+    ///@fn Magnitude @param out Must have room for size() elements
+    void Magnitude(T* out) const {
+        MagnitudeSqr(out);
+        ForEachPack(size(), [out](auto p, const size_t& i){
+            using P = decltype(p);
+            P::Store(out+i, fastmath::Sqrt<SS_MATH_ACCURACY, P>(P::Load(out+i)));
+        });
+    }
+    std::vector<T> Magnitude() const {
+        std::vector<T> ret(size());
+        Magnitude(ret.data());
+        return ret;
+    }
+
+    ///@fn Normalize Scales every vector to unit length in place
+    void Normalize(){
+        std::array<T*, dim> a;
+        for(size_t c = 0; c < dim; c++){a[c] = lanes[c].data();}
+        ForEachPack(size(), [&a](auto p, const size_t& i){
+            using P = decltype(p);
+            auto sqr = P::Mul(P::Load(a[0]+i), P::Load(a[0]+i));
+            for(size_t c = 1; c < dim; c++){
+                sqr = P::Fma(P::Load(a[c]+i), P::Load(a[c]+i), sqr);
+            }
+            auto inv = fastmath::RSqrt<SS_MATH_ACCURACY, P>(sqr);
+            for(size_t c = 0; c < dim; c++){
+                P::Store(a[c]+i, P::Mul(P::Load(a[c]+i), inv));
+            }
+        });
+    }
+    ///@fn Normalized
+    soa Normalized() const {soa ret(*this); ret.Normalize(); return ret;}
+
+    ///@fn Homogenized
+    vec_soa<T,dim+1> Homogenized(const T& fill = 1) const {
+        vec_soa<T,dim+1> ret;
+        for(size_t c = 0; c < dim; c++){ret.lanes[c] = lanes[c];}
+        ret.lanes[dim].assign(size(), fill);
+        return ret;
+    }
+
+    //Operators
+
+    soa operator+(const soa& other) const {return Sum(other);}
+    void operator+=(const soa& other) {Add(other);}
+    void operator+=(const V& v) {Add(v);}
+    soa operator-(const soa& other) const {return Dif(other);}
+    void operator-=(const soa& other) {Sub(other);}
+    void operator-=(const V& v) {Sub(v);}
+    soa operator*(const T& s) const {return Prod(s);}
+    void operator*=(const T& s) {Mul(s);}
+    soa operator/(const T& s) const {return Quot(s);}
+    void operator/=(const T& s) {Div(s);}
+
+//static
+    ///@fn Dimension
+    static constexpr size_t Dimension() { return dim; }
+};
+
+template<typename T>
+using vec2_soa = vec_soa<T,2>;
+template<typename T>
+using vec3_soa = vec_soa<T,3>;
+template<typename T>
+using vec4_soa = vec_soa<T,4>;
+
+using vec2f_soa = vec2_soa<float>;
+using vec3f_soa = vec3_soa<float>;
+using vec4f_soa = vec4_soa<float>;
+
+using vec2d_soa = vec2_soa<double>;
+using vec3d_soa = vec3_soa<double>;
+using vec4d_soa = vec4_soa<double>;
+
+}
+
+#endif // SUBSTD_VEC_SOA_HPP
@@ -0,0 +1,71 @@
+#include "substd/affine.hpp"
+
+template<typename T, size_t dim>
+ss::affine<T,dim> Sample(const size_t& seed){
+    ss::affine<T,dim> a;
+    for(size_t col = 0; col <= dim; col++){
+        for(size_t row = 0; row < dim; row++){a[col][row] = (T)((row*7 + col*3 + seed*5) % 11) - (T)5 + ((row == col) ? (T)9 : (T)0);}
+    }
+    return a;
+}
+
+template<typename T, size_t dim>
+bool Near(const ss::mat<T,dim+1>& a, const ss::mat<T,dim+1>& b, const T& tolerance){
+    for(size_t col = 0; col <= dim; col++){
+        for(size_t row = 0; row <= dim; row++){
+            if(ss::Abs<T>(a[col][row] - b[col][row]) > tolerance){return false;}
+        }
+    }
+    return true;
+}
+
+//Composition, transforms and inverses agree with the homogeneous matrices they stand for
+template<typename T, size_t dim>
+int Check(const T& tolerance){
+    const ss::affine<T,dim> a = Sample<T,dim>(1), b = Sample<T,dim>(2);
+    const ss::mat<T,dim+1> ma = a.ToMatrix(), mb = b.ToMatrix();
+    if(ss::affine<T,dim>(ma) != a || ma[dim][dim] != (T)1 || ma[0][dim] != (T)0){return 1;}
+    //Small integers, so every product is exact whichever way it is summed
+    if((a * b).ToMatrix() != ma * mb){return 2;}
+
+    ss::vec<T,dim> p;
+    for(size_t i = 0; i < dim; i++){p[i] = (T)i - (T)1;}
+    const ss::vec<T,dim+1> hp = ma * p.Homogenized();
+    ss::vec<T,dim+1> hd = ss::vec<T,dim+1>(0);
+    for(size_t i = 0; i < dim; i++){hd[i] = p[i];}
+    hd = ma * hd;
+    for(size_t i = 0; i < dim; i++){
+        if((a * p)[i] != hp[i] || a.TransformDirection(p)[i] != hd[i]){return 3;}
+    }
+
+    if(!Near<T,dim>((a * a.Inverse()).ToMatrix(), ss::mat<T,dim+1>(1), tolerance)){return 4;}
+    if(!Near<T,dim>(a.Inverse().ToMatrix(), ma.Inverse(), tolerance)){return 5;}
+
+    //A rotation then a scale, which OrthogonalInverse handles
+    ss::mat<T,dim> rs = ss::CreateRotationMatrix<T,dim>(ss::vec<T,(dim*(dim-1))/2>((T)0.3));
+    for(size_t col = 0; col < dim; col++){
+        for(size_t row = 0; row < dim; row++){rs[col][row] *= (T)(row + 2);}
+    }
+    const ss::affine<T,dim> o(rs, p);
+    if(!Near<T,dim>(o.OrthogonalInverse().ToMatrix(), o.ToMatrix().AffineInverse(), tolerance)){return 6;}
+    if(!Near<T,dim>(o.OrthogonalInverse().ToMatrix(), o.Inverse().ToMatrix(), tolerance)){return 7;}
+
+    ss::affine<T,dim> identity((T)1);
+    if(identity * a != a || a * identity != a || identity.ToMatrix() != ss::mat<T,dim+1>(1)){return 8;}
+    identity *= a;
+    if(identity != a){return 9;}
+    return 0;
+}
+
+int main(int argc, const char** argv){
+    int code = Check<float,3>(1e-4f);
+    if(code != 0){return code;}
+    code = Check<double,3>(1e-12);
+    if(code != 0){return 10 + code;}
+    code = Check<float,2>(1e-4f);
+    if(code != 0){return 20 + code;}
+    code = Check<double,4>(1e-12);
+    if(code != 0){return 30 + code;}
+    if(sizeof(ss::affine3f) != 12 * sizeof(float)){return 40;}
+    return 0;
+}
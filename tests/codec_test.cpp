@@ -0,0 +1,102 @@
+#include<algorithm>
+#include<sstream>
+#include<vector>
+
+#include "substd/codec.hpp"
+#include "substd/io.hpp"
+
+//Mostly single byte values, some two byte and a few wide ones, like the deltas and ids we store
+std::vector<uint32_t> MixedValues(const size_t& count){
+    std::vector<uint32_t> values(count);
+    uint32_t state = 12345;
+    for(size_t i = 0; i < count; i++){
+        state = (state * 1103515245u) + 12345u;
+        const uint32_t r = state >> 8;
+        switch(r % 16){
+            case 0: values[i] = r; break;
+            case 1: values[i] = 0xFFFFFFFFu - (r & 0xFF); break;
+            case 2: case 3: values[i] = r & 0x3FFF; break;
+            default: values[i] = r & 0x7F; break;
+        }
+    }
+    return values;
+}
+
+int main(int argc, const char** argv){
+    //ZigZag agrees with MapIntToPositive and round trips the extremes
+    for(int32_t i = -1000; i <= 1000; i++){
+        if(ss::ZigZagEncode<int32_t>(i) != (uint32_t)ss::MapIntToPositive<int64_t>(i)){return 1;}
+        if(ss::ZigZagDecode<uint32_t>(ss::ZigZagEncode<int32_t>(i)) != i){return 1;}
+    }
+    if(ss::ZigZagEncode<int64_t>(INT64_MIN) != UINT64_MAX || ss::ZigZagDecode<uint64_t>(UINT64_MAX) != INT64_MIN){return 2;}
+
+    //Single values, every length
+    const uint64_t edges[] = {0, 1, 127, 128, 16383, 16384, 0xFFFFFFFFull, 0x100000000ull, UINT64_MAX};
+    for(uint64_t v : edges){
+        uint8_t bytes[ss::MAX_VARINT_SIZE<uint64_t>];
+        const size_t n = ss::EncodeVarint<uint64_t>(v, bytes);
+        uint64_t back = 0;
+        if(n != ss::VarintSize(v) || ss::DecodeVarint<uint64_t>(bytes, bytes + n, back) != n || back != v){return 3;}
+        //Truncated
+        if(ss::DecodeVarint<uint64_t>(bytes, bytes + n - 1, back) != 0){return 4;}
+    }
+    //Too wide for the type
+    const uint8_t wide[] = {0xFF, 0xFF, 0xFF, 0xFF, 0x1F};
+    uint32_t narrow;
+    if(ss::DecodeVarint<uint32_t>(wide, wide + 5, narrow) != 0){return 5;}
+
+    //Bulk decode, odd length so the tail is decoded one at a time
+    const std::vector<uint32_t> values = MixedValues(10007);
+    std::vector<uint8_t> encoded(values.size() * ss::MAX_VARINT_SIZE<uint32_t>);
+    encoded.resize(ss::EncodeVarintArray<uint32_t>(values.data(), values.size(), encoded.data()));
+    std::vector<uint32_t> decoded(values.size());
+    size_t consumed = 0;
+    if(ss::DecodeVarintArray(encoded.data(), encoded.size(), decoded.data(), decoded.size(), consumed) != values.size()){return 6;}
+    if(consumed != encoded.size() || decoded != values){return 7;}
+    //A truncated stream stops at the last whole varint
+    if(ss::DecodeVarintArray(encoded.data(), encoded.size() - 1, decoded.data(), decoded.size(), consumed) != values.size() - 1){return 8;}
+
+    //Through ByteWriter and ByteReader, the stream buffer small enough to split varints across refills
+    std::stringstream stream;
+    {
+        ss::ByteWriter w(stream, 64);
+        w.WriteVarS32(-5);
+        w.WriteVarU64(UINT64_MAX);
+        w.WriteVarU32Array(values.data(), values.size());
+        w.WriteVarS64(INT64_MIN);
+    }
+    ss::ByteReader r(stream, 64);
+    if(r.ReadVarS32() != -5 || r.ReadVarU64() != UINT64_MAX){return 9;}
+    std::fill(decoded.begin(), decoded.end(), 0);
+    if(r.ReadVarU32Array(decoded.data(), decoded.size()) != values.size() || decoded != values){return 10;}
+    if(r.ReadVarS64() != INT64_MIN || !r.AtEnd() || !r.Good()){return 11;}
+    if(r.ReadVarU32() != 0 || !r.Failed()){return 12;}
+
+    //Bit fields of every width
+    std::vector<uint8_t> packed;
+    {
+        ss::BitWriter bits(packed);
+        for(unsigned width = 1; width <= 64; width++){
+            bits.Write(0xA5A5A5A5A5A5A5A5ull, width);
+            bits.WriteBit(width & 1);
+        }
+    }
+    if(packed.size() != ((64 * 65 / 2) + 64 + 7) / 8){return 13;}
+    ss::BitReader bits(packed.data(), packed.size());
+    for(unsigned width = 1; width <= 64; width++){
+        const uint64_t expect = (width == 64) ? 0xA5A5A5A5A5A5A5A5ull : (0xA5A5A5A5A5A5A5A5ull & ((1ull << width) - 1));
+        if(bits.Read(width) != expect || bits.ReadBit() != (bool)(width & 1)){return 14;}
+    }
+    bits.AlignToByte();
+    if(bits.BitsRemaining() != 0 || !bits.Good() || bits.Read(1) != 0 || !bits.Failed()){return 15;}
+
+    //Only 1 and 2 byte varints, which blocks decode without stepping
+    std::vector<uint32_t> short_values = MixedValues(4099);
+    for(uint32_t& v : short_values){v &= 0x3FFF;}
+    encoded.resize(short_values.size() * 2);
+    encoded.resize(ss::EncodeVarintArray<uint32_t>(short_values.data(), short_values.size(), encoded.data()));
+    decoded.assign(short_values.size(), 0);
+    if(ss::DecodeVarintArray(encoded.data(), encoded.size(), decoded.data(), decoded.size(), consumed) != short_values.size()){return 16;}
+    if(consumed != encoded.size() || decoded != short_values){return 16;}
+    return 0;
+}
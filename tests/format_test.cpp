@@ -0,0 +1,75 @@
+#include<cstring>
+#include<sstream>
+#include<string>
+
+#include "substd/mat.hpp"
+
+//A component without to_chars, written by an operator<< that itself writes a vec
+struct Tagged {
+    int id;
+};
+std::ostream& operator<<(std::ostream& o, const Tagged& t){
+    return o<<"#"<<ss::vec2i{t.id, -t.id};
+}
+
+int main(int argc, const char** argv){
+    //Shortest exact forms, in the layout operator<< always used
+    const ss::vec3f v{0.1f, -2.0f, 1.0f / 3.0f};
+    if(ss::ToString(v) != "(0.1, -2, 0.33333334)"){return 1;}
+    std::ostringstream vo;
+    vo<<v<<ss::vec2i{-7, 12};
+    if(vo.str() != "(0.1, -2, 0.33333334)(-7, 12)"){return 2;}
+
+    ss::mat<double, 2, 3> m(0);
+    m[0][0] = 1; m[1][0] = 0.5; m[2][0] = -3;
+    m[0][1] = 1e-300; m[1][1] = 2; m[2][1] = 4;
+    std::ostringstream mo;
+    mo<<m;
+    if(mo.str() != "[1, 0.5, -3]\n[1e-300, 2, 4]\n" || ss::ToString(m) != mo.str()){return 3;}
+    if(ss::ToString(m, ss::Format::CSV()) != "1,0.5,-3\n1e-300,2,4\n"){return 4;}
+
+    //AppendTo reuses the caller's string
+    std::string rows;
+    for(int i = 0; i < 3; i++){ss::AppendTo(rows, ss::vec2i{i, -i}, ss::Format::CSV());}
+    if(rows != "0,01,-12,-2"){return 5;}
+
+    //Every value reads back bit for bit
+    uint32_t state = 1;
+    for(int i = 0; i < 10000; i++){
+        state = (state * 1103515245u) + 12345u;
+        uint32_t bits = state;
+        float f;
+        std::memcpy(&f, &bits, sizeof(float));
+        if(f != f){continue;}
+        const ss::vec2f a{f, -f};
+        ss::vec2f b;
+        if(!ss::FromString(ss::ToString(a), b) || std::memcmp(&a, &b, sizeof(a)) != 0){return 6;}
+    }
+    ss::mat<double, 2, 3> m_back;
+    if(!ss::FromString(mo.str(), m_back) || m_back != m){return 7;}
+    if(!ss::FromString(ss::ToString(m, ss::Format::CSV()), m_back, ss::Format::CSV()) || m_back != m){return 8;}
+
+    //Spacing does not matter, anything else does
+    ss::vec3i i3;
+    if(!ss::FromString("  ( 1,2 ,\t+3 )\n", i3) || i3 != ss::vec3i{1, 2, 3}){return 9;}
+    if(ss::FromString("(1, 2)", i3) || ss::FromString("(1, 2, 3) x", i3) || ss::FromString("(1; 2; 3)", i3)){return 10;}
+    if(ss::FromString("(1, 2, 99999999999)", i3)){return 11;}
+
+    //Parse walks a stream of several
+    const std::string several = "(1, 2, 3)(4, 5, 6)";
+    const char* at = several.data();
+    const char* end = several.data() + several.size();
+    ss::vec3i first, second;
+    at = ss::Parse(at, end, first);
+    at = (at == nullptr) ? nullptr : ss::Parse(at, end, second);
+    if(at != end || second != ss::vec3i{4, 5, 6}){return 12;}
+
+    //Components formatted by their own operator<< in the middle of writing a vec or mat
+    std::ostringstream nested;
+    nested<<ss::vec<ss::vec<int, 2>, 2>{ss::vec2i{1, 2}, ss::vec2i{3, 4}};
+    if(nested.str() != "((1, 2), (3, 4))"){return 13;}
+    std::ostringstream tagged;
+    tagged<<ss::vec<Tagged, 2>{Tagged{1}, Tagged{2}}<<ss::vec2i{5, 6};
+    if(tagged.str() != "(#(1, -1), #(2, -2))(5, 6)"){return 13;}
+    return 0;
+}
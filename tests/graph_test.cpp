@@ -0,0 +1,149 @@
+#include<algorithm>
+#include<cstdint>
+#include<map>
+#include<vector>
+
+#include "substd/graph.hpp"
+
+using Flat = ss::FlatTree<int>;
+
+//The same forest kept the obvious way, by handle, to check the flat layout against
+struct Reference {
+    std::map<uint32_t, uint32_t> parent;
+    std::map<uint32_t, std::vector<uint32_t>> children;
+    std::vector<uint32_t> roots;
+
+    std::vector<uint32_t>& Siblings(const uint32_t& h){
+        return (parent[h] == Flat::NONE) ? roots : children[parent[h]];
+    }
+    void Attach(const uint32_t& h, const uint32_t& p){
+        parent[h] = p;
+        Siblings(h).push_back(h);
+    }
+    void Detach(const uint32_t& h){
+        std::vector<uint32_t>& s = Siblings(h);
+        s.erase(std::find(s.begin(), s.end(), h));
+    }
+    void Forget(const uint32_t& h){
+        for(uint32_t c : children[h]){Forget(c);}
+        children.erase(h);
+        parent.erase(h);
+    }
+    void PreOrder(const uint32_t& h, std::vector<uint32_t>& out){
+        out.push_back(h);
+        for(uint32_t c : children[h]){PreOrder(c, out);}
+    }
+    void PostOrder(const uint32_t& h, std::vector<uint32_t>& out){
+        for(uint32_t c : children[h]){PostOrder(c, out);}
+        out.push_back(h);
+    }
+    bool IsAncestor(const uint32_t& a, uint32_t d){
+        while(d != Flat::NONE){
+            if(d == a){return true;}
+            d = parent[d];
+        }
+        return false;
+    }
+};
+
+//0 if tree matches ref, otherwise which check failed
+int Compare(const Flat& tree, Reference& ref){
+    std::vector<uint32_t> pre, post, bfs;
+    for(uint32_t r : ref.roots){ref.PreOrder(r, pre);}
+    for(uint32_t r : ref.roots){ref.PostOrder(r, post);}
+    std::vector<uint32_t> level(ref.roots);
+    while(!level.empty()){
+        std::vector<uint32_t> next;
+        for(uint32_t h : level){
+            bfs.push_back(h);
+            next.insert(next.end(), ref.children[h].begin(), ref.children[h].end());
+        }
+        level.swap(next);
+    }
+    if(pre.size() != tree.Size()){return 1;}
+    for(Flat::index_type k = 0; k < tree.Size(); k++){
+        const uint32_t h = tree.HandleOf(k);
+        if(h != pre[k] || tree.IndexOf(h) != k || tree[k] != (int)h){return 2;}
+        const Flat::index_type p = tree.Parent(k);
+        if((p == Flat::NONE) != (ref.parent[h] == Flat::NONE)){return 3;}
+        if(p != Flat::NONE && tree.HandleOf(p) != ref.parent[h]){return 3;}
+        if(tree.Depth(k) != ((p == Flat::NONE) ? 0 : tree.Depth(p) + 1)){return 4;}
+        std::vector<uint32_t> kids;
+        for(Flat::index_type c : tree.Children(k)){kids.push_back(tree.HandleOf(c));}
+        if(kids != ref.children[h]){return 5;}
+    }
+    std::vector<uint32_t> tree_post, tree_bfs, tree_roots;
+    for(Flat::index_type k : tree.PostOrder()){tree_post.push_back(tree.HandleOf(k));}
+    for(Flat::index_type k : tree.BreadthFirst()){tree_bfs.push_back(tree.HandleOf(k));}
+    for(Flat::index_type k : tree.Roots()){tree_roots.push_back(tree.HandleOf(k));}
+    if(tree_post != post){return 6;}
+    if(tree_bfs != bfs){return 7;}
+    if(tree_roots != ref.roots){return 8;}
+    return 0;
+}
+
+int main(int argc, const char** argv){
+    Flat tree;
+    Reference ref;
+    uint32_t state = 7;
+    auto random = [&](const uint32_t& n){
+        state = (state * 1103515245u) + 12345u;
+        return (state >> 8) % n;
+    };
+
+    for(int step = 0; step < 3000; step++){
+        const uint32_t op = random(10);
+        const Flat::index_type n = (Flat::index_type)tree.Size();
+        if(n == 0 || op == 0){
+            const Flat::index_type k = tree.AddRoot(0);
+            tree[k] = (int)tree.HandleOf(k);
+            ref.Attach(tree.HandleOf(k), Flat::NONE);
+        }
+        else if(op < 6){
+            const Flat::index_type p = random(n);
+            const uint32_t ph = tree.HandleOf(p);
+            const Flat::index_type k = tree.AddChild(p, 0);
+            tree[k] = (int)tree.HandleOf(k);
+            if(tree.Parent(k) != tree.IndexOf(ph)){return 20;}
+            ref.Attach(tree.HandleOf(k), ph);
+        }
+        else if(op < 9){
+            const Flat::index_type node = random(n);
+            const Flat::index_type target = (random(8) == 0) ? Flat::NONE : random(n);
+            const uint32_t h = tree.HandleOf(node);
+            const uint32_t th = (target == Flat::NONE) ? Flat::NONE : tree.HandleOf(target);
+            const Flat::index_type moved = tree.Reparent(node, target);
+            if(th != Flat::NONE && ref.IsAncestor(h, th)){
+                if(moved != Flat::NONE){return 21;}
+            }
+            else{
+                if(moved != tree.IndexOf(h)){return 22;}
+                ref.Detach(h);
+                ref.Attach(h, th);
+            }
+        }
+        else if(random(4) == 0){
+            const Flat::index_type node = random(n);
+            const uint32_t h = tree.HandleOf(node);
+            tree.Erase(node);
+            if(tree.IndexOf(h) != Flat::NONE){return 23;}
+            ref.Detach(h);
+            ref.Forget(h);
+        }
+        if(step % 97 == 0 || step == 2999){
+            const int failed = Compare(tree, ref);
+            if(failed != 0){return failed;}
+        }
+    }
+
+    //A subtree is one contiguous slice
+    const Flat::index_type root = *tree.Roots().begin();
+    int sum = 0, expect = 0;
+    for(int v : tree.PreOrder(root)){sum += v;}
+    for(Flat::index_type k = root; k < root + tree.SubtreeSize(root); k++){expect += tree[k];}
+    if(sum != expect){return 24;}
+    std::vector<size_t> starts;
+    const std::vector<Flat::index_type> bfs = tree.BreadthFirst(root, &starts);
+    if(bfs.size() != tree.SubtreeSize(root) || bfs.front() != root || starts.back() != bfs.size()){return 25;}
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include<vector>
+
+#include "substd/interfaces.hpp"
+
+class Node : public ss::ITransformable<float,2> {
+public:
+    ss::mat<float,3> local;
+    Node(Node* parent) : ss::ITransformable<float,2>(parent), local(1) {}
+    ss::mat<float,3> GetLocalMatrix() const override {return local;}
+    void SetLocal(const float& x, const float& y, const float& scale){
+        local = ss::mat<float,3>(scale);
+        local[2] = ss::vec3f{x, y, 1.0f};
+        FlagLocalChange();
+    }
+    Node* Parent() const {return static_cast<Node*>(GetParent());}
+};
+
+//The product of the local matrices from the root down, calculated from scratch
+ss::mat<float,3> Expected(const Node* node){
+    std::vector<const Node*> chain;
+    for(const Node* a = node; a != nullptr; a = a->Parent()){chain.push_back(a);}
+    ss::affine2f global(chain.back()->local);
+    for(size_t i = chain.size() - 1; i-- > 0;){global = global * ss::affine2f(chain[i]->local);}
+    return global.ToMatrix();
+}
+
+class Bound : public ss::IBindable<Bound> {
+public:
+    int binds = 0;
+    void Bind() override {binds++;}
+};
+
+int main(int argc, const char** argv){
+    std::vector<Node*> nodes{new Node(nullptr)};
+    uint32_t state = 99;
+    auto random = [&](const size_t& n){
+        state = (state * 1103515245u) + 12345u;
+        return (size_t)(state >> 8) % n;
+    };
+    for(size_t i = 1; i < 2000; i++){nodes.push_back(new Node(nodes[random(i)]));}
+
+    //Changes, moves and reads interleaved, reads of anything below a change must see it
+    for(size_t step = 0; step < 20000; step++){
+        Node* node = nodes[random(nodes.size())];
+        switch(random(4)){
+            case 0:
+                node->SetLocal((float)random(9) - 4.0f, (float)random(5), (random(2) == 0) ? 0.5f : 2.0f);
+                break;
+            case 1: {
+                Node* target = nodes[random(nodes.size())];
+                bool inside = false;
+                for(const Node* a = target; a != nullptr; a = a->Parent()){inside |= (a == node);}
+                if(!inside && !node->IsRoot()){node->Parent()->GiveChild(target, node);}
+                break;
+            }
+            default:
+                if(node->GetGlobalMatrix() != Expected(node)){return 1;}
+                break;
+        }
+    }
+    for(const Node* node : nodes){
+        if(node->GetGlobalMatrix() != Expected(node)){return 2;}
+    }
+
+    //A trimmed subtree stops following its old parent
+    Node* child = nodes.back();
+    if(!child->IsRoot()){
+        Node* old_parent = child->Parent();
+        old_parent->TrimChild(child);
+        old_parent->SetLocal(100.0f, 100.0f, 3.0f);
+        if(child->GetGlobalMatrix() != child->local){return 3;}
+        delete child;
+    }
+
+    Bound a, b;
+    a.SmartBind();
+    a.SmartBind();
+    b.SmartBind();
+    if(a.binds != 1 || b.binds != 1 || !b.IsBound() || a.IsBound() || ss::IBindable<Bound>::GetCurrentlyBound() != &b){return 4;}
+
+    delete nodes[0];
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include<sstream>
+#include<vector>
+
+#include "substd/io.hpp"
+
+//Writes a record of every width and byte order, then a BE and an LE array of count elements
+template<typename Writer>
+void WriteRecord(Writer& w, const std::vector<uint32_t>& words){
+    w.WriteU8(0xAB);
+    w.WriteBEU16(0x1234);
+    w.WriteLEU16(0x1234);
+    w.WriteBEU32(0x89ABCDEFu);
+    w.WriteLEU32(0x89ABCDEFu);
+    w.WriteBEU64(0x0123456789ABCDEFull);
+    w.WriteLEU64(0x0123456789ABCDEFull);
+    w.WriteBEU32Array(words.data(), words.size());
+    w.WriteLEU32Array(words.data(), words.size());
+}
+
+bool ReadRecord(ss::ByteReader& r, const std::vector<uint32_t>& words){
+    if(r.ReadU8() != 0xAB){return false;}
+    if(r.ReadBEU16() != 0x1234){return false;}
+    if(r.ReadLEU16() != 0x1234){return false;}
+    if(r.ReadBEU32() != 0x89ABCDEFu){return false;}
+    if(r.ReadLEU32() != 0x89ABCDEFu){return false;}
+    if(r.ReadBEU64() != 0x0123456789ABCDEFull){return false;}
+    if(r.ReadLEU64() != 0x0123456789ABCDEFull){return false;}
+    std::vector<uint32_t> be(words.size()), le(words.size());
+    if(r.ReadBEU32Array(be.data(), be.size()) != words.size()){return false;}
+    if(r.ReadLEU32Array(le.data(), le.size()) != words.size()){return false;}
+    return (be == words) && (le == words) && r.AtEnd() && r.Good();
+}
+
+int main(int argc, const char** argv){
+    //Odd length so the byte shuffles leave a remainder
+    std::vector<uint32_t> words(1237);
+    for(size_t i = 0; i < words.size(); i++){words[i] = (uint32_t)(i * 2654435761u);}
+    const size_t record_size = 1 + 2 + 2 + 4 + 4 + 8 + 8 + (words.size() * 8);
+
+    std::vector<uint8_t> bytes;
+    {
+        ss::ByteWriter w(bytes);
+        WriteRecord(w, words);
+    }
+    if(bytes.size() != record_size){return 1;}
+    if(bytes[1] != 0x12 || bytes[2] != 0x34 || bytes[3] != 0x34 || bytes[4] != 0x12){return 2;}
+
+    ss::ByteReader from_buffer(bytes.data(), bytes.size());
+    if(!ReadRecord(from_buffer, words)){return 3;}
+
+    //A stream with a buffer much smaller than the record exercises refills and the direct array path
+    std::stringstream stream;
+    {
+        ss::ByteWriter w(stream, 64);
+        WriteRecord(w, words);
+    }
+    if(stream.str() != std::string(bytes.begin(), bytes.end())){return 4;}
+    ss::ByteReader from_stream(stream, 64);
+    if(!ReadRecord(from_stream, words)){return 5;}
+
+    //The stream functions agree with the reader
+    std::istringstream legacy(std::string(bytes.begin(), bytes.end()));
+    std::ostringstream silent;
+    if(ss::GetNextU8(legacy, silent) != 0xAB){return 6;}
+    if(ss::GetNextBEU16(legacy, silent) != 0x1234 || ss::GetNextLEU16(legacy, silent) != 0x1234){return 7;}
+    if(ss::GetNextBEU32(legacy, silent) != 0x89ABCDEFu || ss::GetNextLEU32(legacy, silent) != 0x89ABCDEFu){return 8;}
+
+    //Running out sets the sticky flag and reads 0
+    ss::ByteReader truncated(bytes.data(), 3);
+    truncated.ReadU8();
+    truncated.ReadBEU32();
+    if(!truncated.Failed() || truncated.ReadBEU16() != 0){return 9;}
+    ss::ByteReader short_array(bytes.data(), 10);
+    uint32_t partial[4];
+    if(short_array.ReadBEU32Array(partial, 4) != 2 || !short_array.Failed()){return 10;}
+    if(ss::GetNextBEU64(legacy, silent) != 0x0123456789ABCDEFull){return 11;}
+    if(!silent.str().empty()){return 12;}
+
+    //The Try functions never log, and the stream's failbit sticks for a check per record
+    std::istringstream tail(std::string(bytes.begin(), bytes.begin() + 5));
+    std::optional<uint8_t> first = ss::TryGetNextU8(tail);
+    std::optional<uint16_t> second = ss::TryGetNextBEU16(tail);
+    std::optional<uint32_t> third = ss::TryGetNextBEU32(tail);
+    std::optional<uint16_t> fourth = ss::TryGetNextLEU16(tail);
+    if(!first || *first != 0xAB || !second || *second != 0x1234){return 13;}
+    if(third || fourth || !tail.fail()){return 14;}
+    if(ss::GetNextBEU32(tail, silent) != 0 || silent.str().empty()){return 15;}
+    return 0;
+}
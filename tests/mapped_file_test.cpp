@@ -0,0 +1,59 @@
+#include<cstdio>
+#include<fstream>
+#include<vector>
+
+#include "substd/io.hpp"
+#include "substd/mapped_file.hpp"
+
+int main(int argc, const char** argv){
+    const char* path = "mapped_file_test.bin";
+    std::vector<uint32_t> words(1001);
+    for(size_t i = 0; i < words.size(); i++){words[i] = (uint32_t)(i * 2654435761u);}
+    {
+        std::ofstream file(path, std::ios::binary);
+        ss::ByteWriter w(file);
+        w.WriteBEU16(0xBEEF);
+        w.WriteLEU32(0x01020304u);
+        w.WriteBEU64(0x0123456789ABCDEFull);
+        w.WriteBEU32Array(words.data(), words.size());
+        w.WriteLEU32Array(words.data(), words.size());
+    }
+
+    ss::MappedFile file(path, ss::MappedFile::Access::Sequential);
+    if(!file.IsOpen() || file.Size() != 2 + 4 + 8 + (words.size() * 8)){return 1;}
+    if(file.PeekBEU16() != 0xBEEF || file.Tell() != 0){return 2;}
+    if(file.GetNextBEU16() != 0xBEEF){return 3;}
+    if(file.GetNextLEU32() != 0x01020304u){return 4;}
+    if(file.GetNextBEU64() != 0x0123456789ABCDEFull){return 5;}
+
+    ss::BEArrayView<uint32_t> be = file.GetNextBEArray<uint32_t>(words.size());
+    ss::LEArrayView<uint32_t> le = file.GetNextLEArray<uint32_t>(words.size());
+    if(be.size() != words.size() || be[500] != words[500] || le[1000] != words[1000]){return 6;}
+    if(be.ToVector() != words || le.ToVector() != words){return 7;}
+    size_t i = 0;
+    for(uint32_t u : be){
+        if(u != words[i++]){return 8;}
+    }
+    if(!file.AtEnd() || !file.Good()){return 9;}
+
+    //Past the end reads 0, gives empty views and sticks
+    if(file.GetNextU8() != 0 || !file.Failed() || !file.GetNextBEArray<uint32_t>(1).empty()){return 10;}
+
+    //Random access does not move the cursor
+    if(file.BEArrayAt<uint32_t>(14, words.size())[3] != words[3]){return 11;}
+    if(!file.BEArrayAt<uint32_t>(15, words.size() * 2).empty()){return 12;}
+    if(!file.Seek(2) || file.PeekLEU32() != 0x01020304u){return 13;}
+
+    ss::MappedFile moved(std::move(file));
+    if(file.IsOpen() || moved.GetNextLEU32() != 0x01020304u){return 14;}
+
+    //Counts whose size in bytes would wrap, as an untrusted file might give, are past the end too
+    if(!moved.Seek(6) || !moved.GetNextLEArray<uint32_t>((size_t)1 << 62).empty() || !moved.Failed()){return 16;}
+    if(!moved.Seek(6) || !moved.GetNextBEArray<uint64_t>(((size_t)1 << 61) + 1).empty() || !moved.Failed()){return 16;}
+    moved.Close();
+
+    ss::MappedFile missing("mapped_file_test.missing");
+    if(missing.IsOpen()){return 15;}
+    std::remove(path);
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include<vector>
+
+#include "substd/mat_batch.hpp"
+
+//Small integers and halves throughout, so every product is exact and fused or not gives the same result
+template<typename T, size_t dim>
+ss::mat<T,dim+1> Affine(){
+    ss::mat<T,dim+1> m(1);
+    for(size_t col = 0; col <= dim; col++){
+        for(size_t row = 0; row < dim; row++){m[col][row] = (T)((row*7 + col*3 + row*col) % 11) - (T)5 + (T)0.5;}
+    }
+    return m;
+}
+template<typename T, size_t dim>
+std::vector<ss::vec<T,dim>> Points(const size_t& count){
+    std::vector<ss::vec<T,dim>> points(count);
+    for(size_t i = 0; i < count; i++){
+        for(size_t c = 0; c < dim; c++){points[i][c] = (T)((i*5 + c*3) % 17) - (T)8 + ((i % 2) ? (T)0.5 : (T)0);}
+    }
+    return points;
+}
+//The first dim rows of m * (v, w)
+template<typename T, size_t dim>
+ss::vec<T,dim> Expected(const ss::mat<T,dim+1>& m, const ss::vec<T,dim>& v, const T& w){
+    const ss::vec<T,dim+1> full = m * v.Homogenized(w);
+    ss::vec<T,dim> ret;
+    for(size_t c = 0; c < dim; c++){ret[c] = full[c];}
+    return ret;
+}
+
+//Every entry point against per element mat * vec, for count points on up to threads threads
+template<typename T, size_t dim>
+bool AgreesWithMat(const size_t& count, const size_t& threads){
+    const ss::mat<T,dim+1> m = Affine<T,dim>();
+    const std::vector<ss::vec<T,dim>> in = Points<T,dim>(count);
+    std::vector<ss::vec<T,dim>> points(count), directions(count);
+    ss::TransformPoints(m, in.data(), points.data(), count, threads);
+    ss::TransformDirections(m, in.data(), directions.data(), count, threads);
+    if(ss::TransformPoints(m, in, threads) != points){return false;}
+    for(size_t i = 0; i < count; i++){
+        if(points[i] != Expected(m, in[i], (T)1) || directions[i] != Expected(m, in[i], (T)0)){return false;}
+    }
+
+    //In place
+    std::vector<ss::vec<T,dim>> aliased(in);
+    ss::TransformPoints(m, aliased.data(), aliased.data(), count, threads);
+    if(aliased != points){return false;}
+    aliased = in;
+    ss::TransformDirections(m, aliased.data(), aliased.data(), count, threads);
+    if(aliased != directions){return false;}
+
+    //Structure of arrays, into another and in place
+    const ss::vec_soa<T,dim> soa(in);
+    ss::vec_soa<T,dim> soa_out;
+    ss::TransformPoints(m, soa, soa_out, threads);
+    if(soa_out.ToVector() != points){return false;}
+    ss::TransformDirections(m, soa, soa_out, threads);
+    if(soa_out.ToVector() != directions){return false;}
+    ss::vec_soa<T,dim> soa_aliased(soa);
+    ss::TransformPoints(m, soa_aliased, soa_aliased, threads);
+    if(soa_aliased.ToVector() != points){return false;}
+
+    //General matrices, every row computed
+    ss::mat<T,dim+1,dim> wide;
+    for(size_t col = 0; col < dim; col++){
+        for(size_t row = 0; row <= dim; row++){wide[col][row] = (T)((row + col*2) % 5) - (T)2;}
+    }
+    std::vector<ss::vec<T,dim+1>> vectors(count);
+    ss::TransformVectors(wide, in.data(), vectors.data(), count, threads);
+    for(size_t i = 0; i < count; i++){
+        if(vectors[i] != wide * in[i]){return false;}
+    }
+    return true;
+}
+
+int main(int argc, const char** argv){
+    //Fewer than a pack, a count no pack width divides, and enough to split across threads
+    const size_t threaded = (SS_PARALLEL_MIN_CHUNK * 3) + 5;
+    if(!AgreesWithMat<float, 2>(1, 1) || !AgreesWithMat<float, 2>(37, 1) || !AgreesWithMat<float, 2>(threaded, 4)){return 1;}
+    if(!AgreesWithMat<float, 3>(1, 1) || !AgreesWithMat<float, 3>(37, 1) || !AgreesWithMat<float, 3>(threaded, 4)){return 2;}
+    if(!AgreesWithMat<double, 3>(37, 1) || !AgreesWithMat<double, 3>(threaded, 0)){return 3;}
+
+    //AffineLanes driven by a ThreadPool rather than ParallelFor
+    const ss::mat<float,4> m = Affine<float,3>();
+    const std::vector<ss::vec3f> in = Points<float,3>(threaded);
+    std::vector<ss::vec3f> out(threaded);
+    const ss::AffineLanes<float,3,true> lanes(m);
+    ss::ThreadPool pool(4);
+    pool.ParallelFor(threaded, [&](const size_t& begin, const size_t& end){lanes.Apply(in.data(), out.data(), begin, end);});
+    for(size_t i = 0; i < threaded; i++){
+        if(out[i] != Expected(m, in[i], 1.0f)){return 4;}
+    }
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "substd/mat.hpp"
+#include "substd/quat.hpp"
+
+template<typename T, size_t r, size_t k, size_t c>
+bool CheckProduct(){
+    ss::mat<T,r,k> a;
+    ss::mat<T,k,c> b;
+    for(size_t col = 0; col < k; col++){
+        for(size_t row = 0; row < r; row++){a[col][row] = (T)((row*7 + col*3) % 11) - (T)5;}
+    }
+    for(size_t col = 0; col < c; col++){
+        for(size_t row = 0; row < k; row++){b[col][row] = (T)((row*5 + col*2) % 13) - (T)6;}
+    }
+    ss::mat<T,r,c> prod = a * b;
+    for(size_t col = 0; col < c; col++){
+        for(size_t row = 0; row < r; row++){
+            T expected = 0;
+            for(size_t p = 0; p < k; p++){expected += a[p][row] * b[col][p];}
+            if(prod[col][row] != expected){return false;}
+        }
+    }
+    return true;
+}
+
+template<typename T, size_t n>
+bool CheckInverse(const T& tolerance){
+    ss::mat<T,n> m;
+    for(size_t col = 0; col < n; col++){
+        for(size_t row = 0; row < n; row++){m[col][row] = (T)((row*7 + col*3 + row*col) % 11) - (T)5 + ((row == col) ? (T)9 : (T)0);}
+    }
+    ss::mat<T,n> prod = m * m.Inverse();
+    for(size_t col = 0; col < n; col++){
+        for(size_t row = 0; row < n; row++){
+            if(ss::Abs<T>(prod[col][row] - ((row == col) ? (T)1 : (T)0)) > tolerance){return false;}
+        }
+    }
+    return ss::Abs<T>((m.Determinant() * m.Inverse().Determinant()) - (T)1) <= tolerance * n;
+}
+
+template<typename T>
+bool CheckAffineInverse(const T& tolerance){
+    //Rotation about z followed by a per-axis scale, then a translation
+    ss::mat<T,4> affine(1);
+    affine[0] = ss::vec<T,4>{(T)0, (T)2, (T)0, (T)0};
+    affine[1] = ss::vec<T,4>{(T)-3, (T)0, (T)0, (T)0};
+    affine[2] = ss::vec<T,4>{(T)0, (T)0, (T)0.5, (T)0};
+    affine[3] = ss::vec<T,4>{(T)1, (T)2, (T)3, (T)1};
+    ss::mat<T,4> affine_inverse = affine.AffineInverse(), inverse = affine.Inverse();
+    for(size_t col = 0; col < 4; col++){
+        for(size_t row = 0; row < 4; row++){
+            if(ss::Abs<T>(affine_inverse[col][row] - inverse[col][row]) > tolerance){return false;}
+        }
+    }
+    return true;
+}
+
+template<typename T>
+bool CheckRotation(const T& tolerance){
+    const ss::vec<T,3> rot{(T)0.3, (T)-1.1, (T)2.4};
+    const ss::mat<T,3> m = ss::CreateRotationMatrix<T>(rot);
+    //z first, then y, then x
+    const ss::mat<T,3> expected = ss::CreateRotationMatrix<T,3>(ss::vec<T,3>{rot[0], (T)0, (T)0})
+        * ss::CreateRotationMatrix<T,3>(ss::vec<T,3>{(T)0, rot[1], (T)0})
+        * ss::CreateRotationMatrix<T,3>(ss::vec<T,3>{(T)0, (T)0, rot[2]});
+    const ss::mat<T,3> from_quat = ss::quat<T>::FromRotation(rot).ToMatrix();
+    const ss::vec<T,3> v{(T)1, (T)2, (T)3};
+    const ss::vec<T,3> rotated = ss::quat<T>::FromRotation(rot).Rotate(v);
+    const ss::vec<T,3> by_matrix = m.VecProd(v);
+    for(size_t col = 0; col < 3; col++){
+        if(ss::Abs<T>(rotated[col] - by_matrix[col]) > tolerance){return false;}
+        for(size_t row = 0; row < 3; row++){
+            if(ss::Abs<T>(m[col][row] - expected[col][row]) > tolerance){return false;}
+            if(ss::Abs<T>(m[col][row] - from_quat[col][row]) > tolerance){return false;}
+        }
+    }
+    //x rotation turns y towards z
+    const ss::mat<T,3> x = ss::CreateRotationMatrix<T,3>(ss::vec<T,3>{(T)1.5707963267948966, (T)0, (T)0});
+    if(ss::Abs<T>(x[1][2] - (T)1) > tolerance){return false;}
+    //5D rotations are orthonormal with determinant 1
+    ss::vec<T,10> rot5;
+    for(size_t k = 0; k < 10; k++){rot5[k] = (T)0.1 * (T)(k + 1);}
+    const ss::mat<T,5> m5 = ss::CreateRotationMatrix<T,5>(rot5);
+    const ss::mat<T,5> identity = m5.Transpose() * m5;
+    for(size_t col = 0; col < 5; col++){
+        for(size_t row = 0; row < 5; row++){
+            if(ss::Abs<T>(identity[col][row] - ((row == col) ? (T)1 : (T)0)) > tolerance){return false;}
+        }
+    }
+    if(ss::Abs<T>(m5.Determinant() - (T)1) > tolerance){return false;}
+    return true;
+}
+
+template<typename T>
+bool CheckSlerp(const T& tolerance){
+    const ss::vec<T,3> axis{(T)0, (T)0, (T)1};
+    const ss::quat<T> a = ss::quat<T>::Identity();
+    const ss::quat<T> b = ss::quat<T>::FromAxisAngle(axis, (T)2);
+    const ss::quat<T> half = ss::quat<T>::Slerp(a, b, (T)0.5);
+    const ss::quat<T> expected = ss::quat<T>::FromAxisAngle(axis, (T)1);
+    for(size_t i = 0; i < 4; i++){
+        if(ss::Abs<T>(half[i] - expected[i]) > tolerance){return false;}
+    }
+    const ss::quat<T> near = ss::quat<T>::Slerp(a, ss::quat<T>::FromAxisAngle(axis, (T)0.001), (T)0.5);
+    if(ss::Abs<T>(near.MagnitudeSqr() - (T)1) > tolerance){return false;}
+    return true;
+}
+
+int main(int argc, const char** argv){
+    if(!CheckProduct<float,4,4,4>()){return 1;}
+    if(!CheckProduct<double,4,4,4>()){return 2;}
+    if(!CheckProduct<float,3,3,3>()){return 3;}
+    if(!CheckProduct<int,2,3,4>()){return 4;}
+    if(!CheckProduct<double,70,65,90>()){return 5;}
+
+    ss::mat<float,4> m(1);
+    m[3][0] = 5.0f;
+    m *= ss::mat<float,4>(2.0f);
+    if(m[3][0] != 10.0f || m[0][0] != 2.0f){return 6;}
+
+    if(!CheckInverse<double,2>(1e-12)){return 7;}
+    if(!CheckInverse<double,3>(1e-12)){return 8;}
+    if(!CheckInverse<float,4>(1e-5f)){return 9;}
+    if(!CheckInverse<double,4>(1e-12)){return 10;}
+    if(!CheckInverse<double,6>(1e-12)){return 11;}
+
+    ss::mat<double,3> diag(2.0);
+    if(diag.Determinant() != 8.0){return 12;}
+
+    if(!CheckAffineInverse<double>(1e-12)){return 13;}
+    if(!CheckAffineInverse<float>(1e-5f)){return 15;}
+
+    ss::mat<int,2,3> rect;
+    rect[0] = ss::vec2i{1, 2};
+    rect[1] = ss::vec2i{3, 4};
+    rect[2] = ss::vec2i{5, 6};
+    ss::mat<int,3,2> transposed = rect.Transpose();
+    if(transposed[1][2] != 6 || transposed[0][1] != 3){return 14;}
+
+    if(!CheckRotation<double>(1e-12)){return 16;}
+    if(!CheckRotation<float>(1e-5f)){return 17;}
+    if(!CheckSlerp<double>(1e-12)){return 18;}
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include<cmath>
+#include<vector>
+
+#include "substd/math.hpp"
+
+template<typename T, ss::Accuracy a>
+bool CheckTrig(const double& tolerance){
+    //Not a multiple of any pack width, so the scalar remainder is covered too
+    constexpr size_t count = 1001;
+    std::vector<T> theta(count), sin(count), cos(count), single(count);
+    for(size_t i = 0; i < count; i++){
+        theta[i] = (T)(-100.0 + 0.2 * (double)i);
+    }
+    ss::SinCos<T, a>(theta.data(), sin.data(), cos.data(), count);
+    ss::Sin<T, a>(theta.data(), single.data(), count);
+    for(size_t i = 0; i < count; i++){
+        const double expected_sin = std::sin((double)theta[i]);
+        const double expected_cos = std::cos((double)theta[i]);
+        if(std::abs(sin[i] - expected_sin) > tolerance){return false;}
+        if(std::abs(cos[i] - expected_cos) > tolerance){return false;}
+        if(single[i] != sin[i]){return false;}
+        if(std::abs(ss::Sin<T, a>(theta[i]) - expected_sin) > tolerance){return false;}
+        if(std::abs(ss::Cos<T, a>(theta[i]) - expected_cos) > tolerance){return false;}
+    }
+    return true;
+}
+
+template<typename T, ss::Accuracy a>
+bool CheckSqrt(const double& tolerance){
+    constexpr size_t count = 1001;
+    std::vector<T> x(count), sqrt(count), rsqrt(count);
+    for(size_t i = 0; i < count; i++){
+        x[i] = (T)std::pow(10.0, -20.0 + 0.04 * (double)i);
+    }
+    ss::Sqrt<T, a>(x.data(), sqrt.data(), count);
+    ss::RSqrt<T, a>(x.data(), rsqrt.data(), count);
+    for(size_t i = 0; i < count; i++){
+        const double expected = std::sqrt((double)x[i]);
+        if(std::abs(sqrt[i] / expected - 1.0) > tolerance){return false;}
+        if(std::abs(rsqrt[i] * expected - 1.0) > tolerance){return false;}
+        if(std::abs(ss::Sqrt<T, a>(x[i]) / expected - 1.0) > tolerance){return false;}
+        if(std::abs(ss::RSqrt<T, a>(x[i]) * expected - 1.0) > tolerance){return false;}
+    }
+    return ss::Sqrt<T, a>((T)0) == (T)0;
+}
+
+int main(int argc, const char** argv){
+    if(!CheckTrig<float, ss::Accuracy::Low>(1e-3)){return 1;}
+    if(!CheckTrig<float, ss::Accuracy::Medium>(1e-6)){return 2;}
+    if(!CheckTrig<float, ss::Accuracy::Full>(1e-6)){return 3;}
+    if(!CheckTrig<double, ss::Accuracy::Low>(1e-3)){return 4;}
+    if(!CheckTrig<double, ss::Accuracy::Medium>(1e-6)){return 5;}
+    if(!CheckTrig<double, ss::Accuracy::Full>(1e-15)){return 6;}
+
+    if(!CheckSqrt<float, ss::Accuracy::Low>(1e-3)){return 7;}
+    if(!CheckSqrt<float, ss::Accuracy::Medium>(1e-6)){return 8;}
+    if(!CheckSqrt<double, ss::Accuracy::Low>(1e-3)){return 9;}
+    if(!CheckSqrt<double, ss::Accuracy::Medium>(1e-6)){return 10;}
+    if(!CheckSqrt<double, ss::Accuracy::Full>(1e-15)){return 11;}
+
+    //Integral arguments keep going through double
+    if(ss::Sqrt(17) != 4){return 12;}
+    if(std::abs(ss::Sin(1) - std::sin(1.0)) > 1e-15){return 13;}
+    return 0;
+}
@@ -0,0 +1,243 @@
+#include<random>
+#include<vector>
+
+#include "substd/raycoll.hpp"
+#include "substd/broadphase.hpp"
+
+//What TrimMoves must agree with, each ray trimmed by TrimMove in turn
+float TrimEach(const ss::IRayCollidable<float, 2>& coll, const std::vector<ss::vec2f>& origins, const size_t& dir, float move){
+    for(const ss::vec2f& origin : origins){move = coll.TrimMove(origin, dir, move);}
+    return move;
+}
+float TrimPacket(const ss::IRayCollidable<float, 2>& coll, const std::vector<ss::vec2f>& origins, const size_t& dir, const float& move){
+    std::vector<float> x, y;
+    for(const ss::vec2f& origin : origins){
+        x.push_back(origin[0]);
+        y.push_back(origin[1]);
+    }
+    return coll.TrimMoves(std::array<const float*, 2>{x.data(), y.data()}, origins.size(), dir, move);
+}
+
+class Mover : public ss::AABBRayMoveChecker<float>, public ss::Orientation<float, float, 2> {
+public:
+    Mover(const int& res = 3) : ss::AABBRayMoveChecker<float>(res, res) {}
+};
+class SweptMover : public ss::SweptAABBMoveChecker<float, 2>, public ss::Orientation<float, float, 2> {};
+
+//Whether every broad phase sweeps 3D boxes exactly as trying every collidable does
+bool SweepsAgree3D(){
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> place(0.0f, 60.0f), size(0.5f, 6.0f), step(-20.0f, 20.0f), outside(-10.0f, 70.0f);
+    std::vector<ss::AABBRayCollidable<float, 3>> boxes;
+    boxes.reserve(600);
+    for(size_t i = 0; i < 600; i++){
+        boxes.emplace_back(ss::vec3f{place(rng), place(rng), place(rng)}, ss::vec3f{size(rng), size(rng), size(rng)});
+    }
+    ss::RayCollisionGroup<float, 3> all;
+    ss::BVHCollisionGroup<float, 3> bvh;
+    ss::GridCollisionGroup<float, 3> grid;
+    ss::SpatialHashCollisionGroup<float, 3> spatial(4.0f);
+    for(size_t i = 0; i < boxes.size(); i++){
+        all.AddCollidable(&boxes[i]);
+        bvh.AddCollidable(&boxes[i], i % 2 == 0);
+        grid.AddCollidable(&boxes[i]);
+        spatial.AddCollidable(&boxes[i]);
+    }
+    for(size_t q = 0; q < 1000; q++){
+        const ss::aabb3f box = ss::aabb3f::FromCenter(ss::vec3f{outside(rng), outside(rng), outside(rng)}, ss::vec3f{size(rng), size(rng), size(rng)});
+        const size_t dir = q % 3;
+        const float move = step(rng);
+        const float expected = all.TrimBoxMove(box, dir, move);
+        //Exactly the nearest face in the way, found by looking at every box
+        float nearest = move;
+        for(const auto& b : boxes){
+            const ss::aabb3f bounds = b.GetBounds();
+            bool across = true;
+            for(size_t i = 0; i < 3; i++){
+                if(i != dir){across = across && box.min[i] < bounds.max[i] && bounds.min[i] < box.max[i];}
+            }
+            if(!across){continue;}
+            if(move > 0 && box.max[dir] <= bounds.min[dir]){nearest = std::min(nearest, bounds.min[dir] - box.max[dir]);}
+            if(move < 0 && box.min[dir] >= bounds.max[dir]){nearest = std::max(nearest, bounds.max[dir] - box.min[dir]);}
+        }
+        if(expected != nearest){return false;}
+        if(bvh.TrimBoxMove(box, dir, move) != expected || grid.TrimBoxMove(box, dir, move) != expected){return false;}
+        if(spatial.TrimBoxMove(box, dir, move) != expected){return false;}
+        //And rays in 3D, singly and as packets
+        const ss::vec3f origin = box.Center();
+        const float x[3] = {origin[0], box.min[0], box.max[0]}, y[3] = {origin[1], box.max[1], box.min[1]}, z[3] = {origin[2], box.min[2], box.min[2]};
+        const std::array<const float*, 3> lanes{x, y, z};
+        float each = move;
+        for(size_t k = 0; k < 3; k++){each = all.TrimMove(ss::vec3f{x[k], y[k], z[k]}, dir, each);}
+        if(bvh.TrimMove(origin, dir, move) != all.TrimMove(origin, dir, move)){return false;}
+        if(all.TrimMoves(lanes, 3, dir, move) != each || bvh.TrimMoves(lanes, 3, dir, move) != each){return false;}
+        if(grid.TrimMoves(lanes, 3, dir, move) != each || spatial.TrimMoves(lanes, 3, dir, move) != each){return false;}
+    }
+    return true;
+}
+
+int main(int argc, const char** argv){
+    //Stopped at the face crossed, only when the origin is strictly within the other axis' extent
+    ss::AABBRayCollidable<float> wall(ss::vec2f{5.0f, 0.0f}, ss::vec2f{2.0f, 10.0f});
+    if(wall.TrimMove(ss::vec2f{0.0f, 0.0f}, 0, 10.0f) != 4.0f){return 1;}
+    if(wall.TrimMove(ss::vec2f{10.0f, 0.0f}, 0, -10.0f) != -4.0f){return 1;}
+    if(wall.TrimMove(ss::vec2f{0.0f, 0.0f}, 0, 3.0f) != 3.0f){return 2;}
+    if(wall.TrimMove(ss::vec2f{0.0f, 5.0f}, 0, 10.0f) != 10.0f){return 2;}
+    if(wall.TrimMove(ss::vec2f{0.0f, 0.0f}, 0, -10.0f) != -10.0f){return 2;}
+    if(wall.TrimMove(ss::vec2f{5.0f, 0.0f}, 0, 10.0f) != 10.0f){return 3;}
+    //Packets of every size around the SIMD width, origins on the faces and edges included
+    std::mt19937 edge_rng(3);
+    std::uniform_int_distribution<int> coord(-14, 14);
+    for(size_t count = 0; count <= 37; count++){
+        for(size_t q = 0; q < 50; q++){
+            std::vector<ss::vec2f> origins;
+            for(size_t k = 0; k < count; k++){origins.push_back(ss::vec2f{coord(edge_rng) * 0.5f, coord(edge_rng) * 0.5f});}
+            const size_t dir = q % 2;
+            const float move = (q % 4 < 2) ? 9.0f : -9.0f;
+            if(TrimPacket(wall, origins, dir, move) != TrimEach(wall, origins, dir, move)){return 12;}
+        }
+    }
+
+    //Swept boxes stop exactly at the face, slide past boxes they only touch, and never trim out of an overlap
+    const ss::aabb2f unit = ss::aabb2f::FromCenter(ss::vec2f{0.0f, 0.0f}, ss::vec2f{1.0f, 1.0f});
+    if(wall.TrimBoxMove(unit, 0, 10.0f) != 3.5f || wall.TrimBoxMove(unit, 0, -10.0f) != -10.0f){return 13;}
+    if(wall.TrimBoxMove(ss::aabb2f::FromCenter(ss::vec2f{0.0f, 5.5f}, ss::vec2f{1.0f, 1.0f}), 0, 10.0f) != 10.0f){return 13;}
+    if(wall.TrimBoxMove(ss::aabb2f::FromCenter(ss::vec2f{0.0f, 5.4f}, ss::vec2f{1.0f, 1.0f}), 0, 10.0f) != 3.5f){return 13;}
+    if(wall.TrimBoxMove(ss::aabb2f::FromCenter(ss::vec2f{3.5f, 0.0f}, ss::vec2f{1.0f, 1.0f}), 0, 1.0f) != 0.0f){return 13;}
+    if(wall.TrimBoxMove(ss::aabb2f::FromCenter(ss::vec2f{4.5f, 0.0f}, ss::vec2f{1.0f, 1.0f}), 0, 1.0f) != 1.0f){return 13;}
+    //The default for collidables without an exact sweep casts rays from the leading face's corners
+    ss::RayCollisionGroup<float, 2> wall_only;
+    wall_only.AddCollidable(&wall);
+    if(wall_only.ss::IRayCollidable<float, 2>::TrimBoxMove(unit, 0, 10.0f) != 3.5f){return 13;}
+
+    //A wall thinner than the gap between check points stops a swept box, not a sampled one
+    ss::AABBRayCollidable<float> thin(ss::vec2f{0.0f, 3.0f}, ss::vec2f{0.2f, 1.0f});
+    Mover sampled(2);
+    SweptMover swept;
+    if(sampled.AllowedMove(ss::vec2f{0.0f, 10.0f}, thin) != ss::vec2f{0.0f, 10.0f}){return 14;}
+    if(swept.AllowedMove(ss::vec2f{0.0f, 10.0f}, thin) != ss::vec2f{0.0f, 2.0f}){return 14;}
+    //The checked box follows the mover's position and scale
+    swept.SetPosition(ss::vec2f{-2.0f, 3.0f});
+    swept.SetScale(ss::vec2f{2.0f, 0.5f});
+    if(swept.AllowedMove(ss::vec2f{10.0f, 0.0f}, thin) != ss::vec2f{0.9f, 0.0f}){return 14;}
+    if(swept.GetCheckedBox() != ss::aabb2f(ss::vec2f{-3.0f, 2.75f}, ss::vec2f{-1.0f, 3.25f})){return 14;}
+    if(!SweepsAgree3D()){return 15;}
+
+    //A unit mover at the origin stops against the wall and slides along it
+    Mover mover;
+    ss::RayCollisionGroup<float, 2> linear;
+    linear.AddCollidable(&wall);
+    const ss::vec2f allowed = mover.MoveAsAllowed(ss::vec2f{10.0f, 1.0f}, linear);
+    if(allowed[0] != 3.5f || allowed[1] != 1.0f){return 4;}
+    if(mover.GetPosition()[0] != 3.5f || mover.GetPosition()[1] != 1.0f){return 4;}
+
+    //The broad phases trim every ray exactly as trying every collidable does
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> place(0.0f, 200.0f), size(0.5f, 8.0f), step(-40.0f, 40.0f);
+    std::vector<ss::AABBRayCollidable<float>> boxes;
+    boxes.reserve(2000);
+    for(size_t i = 0; i < 2000; i++){boxes.emplace_back(ss::vec2f{place(rng), place(rng)}, ss::vec2f{size(rng), size(rng)});}
+    ss::RayCollisionGroup<float, 2> all;
+    ss::BVHCollisionGroup<float, 2> bvh;
+    ss::GridCollisionGroup<float, 2> grid, coarse(50.0f);
+    for(size_t i = 0; i < boxes.size(); i++){
+        all.AddCollidable(&boxes[i]);
+        bvh.AddCollidable(&boxes[i], i % 4 == 0);
+        grid.AddCollidable(&boxes[i]);
+        coarse.AddCollidable(&boxes[i]);
+    }
+    if(bvh.Size() != boxes.size() || grid.Size() != boxes.size()){return 5;}
+    auto agree = [&]{
+        std::uniform_real_distribution<float> outside(-50.0f, 250.0f);
+        for(size_t q = 0; q < 2000; q++){
+            const ss::vec2f origin{outside(rng), outside(rng)};
+            const size_t dir = q % 2;
+            const float move = step(rng);
+            const float expected = all.TrimMove(origin, dir, move);
+            if(bvh.TrimMove(origin, dir, move) != expected){return false;}
+            if(grid.TrimMove(origin, dir, move) != expected){return false;}
+            if(coarse.TrimMove(origin, dir, move) != expected){return false;}
+        }
+        //A mover's worth of rays at once
+        for(size_t q = 0; q < 300; q++){
+            const ss::vec2f corner{outside(rng), outside(rng)};
+            std::vector<ss::vec2f> origins;
+            for(size_t k = 0; k < 1 + (q % 9); k++){origins.push_back(corner + ss::vec2f{(float)(k % 3), (float)(k / 3)});}
+            const size_t dir = q % 2;
+            const float move = step(rng);
+            const float expected = TrimEach(all, origins, dir, move);
+            if(TrimPacket(all, origins, dir, move) != expected || TrimPacket(bvh, origins, dir, move) != expected){return false;}
+            if(TrimPacket(grid, origins, dir, move) != expected || TrimPacket(coarse, origins, dir, move) != expected){return false;}
+        }
+        return true;
+    };
+    if(!agree()){return 6;}
+
+    //Dynamic collidables moved, then refit
+    for(size_t i = 0; i < boxes.size(); i += 4){
+        boxes[i].SetPosition(boxes[i].GetPosition() + ss::vec2f{step(rng) / 4.0f, step(rng) / 4.0f});
+    }
+    bvh.Update();
+    grid.Update();
+    coarse.Update();
+    if(!agree()){return 7;}
+
+    //Removal, static and dynamic
+    for(size_t i = 0; i < 100; i++){
+        all.RemoveCollidable(&boxes[i]);
+        bvh.RemoveCollidable(&boxes[i]);
+        grid.RemoveCollidable(&boxes[i]);
+        coarse.RemoveCollidable(&boxes[i]);
+    }
+    if(bvh.Size() != boxes.size() - 100 || grid.Size() != boxes.size() - 100){return 8;}
+    if(!agree()){return 9;}
+
+    //Movers checked against a broad phase move exactly as they do against the plain group
+    Mover a, b;
+    a.SetPosition(ss::vec2f{100.0f, 100.0f});
+    b.SetPosition(ss::vec2f{100.0f, 100.0f});
+    for(size_t i = 0; i < 200; i++){
+        const ss::vec2f move{step(rng), step(rng)};
+        if(a.MoveAsAllowed(move, all) != b.MoveAsAllowed(move, bvh)){return 10;}
+    }
+
+    //Empty groups trim nothing
+    ss::BVHCollisionGroup<float, 2> empty_bvh;
+    ss::GridCollisionGroup<float, 2> empty_grid;
+    if(empty_bvh.TrimMove(ss::vec2f{0.0f, 0.0f}, 0, 5.0f) != 5.0f || empty_grid.TrimMove(ss::vec2f{0.0f, 0.0f}, 1, -5.0f) != -5.0f){return 11;}
+
+    //A trimmed end rounding into the cell before the one that trimmed it still ends the walk, within the grid
+    ss::AABBRayCollidable<float> blocker(ss::vec2f{44.8697052f, 0.0f}, ss::vec2f{2.0f, 2.0f}), corner(ss::vec2f{-70.1195984f, 10.0f}, ss::vec2f{2.0f, 2.0f});
+    ss::GridCollisionGroup<float, 2> fine(0.517969847f);
+    fine.AddCollidable(&blocker);
+    fine.AddCollidable(&corner);
+    const ss::vec2f from{-93.3667831f, 0.0f};
+    if(fine.TrimMove(from, 0, 200.0f) != blocker.TrimMove(from, 0, 200.0f)){return 12;}
+    const ss::vec2f back{193.3667831f, 0.0f};
+    if(fine.TrimMove(back, 0, -400.0f) != blocker.TrimMove(back, 0, -400.0f)){return 12;}
+    std::uniform_real_distribution<float> low(-100.0f, 100.0f);
+    for(size_t q = 0; q < 2000; q++){
+        blocker.SetPosition(ss::vec2f{low(rng), 0.0f});
+        fine.Update();
+        const ss::vec2f origin{low(rng) - 100.0f, 0.0f};
+        if(fine.TrimMove(origin, 0, 300.0f) != blocker.TrimMove(origin, 0, 300.0f)){return 12;}
+        const ss::vec2f mirrored{origin[0] + 300.0f, 0.0f};
+        if(fine.TrimMove(mirrored, 0, -300.0f) != blocker.TrimMove(mirrored, 0, -300.0f)){return 12;}
+    }
+
+    //Collidables with no size give the automatic cell size nothing to go on, together or spread apart
+    std::vector<ss::AABBRayCollidable<float>> points;
+    for(size_t i = 0; i < 50; i++){points.emplace_back(ss::vec2f{0.0f, 0.0f}, ss::vec2f{0.0f, 0.0f});}
+    ss::GridCollisionGroup<float, 2> degenerate;
+    for(auto& p : points){degenerate.AddCollidable(&p);}
+    degenerate.Update();
+    if(!(degenerate.CellSize() > 0.0f) || degenerate.TrimMove(ss::vec2f{-10.0f, 0.0f}, 0, 20.0f) != points[0].TrimMove(ss::vec2f{-10.0f, 0.0f}, 0, 20.0f)){return 13;}
+    for(size_t i = 0; i < points.size(); i++){points[i].SetPosition(ss::vec2f{(float)i * 1000.0f, 5.0f});}
+    degenerate.Update();
+    if(!((49000.0f / degenerate.CellSize()) + 1.0f <= (float)(points.size() * SS_GRID_MAX_CELLS_PER_COLLIDABLE))){return 13;}
+    for(size_t i = 0; i < points.size(); i++){
+        const ss::vec2f origin{(float)i * 1000.0f, -10.0f};
+        if(degenerate.TrimMove(origin, 1, 20.0f) != points[i].TrimMove(origin, 1, 20.0f)){return 13;}
+    }
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include<atomic>
+#include<list>
+#include<set>
+#include<thread>
+#include<vector>
+
+#include "substd/interfaces.hpp"
+#include "substd/registry.hpp"
+
+class Dense : public ss::IRegistered<Dense> {
+public:
+    int value;
+    Dense(const int& v = 0) : value(v) {}
+};
+
+class Sharded : public ss::IRegistered<Sharded, ss::ShardedRegistry<Sharded, 4>> {};
+
+class Listed : public ss::IRegistered<Listed, std::list<Listed*>> {};
+
+class Concurrent : public ss::IRegistered<Concurrent, ss::ConcurrentRegistry<Concurrent>> {
+public:
+    size_t owner;
+    Concurrent(const size_t& t) : owner(t) {}
+};
+
+int main(int argc, const char** argv){
+    //Random inserts and erases against a std::set, handles following their entries as they move
+    std::vector<int> values(1000);
+    ss::DenseRegistry<int> registry;
+    std::vector<std::pair<int*, ss::RegistryHandle>> live;
+    std::vector<ss::RegistryHandle> dead;
+    uint32_t state = 7;
+    for(size_t step = 0; step < 20000; step++){
+        state = (state * 1103515245u) + 12345u;
+        if(live.empty() || (state >> 16) % 3 != 0){
+            int* p = &values[(state >> 8) % values.size()];
+            live.emplace_back(p, registry.Insert(p));
+        }
+        else {
+            const size_t k = (state >> 8) % live.size();
+            if(!registry.Erase(live[k].second)){return 1;}
+            dead.push_back(live[k].second);
+            live[k] = live.back();
+            live.pop_back();
+        }
+    }
+    if(registry.size() != live.size()){return 2;}
+    std::multiset<int*> expected, actual(registry.begin(), registry.end());
+    for(const auto& entry : live){
+        expected.insert(entry.first);
+        if(registry.Get(entry.second) != entry.first){return 3;}
+    }
+    if(expected != actual){return 4;}
+    //Reused indices have moved on a generation, so no stale handle reaches a new entry
+    for(const ss::RegistryHandle& h : dead){
+        if(registry.Valid(h) || registry.Get(h) != nullptr || registry.Erase(h)){return 5;}
+    }
+    if(registry.Valid(ss::RegistryHandle()) || registry.Erase(ss::RegistryHandle())){return 5;}
+
+    //ForEachParallel visits every entry once
+    std::vector<int> many(50000);
+    ss::DenseRegistry<int> big;
+    for(int& i : many){big.Insert(&i);}
+    ss::ThreadPool pool(4);
+    big.ForEachParallel(pool, [](int* p){(*p)++;});
+    big.ForEachParallel([](int* p){(*p)++;}, 3);
+    for(const int& i : many){
+        if(i != 2){return 6;}
+    }
+
+    //IRegistered with the default storage, copies registered separately
+    {
+        Dense a(1), b(2);
+        Dense c(a);
+        if(Dense::registry.size() != 3 || Dense::registry.Get(c.GetRegistryHandle()) != &c){return 7;}
+        std::vector<Dense*> heap;
+        for(int i = 0; i < 100; i++){heap.push_back(new Dense(i));}
+        for(size_t i = 0; i < heap.size(); i += 2){delete heap[i];}
+        if(Dense::registry.size() != 53 || Dense::registry.Get(a.GetRegistryHandle()) != &a){return 8;}
+        for(size_t i = 1; i < heap.size(); i += 2){
+            if(Dense::registry.Get(heap[i]->GetRegistryHandle()) != heap[i]){return 8;}
+            delete heap[i];
+        }
+    }
+    if(!Dense::registry.empty()){return 9;}
+
+    //Constructed and destroyed from many threads at once, some destroyed on a different thread
+    std::vector<Sharded*> handed_over[4];
+    std::vector<std::thread> threads;
+    for(size_t t = 0; t < 4; t++){
+        threads.emplace_back([&handed_over, t]{
+            std::vector<Sharded*> mine;
+            for(size_t i = 0; i < 5000; i++){mine.push_back(new Sharded());}
+            for(size_t i = 0; i < mine.size(); i++){
+                if(i % 4 == 0){handed_over[t].push_back(mine[i]);}
+                else {delete mine[i];}
+            }
+        });
+    }
+    for(auto& thread : threads){thread.join();}
+    if(Sharded::registry.size() != 5000){return 10;}
+    std::atomic<size_t> seen{0};
+    Sharded::registry.ForEachParallel(pool, [&](Sharded*){seen++;});
+    if(seen != 5000){return 11;}
+    for(size_t t = 0; t < 4; t++){
+        for(Sharded* s : handed_over[(t + 1) % 4]){
+            if(Sharded::registry.Get(s->GetRegistryHandle()) != s){return 12;}
+            delete s;
+        }
+    }
+    if(!Sharded::registry.empty()){return 13;}
+
+    //Storages without handles still work as before
+    {
+        Listed a, b;
+        if(Listed::registry.size() != 2 || Listed::registry.front() != &a){return 14;}
+    }
+    if(!Listed::registry.empty()){return 15;}
+
+    //16 threads creating and destroying at once while another iterates snapshots, slots reused throughout.
+    //The objects themselves may be mid construction or destruction, so the reader only looks at the pointers.
+    std::atomic<bool> writing{true};
+    std::atomic<size_t> bad{0};
+    std::thread reader([&]{
+        while(writing){
+            size_t visited = 0;
+            Concurrent::registry.ForEach([&](Concurrent* c){visited++; bad += (c == nullptr);});
+            bad += (visited > Concurrent::registry.Capacity());
+        }
+    });
+    std::vector<Concurrent*> kept[16];
+    threads.clear();
+    for(size_t t = 0; t < 16; t++){
+        threads.emplace_back([&kept, t]{
+            std::vector<Concurrent*> mine;
+            for(size_t round = 0; round < 20; round++){
+                for(size_t i = 0; i < 500; i++){mine.push_back(new Concurrent(t));}
+                //Keep one in five, so the survivors end up spread over reused slots
+                for(size_t i = 0; i < mine.size(); i++){
+                    if(i % 5 == 0){kept[t].push_back(mine[i]);}
+                    else {delete mine[i];}
+                }
+                mine.clear();
+            }
+        });
+    }
+    for(auto& thread : threads){thread.join();}
+    writing = false;
+    reader.join();
+    if(bad != 0){return 16;}
+    if(Concurrent::registry.size() != 16 * 2000){return 17;}
+    //Freed slots were reused rather than the tail growing by every construction
+    if(Concurrent::registry.Capacity() >= 16 * 10000){return 18;}
+    std::vector<Concurrent*> snapshot;
+    Concurrent::registry.Snapshot(snapshot);
+    std::set<Concurrent*> all(snapshot.begin(), snapshot.end());
+    for(size_t t = 0; t < 16; t++){
+        for(Concurrent* c : kept[t]){
+            if(all.count(c) != 1 || Concurrent::registry.Get(c->GetRegistryHandle()) != c){return 19;}
+        }
+    }
+    if(all.size() != snapshot.size()){return 19;}
+    seen = 0;
+    Concurrent::registry.ForEachParallel(pool, [&](Concurrent*){seen++;});
+    if(seen != 16 * 2000){return 20;}
+    const ss::RegistryHandle stale = kept[0][0]->GetRegistryHandle();
+    for(size_t t = 0; t < 16; t++){
+        for(Concurrent* c : kept[t]){delete c;}
+    }
+    if(!Concurrent::registry.empty() || Concurrent::registry.Get(stale) != nullptr){return 21;}
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include<cmath>
+#include<cstring>
+#include<limits>
+#include<sstream>
+#include<vector>
+
+#include "substd/serialize.hpp"
+
+//Bitwise, so NaNs compare equal to themselves and -0 differs from 0
+template<typename T>
+bool SameBits(const T& a, const T& b){
+    return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+int main(int argc, const char** argv){
+    //Values text output would lose, NaN with a payload, -0, a denormal and the extremes
+    uint32_t payload = 0x7FC12345u;
+    float nan;
+    std::memcpy(&nan, &payload, sizeof(float));
+    const ss::vec3f odd{nan, -0.0f, std::numeric_limits<float>::denorm_min()};
+    const ss::vec4d wide{std::numeric_limits<double>::max(), -std::numeric_limits<double>::infinity(), 0.1, -1e-300};
+    const ss::vec3i ints{-1, std::numeric_limits<int>::min(), 42};
+    ss::mat<double, 3, 4> m;
+    for(size_t c = 0; c < 4; c++){
+        for(size_t r = 0; r < 3; r++){m[c][r] = (double)((c * 3) + r) / 7.0;}
+    }
+
+    std::vector<uint8_t> bytes;
+    {
+        ss::ByteWriter w(bytes);
+        ss::Write(w, odd);
+        ss::Write(w, wide);
+        ss::Write(w, ints);
+        ss::Write(w, m);
+    }
+    if(bytes.size() != (3 * 4) + (4 * 8) + (3 * 4) + (12 * 8)){return 1;}
+    //Little endian regardless of the host, INT_MIN's only set byte is its last
+    if(bytes[44] != 0xFF || bytes[48] != 0x00 || bytes[51] != 0x80){return 2;}
+
+    ss::ByteReader r(bytes.data(), bytes.size());
+    ss::vec3f odd_back;
+    ss::vec4d wide_back;
+    ss::vec3i ints_back;
+    ss::mat<double, 3, 4> m_back;
+    if(!ss::Read(r, odd_back) || !ss::Read(r, wide_back) || !ss::Read(r, ints_back) || !ss::Read(r, m_back)){return 3;}
+    for(size_t i = 0; i < 3; i++){
+        if(!SameBits(odd[i], odd_back[i])){return 4;}
+    }
+    if(!SameBits(wide, wide_back) || ints != ints_back || !SameBits(m, m_back)){return 5;}
+    if(ss::Read(r, odd_back)){return 6;}
+
+    //Arrays through a stream with a buffer smaller than the payload
+    std::vector<ss::vec3f> points(1001);
+    for(size_t i = 0; i < points.size(); i++){points[i] = ss::vec3f{(float)i, (float)i / 3.0f, -(float)i * 1e-7f};}
+    std::vector<ss::mat<float, 4>> transforms(17, ss::mat<float, 4>(1));
+    transforms[16][3][0] = 5.5f;
+    std::stringstream stream;
+    {
+        ss::ByteWriter w(stream, 64);
+        ss::WriteArray(w, points);
+        ss::WriteArray(w, transforms.data(), transforms.size());
+        ss::WriteArray(w, std::vector<ss::vec2d>());
+    }
+    if(stream.str().size() != (16 * 3) + (points.size() * 12) + (transforms.size() * 64)){return 7;}
+
+    ss::ByteReader from_stream(stream, 64);
+    std::vector<ss::vec3f> points_back;
+    std::vector<ss::mat<float, 4>> transforms_back;
+    std::vector<ss::vec2d> empty(3);
+    if(!ss::ReadArray(from_stream, points_back) || points_back.size() != points.size()){return 8;}
+    if(std::memcmp(points.data(), points_back.data(), points.size() * sizeof(ss::vec3f)) != 0){return 9;}
+    if(!ss::ReadArray(from_stream, transforms_back) || transforms_back.size() != 17 || transforms_back[16][3][0] != 5.5f){return 10;}
+    if(!ss::ReadArray(from_stream, empty) || !empty.empty() || !from_stream.AtEnd()){return 11;}
+
+    //The wrong type or shape, and a cut short payload, fail
+    const std::string encoded = stream.str();
+    ss::ByteReader as_doubles(encoded.data(), encoded.size());
+    std::vector<ss::vec3d> wrong_type;
+    if(ss::ReadArray(as_doubles, wrong_type)){return 12;}
+    ss::ByteReader as_vec4(encoded.data(), encoded.size());
+    std::vector<ss::vec4f> wrong_shape;
+    if(ss::ReadArray(as_vec4, wrong_shape)){return 13;}
+    ss::ByteReader truncated(encoded.data(), 16 + (10 * 12) + 5);
+    if(ss::ReadArray(truncated, points_back) || points_back.size() != 10 || !truncated.Failed()){return 14;}
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include<algorithm>
+#include<limits>
+#include<random>
+#include<set>
+#include<vector>
+
+#include "substd/spatial_hash.hpp"
+#include "substd/broadphase.hpp"
+
+//Random inserts, removes and moves, every query checked against looking at every point
+template<size_t dim>
+bool AgreesWithBruteForce(const float& cell_size, const uint32_t& seed){
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> place(-100.0f, 100.0f), radius(0.0f, 30.0f);
+    ss::SpatialHash<float, dim, int> hash(cell_size);
+    std::vector<std::pair<ss::RegistryHandle, ss::vec<float,dim>>> live;
+    auto point = [&]{
+        ss::vec<float,dim> p;
+        for(size_t i = 0; i < dim; i++){p[i] = place(rng);}
+        return p;
+    };
+    for(size_t step = 0; step < 4000; step++){
+        const uint32_t r = rng() % 10;
+        if(live.empty() || r < 4){
+            const ss::vec<float,dim> p = point();
+            live.emplace_back(hash.Insert(p, (int)live.size()), p);
+        }
+        else if(r < 6){
+            const size_t k = rng() % live.size();
+            if(!hash.Remove(live[k].first) || hash.Valid(live[k].first)){return false;}
+            live[k] = live.back();
+            live.pop_back();
+        }
+        else {
+            //Mostly small moves within or next to a cell, some right across the world
+            const size_t k = rng() % live.size();
+            ss::vec<float,dim> p = point();
+            if(r < 9){
+                for(size_t i = 0; i < dim; i++){p[i] = live[k].second[i] + (p[i] / 50.0f);}
+            }
+            if(!hash.Move(live[k].first, p)){return false;}
+            live[k].second = p;
+        }
+    }
+    if(hash.size() != live.size()){return false;}
+    for(auto& entry : live){
+        if(hash.Position(entry.first) != entry.second){return false;}
+        *hash.Get(entry.first) = (int)(&entry - live.data());
+    }
+    for(size_t q = 0; q < 200; q++){
+        const ss::vec<float,dim> center = point();
+        const float r = radius(rng);
+        std::multiset<int> expected, actual;
+        for(size_t i = 0; i < live.size(); i++){
+            float dist_sq = 0.0f;
+            for(size_t d = 0; d < dim; d++){dist_sq += (live[i].second[d] - center[d]) * (live[i].second[d] - center[d]);}
+            if(dist_sq <= r * r){expected.insert((int)i);}
+        }
+        hash.QueryRadius(center, r, [&](const int& i, const ss::vec<float,dim>&){actual.insert(i);});
+        if(expected != actual){return false;}
+
+        const ss::aabb<float,dim> box = ss::aabb<float,dim>::FromCenter(center, ss::vec<float,dim>(r * 3.0f));
+        expected.clear();
+        actual.clear();
+        for(size_t i = 0; i < live.size(); i++){
+            if(box.Contains(live[i].second)){expected.insert((int)i);}
+        }
+        hash.QueryAABB(box, [&](const int& i, const ss::vec<float,dim>& p){
+            actual.insert(i);
+            if(p != live[i].second){actual.insert(-1);}
+        });
+        if(expected != actual){return false;}
+    }
+    return true;
+}
+
+int main(int argc, const char** argv){
+    //Different cells get different keys
+    std::set<uint64_t> keys;
+    for(int64_t x = -20; x <= 20; x++){
+        for(int64_t y = -20; y <= 20; y++){keys.insert(ss::SpatialKey<2>(ss::vec<int64_t,2>{x, y}));}
+    }
+    if(keys.size() != 41 * 41){return 1;}
+    keys.clear();
+    for(int64_t x = -8; x <= 8; x++){
+        for(int64_t y = -8; y <= 8; y++){
+            for(int64_t z = -8; z <= 8; z++){keys.insert(ss::SpatialKey<3>(ss::vec<int64_t,3>{x, y, z}));}
+        }
+    }
+    if(keys.size() != 17 * 17 * 17){return 1;}
+    if(ss::SpatialKey<2>(ss::vec<int64_t,2>{1 << 30, -(1 << 30)}) == ss::SpatialKey<2>(ss::vec<int64_t,2>{-(1 << 30), 1 << 30})){return 1;}
+
+    if(!AgreesWithBruteForce<1>(4.0f, 1)){return 2;}
+    if(!AgreesWithBruteForce<2>(4.0f, 2)){return 3;}
+    if(!AgreesWithBruteForce<2>(0.5f, 3)){return 3;}
+    if(!AgreesWithBruteForce<3>(8.0f, 4)){return 4;}
+
+    //Stale handles stay invalid after their entry is reused, and Clear() empties every cell
+    ss::SpatialHash<float, 2, int> hash(1.0f);
+    const ss::RegistryHandle a = hash.Insert(ss::vec2f{0.5f, 0.5f}, 1);
+    hash.Remove(a);
+    const ss::RegistryHandle b = hash.Insert(ss::vec2f{0.5f, 0.5f}, 2);
+    if(hash.Valid(a) || hash.Get(a) != nullptr || hash.Move(a, ss::vec2f{0.0f, 0.0f}) || *hash.Get(b) != 2){return 5;}
+    hash.Insert(ss::vec2f{5.5f, 0.5f}, 3);
+    if(hash.CellCount() != 2){return 5;}
+    hash.Clear();
+    size_t found = 0;
+    hash.QueryRadius(ss::vec2f{0.0f, 0.0f}, 100.0f, [&](const int&, const ss::vec2f&){found++;});
+    if(!hash.empty() || hash.CellCount() != 0 || hash.Valid(b) || found != 0){return 6;}
+
+    //Points past what SpatialKey keeps apart, infinite or NaN land in the border cells and are still found
+    const float inf = std::numeric_limits<float>::infinity(), nan = std::numeric_limits<float>::quiet_NaN();
+    ss::SpatialHash<float, 3, int> far(1.0f);
+    const int64_t reach = ss::SpatialKeyReach<3>;
+    if(far.CellOf(ss::vec3f{1e30f, -inf, nan}) != ss::vec<int64_t,3>{reach - 1, -reach, -reach}){return 10;}
+    if(far.CellOf(ss::vec3f{-3.5f, 2.0f, 0.0f}) != ss::vec<int64_t,3>{-4, 2, 0}){return 10;}
+    far.Insert(ss::vec3f{1e30f, 0.0f, 0.0f}, 1);
+    far.Insert(ss::vec3f{inf, 0.0f, 0.0f}, 2);
+    far.Insert(ss::vec3f{nan, 5.0f, 0.0f}, 3);
+    far.Insert(ss::vec3f{2e6f, 0.5f, 0.5f}, 4);
+    found = 0;
+    far.QueryAABB(ss::aabb3f(ss::vec3f{1e29f, -1.0f, -1.0f}, ss::vec3f{inf, 1.0f, 1.0f}), [&](const int& i, const ss::vec3f&){found += (size_t)i;});
+    if(found != 3){return 10;}
+    found = 0;
+    far.QueryRadius(ss::vec3f{2e6f, 0.0f, 0.0f}, 1.0f, [&](const int& i, const ss::vec3f&){found += (size_t)i;});
+    if(found != 4){return 10;}
+
+    //As a broad phase, trimming exactly as trying every collidable does, before and after collidables move
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> place(0.0f, 200.0f), size(0.5f, 8.0f), step(-40.0f, 40.0f), outside(-50.0f, 250.0f);
+    std::vector<ss::AABBRayCollidable<float>> boxes;
+    boxes.reserve(2000);
+    for(size_t i = 0; i < 2000; i++){boxes.emplace_back(ss::vec2f{place(rng), place(rng)}, ss::vec2f{size(rng), size(rng)});}
+    ss::RayCollisionGroup<float, 2> all;
+    ss::SpatialHashCollisionGroup<float, 2> spatial(6.0f);
+    for(auto& box : boxes){
+        all.AddCollidable(&box);
+        spatial.AddCollidable(&box);
+    }
+    auto agree = [&]{
+        for(size_t q = 0; q < 1500; q++){
+            const ss::vec2f origin{outside(rng), outside(rng)};
+            const float move = step(rng);
+            if(spatial.TrimMove(origin, q % 2, move) != all.TrimMove(origin, q % 2, move)){return false;}
+            //A packet of a few rays around origin, against each ray trimmed in turn
+            const float x[3] = {origin[0], origin[0] + 0.5f, origin[0] + 1.0f}, y[3] = {origin[1], origin[1] + 1.0f, origin[1] - 0.5f};
+            const std::array<const float*, 2> lanes{x, y};
+            float each = move;
+            for(size_t k = 0; k < 3; k++){each = all.TrimMove(ss::vec2f{x[k], y[k]}, q % 2, each);}
+            if(spatial.TrimMoves(lanes, 3, q % 2, move) != each){return false;}
+        }
+        return true;
+    };
+    if(!agree()){return 7;}
+    for(size_t i = 0; i < boxes.size(); i += 3){
+        boxes[i].SetPosition(boxes[i].GetPosition() + ss::vec2f{step(rng), step(rng)});
+    }
+    spatial.Update();
+    if(!agree()){return 8;}
+    for(size_t i = 0; i < boxes.size(); i += 2){
+        all.RemoveCollidable(&boxes[i]);
+        spatial.RemoveCollidable(&boxes[i]);
+    }
+    if(spatial.Size() != boxes.size() / 2 || !agree()){return 9;}
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include<algorithm>
+#include<cmath>
+#include<random>
+#include<vector>
+
+#include "substd/static_collision.hpp"
+#include "substd/raycoll.hpp"
+
+using Group = ss::StaticCollisionGroup<ss::BoxShape<float, 2>, ss::SphereShape<float, 2>, ss::HalfSpaceShape<float, 2>>;
+
+//The move a box makes before touching shape, found by casting rays from many points along its leading face
+template<typename S>
+float SampledBoxMove(const S& shape, const ss::aabb2f& box, const size_t& dir, float move){
+    const size_t other = 1 - dir;
+    for(size_t k = 0; k <= 400; k++){
+        ss::vec2f origin;
+        origin[dir] = (move > 0) ? box.max[dir] : box.min[dir];
+        origin[other] = box.min[other] + ((box.max[other] - box.min[other]) * (float)k / 400.0f);
+        move = shape.TrimMove(origin, dir, move);
+    }
+    return move;
+}
+
+int main(int argc, const char** argv){
+    //Circles stop rays at the chord, only strictly within the radius
+    const ss::SphereShape<float, 2> circle(ss::vec2f{5.0f, 0.0f}, 2.0f);
+    if(circle.TrimMove(ss::vec2f{0.0f, 0.0f}, 0, 10.0f) != 3.0f || circle.TrimMove(ss::vec2f{10.0f, 0.0f}, 0, -10.0f) != -3.0f){return 1;}
+    if(std::abs(circle.TrimMove(ss::vec2f{0.0f, 1.0f}, 0, 10.0f) - (5.0f - std::sqrt(3.0f))) > 1e-5f){return 1;}
+    if(circle.TrimMove(ss::vec2f{0.0f, 2.0f}, 0, 10.0f) != 10.0f || circle.TrimMove(ss::vec2f{5.0f, 0.0f}, 0, 10.0f) != 10.0f){return 1;}
+    if(circle.TrimMove(ss::vec2f{0.0f, 0.0f}, 0, -10.0f) != -10.0f || circle.TrimMove(ss::vec2f{0.0f, 0.0f}, 0, 2.0f) != 2.0f){return 1;}
+
+    //Half spaces stop rays heading in at the surface, never ones heading out or starting inside
+    const ss::HalfSpaceShape<float, 2> floor(ss::vec2f{0.0f, 1.0f}, -1.0f);
+    if(floor.TrimMove(ss::vec2f{3.0f, 4.0f}, 1, -10.0f) != -5.0f || floor.TrimMove(ss::vec2f{3.0f, 4.0f}, 1, 10.0f) != 10.0f){return 2;}
+    if(floor.TrimMove(ss::vec2f{3.0f, 4.0f}, 0, -10.0f) != -10.0f || floor.TrimMove(ss::vec2f{3.0f, -4.0f}, 1, -10.0f) != -10.0f){return 2;}
+    if(floor.TrimMove(ss::vec2f{3.0f, -1.0f}, 1, -10.0f) != 0.0f){return 2;}
+    const ss::HalfSpaceShape<float, 2> slope(ss::vec2f{-1.0f, -1.0f}, -4.0f);
+    if(slope.TrimMove(ss::vec2f{0.0f, 0.0f}, 0, 10.0f) != 4.0f || slope.TrimMove(ss::vec2f{0.0f, 0.0f}, 1, 10.0f) != 4.0f){return 2;}
+
+    //Swept boxes against circles and half spaces, exactly what sampling their leading face converges to
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<float> place(-10.0f, 10.0f), size(0.2f, 4.0f), step(-15.0f, 15.0f), fall(-30.0f, 30.0f), normal(-1.0f, 1.0f);
+    for(size_t q = 0; q < 2000; q++){
+        const ss::aabb2f box = ss::aabb2f::FromCenter(ss::vec2f{place(rng), place(rng)}, ss::vec2f{size(rng), size(rng)});
+        const size_t dir = q % 2;
+        const float move = step(rng);
+        //Boxes starting inside a shape are never trimmed by it, where sampling the face might still be
+        const ss::SphereShape<float, 2> s(ss::vec2f{place(rng), place(rng)}, size(rng));
+        float sqr_distance = 0.0f;
+        for(size_t i = 0; i < 2; i++){
+            const float off = std::min(std::max(s.center[i], box.min[i]), box.max[i]) - s.center[i];
+            sqr_distance += off * off;
+        }
+        const float exact = s.TrimBoxMove(box, dir, move), sampled = SampledBoxMove(s, box, dir, move);
+        if(sqr_distance < s.radius * s.radius){
+            if(exact != move){return 3;}
+        }
+        //Sampling can only miss some of the box, so never trims further than the exact sweep
+        else if(std::abs(exact) > std::abs(sampled) + 1e-4f || std::abs(exact - sampled) > 0.05f){return 3;}
+
+        const ss::HalfSpaceShape<float, 2> h(ss::vec2f{normal(rng), normal(rng)}, place(rng));
+        const ss::vec2f deepest{(h.normal[0] > 0) ? box.min[0] : box.max[0], (h.normal[1] > 0) ? box.min[1] : box.max[1]};
+        if((h.normal[0] * deepest[0]) + (h.normal[1] * deepest[1]) < h.offset){
+            if(h.TrimBoxMove(box, dir, move) != move){return 4;}
+        }
+        else if(std::abs(h.TrimBoxMove(box, dir, move) - SampledBoxMove(h, box, dir, move)) > 1e-4f){return 4;}
+    }
+
+    //Boxes trim exactly as AABBRayCollidable, and a mixed group as the same shapes in a virtual group
+    std::vector<ss::AABBRayCollidable<float>> walls;
+    walls.reserve(300);
+    Group group;
+    ss::RayCollisionGroup<float, 2> virtual_group;
+    std::uniform_real_distribution<float> world(0.0f, 100.0f);
+    for(size_t i = 0; i < 300; i++){
+        walls.emplace_back(ss::vec2f{world(rng), world(rng)}, ss::vec2f{size(rng), size(rng)});
+        group.Add(ss::BoxShape<float, 2>(walls.back().GetBounds()));
+        virtual_group.AddCollidable(&walls.back());
+    }
+    std::vector<ss::SphereShape<float, 2>> circles;
+    for(size_t i = 0; i < 50; i++){
+        circles.emplace_back(ss::vec2f{world(rng), world(rng)}, size(rng));
+        if(group.Add(circles.back()) != i){return 5;}
+    }
+    const ss::HalfSpaceShape<float, 2> ground(ss::vec2f{0.0f, 1.0f}, -5.0f);
+    group.Add(ground);
+    if(group.Size() != 351 || group.Get<ss::SphereShape<float, 2>>().size() != 50){return 5;}
+    for(size_t q = 0; q < 2000; q++){
+        const ss::vec2f origin{world(rng), world(rng) / 4.0f};
+        const size_t dir = q % 2;
+        const float move = fall(rng);
+        float expected = virtual_group.TrimMove(origin, dir, move);
+        for(const auto& c : circles){expected = c.TrimMove(origin, dir, expected);}
+        expected = ground.TrimMove(origin, dir, expected);
+        if(group.TrimMove(origin, dir, move) != expected){return 6;}
+
+        const float x[4] = {origin[0], origin[0] + 1.0f, origin[0], origin[0] + 1.0f}, y[4] = {origin[1], origin[1], origin[1] + 1.0f, origin[1] + 1.0f};
+        const std::array<const float*, 2> lanes{x, y};
+        float each = move;
+        for(size_t k = 0; k < 4; k++){each = group.TrimMove(ss::vec2f{x[k], y[k]}, dir, each);}
+        if(group.TrimMoves(lanes, 4, dir, move) != each){return 7;}
+
+        const ss::aabb2f box = ss::aabb2f::FromCenter(origin, ss::vec2f{size(rng), size(rng)});
+        float swept = virtual_group.TrimBoxMove(box, dir, move);
+        for(const auto& c : circles){swept = c.TrimBoxMove(box, dir, swept);}
+        swept = ground.TrimBoxMove(box, dir, swept);
+        if(group.TrimBoxMove(box, dir, move) != swept){return 8;}
+    }
+
+    //Editing the stored shapes directly, then clearing
+    auto& box_list = group.Get<ss::BoxShape<float, 2>>();
+    if(box_list.Get(7).bounds.min != walls[7].GetBounds().min || box_list.Get(7).bounds.max != walls[7].GetBounds().max){return 9;}
+    box_list.Set(7, ss::BoxShape<float, 2>(ss::aabb2f(ss::vec2f{-20.0f, -20.0f}, ss::vec2f{-10.0f, -10.0f})));
+    if(group.TrimMove(ss::vec2f{-25.0f, -15.0f}, 0, 10.0f) != 5.0f || group.TrimBoxMove(ss::aabb2f(ss::vec2f{-16.0f, -30.0f}, ss::vec2f{-14.0f, -25.0f}), 1, 10.0f) != 5.0f){return 9;}
+    box_list.clear();
+    if(group.Size() != 51){return 9;}
+    group.Clear();
+    if(group.Size() != 0 || group.TrimMove(ss::vec2f{0.0f, 0.0f}, 1, -100.0f) != -100.0f){return 9;}
+    return 0;
+}
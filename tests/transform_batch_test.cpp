@@ -0,0 +1,124 @@
+#include<atomic>
+#include<vector>
+
+#include "substd/transform_batch.hpp"
+
+//A local matrix of a translation and a uniform scale, set directly
+class Node : public ss::ITransformable<float,3> {
+public:
+    ss::mat<float,4> local;
+    size_t id;
+    Node(Node* parent, const size_t& id) : ss::ITransformable<float,3>(parent), local(1), id(id) {}
+    ss::mat<float,4> GetLocalMatrix() const override {return local;}
+    void SetLocal(const float& x, const float& scale){
+        local = ss::mat<float,4>(scale);
+        local[3] = ss::vec4f{x, 1.0f - x, 0.5f * x, 1.0f};
+        FlagLocalChange();
+    }
+};
+
+int main(int argc, const char** argv){
+    //Splitting loops across a pool covers every index exactly once
+    ss::ThreadPool pool(4);
+    if(pool.Threads() != 4){return 1;}
+    std::vector<std::atomic<int>> hits(100003);
+    for(int round = 0; round < 3; round++){
+        pool.ParallelFor(hits.size(), [&](const size_t& begin, const size_t& end){
+            for(size_t i = begin; i < end; i++){hits[i].fetch_add(1);}
+        });
+    }
+    for(auto& h : hits){if(h.load() != 3){return 2;}}
+
+    //Wide enough that levels split across threads, parents always created before children
+    const size_t count = 60000;
+    std::vector<Node*> nodes;
+    std::vector<size_t> parent_of(count, count);
+    uint32_t state = 7;
+    nodes.push_back(new Node(nullptr, 0));
+    nodes.push_back(new Node(nullptr, 1));
+    for(size_t i = 2; i < count; i++){
+        state = (state * 1103515245u) + 12345u;
+        parent_of[i] = (state >> 8) % i;
+        nodes.push_back(new Node(nodes[parent_of[i]], i));
+    }
+    for(size_t i = 0; i < count; i++){nodes[i]->SetLocal((float)(i % 13) - 6.0f, (i % 3 == 0) ? 0.5f : 1.0f);}
+
+    //The same products, in the same order, one node at a time
+    auto expected = [&](){
+        std::vector<ss::affine3f> ret(count);
+        for(size_t i = 0; i < count; i++){
+            const ss::affine3f local(nodes[i]->local);
+            ret[i] = (parent_of[i] == count) ? local : (ret[parent_of[i]] * local);
+        }
+        return ret;
+    };
+    ss::ITransformable<float,3>* roots[] = {nodes[0], nodes[1]};
+    ss::TransformLevels<float,3> levels;
+    levels.Rebuild(roots, 2);
+    if(levels.Size() != count || levels.LevelStart(1) != 2 || levels.Levels() < 3){return 3;}
+    auto compare = [&](const std::vector<ss::affine3f>& want){
+        for(size_t k = 0; k < levels.Size(); k++){
+            const Node* node = static_cast<const Node*>(levels.Node(k));
+            const size_t i = node->id;
+            if(levels.Global(k) != want[i] || node->GetGlobalAffine() != want[i] || node->GetGlobalMatrix() != want[i].ToMatrix()){return false;}
+            const ss::TransformLevels<float,3>::index_type p = levels.Parent(k);
+            if((p == levels.NONE) != (parent_of[i] == count)){return false;}
+            if(p != levels.NONE && (levels.LevelStart(1) > k || levels.Node(p) != nodes[parent_of[i]])){return false;}
+        }
+        return true;
+    };
+
+    if(levels.Update(4) != count){return 4;}
+    if(!compare(expected())){return 5;}
+    //Nothing changed, nothing recalculated
+    if(levels.Update(pool) != 0){return 6;}
+
+    //Moving one node recalculates exactly its subtree
+    const size_t moved = 5;
+    nodes[moved]->SetLocal(3.0f, 2.0f);
+    size_t subtree = 0;
+    for(size_t i = 0; i < count; i++){
+        size_t a = i;
+        while(a != count && a != moved){a = parent_of[a];}
+        subtree += (a == moved);
+    }
+    if(levels.Update(pool) != subtree){return 7;}
+    if(!compare(expected())){return 8;}
+
+    //Reads in between recalculate lazily, the next Update copies what they did rather than redoing it
+    nodes[0]->SetLocal(-2.0f, 1.0f);
+    for(size_t i = 0; i < count; i += 2){nodes[i]->GetGlobalMatrix();}
+    const size_t under_root = levels.Update(pool);
+    if(under_root == 0 || !compare(expected())){return 9;}
+
+    //Trimming a subtree into its own tree is picked up after a Rebuild, recalculating only that subtree
+    nodes[parent_of[moved]]->TrimChild(nodes[moved]);
+    parent_of[moved] = count;
+    ss::ITransformable<float,3>* more[] = {nodes[0], nodes[1], nodes[moved]};
+    levels.Rebuild(more, 3);
+    if(levels.Size() != count || levels.Update(1) != subtree){return 10;}
+    if(!compare(expected())){return 11;}
+
+    //Many roots under one parent outside the trees, which moves before the update
+    Node* outside = new Node(nullptr, 0);
+    std::vector<ss::ITransformable<float,3>*> siblings;
+    for(size_t i = 0; i < 10000; i++){
+        Node* child = new Node(outside, i);
+        child->SetLocal((float)(i % 13), 1.0f);
+        siblings.push_back(child);
+    }
+    levels.Rebuild(siblings.data(), siblings.size());
+    levels.Update(4);
+    outside->SetLocal(3.0f, 2.0f);
+    if(levels.Update(4) != siblings.size()){return 12;}
+    for(size_t k = 0; k < levels.Size(); k++){
+        const Node* child = static_cast<const Node*>(levels.Node(k));
+        if(levels.Global(k).ToMatrix() != outside->local * child->local){return 12;}
+    }
+
+    delete outside;
+    delete nodes[0];
+    delete nodes[1];
+    delete nodes[moved];
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "substd/transform.hpp"
+
+template<typename T, size_t dim>
+bool Near(const ss::mat<T,dim+1>& a, const ss::mat<T,dim+1>& b, const T& tolerance){
+    for(size_t col = 0; col <= dim; col++){
+        for(size_t row = 0; row <= dim; row++){
+            if(ss::Abs<T>(a[col][row] - b[col][row]) > tolerance){return false;}
+        }
+    }
+    return true;
+}
+
+//Translation * scale * rotation, built from full homogeneous matrices
+template<typename T, size_t dim>
+ss::mat<T,dim+1> Reference(const ss::vec<T,dim>& position, const ss::vec<T,dim>& scale, const ss::vec<T,(dim*(dim-1))/2>& rotation){
+    ss::mat<T,dim+1> plug(1), rot(1);
+    for(size_t i = 0; i < dim; i++){
+        plug[i][i] = scale[i];
+        plug[dim][i] = position[i];
+    }
+    const ss::mat<T,dim> r = ss::CreateRotationMatrix<T,dim>(rotation);
+    for(size_t col = 0; col < dim; col++){
+        for(size_t row = 0; row < dim; row++){rot[col][row] = r[col][row];}
+    }
+    return plug * rot;
+}
+
+int main(int argc, const char** argv){
+    ss::Transform3d root;
+    ss::Transform3d* child = new ss::Transform3d(&root);
+    const ss::vec3d position{1.0, -2.0, 3.0}, scale{2.0, 0.5, 1.5}, rotation{0.1, -0.7, 2.0};
+    root.SetPosition(position);
+    root.SetScale(scale);
+    root.SetRotation(rotation);
+    if(!Near<double,3>(root.GetLocalMatrix(), Reference<double,3>(position, scale, rotation), 1e-12)){return 1;}
+    if(root.GetLocalAffine().ToMatrix() != root.GetLocalMatrix()){return 2;}
+    if(root.GetPosition() != position || root.GetScale() != scale){return 3;}
+
+    //Angles are kept modulo tau, which leaves the matrix as it was
+    root.SetRotation(rotation[1] + (ss::TAU * 3.0), 1);
+    if(ss::Abs<double>(root.GetRotation()[1] - (rotation[1] + ss::TAU)) > 1e-12){return 4;}
+    if(!Near<double,3>(root.GetLocalMatrix(), Reference<double,3>(position, scale, rotation), 1e-12)){return 5;}
+
+    //Every setter reaches the globals below
+    child->SetPosition(ss::vec3d{0.0, 1.0, 0.0});
+    child->SetRotation(0.5, 2);
+    if(!Near<double,3>(child->GetGlobalMatrix(), root.GetLocalMatrix() * child->GetLocalMatrix(), 1e-12)){return 6;}
+    root.SetPosition(4.0, 0);
+    root.SetScale(3.0, 2);
+    if(!Near<double,3>(child->GetGlobalMatrix(), root.GetLocalMatrix() * child->GetLocalMatrix(), 1e-12)){return 7;}
+    if(!Near<double,3>(child->GetGlobalAffine().ToMatrix(), child->GetGlobalMatrix(), 0.0)){return 8;}
+
+    //Every matrix Orientation builds has orthogonal rows, so either inverse works
+    const ss::affine3d local = root.GetLocalAffine();
+    if(!Near<double,3>((local * local.OrthogonalInverse()).ToMatrix(), ss::mat<double,4>(1), 1e-12)){return 9;}
+
+    //CreateTRS in every dimension, a zero angle skipped
+    const ss::vec<double,4> position4{1.0, 2.0, -3.0, 0.5}, scale4{2.0, 1.0, 0.25, 3.0};
+    const ss::vec<double,6> rotation4{0.3, 0.0, -1.2, 2.5, 0.7, -0.1};
+    if(!Near<double,4>(ss::CreateTRS<double,4>(position4, scale4, rotation4).ToMatrix(), Reference<double,4>(position4, scale4, rotation4), 1e-12)){return 11;}
+
+    ss::Transform2f flat;
+    flat.SetPosition(ss::vec2f{1.0f, 2.0f});
+    flat.SetRotation(ss::vec<float,1>{1.0f});
+    if(!Near<float,2>(flat.GetLocalMatrix(), Reference<float,2>(ss::vec2f{1.0f, 2.0f}, ss::vec2f{1.0f, 1.0f}, ss::vec<float,1>{1.0f}), 1e-6f)){return 10;}
+    return 0;
+}
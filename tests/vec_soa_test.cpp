@@ -0,0 +1,96 @@
+#include<cmath>
+#include<cstdint>
+#include<stdexcept>
+#include<vector>
+
+#include "substd/vec_soa.hpp"
+
+//Every bulk operation against the same done one vec at a time, over a count no pack width divides
+template<typename T>
+bool AgreesWithVec(const size_t& count){
+    using V = ss::vec<T,3>;
+    std::vector<V> a(count), b(count);
+    for(size_t i = 0; i < count; i++){
+        a[i] = V{(T)i * (T)0.5, (T)1 - (T)i, (T)(i % 7) + (T)0.25};
+        b[i] = V{(T)3, (T)i * (T)0.125, (T)-2 - (T)(i % 5)};
+    }
+    ss::vec_soa<T,3> sa(a), sb(b);
+    if(sa.size() != count || sa.ToVector() != a){return false;}
+    //Lanes start on a cache line, so whole packs load from them
+    for(size_t c = 0; c < 3; c++){
+        if(reinterpret_cast<uintptr_t>(sa.Lane(c)) % 64 != 0 || sa.Lane(c)[count - 1] != a[count - 1][c]){return false;}
+    }
+
+    const ss::vec_soa<T,3> sum = sa + sb, dif = sa - sb, prod = sa * (T)3, quot = sa / (T)4;
+    ss::vec_soa<T,3> shifted(sa);
+    shifted += V{(T)1, (T)2, (T)3};
+    shifted -= V{(T)0.5, (T)0.5, (T)0.5};
+    const std::vector<T> dot = sa.Dot(sb), length = sa.Magnitude();
+    const ss::vec_soa<T,3> unit = sa.Normalized();
+    for(size_t i = 0; i < count; i++){
+        if(sum.Get(i) != a[i] + b[i] || dif.Get(i) != a[i] - b[i]){return false;}
+        if(prod.Get(i) != a[i] * (T)3 || quot.Get(i) != a[i] / (T)4){return false;}
+        if(shifted.Get(i) != a[i] + V{(T)1, (T)2, (T)3} - V{(T)0.5, (T)0.5, (T)0.5}){return false;}
+        const T expected_dot = (a[i][0] * b[i][0]) + (a[i][1] * b[i][1]) + (a[i][2] * b[i][2]);
+        if(std::abs(dot[i] - expected_dot) > (T)1e-4 * (std::abs(expected_dot) + (T)1)){return false;}
+        const T expected_length = std::sqrt((a[i][0] * a[i][0]) + (a[i][1] * a[i][1]) + (a[i][2] * a[i][2]));
+        if(std::abs(length[i] - expected_length) > (T)1e-3 * expected_length){return false;}
+        for(size_t c = 0; c < 3; c++){
+            if(std::abs(unit[i][c] - (a[i][c] / expected_length)) > (T)1e-3){return false;}
+        }
+    }
+
+    //Binary operations only cover the shorter of the two
+    if(count < 2){return true;}
+    ss::vec_soa<T,3> shorter(sb);
+    shorter.pop_back();
+    ss::vec_soa<T,3> partial(sa);
+    partial.Add(shorter);
+    if(partial.Get(count - 2) != a[count - 2] + b[count - 2] || partial.Get(count - 1) != a[count - 1]){return false;}
+    if(sa.Dot(shorter).size() != count - 1){return false;}
+    return true;
+}
+
+int main(int argc, const char** argv){
+    //Proxies read and write through to the lanes
+    ss::vec3f_soa soa(4, ss::vec3f{1.0f, 2.0f, 3.0f});
+    if(soa.size() != 4 || soa[3].Get() != ss::vec3f{1.0f, 2.0f, 3.0f} || soa[2][1] != 2.0f){return 1;}
+    soa[1] = ss::vec3f{4.0f, 5.0f, 6.0f};
+    soa[2] = soa[1];
+    soa[0][2] = 9.0f;
+    const ss::vec3f_soa& view = soa;
+    const ss::vec3f read = view[2];
+    if(read != ss::vec3f{4.0f, 5.0f, 6.0f} || view[0].Get() != ss::vec3f{1.0f, 2.0f, 9.0f} || soa.Lane(1)[1] != 5.0f){return 2;}
+
+    //Get and Set, Set taking only the components both have
+    soa.Set(3, ss::vec2i{7, 8});
+    if(soa.Get(3) != ss::vec3f{7.0f, 8.0f, 3.0f}){return 3;}
+
+    //Container operations keep every lane the same length
+    soa.push_back(ss::vec3f{-1.0f, -2.0f, -3.0f});
+    if(soa.size() != 5 || soa.Lane(2)[4] != -3.0f){return 4;}
+    soa.pop_back();
+    soa.resize(6, ss::vec3f{0.5f, 0.5f, 0.5f});
+    if(soa.size() != 6 || soa.Get(5) != ss::vec3f{0.5f, 0.5f, 0.5f} || soa.Get(3) != ss::vec3f{7.0f, 8.0f, 3.0f}){return 4;}
+    bool thrown = false;
+    try {soa.at(6);}
+    catch(const std::out_of_range&){thrown = true;}
+    if(!thrown){return 4;}
+    soa.clear();
+    if(!soa.empty() || soa.size() != 0){return 4;}
+
+    //AoS to SoA and back, and homogenized with a filled lane
+    std::vector<ss::vec2d> aos{ss::vec2d{1.0, 2.0}, ss::vec2d{3.0, 4.0}, ss::vec2d{5.0, 6.0}};
+    ss::vec2d_soa from(aos);
+    std::vector<ss::vec2d> back(3);
+    from.CopyTo(back.data());
+    if(back != aos){return 5;}
+    from.Assign(aos.data() + 1, 2);
+    if(from.size() != 2 || from.Get(0) != aos[1]){return 5;}
+    const ss::vec3d_soa homogenized = from.Homogenized();
+    if(homogenized.Get(1) != ss::vec3d{5.0, 6.0, 1.0}){return 5;}
+
+    if(!AgreesWithVec<float>(1) || !AgreesWithVec<float>(37) || !AgreesWithVec<float>(1000)){return 6;}
+    if(!AgreesWithVec<double>(1) || !AgreesWithVec<double>(37) || !AgreesWithVec<double>(1000)){return 7;}
+    return 0;
+}
@@ -1,7 +1,93 @@
+#include<cstdint>
+#include<type_traits>
+
 #include "substd/vec.hpp"
 
+//Each kernel against the same done element by element, values small enough that every result is exact
+template<typename T, size_t dim>
+bool KernelAgreesWithScalar(){
+    using K = ss::simd::kernel<T,dim>;
+    if constexpr(K::enabled) {
+        T a[dim], b[dim], out[dim];
+        for(size_t i = 0; i < dim; i++){
+            a[i] = (T)((int)(i * 3) - 4);
+            b[i] = (T)((int)(i * 5) + 2);
+        }
+        T dot = 0;
+        for(size_t i = 0; i < dim; i++){dot += a[i] * b[i];}
+        if(K::Dot(a, b) != dot){return false;}
+        K::Add(a, b, out);
+        for(size_t i = 0; i < dim; i++){if(out[i] != a[i] + b[i]){return false;}}
+        K::Sub(a, b, out);
+        for(size_t i = 0; i < dim; i++){if(out[i] != a[i] - b[i]){return false;}}
+        K::Mul(a, b, out);
+        for(size_t i = 0; i < dim; i++){if(out[i] != a[i] * b[i]){return false;}}
+        K::Scale(a, (T)-3, out);
+        for(size_t i = 0; i < dim; i++){if(out[i] != a[i] * (T)-3){return false;}}
+        if constexpr(K::has_div) {
+            K::Div(a, b, out);
+            for(size_t i = 0; i < dim; i++){if(out[i] != a[i] / b[i]){return false;}}
+            K::ScaleDiv(a, (T)4, out);
+            for(size_t i = 0; i < dim; i++){if(out[i] != a[i] / (T)4){return false;}}
+        }
+        //In place, as vec's compound operators call them
+        K::Add(a, b, a);
+        for(size_t i = 0; i < dim; i++){if(a[i] != (T)((int)(i * 8) - 2)){return false;}}
+    }
+    return true;
+}
+
+//vec's operators, whichever path they take, against the same done element by element
+template<typename T, size_t dim>
+bool VecAgreesWithScalar(){
+    ss::vec<T,dim> a, b;
+    for(size_t i = 0; i < dim; i++){
+        a[i] = (T)((int)(i * 7) - 9);
+        b[i] = (T)((int)(i * 2) + 1);
+    }
+    const ss::vec<T,dim> sum = a + b, dif = a - b, prod = a * (T)5, quot = a / (T)2;
+    ss::vec<T,dim> compound(a);
+    compound += b;
+    compound -= a;
+    compound *= (T)3;
+    T dot = 0;
+    for(size_t i = 0; i < dim; i++){
+        if(sum[i] != a[i] + b[i] || dif[i] != a[i] - b[i] || prod[i] != a[i] * (T)5 || quot[i] != a[i] / (T)2){return false;}
+        if(compound[i] != b[i] * (T)3){return false;}
+        dot += a[i] * b[i];
+    }
+    return a.Dot(b) == dot && a.MagnitudeSqr() == a.Dot(a);
+}
+
 int main(int argc, const char** argv){
     ss::vec<float,2> v2f = {1.0f, 2.0f};
-    if(v2f[0] != 2.0f){return 1;}
+    if(v2f[0] != 1.0f){return 1;}
     if(v2f[1] != 2.0f){return 2;}
-}
\ No newline at end of file
+
+    //Every kernel specialization, whichever this target enables, and the vec operations using them
+    if(!KernelAgreesWithScalar<float, 4>() || !VecAgreesWithScalar<float, 4>()){return 3;}
+    if(!KernelAgreesWithScalar<double, 2>() || !VecAgreesWithScalar<double, 2>()){return 4;}
+    if(!KernelAgreesWithScalar<double, 4>() || !VecAgreesWithScalar<double, 4>()){return 5;}
+    if(!KernelAgreesWithScalar<int32_t, 4>() || !VecAgreesWithScalar<int32_t, 4>()){return 6;}
+    if(!VecAgreesWithScalar<float, 3>() || !VecAgreesWithScalar<int32_t, 2>() || !VecAgreesWithScalar<double, 5>()){return 7;}
+
+    //A shorter or differently typed other applies over the elements both have, the rest keep the value of this
+    const ss::vec<float,4> v4f{1.0f, 2.0f, 3.0f, 4.0f};
+    if(v4f + ss::vec2f{10.0f, 20.0f} != ss::vec4f{11.0f, 22.0f, 3.0f, 4.0f}){return 8;}
+    if(v4f - ss::vec<int,3>{1, 1, 1} != ss::vec4f{0.0f, 1.0f, 2.0f, 4.0f}){return 8;}
+    ss::vec<int,3> v3i{1, 2, 3};
+    v3i += ss::vec<int,5>{1, 1, 1, 100, 100};
+    if(v3i != ss::vec<int,3>{2, 3, 4}){return 8;}
+    if(v4f.Dot(ss::vec2f{1.0f, 1.0f}) != 3.0f){return 8;}
+
+    //Magnitude and Normalized default to trig_t, whatever T is
+    const ss::vec<int,2> v2i{3, 4};
+    static_assert(std::is_same_v<decltype(v2i.Magnitude()), ss::trig_t>, "Magnitude() defaults to trig_t");
+    static_assert(std::is_same_v<decltype(v2i.Normalized()), ss::vec<ss::trig_t,2>>, "Normalized() defaults to trig_t");
+    if(ss::Abs(v2i.Magnitude() - 5.0) > 1e-6 || ss::Abs(v2i.Normalized()[1] - 0.8) > 1e-3){return 9;}
+    if(ss::Abs(v2i.Magnitude<float>() - 5.0f) > 1e-4f){return 9;}
+
+    //Nearest picks whichever value is closer, not the distance to it
+    if(ss::Nearest(1.0, 5.0, 4.0) != 5.0 || ss::Nearest(-3, 10, -1) != -3 || ss::Nearest(2.0f, 8.0f, 2.5f) != 2.0f){return 10;}
+    return 0;
+}